@@ -14,12 +14,13 @@ import voluptuous as vol
 
 from homeassistant.core import HomeAssistant, CoreState, Event
 from homeassistant.config_entries import ConfigEntry
-from homeassistant.const import Platform, EVENT_HOMEASSISTANT_STARTED
+from homeassistant.const import Platform, EVENT_HOMEASSISTANT_STARTED, EVENT_HOMEASSISTANT_STOP
 from homeassistant.helpers import config_validation as cv
 from homeassistant.helpers.discovery import async_load_platform
 
 from .const import DOMAIN
-from .websocket_api import async_register_websocket_api
+from .pool import IntercomConnectionPool
+from .websocket_api import async_register_websocket_api, intercom_hosts
 
 CONFIG_SCHEMA = cv.config_entry_only_config_schema(DOMAIN)
 
@@ -34,6 +35,10 @@ async def _async_setup_shared(hass: HomeAssistant, config: dict | None = None) -
     hass.data.setdefault(DOMAIN, {})
     hass.data[DOMAIN]["initialized"] = True
 
+    # Warm standby connection per intercom, leased by call sessions and bridges
+    pool = IntercomConnectionPool(lambda: intercom_hosts(hass))
+    hass.data[DOMAIN]["pool"] = pool
+
     # Register WebSocket API commands
     async_register_websocket_api(hass)
 
@@ -53,6 +58,19 @@ async def _async_setup_shared(hass: HomeAssistant, config: dict | None = None) -
     else:
         hass.bus.async_listen_once(EVENT_HOMEASSISTANT_STARTED, _register_frontend)
 
+    # Start warming once devices are registered, close the idle links on shutdown
+    async def _start_pool(_event: Event | None = None) -> None:
+        pool.start()
+
+    async def _stop_pool(_event: Event) -> None:
+        await pool.async_stop()
+
+    if hass.state == CoreState.running:
+        await _start_pool(None)
+    else:
+        hass.bus.async_listen_once(EVENT_HOMEASSISTANT_STARTED, _start_pool)
+    hass.bus.async_listen_once(EVENT_HOMEASSISTANT_STOP, _stop_pool)
+
     _LOGGER.info("Intercom Native integration loaded (simple + full mode auto-bridge)")
 
 
@@ -0,0 +1,98 @@
+"""Opus transcoding between ESP Opus calls and PCM consumers (browser card)."""
+
+import logging
+import random
+import struct
+
+from .const import SAMPLE_RATE, OPUS_BITRATE, DTX_SILENCE_LEVEL
+
+_LOGGER = logging.getLogger(__name__)
+
+try:
+    import opuslib
+
+    OPUS_AVAILABLE = True
+except Exception:  # ImportError, or OSError when libopus itself is missing
+    opuslib = None
+    OPUS_AVAILABLE = False
+
+OPUS_MAX_FRAME_SAMPLES = SAMPLE_RATE * 60 // 1000  # Largest Opus frame the ESP can send
+
+
+class OpusTranscoder:
+    """PCM <-> Opus for one TCP leg (16 kHz mono 16-bit).
+
+    encode() buffers PCM until a full frame is available, so callers can push
+    chunks of any size (the card sends 2048-byte chunks, Opus wants 640 bytes).
+    """
+
+    def __init__(self, frame_ms: int, bitrate: int = OPUS_BITRATE):
+        self.frame_ms = frame_ms
+        self._frame_samples = SAMPLE_RATE * frame_ms // 1000
+        self._frame_bytes = self._frame_samples * 2
+        self._pcm_pending = bytearray()
+
+        self._encoder = opuslib.Encoder(SAMPLE_RATE, 1, opuslib.APPLICATION_VOIP)
+        self._encoder.bitrate = bitrate
+        self._decoder = opuslib.Decoder(SAMPLE_RATE, 1)
+        self._decode_errors = 0
+
+    def encode(self, pcm: bytes) -> list:
+        """Return the Opus packets for every complete frame buffered so far."""
+        self._pcm_pending.extend(pcm)
+        packets = []
+        while len(self._pcm_pending) >= self._frame_bytes:
+            frame = bytes(self._pcm_pending[:self._frame_bytes])
+            del self._pcm_pending[:self._frame_bytes]
+            try:
+                packets.append(self._encoder.encode(frame, self._frame_samples))
+            except opuslib.OpusError as err:
+                _LOGGER.debug("Opus encode error: %s", err)
+        return packets
+
+    def decode(self, packet: bytes) -> bytes:
+        """Decode one Opus packet to PCM, b"" on error."""
+        try:
+            return self._decoder.decode(packet, OPUS_MAX_FRAME_SAMPLES)
+        except opuslib.OpusError as err:
+            self._decode_errors += 1
+            if self._decode_errors <= 5 or self._decode_errors % 100 == 0:
+                _LOGGER.warning("Opus decode error: %s (errors=%d)", err, self._decode_errors)
+            return b""
+
+
+COMFORT_NOISE_TABLE_SAMPLES = 8192  # ~0.5 s of noise per level before it repeats
+
+
+class ComfortNoise:
+    """PCM comfort noise for DTX silence descriptors (16 kHz mono 16-bit).
+
+    One white noise table per noise floor level is built on first use and then
+    played from a running offset, so a long pause costs slicing only.
+    """
+
+    def __init__(self):
+        self._tables: dict = {}
+        self._offset = 0
+
+    def generate(self, level: int, samples: int) -> bytes:
+        """Return samples of noise at -level dBFS RMS (zeros at DTX_SILENCE_LEVEL and below)."""
+        samples = min(samples, COMFORT_NOISE_TABLE_SAMPLES)
+        if level >= DTX_SILENCE_LEVEL:
+            return bytes(samples * 2)
+        table = self._tables.get(level)
+        if table is None:
+            # Uniform noise: peak = RMS * sqrt(3)
+            peak = min(32767.0, 32768.0 * 10 ** (-level / 20) * 1.7320508)
+            rng = random.Random(level)
+            table = struct.pack(
+                "<%dh" % COMFORT_NOISE_TABLE_SAMPLES,
+                *(int(rng.uniform(-peak, peak)) for _ in range(COMFORT_NOISE_TABLE_SAMPLES)),
+            )
+            self._tables[level] = table
+        start = self._offset * 2
+        end = start + samples * 2
+        self._offset = (self._offset + samples) % COMFORT_NOISE_TABLE_SAMPLES
+        if end <= len(table):
+            return table[start:end]
+        return table[start:] + table[:end - len(table)]
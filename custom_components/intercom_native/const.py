@@ -25,15 +25,71 @@ MSG_PONG = 0x05
 MSG_ERROR = 0x06
 MSG_RING = 0x07      # ESP→HA: auto_answer OFF, waiting for local answer
 MSG_ANSWER = 0x08    # ESP→HA: call answered locally, start stream
+MSG_DIAL = 0x09      # HA→ESP: call a peer ESP directly (IPv4, port LE, callee name)
+MSG_PROBE = 0x0A       # In-call latency probe (both directions), answered with MSG_PROBE_ECHO
+MSG_PROBE_ECHO = 0x0B  # Probe answer: the probe's origin timestamp, the responder's own delays
 
 # Message flags
 FLAG_NONE = 0x00
 FLAG_NO_RING = 0x02  # START flag: skip ringing, start streaming directly (for caller in bridge)
+FLAG_CODEC = 0x04    # START/ANSWER: payload ends with codec offer; PONG/RING: payload is codec params
+FLAG_DATAGRAM = 0x08 # START/ANSWER: offer ends with our UDP port; PONG/RING: ESP's UDP port follows
+FLAG_MONITOR = 0x10  # START flag: listen-only subscriber to the call's mic audio
+FLAG_DTX = 0x20      # START/ANSWER/PONG/RING: peer plays comfort noise; AUDIO: payload is a silence descriptor
+FLAG_LATENCY = 0x40  # START/ANSWER/PONG/RING: peer answers MSG_PROBE during the call
+FLAG_STANDBY = 0x80  # PING/PONG: ESP parks this connection between calls (connection pool)
+
+# Error codes (ERROR payload)
+ERROR_BUSY = 0x01
+ERROR_UNREACHABLE = 0x04  # DIAL: the ESP could not reach the callee - relay instead
+
+# Codecs (negotiated per call, PCM is always the fallback)
+CODEC_PCM = 0x00
+CODEC_OPUS = 0x01
+CODEC_MASK_PCM = 1 << CODEC_PCM
+CODEC_MASK_OPUS = 1 << CODEC_OPUS
+CODEC_NAMES = {CODEC_PCM: "pcm", CODEC_OPUS: "opus"}
+
+# Audio format (fixed on the ESP side)
+SAMPLE_RATE = 16000
+PCM_FRAME_MS = 32    # ESP PCM frame until it answers our offer (older firmware: always 1024 bytes)
+OPUS_FRAME_MS = 20   # Frame duration we offer for Opus
+OPUS_BITRATE = 24000
 
 # Header size
 HEADER_SIZE = 4
 
+# DTX silence descriptor (AUDIO with FLAG_DTX): <BH> noise floor (-dBFS), samples it replaces
+COMFORT_NOISE_FRAME_SIZE = 3
+DTX_SILENCE_LEVEL = 90  # Floor at or below -90 dBFS plays zeros
+
+# Latency probe (MSG_PROBE / MSG_PROBE_ECHO): <IHH> origin µs (prober's clock, wraps),
+# sender's capture-side and playout-side buffered delay in ms
+LATENCY_PROBE_SIZE = 8
+PROBE_MAX_RTT_US = 5_000_000  # Older echoes are dropped
+
+# Binary browser audio channel (card <-> HA websocket, replaces base64 JSON)
+# One frame per websocket message: <BBH> kind, codec, seq (+1 per frame, wraps) + payload
+AUDIO_CHANNEL_URL = "/api/intercom_native/audio/{device_id}"
+AUDIO_FRAME_HEADER_SIZE = 4
+AUDIO_FRAME_KIND_AUDIO = 0x01
+AUDIO_FRAME_MAX_SIZE = 8192
+
+# Datagram audio: <BBHI> type, flags, seq, timestamp (16 kHz samples) + one AUDIO frame
+DATAGRAM_HEADER_SIZE = 8
+MAX_DATAGRAM_PAYLOAD = 1024  # ESP jitter buffer slot size
+
 # Timeouts
 CONNECT_TIMEOUT = 5.0
+CALL_REPLY_TIMEOUT = 0.5  # PONG/RING to START/ANSWER - older firmware may send none
+DIAL_TIMEOUT = 2.5   # ESP gives up on the callee after 1.5 s
+STANDBY_TIMEOUT = 2.0  # PONG to the pool's standby PING
 PING_INTERVAL = 5.0
+PROBE_INTERVAL = 2.5  # In-call latency probe, every other tick is a PING
+LATENCY_ATTR_INTERVAL = 10.0  # Sensor attribute writes while calls report latency
+
+# Connection pool: warm links are (re)opened on every pass, firmware without a standby
+# slot is asked again after POOL_LEGACY_RETRY (it may have been updated)
+POOL_REFRESH_INTERVAL = 30.0
+POOL_LEGACY_RETRY = 600.0
 
@@ -13,6 +13,14 @@
 
 const INTERCOM_CARD_VERSION = "2.1.4";
 
+// Binary audio channel (AudioChannelView): one frame per websocket message,
+// <BBH> kind, codec, seq (little-endian) + PCM s16le 16 kHz mono
+const AUDIO_FRAME_HEADER_SIZE = 4;
+const AUDIO_FRAME_KIND_AUDIO = 0x01;
+const AUDIO_CODEC_PCM = 0x00;
+const AUDIO_SOCKET_MAX_BUFFERED = 16384;  // Drop mic frames rather than queue latency
+const AUDIO_SOCKET_OPEN_TIMEOUT_MS = 3000;
+
 class IntercomCard extends HTMLElement {
   constructor() {
     super();
@@ -31,6 +39,8 @@ class IntercomCard extends HTMLElement {
     this._gainNode = null;
     this._nextPlayTime = 0;
     this._unsubscribeAudio = null;
+    this._audioSocket = null;  // Binary channel; null = base64 JSON fallback
+    this._txSeq = 0;
     this._chunksSent = 0;
     this._chunksReceived = 0;
 
@@ -516,10 +526,7 @@ class IntercomCard extends HTMLElement {
     });
     if (!result.success) throw new Error("Start failed");
 
-    this._unsubscribeAudio = await this._hass.connection.subscribeMessage(
-      (msg) => this._handleAudioMessage(msg),
-      { type: "intercom_native/subscribe_audio", device_id: deviceInfo.device_id }
-    );
+    await this._openAudioChannel(deviceInfo.device_id);
 
     this._audioStreaming = true;
     this._chunksSent = 0;
@@ -536,10 +543,7 @@ class IntercomCard extends HTMLElement {
     });
     if (!result.success) throw new Error("Answer failed");
 
-    this._unsubscribeAudio = await this._hass.connection.subscribeMessage(
-      (msg) => this._handleAudioMessage(msg),
-      { type: "intercom_native/subscribe_audio", device_id: deviceInfo.device_id }
-    );
+    await this._openAudioChannel(deviceInfo.device_id);
 
     this._audioStreaming = true;
     this._chunksSent = 0;
@@ -682,6 +686,7 @@ class IntercomCard extends HTMLElement {
 
   async _cleanup() {
     if (this._unsubscribeAudio) { this._unsubscribeAudio(); this._unsubscribeAudio = null; }
+    if (this._audioSocket) { this._audioSocket.close(); this._audioSocket = null; }
     if (this._mediaStream) { this._mediaStream.getTracks().forEach(t => t.stop()); this._mediaStream = null; }
     if (this._workletNode) { this._workletNode.disconnect(); this._workletNode = null; }
     if (this._scriptProcessor) { this._scriptProcessor.disconnect(); this._scriptProcessor = null; }
@@ -715,9 +720,58 @@ class IntercomCard extends HTMLElement {
     return null;
   }
 
+  async _openAudioChannel(deviceId) {
+    // Binary websocket first: raw frames, no JSON/base64 on either side
+    try {
+      const { path } = await this._hass.callWS({
+        type: "auth/sign_path",
+        path: `/api/intercom_native/audio/${encodeURIComponent(deviceId)}`,
+      });
+      const url = new URL(path, window.location.href);
+      url.protocol = url.protocol === "https:" ? "wss:" : "ws:";
+      const ws = new WebSocket(url.toString());
+      ws.binaryType = "arraybuffer";
+      await new Promise((resolve, reject) => {
+        const timer = setTimeout(() => reject(new Error("timeout")), AUDIO_SOCKET_OPEN_TIMEOUT_MS);
+        ws.onopen = () => { clearTimeout(timer); resolve(); };
+        ws.onerror = () => { clearTimeout(timer); reject(new Error("connect failed")); };
+      });
+      ws.onmessage = (e) => this._handleBinaryAudio(e.data);
+      ws.onclose = () => { if (this._audioSocket === ws) this._audioSocket = null; };
+      this._audioSocket = ws;
+      this._txSeq = 0;
+      return;
+    } catch (err) {
+      console.warn("[IntercomCard] Binary audio channel unavailable, using JSON:", err);
+    }
+
+    this._unsubscribeAudio = await this._hass.connection.subscribeMessage(
+      (msg) => this._handleAudioMessage(msg),
+      { type: "intercom_native/subscribe_audio", device_id: deviceId }
+    );
+  }
+
   _sendAudio(int16Array) {
     if (!this._audioStreaming || !this._activeDeviceInfo) return;
     const bytes = new Uint8Array(int16Array.buffer);
+
+    const ws = this._audioSocket;
+    if (ws && ws.readyState === WebSocket.OPEN) {
+      if (ws.bufferedAmount <= AUDIO_SOCKET_MAX_BUFFERED) {
+        const frame = new Uint8Array(AUDIO_FRAME_HEADER_SIZE + bytes.length);
+        const header = new DataView(frame.buffer);
+        header.setUint8(0, AUDIO_FRAME_KIND_AUDIO);
+        header.setUint8(1, AUDIO_CODEC_PCM);
+        header.setUint16(2, this._txSeq, true);
+        frame.set(bytes, AUDIO_FRAME_HEADER_SIZE);
+        ws.send(frame.buffer);
+      }
+      this._txSeq = (this._txSeq + 1) & 0xffff;
+      this._chunksSent++;
+      if (this._chunksSent % 25 === 0) this._updateStats();
+      return;
+    }
+
     let binary = "";
     for (let i = 0; i < bytes.length; i += 0x8000) {
       binary += String.fromCharCode.apply(null, bytes.subarray(i, Math.min(i + 0x8000, bytes.length)));
@@ -744,14 +798,29 @@ class IntercomCard extends HTMLElement {
       const bytes = new Uint8Array(binary.length);
       for (let i = 0; i < binary.length; i++) bytes[i] = binary.charCodeAt(i);
 
-      const int16 = new Int16Array(bytes.buffer);
-      const float32 = new Float32Array(int16.length);
-      for (let i = 0; i < int16.length; i++) float32[i] = int16[i] / 32768.0;
-
-      this._playScheduled(float32);
+      this._playPcm(new Int16Array(bytes.buffer));
     } catch (err) {}
   }
 
+  _handleBinaryAudio(data) {
+    if (!(data instanceof ArrayBuffer) || data.byteLength <= AUDIO_FRAME_HEADER_SIZE) return;
+    if (!this._audioStreaming || !this._playbackContext) return;
+    const header = new DataView(data, 0, AUDIO_FRAME_HEADER_SIZE);
+    if (header.getUint8(0) !== AUDIO_FRAME_KIND_AUDIO || header.getUint8(1) !== AUDIO_CODEC_PCM) return;
+
+    this._chunksReceived++;
+    if (this._chunksReceived % 50 === 0) this._updateStats();
+
+    const samples = (data.byteLength - AUDIO_FRAME_HEADER_SIZE) >> 1;
+    this._playPcm(new Int16Array(data, AUDIO_FRAME_HEADER_SIZE, samples));
+  }
+
+  _playPcm(int16) {
+    const float32 = new Float32Array(int16.length);
+    for (let i = 0; i < int16.length; i++) float32[i] = int16[i] / 32768.0;
+    this._playScheduled(float32);
+  }
+
   _playScheduled(float32) {
     if (!this._playbackContext || !this._gainNode) return;
     try {
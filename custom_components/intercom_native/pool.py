@@ -0,0 +1,147 @@
+"""Connection pool: one warm, keep-alive TCP link per intercom, leased per call."""
+
+import asyncio
+import logging
+import time
+from typing import Awaitable, Callable, Dict, Iterable, Optional, Set
+
+from .const import INTERCOM_PORT, POOL_LEGACY_RETRY, POOL_REFRESH_INTERVAL
+from .tcp_client import IntercomTcpClient
+
+_LOGGER = logging.getLogger(__name__)
+
+
+class IntercomConnectionPool:
+    """Warm connections to every intercom, shared by sessions and bridges.
+
+    A call on a fresh connection waits for the TCP handshake (and the ESP's accept)
+    before START can go out. The pool connects to every intercom up front and asks
+    the ESP to park the link in its standby slot (PING with FLAG_STANDBY), outside the
+    call client slot, so peers can still call the device directly. acquire() leases
+    that link to one session or bridge leg: START/ANSWER/DIAL go out at once, and the
+    ESP moves the link into its call slot. release() hands it back; the ESP has parked
+    it again by then. Busy links, unreachable hosts and firmware without a standby slot
+    get a connection per call, as before - the pool only ever saves the handshake.
+    """
+
+    def __init__(self, hosts: Callable[[], Awaitable[Iterable[str]]]):
+        self._hosts = hosts  # Intercom hosts to keep warm, read again on every pass
+        self._idle: Dict[str, IntercomTcpClient] = {}
+        self._leased: Set[IntercomTcpClient] = set()
+        self._legacy: Dict[str, float] = {}  # host -> when it answered without FLAG_STANDBY
+        self._warming: Set[str] = set()
+        self._wakeup = asyncio.Event()
+        self._task: Optional[asyncio.Task] = None
+
+    def start(self) -> None:
+        """Start keeping connections warm (call once HA is running: devices are known)."""
+        if self._task is None:
+            self._task = asyncio.create_task(self._maintain())
+
+    def refresh(self) -> None:
+        """Run a pass now, e.g. after a pooled link was lost."""
+        self._wakeup.set()
+
+    async def async_stop(self) -> None:
+        """Close the idle links. Leased ones close with their call."""
+        if self._task:
+            self._task.cancel()
+            try:
+                await self._task
+            except asyncio.CancelledError:
+                pass
+            self._task = None
+        clients = list(self._idle.values())
+        self._idle.clear()
+        await asyncio.gather(*(client.disconnect() for client in clients), return_exceptions=True)
+
+    def is_warm(self, host: str) -> bool:
+        """Return True if a parked link to host is ready for the next call."""
+        client = self._idle.get(host)
+        return client is not None and client.is_connected
+
+    async def acquire(self, host: str, **callbacks) -> Optional[IntercomTcpClient]:
+        """Lease a connected client for one call, bound to the callbacks. None = unreachable."""
+        client = self._idle.pop(host, None)
+        if client is not None and not client.is_connected:
+            client = None
+        if client is None:
+            client = IntercomTcpClient(host=host, port=INTERCOM_PORT)
+            if not await client.connect():
+                return None
+        else:
+            _LOGGER.debug("Pool: warm link to %s", host)
+        client.bind(**callbacks)
+        self._leased.add(client)
+        return client
+
+    async def release(self, client: Optional[IntercomTcpClient]) -> None:
+        """The call is over: park the client for the next one, or close it."""
+        if client is None:
+            return
+        self._leased.discard(client)
+        client.detach()  # The owner's callbacks never fire again, not even on disconnect
+        if client.is_connected and client.is_standby and client.host not in self._idle:
+            self._park(client)
+            return
+        await client.disconnect()
+
+    def _park(self, client: IntercomTcpClient) -> None:
+        host = client.host
+
+        def on_disconnected() -> None:
+            if self._idle.get(host) is client:
+                del self._idle[host]
+                _LOGGER.debug("Pool: link to %s lost", host)
+                self.refresh()
+
+        client.bind(on_disconnected=on_disconnected)
+        self._idle[host] = client
+
+    async def _maintain(self) -> None:
+        while True:
+            try:
+                hosts = set(await self._hosts())
+                # Devices that went away
+                for host in [h for h in self._idle if h not in hosts]:
+                    await self._idle.pop(host).disconnect()
+                now = time.monotonic()
+                missing = [
+                    host for host in hosts
+                    if host not in self._idle and host not in self._warming
+                    and not any(client.host == host for client in self._leased)
+                    and now - self._legacy.get(host, -POOL_LEGACY_RETRY) >= POOL_LEGACY_RETRY
+                ]
+                if missing:
+                    await asyncio.gather(*(self._warm(host) for host in missing))
+            except asyncio.CancelledError:
+                raise
+            except Exception as err:
+                _LOGGER.debug("Pool pass failed: %s", err)
+
+            self._wakeup.clear()
+            try:
+                await asyncio.wait_for(self._wakeup.wait(), timeout=POOL_REFRESH_INTERVAL)
+            except asyncio.TimeoutError:
+                pass
+
+    async def _warm(self, host: str) -> None:
+        self._warming.add(host)
+        try:
+            client = IntercomTcpClient(host=host, port=INTERCOM_PORT)
+            if not await client.connect(quiet=True):
+                return  # Offline - try again on the next pass
+            if not await client.request_standby():
+                # Older firmware would hold its call slot for us: per-call connections instead
+                _LOGGER.debug("Pool: %s has no standby slot - connecting per call", host)
+                self._legacy[host] = time.monotonic()
+                await client.disconnect()
+                return
+            self._legacy.pop(host, None)
+            if host in self._idle or any(c.host == host for c in self._leased):
+                await client.disconnect()  # A call connected meanwhile
+                return
+            _LOGGER.debug("Pool: warm link to %s parked", host)
+            self._park(client)
+        finally:
+            self._warming.discard(host)
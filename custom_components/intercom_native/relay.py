@@ -0,0 +1,131 @@
+"""Bridge relay engine: one direction of an ESP<->ESP call relayed through HA."""
+
+import asyncio
+import logging
+import time
+from collections import deque
+from typing import Any, Callable, Dict, Optional
+
+from .tcp_client import IntercomTcpClient
+
+_LOGGER = logging.getLogger(__name__)
+
+RELAY_MAX_FRAMES = 8        # Queue depth per direction (~256 ms of PCM) - oldest frame dropped when full
+RELAY_LATENCY_ALPHA = 0.05  # Smoothing of the queueing latency average
+
+
+class FrameRelay:
+    """Frames from one bridge leg to the other, coalesced into one write per wakeup.
+
+    push() runs synchronously in the source client's receive path. The sender task
+    wakes on an Event (no per-frame timers), takes everything queued and hands it
+    to the dest client in one call: already-framed TCP messages are written as-is
+    (raw), otherwise payloads go through the client's codec/transport. While the
+    dest socket is backpressured the deque keeps only the newest frames.
+    """
+
+    def __init__(self, direction: str, max_frames: int = RELAY_MAX_FRAMES):
+        self.direction = direction
+        self._frames: deque = deque(maxlen=max_frames)  # (monotonic enqueue time, frame)
+        self._wakeup = asyncio.Event()
+        self._task: Optional[asyncio.Task] = None
+        self._raw = False
+
+        self._frames_in = 0
+        self._frames_out = 0
+        self._batches = 0
+        self._dropped = 0
+        self._depth_peak = 0
+        self._latency_avg_ms = 0.0
+        self._latency_peak_ms = 0.0
+
+    @property
+    def running(self) -> bool:
+        """Return True once the sender task is started."""
+        return self._task is not None
+
+    def push(self, frame: bytes) -> None:
+        """Queue one frame - never blocks, the oldest frame goes when the queue is full."""
+        frames = self._frames
+        if len(frames) == frames.maxlen:
+            self._dropped += 1
+        frames.append((time.monotonic(), frame))
+        self._frames_in += 1
+        if len(frames) > self._depth_peak:
+            self._depth_peak = len(frames)
+        self._wakeup.set()
+
+    def start(self, client: IntercomTcpClient, raw: bool, on_error: Callable[[], None]) -> None:
+        """Start forwarding to client; raw = frames are complete TCP messages."""
+        if self._task is None:
+            self._raw = raw
+            self._task = asyncio.create_task(self._run(client, raw, on_error))
+
+    async def stop(self) -> None:
+        """Stop the sender task and discard whatever is still queued."""
+        task, self._task = self._task, None
+        if task:
+            task.cancel()
+            try:
+                await asyncio.wait_for(task, timeout=1.0)
+            except (asyncio.CancelledError, asyncio.TimeoutError):
+                pass
+        self._frames.clear()
+
+    async def _run(self, client: IntercomTcpClient, raw: bool, on_error: Callable[[], None]) -> None:
+        _LOGGER.debug("Bridge relay %s started (%s)", self.direction, "raw frames" if raw else "payloads")
+        frames = self._frames
+        try:
+            while True:
+                await self._wakeup.wait()
+                self._wakeup.clear()
+                if not frames:
+                    continue
+
+                batch = list(frames)
+                frames.clear()
+                self._record_latency((time.monotonic() - batch[0][0]) * 1000.0)
+                data = [frame for _, frame in batch]
+
+                if raw:
+                    sent = client.write_frames(data)
+                else:
+                    sent = await client.send_audio_batch(data)
+                if sent:
+                    self._frames_out += len(data)
+                    self._batches += 1
+
+                # Returns at once below the transport's high-water mark; while the
+                # dest is congested, push() keeps only the newest frames meanwhile
+                await client.drain()
+        except asyncio.CancelledError:
+            pass
+        except Exception as err:
+            _LOGGER.error("Bridge relay %s fatal error: %s - stopping bridge", self.direction, err)
+            on_error()
+        finally:
+            _LOGGER.debug("Bridge relay %s stopped (%s)", self.direction, self.stats)
+
+    def _record_latency(self, latency_ms: float) -> None:
+        """Queueing latency of the oldest frame in a batch (enqueue -> write)."""
+        if self._batches == 0:
+            self._latency_avg_ms = latency_ms
+        else:
+            self._latency_avg_ms += RELAY_LATENCY_ALPHA * (latency_ms - self._latency_avg_ms)
+        if latency_ms > self._latency_peak_ms:
+            self._latency_peak_ms = latency_ms
+
+    @property
+    def stats(self) -> Dict[str, Any]:
+        """Counters since the relay was created."""
+        return {
+            "mode": "raw" if self._raw else "payload",
+            "frames_in": self._frames_in,
+            "frames_out": self._frames_out,
+            "batches": self._batches,
+            "dropped": self._dropped,
+            "depth": len(self._frames),
+            "depth_peak": self._depth_peak,
+            "latency_avg_ms": round(self._latency_avg_ms, 2),
+            "latency_peak_ms": round(self._latency_peak_ms, 2),
+        }
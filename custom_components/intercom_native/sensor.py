@@ -1,12 +1,14 @@
 """Sensor platform for Intercom Native integration."""
 import logging
+import time
+from typing import Any
 
 from homeassistant.components.sensor import SensorEntity
 from homeassistant.core import HomeAssistant, callback
 from homeassistant.helpers.entity_platform import AddEntitiesCallback
 from homeassistant.const import EVENT_STATE_CHANGED
 
-from .const import DOMAIN
+from .const import DOMAIN, LATENCY_ATTR_INTERVAL
 
 _LOGGER = logging.getLogger(__name__)
 
@@ -38,6 +40,32 @@ class IntercomActiveDevicesSensor(SensorEntity):
         self._attr_native_value = "Home Assistant"
         self._tracked_entities: set[str] = set()
         self._unsubscribe = None
+        # device_id -> latest in-call latency (IntercomTcpClient.latency), calls in progress only
+        self._call_latency: dict[str, dict] = {}
+        self._latency_written = 0.0
+
+    @property
+    def extra_state_attributes(self) -> dict[str, Any]:
+        """In-call latency per device (rtt_ms, esp_to_ha_ms, ha_to_esp_ms)."""
+        return {"call_latency": dict(self._call_latency)}
+
+    @callback
+    def set_call_latency(self, device_id: str, stats: dict | None) -> None:
+        """Record one device's latest estimate (None = its call ended).
+
+        New estimates arrive every few seconds per call; state is written at most every
+        LATENCY_ATTR_INTERVAL for them, at once when a call ends.
+        """
+        if stats is None:
+            if self._call_latency.pop(device_id, None) is None:
+                return
+        else:
+            self._call_latency[device_id] = stats
+            if time.monotonic() - self._latency_written < LATENCY_ATTR_INTERVAL:
+                return
+        self._latency_written = time.monotonic()
+        if self.hass and self.entity_id:
+            self.async_write_ha_state()
 
     async def async_added_to_hass(self) -> None:
         """Run when entity is added to hass."""
@@ -5,7 +5,9 @@ DRAIN_INTERVAL = 10  # Drain every N packets instead of every packet
 
 import asyncio
 import logging
+import socket
 import struct
+import time
 from typing import Callable, Optional
 
 from .const import (
@@ -19,14 +21,61 @@ from .const import (
     MSG_ERROR,
     MSG_RING,
     MSG_ANSWER,
+    MSG_DIAL,
+    MSG_PROBE,
+    MSG_PROBE_ECHO,
+    ERROR_UNREACHABLE,
     FLAG_NONE,
     FLAG_NO_RING,
+    FLAG_CODEC,
+    FLAG_DATAGRAM,
+    FLAG_DTX,
+    FLAG_LATENCY,
+    FLAG_STANDBY,
+    COMFORT_NOISE_FRAME_SIZE,
+    LATENCY_PROBE_SIZE,
+    PROBE_MAX_RTT_US,
+    DATAGRAM_HEADER_SIZE,
+    MAX_DATAGRAM_PAYLOAD,
+    CODEC_PCM,
+    CODEC_OPUS,
+    CODEC_MASK_PCM,
+    CODEC_MASK_OPUS,
+    CODEC_NAMES,
+    SAMPLE_RATE,
+    PCM_FRAME_MS,
+    OPUS_FRAME_MS,
     CONNECT_TIMEOUT,
+    CALL_REPLY_TIMEOUT,
+    DIAL_TIMEOUT,
+    STANDBY_TIMEOUT,
     PING_INTERVAL,
+    PROBE_INTERVAL,
 )
+from .codec import OPUS_AVAILABLE, ComfortNoise, OpusTranscoder
 
 _LOGGER = logging.getLogger(__name__)
 
+# Streaming over UDP (or a parked standby link) leaves TCP quiet: keepalive PING/PONG every
+# PING_INTERVAL instead
+KEEPALIVE_READ_TIMEOUT = PING_INTERVAL * 3
+
+# Reply future result when the connection drops while a reply is awaited
+_REPLY_LOST = "lost"
+
+
+class _AudioDatagramProtocol(asyncio.DatagramProtocol):
+    """UDP endpoint for datagram AUDIO - hands packets to the owning client."""
+
+    def __init__(self, client: "IntercomTcpClient"):
+        self._client = client
+
+    def datagram_received(self, data: bytes, addr) -> None:
+        self._client._on_datagram(data, addr)
+
+    def error_received(self, exc: Exception) -> None:
+        _LOGGER.debug("[TCP#%d] Datagram error: %s", self._client._instance_id, exc)
+
 
 class IntercomTcpClient:
     """Async TCP client for ESP intercom communication."""
@@ -43,18 +92,15 @@ class IntercomTcpClient:
         on_answered: Optional[Callable[[], None]] = None,
         on_stop_received: Optional[Callable[[], None]] = None,
         on_error_received: Optional[Callable[[int], None]] = None,
+        on_latency: Optional[Callable[[Optional[dict]], None]] = None,
     ):
         IntercomTcpClient._instance_counter += 1
         self._instance_id = IntercomTcpClient._instance_counter
 
         self.host = host
         self.port = port
-        self._on_audio = on_audio
-        self._on_disconnected = on_disconnected
-        self._on_ringing = on_ringing
-        self._on_answered = on_answered
-        self._on_stop_received = on_stop_received
-        self._on_error_received = on_error_received
+        self.bind(on_audio, on_disconnected, on_ringing, on_answered,
+                  on_stop_received, on_error_received, on_latency)
 
         self._reader: Optional[asyncio.StreamReader] = None
         self._writer: Optional[asyncio.StreamWriter] = None
@@ -67,6 +113,36 @@ class IntercomTcpClient:
         # Flags to distinguish ACK PONG from keepalive PONG
         self._awaiting_start_ack = False   # Waiting for PONG/RING after START
         self._awaiting_answer_ack = False  # Waiting for PONG after ANSWER
+        self._awaiting_dial_ack = False    # Waiting for PONG/ERROR after DIAL
+        self._awaiting_standby_ack = False  # Waiting for PONG after PING with FLAG_STANDBY
+        # Reply to the START/ANSWER/DIAL/standby PING in flight, resolved by _handle_message
+        self._reply: Optional[asyncio.Future] = None
+        self._call_active = False  # START/DIAL/ANSWER sent, call not ended yet
+        self._standby = False      # ESP parks this link between calls (echoed FLAG_STANDBY)
+
+        # Codec of the current call (set from the ESP's PONG/RING/ANSWER reply)
+        self._codec = CODEC_PCM
+        self._frame_ms = PCM_FRAME_MS
+        self._transcoder: Optional[OpusTranscoder] = None
+        self._pcm_audio = True  # on_audio/send_audio use PCM; False = raw codec frames (bridge passthrough)
+        self._frame_sink: Optional[Callable[[bytes], None]] = None  # Framed TCP AUDIO, bypasses on_audio
+        self._dtx = False  # ESP echoed FLAG_DTX: it plays comfort noise for silence descriptors
+        self._comfort_noise = ComfortNoise()
+        # Framing to ask for instead of our defaults (codec, frame ms), see match_framing()
+        self._match_framing: Optional[tuple] = None
+
+        # In-call latency (ESP echoed FLAG_LATENCY): smoothed RTT of our probes, last estimate
+        self._latency = False
+        self._srtt_us = 0
+        self._latency_stats: Optional[dict] = None
+
+        # Datagram audio (set from the ESP's reply when it accepts our UDP offer)
+        self._udp_transport: Optional[asyncio.DatagramTransport] = None
+        self._udp_port = 0
+        self._udp_peer: Optional[tuple] = None
+        self._udp_tx_seq = 0
+        self._udp_tx_ts = 0
+        self._udp_rx_seq: Optional[int] = None
 
         self._audio_sent = 0
         self._audio_recv = 0
@@ -74,9 +150,37 @@ class IntercomTcpClient:
 
         _LOGGER.debug("[TCP#%d] Created for %s:%d", self._instance_id, host, port)
 
-    async def connect(self) -> bool:
+    def bind(
+        self,
+        on_audio: Optional[Callable[[bytes], None]] = None,
+        on_disconnected: Optional[Callable[[], None]] = None,
+        on_ringing: Optional[Callable[[], None]] = None,
+        on_answered: Optional[Callable[[], None]] = None,
+        on_stop_received: Optional[Callable[[], None]] = None,
+        on_error_received: Optional[Callable[[int], None]] = None,
+        on_latency: Optional[Callable[[Optional[dict]], None]] = None,
+    ) -> None:
+        """Route this connection's events to an owner - pooled connections change hands per call."""
+        self._on_audio = on_audio
+        self._on_disconnected = on_disconnected
+        self._on_ringing = on_ringing
+        self._on_answered = on_answered
+        self._on_stop_received = on_stop_received
+        self._on_error_received = on_error_received
+        self._on_latency = on_latency
+
+    def detach(self) -> None:
+        """Drop the owner's callbacks and relay options before the connection is reused."""
+        self.bind()
+        self._pcm_audio = True
+        self._frame_sink = None
+        self._match_framing = None
+
+    async def connect(self, quiet: bool = False) -> bool:
+        """Open the connection. quiet: failures log at debug (connection pool retries)."""
         if self._connected:
             return True
+        log_error = _LOGGER.debug if quiet else _LOGGER.error
 
         try:
             _LOGGER.debug("[TCP#%d] Connecting to %s:%d...", self._instance_id, self.host, self.port)
@@ -88,16 +192,18 @@ class IntercomTcpClient:
             self._disconnect_notified = False
             _LOGGER.debug("[TCP#%d] Connected", self._instance_id)
 
+            await self._open_datagram_endpoint()
+
             self._receive_task = asyncio.create_task(self._receive_loop())
             self._ping_task = asyncio.create_task(self._ping_loop())
 
             return True
 
         except asyncio.TimeoutError:
-            _LOGGER.error("[TCP#%d] Connection timeout", self._instance_id)
+            log_error("[TCP#%d] Connection timeout", self._instance_id)
             return False
         except OSError as err:
-            _LOGGER.error("[TCP#%d] Connection error: %s", self._instance_id, err)
+            log_error("[TCP#%d] Connection error: %s", self._instance_id, err)
             return False
 
     async def disconnect(self) -> None:
@@ -106,6 +212,8 @@ class IntercomTcpClient:
         self._connected = False
         self._streaming = False
         self._ringing = False
+        self._call_active = False
+        self._resolve_reply(_REPLY_LOST)
 
         if self._receive_task:
             self._receive_task.cancel()
@@ -123,6 +231,12 @@ class IntercomTcpClient:
                 pass
             self._ping_task = None
 
+        if self._udp_transport:
+            self._udp_transport.close()
+            self._udp_transport = None
+            self._udp_port = 0
+        self._udp_peer = None
+
         if self._writer:
             try:
                 self._writer.close()
@@ -163,34 +277,27 @@ class IntercomTcpClient:
         self._ringing = False
         self._awaiting_start_ack = True
         self._awaiting_answer_ack = False
+        self._call_active = True
+        self._reset_codec()
 
-        # Send START with caller_name as payload (for full mode)
+        # Send START with caller_name as payload (for full mode), plus our codec/transport offers
         payload = caller_name.encode("utf-8") if caller_name else b""
+        payload, flags = self._with_call_offers(payload, flags)
+        self._expect_reply()
         if not await self._send_message(MSG_START, data=payload, flags=flags):
             self._awaiting_start_ack = False
+            self._call_active = False
             return "error"
 
-        # Wait briefly for ESP response (PONG=accept, RING=waiting)
-        # The actual state is set in _handle_message
-        for _ in range(50):  # 500ms max wait
-            await asyncio.sleep(0.01)
-            # Check if connection was closed
-            if not self._connected:
-                _LOGGER.error("[TCP#%d] Connection lost while waiting for response", self._instance_id)
-                self._awaiting_start_ack = False
-                return "error"
-            if self._streaming:
-                _LOGGER.debug("[TCP#%d] Stream started", self._instance_id)
-                return "streaming"
-            if self._ringing:
-                _LOGGER.debug("[TCP#%d] ESP ringing", self._instance_id)
-                return "ringing"
-
-        # Timeout - check if still connected before assuming streaming
-        if not self._connected:
-            _LOGGER.error("[TCP#%d] Connection lost, cannot start stream", self._instance_id)
+        # ESP response (PONG=accept, RING=waiting, ERROR=busy) resolves the reply in _handle_message
+        result = await self._wait_reply(CALL_REPLY_TIMEOUT)
+        if result == _REPLY_LOST or (result is None and not self._connected):
+            _LOGGER.error("[TCP#%d] Connection lost while waiting for response", self._instance_id)
             self._awaiting_start_ack = False
             return "error"
+        if result is not None:
+            _LOGGER.debug("[TCP#%d] START reply: %s", self._instance_id, result)
+            return result
 
         # Still connected but no response - assume old ESP that doesn't send response
         self._awaiting_start_ack = False
@@ -198,6 +305,76 @@ class IntercomTcpClient:
         _LOGGER.warning("[TCP#%d] No response, assuming stream started", self._instance_id)
         return "streaming"
 
+    async def dial(self, peer_ip: str, peer_port: int, callee_name: str = "") -> str:
+        """Ask the ESP to call a peer ESP directly - HA stays on as signalling only.
+
+        After "dialing" this connection reports the call: RING (callee ringing),
+        ANSWER (connected), STOP (ended). stop_stream() hangs the call up.
+
+        Returns:
+            "dialing" - ESP reached the peer and sent it START
+            "unreachable" - ESP could not reach the peer, relay the call instead
+            "unsupported" - No answer (firmware without DIAL) or connection lost
+            "error" - ESP refused (e.g. busy)
+        """
+        _LOGGER.debug("[TCP#%d] dial(%s:%d, callee=%s)", self._instance_id, peer_ip, peer_port,
+                      callee_name or "(none)")
+
+        if not self._connected:
+            if not await self.connect():
+                return "unsupported"
+
+        try:
+            address = socket.inet_aton(peer_ip)
+        except OSError:
+            return "unreachable"
+        payload = address + struct.pack("<H", peer_port) + callee_name.encode("utf-8")
+
+        self._reset_codec()
+        self._awaiting_dial_ack = True
+        self._call_active = True
+        self._expect_reply()
+        if not await self._send_message(MSG_DIAL, data=payload):
+            self._awaiting_dial_ack = False
+            self._call_active = False
+            return "unsupported"
+
+        result = await self._wait_reply(DIAL_TIMEOUT)
+        self._awaiting_dial_ack = False
+        if result is None or result == _REPLY_LOST:
+            self._call_active = False
+            return "unsupported"
+        if result != "dialing":
+            self._call_active = False  # Refused: the caller relays or gives up, no call on this link
+        return result
+
+    async def request_standby(self) -> bool:
+        """Ask the ESP to keep this connection between calls (PING with FLAG_STANDBY).
+
+        Firmware with a standby slot echoes the flag on its PONG and parks the link outside
+        its call slot, so peers can still call the device. Older firmware answers a plain
+        PONG: False, and the connection pool doesn't keep the link.
+        """
+        self._awaiting_standby_ack = True
+        self._expect_reply()
+        if not await self._send_message(MSG_PING, flags=FLAG_STANDBY):
+            self._awaiting_standby_ack = False
+            return False
+        result = await self._wait_reply(STANDBY_TIMEOUT)
+        self._awaiting_standby_ack = False
+        self._standby = result is True
+        return self._standby
+
+    @property
+    def is_connected(self) -> bool:
+        """Return True while the TCP connection is up."""
+        return self._connected
+
+    @property
+    def is_standby(self) -> bool:
+        """Return True if the ESP parks this connection between calls."""
+        return self._standby
+
     @property
     def is_ringing(self) -> bool:
         """Return True if ESP is ringing (auto_answer OFF)."""
@@ -208,11 +385,135 @@ class IntercomTcpClient:
         """Return True if actively streaming."""
         return self._streaming
 
+    @property
+    def codec(self) -> int:
+        """Return the negotiated codec (CODEC_PCM until the ESP accepts an offer)."""
+        return self._codec
+
+    @property
+    def frame_ms(self) -> int:
+        """Return the frame duration of AUDIO payloads on this connection."""
+        return self._frame_ms
+
+    def match_framing(self, codec: int, frame_ms: int) -> None:
+        """Offer another call leg's codec and frame duration on the next START/ANSWER.
+
+        Bridges ask the dest ESP for the framing the source leg negotiated, so both
+        legs carry the same frames and the relay forwards them without rechunking.
+        """
+        self._match_framing = (codec, frame_ms)
+
+    def set_pcm_audio(self, pcm: bool) -> None:
+        """Choose PCM (transcode Opus) or raw codec frames for on_audio/send_audio.
+
+        Bridges whose two legs negotiated the same codec relay raw frames instead.
+        """
+        self._pcm_audio = pcm
+
+    def set_frame_sink(self, sink: Optional[Callable[[bytes], None]]) -> None:
+        """Hand TCP AUDIO messages to sink exactly as read (header + payload).
+
+        For bridge relays between two TCP legs with the same codec: the receiving
+        leg forwards the bytes to write_frames() on the other one without parsing or
+        re-packing. None = decode and deliver through on_audio.
+        """
+        self._frame_sink = sink
+
+    @property
+    def dtx(self) -> bool:
+        """Return True if the ESP understands DTX silence descriptors on this call."""
+        return self._dtx
+
+    @property
+    def latency(self) -> Optional[dict]:
+        """Return the latest in-call latency estimate, None until a probe came back.
+
+        rtt_ms: smoothed round trip HA <-> ESP. esp_to_ha_ms: ESP mic to HA, ha_to_esp_ms:
+        HA to the ESP speaker (half the RTT plus what the ESP reports buffered). HA adds
+        no buffering of its own; a browser's playout is not included.
+        """
+        return self._latency_stats
+
+    @property
+    def is_datagram(self) -> bool:
+        """Return True if AUDIO goes over UDP on this connection."""
+        return self._udp_peer is not None
+
+    def _with_call_offers(self, payload: bytes, flags: int) -> tuple:
+        """Append codec/transport offers to a START/ANSWER payload.
+
+        Layout: caller name, NUL, codec mask, frame ms, [UDP port LE].
+        Older firmware reads the name up to the NUL and never sees the offers.
+        With Opus in the mask frame ms is the Opus frame we prefer; a PCM-only offer
+        carries a PCM frame (0 = the ESP's own), the ESP answers the longer of it and its own.
+        FLAG_DTX adds no bytes: we always turn silence descriptors into comfort noise.
+        FLAG_LATENCY neither: we always answer latency probes.
+        """
+        flags |= FLAG_DTX | FLAG_LATENCY | FLAG_CODEC
+        if self._match_framing is not None:
+            codec, frame_ms = self._match_framing
+            mask = CODEC_MASK_PCM | CODEC_MASK_OPUS if codec == CODEC_OPUS and OPUS_AVAILABLE else CODEC_MASK_PCM
+        elif OPUS_AVAILABLE:
+            mask, frame_ms = CODEC_MASK_PCM | CODEC_MASK_OPUS, OPUS_FRAME_MS
+        else:
+            mask, frame_ms = CODEC_MASK_PCM, 0
+        offers = struct.pack("<BB", mask, frame_ms)
+        if self._udp_port:
+            offers += struct.pack("<H", self._udp_port)
+            flags |= FLAG_DATAGRAM
+        return payload + b"\x00" + offers, flags
+
+    def _reset_codec(self) -> None:
+        """Back to PCM over TCP until the ESP answers a new offer."""
+        self._codec = CODEC_PCM
+        self._frame_ms = PCM_FRAME_MS
+        self._transcoder = None
+        self._udp_peer = None
+        self._dtx = False
+        self._latency = False
+        self._srtt_us = 0
+        self._clear_latency()
+
+    def _apply_call_params(self, flags: int, payload: bytes) -> None:
+        """Adopt the codec/transport the ESP picked (reply to our offers)."""
+        if flags & FLAG_DTX:
+            self._dtx = True
+        if flags & FLAG_LATENCY:
+            self._latency = True
+        if flags & FLAG_CODEC and len(payload) >= 2:
+            self._apply_codec(payload[:2])
+            payload = payload[2:]
+        if flags & FLAG_DATAGRAM and len(payload) >= 2 and self._udp_transport:
+            (port,) = struct.unpack("<H", payload[:2])
+            peer_ip = self._writer.get_extra_info("peername")[0] if self._writer else self.host
+            self._udp_peer = (peer_ip, port)
+            self._udp_tx_seq = 0
+            self._udp_tx_ts = 0
+            self._udp_rx_seq = None
+            _LOGGER.debug("[TCP#%d] Audio over UDP -> %s:%d", self._instance_id, peer_ip, port)
+
+    def _apply_codec(self, params: bytes) -> None:
+        codec, frame_ms = struct.unpack("<BB", params)
+        if codec == CODEC_OPUS and OPUS_AVAILABLE:
+            if self._transcoder is None or self._transcoder.frame_ms != frame_ms:
+                self._transcoder = OpusTranscoder(frame_ms)
+        else:
+            codec = CODEC_PCM
+            self._transcoder = None
+            frame_ms = frame_ms or PCM_FRAME_MS
+        self._codec = codec
+        self._frame_ms = frame_ms
+        _LOGGER.debug("[TCP#%d] Codec: %s, %d ms frames",
+                      self._instance_id, CODEC_NAMES.get(codec, "?"), frame_ms)
+
     async def stop_stream(self) -> None:
         _LOGGER.debug("[TCP#%d] stop_stream()", self._instance_id)
 
         # First stop accepting new audio
         self._streaming = False
+        self._ringing = False
+        self._call_active = False
+        self._clear_latency()
 
         # Try to send STOP but don't block forever
         if self._connected and self._writer:
@@ -252,6 +553,62 @@ class IntercomTcpClient:
             _LOGGER.error("[TCP#%d] ANSWER error: %s", self._instance_id, err)
             return False
 
+    async def answer_call(self) -> str:
+        """Send ANSWER (with codec offer) to an ESP that is calling us (OUTGOING state).
+
+        Returns:
+            "streaming" - ESP confirmed with PONG (on_answered fired), or sent no reply (older firmware)
+            "error" - Send failed, ESP refused or connection lost
+        """
+        _LOGGER.debug("[TCP#%d] answer_call()", self._instance_id)
+
+        if not self._connected:
+            return "error"
+
+        self._reset_codec()
+        self._call_active = True
+        payload, flags = self._with_call_offers(b"", FLAG_NONE)
+        # Mark that we're awaiting PONG as answer confirmation
+        self._awaiting_answer_ack = True
+        self._expect_reply()
+        if not await self._send_message(MSG_ANSWER, data=payload, flags=flags):
+            self._awaiting_answer_ack = False
+            self._call_active = False
+            return "error"
+
+        result = await self._wait_reply(CALL_REPLY_TIMEOUT)
+        if result is None and self._connected:
+            # Older firmware may not PONG an ANSWER - start streaming anyway
+            _LOGGER.warning("[TCP#%d] No PONG for ANSWER, assuming stream started", self._instance_id)
+            self._awaiting_answer_ack = False
+            self._streaming = True
+            return "streaming"
+        self._awaiting_answer_ack = False
+        return "streaming" if result == "streaming" else "error"
+
+    def _expect_reply(self) -> asyncio.Future:
+        """Arm the reply future before sending - a fast reply can't arrive unseen."""
+        self._resolve_reply(None)
+        self._reply = asyncio.get_running_loop().create_future()
+        return self._reply
+
+    def _resolve_reply(self, result) -> None:
+        if self._reply is not None and not self._reply.done():
+            self._reply.set_result(result)
+
+    async def _wait_reply(self, timeout: float):
+        """Result of the armed reply, None when nothing came within timeout."""
+        reply = self._reply
+        if reply is None:
+            return None
+        try:
+            return await asyncio.wait_for(reply, timeout=timeout)
+        except asyncio.TimeoutError:
+            return None
+        finally:
+            if self._reply is reply:
+                self._reply = None
+
     async def send_audio(self, data: bytes) -> bool:
         """Send audio data - drain periodically to avoid blocking."""
         if not self._connected or not self._streaming or not self._writer:
@@ -260,8 +617,8 @@ class IntercomTcpClient:
         self._audio_sent += 1
 
         try:
-            header = struct.pack("<BBH", MSG_AUDIO, FLAG_NONE, len(data))
-            self._writer.write(header + data)
+            if not self._write_audio(data):
+                return True  # UDP - nothing to drain
 
             # Drain periodically to avoid blocking on every packet
             if self._audio_sent % DRAIN_INTERVAL == 0:
@@ -274,6 +631,111 @@ class IntercomTcpClient:
             _LOGGER.error("[TCP#%d] Audio send error: %s", self._instance_id, err)
             return False
 
+    async def send_audio_batch(self, payloads: list) -> bool:
+        """Send several audio payloads back to back - the caller drains once after."""
+        if not self._connected or not self._streaming or not self._writer:
+            return False
+
+        self._audio_sent += len(payloads)
+        try:
+            for data in payloads:
+                self._write_audio(data)
+            return True
+        except Exception as err:
+            _LOGGER.error("[TCP#%d] Audio send error: %s", self._instance_id, err)
+            return False
+
+    def write_frames(self, frames: list) -> bool:
+        """Write already-framed AUDIO messages (from a frame sink) in one transport write."""
+        if not self._connected or not self._streaming or not self._writer:
+            return False
+
+        self._audio_sent += len(frames)
+        self._writer.writelines(frames)
+        return True
+
+    async def drain(self) -> None:
+        """Wait for the socket only when its buffer is over the transport high-water mark."""
+        if self._writer and self._connected:
+            await self._writer.drain()
+
+    def _write_audio(self, data: bytes) -> bool:
+        """Encode/split one payload and hand it to the transport. False = sent over UDP."""
+        if self._transcoder and self._pcm_audio:
+            packets = self._transcoder.encode(data)
+        elif self._codec == CODEC_PCM:
+            # One AUDIO frame per negotiated PCM frame - the block every ESP stage works in
+            # (and at most one ESP jitter buffer slot per datagram)
+            step = min(self._frame_ms * SAMPLE_RATE // 1000 * 2, MAX_DATAGRAM_PAYLOAD)
+            packets = [data[i:i + step] for i in range(0, len(data), step)] if len(data) > step else [data]
+        else:
+            packets = [data]
+
+        if self._udp_peer:
+            self._send_datagrams(packets)
+            return False
+
+        for packet in packets:
+            header = struct.pack("<BBH", MSG_AUDIO, FLAG_NONE, len(packet))
+            self._writer.write(header + packet)
+        return True
+
+    def _send_datagrams(self, packets: list) -> None:
+        """Send AUDIO frames over UDP - seq +1 per frame, timestamp in 16 kHz samples."""
+        for packet in packets:
+            samples = self._frame_ms * 16 if self._codec != CODEC_PCM else len(packet) // 2
+            header = struct.pack("<BBHI", MSG_AUDIO, FLAG_NONE, self._udp_tx_seq, self._udp_tx_ts)
+            self._udp_transport.sendto(header + packet, self._udp_peer)
+            self._udp_tx_seq = (self._udp_tx_seq + 1) & 0xFFFF
+            self._udp_tx_ts = (self._udp_tx_ts + samples) & 0xFFFFFFFF
+
+    async def _open_datagram_endpoint(self) -> None:
+        """Bind an ephemeral UDP port for datagram audio (offered on START/ANSWER)."""
+        try:
+            loop = asyncio.get_running_loop()
+            self._udp_transport, _ = await loop.create_datagram_endpoint(
+                lambda: _AudioDatagramProtocol(self), local_addr=("0.0.0.0", 0)
+            )
+            self._udp_port = self._udp_transport.get_extra_info("sockname")[1]
+        except OSError as err:
+            _LOGGER.debug("[TCP#%d] No datagram endpoint (%s) - audio stays on TCP", self._instance_id, err)
+            self._udp_transport = None
+            self._udp_port = 0
+
+    def _on_datagram(self, data: bytes, addr) -> None:
+        """Handle one AUDIO datagram from the ESP."""
+        if not self._udp_peer or addr[0] != self._udp_peer[0] or len(data) <= DATAGRAM_HEADER_SIZE:
+            return
+        msg_type, flags, seq, _ts = struct.unpack("<BBHI", data[:DATAGRAM_HEADER_SIZE])
+        if msg_type != MSG_AUDIO:
+            return
+        # Drop duplicates and late arrivals; the receiving ESP's jitter buffer handles the rest
+        if self._udp_rx_seq is not None:
+            delta = (seq - self._udp_rx_seq) & 0xFFFF
+            if delta == 0 or delta >= 0x8000:
+                return
+        self._udp_rx_seq = seq
+        self._deliver_audio(data[DATAGRAM_HEADER_SIZE:], flags)
+
+    def _deliver_audio(self, payload: bytes, flags: int = FLAG_NONE) -> None:
+        """Pass received audio to on_audio (decoded to PCM unless relaying raw frames)."""
+        self._audio_recv += 1
+        if flags & FLAG_DTX:
+            # Silence descriptor: comfort noise for PCM consumers. A raw Opus relay has no
+            # frame to forward - the receiving ESP conceals the gap.
+            if self._codec != CODEC_PCM and not self._pcm_audio:
+                return
+            if len(payload) < COMFORT_NOISE_FRAME_SIZE:
+                return
+            level, samples = struct.unpack("<BH", payload[:COMFORT_NOISE_FRAME_SIZE])
+            payload = self._comfort_noise.generate(level, samples)
+        elif self._transcoder and self._pcm_audio:
+            payload = self._transcoder.decode(payload)
+            if not payload:
+                return
+        if self._on_audio:
+            self._on_audio(payload)
+
     async def _send_message(self, msg_type: int, data: bytes = b"", flags: int = FLAG_NONE) -> bool:
         """Send control message with drain (blocking)."""
         if not self._writer:
@@ -294,7 +756,11 @@ class IntercomTcpClient:
             while self._connected and self._reader:
                 # Timeout detects dead connections (ESP crash without TCP FIN)
                 # Idle: ping every 30s, so 60s is safe. Streaming: audio every 16ms, 5s is generous.
-                read_timeout = 5.0 if self._streaming else 60.0
+                # UDP audio: TCP only carries keepalives, allow a few missed PONGs.
+                if self._streaming:
+                    read_timeout = KEEPALIVE_READ_TIMEOUT if self._udp_peer else 5.0
+                else:
+                    read_timeout = KEEPALIVE_READ_TIMEOUT if self._standby else 60.0
                 header_data = await asyncio.wait_for(
                     self._reader.readexactly(HEADER_SIZE), timeout=read_timeout
                 )
@@ -311,6 +777,12 @@ class IntercomTcpClient:
                         self._reader.readexactly(length), timeout=read_timeout
                     )
 
+                if msg_type == MSG_AUDIO and self._frame_sink:
+                    # Bridge relay: forward the message untouched
+                    self._audio_recv += 1
+                    self._frame_sink(header_data + payload)
+                    continue
+
                 await self._handle_message(msg_type, flags, payload)
 
         except asyncio.TimeoutError:
@@ -328,17 +800,36 @@ class IntercomTcpClient:
             # Mark as disconnected so other parts know the connection is dead
             self._connected = False
             self._streaming = False
+            self._call_active = False
+            self._resolve_reply(_REPLY_LOST)
+            self._clear_latency()
             if not self._disconnect_notified and self._on_disconnected:
                 self._disconnect_notified = True
                 self._on_disconnected()
 
     async def _handle_message(self, msg_type: int, flags: int, payload: bytes) -> None:
         if msg_type == MSG_AUDIO:
-            self._audio_recv += 1
-            if self._on_audio:
-                self._on_audio(payload)
+            self._deliver_audio(payload, flags)
+
+        elif msg_type == MSG_PONG and self._awaiting_standby_ack:
+            self._awaiting_standby_ack = False
+            self._resolve_reply(bool(flags & FLAG_STANDBY))
+
+        elif msg_type == MSG_PONG and self._awaiting_dial_ack:
+            _LOGGER.debug("[TCP#%d] PONG - direct call placed", self._instance_id)
+            self._awaiting_dial_ack = False
+            self._resolve_reply("dialing")
+
+        elif msg_type == MSG_ERROR and self._awaiting_dial_ack:
+            # DIAL refused: the caller decides whether to relay, the call isn't over
+            error_code = payload[0] if payload else 0
+            _LOGGER.debug("[TCP#%d] DIAL refused: code=%d", self._instance_id, error_code)
+            self._awaiting_dial_ack = False
+            self._resolve_reply("unreachable" if error_code == ERROR_UNREACHABLE else "error")
 
         elif msg_type == MSG_PONG:
+            # Call replies to our START/ANSWER carry the negotiated codec
+            self._apply_call_params(flags, payload)
             # PONG can be:
             # 1. ACK for START (auto_answer ON) - we set _awaiting_start_ack
             # 2. ACK for ANSWER - we set _awaiting_answer_ack
@@ -349,21 +840,25 @@ class IntercomTcpClient:
                 self._awaiting_start_ack = False
                 self._ringing = False
                 self._streaming = True
+                self._resolve_reply("streaming")
                 if self._on_answered:
                     self._on_answered()
             elif self._awaiting_start_ack:
                 _LOGGER.debug("[TCP#%d] PONG - stream accepted (auto_answer ON)", self._instance_id)
                 self._awaiting_start_ack = False
                 self._streaming = True
+                self._resolve_reply("streaming")
             else:
                 # Keepalive PONG - do NOT change state
                 _LOGGER.debug("[TCP#%d] PONG - keepalive (ignored)", self._instance_id)
 
         elif msg_type == MSG_RING:
             _LOGGER.debug("[TCP#%d] RING received", self._instance_id)
+            self._apply_call_params(flags, payload)
             # RING means ESP has auto_answer OFF - not a PONG for START
             self._awaiting_start_ack = False
             self._ringing = True
+            self._resolve_reply("ringing")
             if self._on_ringing:
                 self._on_ringing()
 
@@ -378,8 +873,14 @@ class IntercomTcpClient:
                 self._on_answered()
 
         elif msg_type == MSG_STOP:
+            if not self._call_active:
+                # Pooled link: nothing to hang up (e.g. the ESP confirming a call we ended)
+                _LOGGER.debug("[TCP#%d] STOP outside a call (ignored)", self._instance_id)
+                return
             _LOGGER.debug("[TCP#%d] STOP received from ESP", self._instance_id)
+            self._call_active = False
             self._streaming = False
+            self._clear_latency()
             self._ringing = False
             if self._on_stop_received:
                 self._on_stop_received()
@@ -388,22 +889,79 @@ class IntercomTcpClient:
             _LOGGER.debug("[TCP#%d] PING -> PONG", self._instance_id)
             await self._send_message(MSG_PONG)
 
+        elif msg_type == MSG_PROBE:
+            if len(payload) >= LATENCY_PROBE_SIZE:
+                (origin_us,) = struct.unpack("<I", payload[:4])
+                await self._send_probe(MSG_PROBE_ECHO, origin_us)
+
+        elif msg_type == MSG_PROBE_ECHO:
+            self._on_probe_echo(payload)
+
         elif msg_type == MSG_ERROR:
             error_code = payload[0] if payload else 0
             _LOGGER.error("[TCP#%d] ERROR from ESP: code=%d", self._instance_id, error_code)
             self._streaming = False
             self._ringing = False
+            self._awaiting_start_ack = False
+            self._awaiting_answer_ack = False
+            self._call_active = False
+            self._resolve_reply("error")
             if self._on_error_received:
                 self._on_error_received(error_code)
 
+    @staticmethod
+    def _clock_us() -> int:
+        return (time.monotonic_ns() // 1000) & 0xFFFFFFFF
+
+    async def _send_probe(self, msg_type: int, origin_us: int) -> None:
+        """Send a latency probe or echo. HA relays at once: no capture or playout delay of its own."""
+        await self._send_message(msg_type, data=struct.pack("<IHH", origin_us, 0, 0))
+
+    def _on_probe_echo(self, payload: bytes) -> None:
+        """RTT from the echoed timestamp (SRTT-style smoothing), ESP delays from its report."""
+        if len(payload) < LATENCY_PROBE_SIZE:
+            return
+        origin_us, esp_capture_ms, esp_playout_ms = struct.unpack("<IHH", payload[:LATENCY_PROBE_SIZE])
+        rtt_us = (self._clock_us() - origin_us) & 0xFFFFFFFF
+        if rtt_us > PROBE_MAX_RTT_US:
+            return
+        if self._srtt_us:
+            self._srtt_us += (rtt_us - self._srtt_us) // 8
+        else:
+            self._srtt_us = rtt_us
+        one_way_ms = self._srtt_us / 2000
+        self._latency_stats = {
+            "rtt_ms": round(self._srtt_us / 1000, 1),
+            "esp_to_ha_ms": round(esp_capture_ms + one_way_ms),
+            "ha_to_esp_ms": round(one_way_ms + esp_playout_ms),
+        }
+        if self._on_latency:
+            self._on_latency(self._latency_stats)
+
+    def _clear_latency(self) -> None:
+        """Call over (or a new one starting): drop the estimate and tell the owner once."""
+        if self._latency_stats is None:
+            return
+        self._latency_stats = None
+        if self._on_latency:
+            self._on_latency(None)
+
     async def _ping_loop(self) -> None:
         try:
+            last_ping = time.monotonic()
             while self._connected:
-                await asyncio.sleep(PING_INTERVAL)
+                await asyncio.sleep(PROBE_INTERVAL)
+                # In-call latency probe: ESPs that echoed FLAG_LATENCY answer it while PINGs are off
+                if self._connected and self._streaming and self._latency:
+                    await self._send_probe(MSG_PROBE, self._clock_us())
+                if time.monotonic() - last_ping < PING_INTERVAL - PROBE_INTERVAL / 2:
+                    continue
+                last_ping = time.monotonic()
                 # Don't ping during streaming or ringing:
                 # - Streaming: TCP already detects dead connections, ping interferes with audio
+                #   (UDP audio is the exception - TCP is idle, so keepalive it like an idle link)
                 # - Ringing: PONG response would be confused with answer ACK
-                if self._connected and not self._streaming and not self._ringing:
+                if self._connected and (not self._streaming or self._udp_peer) and not self._ringing:
                     await self._send_message(MSG_PING)
         except asyncio.CancelledError:
             pass
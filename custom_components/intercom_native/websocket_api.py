@@ -3,21 +3,33 @@
 import asyncio
 import base64
 import logging
+import socket
+import struct
 from typing import Any, Dict, Optional
 
 # Audio queue config
 AUDIO_QUEUE_SIZE = 8  # Max pending audio chunks - drop old if full
 
 import voluptuous as vol
+from aiohttp import WSMsgType, web
 
 from homeassistant.components import websocket_api
+from homeassistant.components.http import HomeAssistantView
 from homeassistant.core import HomeAssistant, callback
 
 from .const import (
     DOMAIN,
     INTERCOM_PORT,
     FLAG_NO_RING,
+    CODEC_PCM,
+    CODEC_NAMES,
+    AUDIO_CHANNEL_URL,
+    AUDIO_FRAME_HEADER_SIZE,
+    AUDIO_FRAME_KIND_AUDIO,
+    AUDIO_FRAME_MAX_SIZE,
 )
+from .pool import IntercomConnectionPool
+from .relay import FrameRelay
 from .tcp_client import IntercomTcpClient
 
 _LOGGER = logging.getLogger(__name__)
@@ -30,6 +42,7 @@ WS_TYPE_AUDIO = f"{DOMAIN}/audio"
 WS_TYPE_LIST = f"{DOMAIN}/list_devices"
 WS_TYPE_BRIDGE = f"{DOMAIN}/bridge"
 WS_TYPE_BRIDGE_STOP = f"{DOMAIN}/bridge_stop"
+WS_TYPE_BRIDGE_STATS = f"{DOMAIN}/bridge_stats"
 
 # Active sessions: device_id -> IntercomSession
 _sessions: Dict[str, "IntercomSession"] = {}
@@ -42,6 +55,22 @@ _bridges: Dict[str, "BridgeSession"] = {}
 # without going through event bus (which requires admin privileges)
 _audio_subscribers: Dict[str, set] = {}
 
+# Binary audio channels: device_id -> set of _BinaryAudioSink (AudioChannelView)
+# Preferred by the card; _audio_subscribers (base64 JSON) is the fallback
+_binary_subscribers: Dict[str, set] = {}
+
+
+def _pool(hass: HomeAssistant) -> IntercomConnectionPool:
+    """The connection pool set up with the integration (see __init__.py)."""
+    return hass.data[DOMAIN]["pool"]
+
+
+def _publish_latency(hass: HomeAssistant, device_id: str, stats: Optional[dict]) -> None:
+    """Hand a call leg's latency estimate (None = call over) to the active devices sensor."""
+    sensor = hass.data.get(DOMAIN, {}).get("active_devices_sensor")
+    if sensor is not None:
+        sensor.set_call_latency(device_id, stats)
+
 
 class IntercomSession:
     """Manages a single intercom session between browser and ESP."""
@@ -69,6 +98,8 @@ class IntercomSession:
         """Handle audio from ESP - push to subscribed WS connections."""
         if not self._active:
             return
+        for sink in list(_binary_subscribers.get(self.device_id, ())):
+            sink.push(data)
         subs = _audio_subscribers.get(self.device_id)
         if not subs:
             return
@@ -126,19 +157,24 @@ class IntercomSession:
             {"device_id": self.device_id, "state": "idle"}
         )
 
-    def _create_tcp_client(self) -> IntercomTcpClient:
-        """Create a TCP client with standard callbacks."""
-        return IntercomTcpClient(
-            host=self.host,
-            port=INTERCOM_PORT,
+    async def _acquire_tcp_client(self) -> Optional[IntercomTcpClient]:
+        """Lease the device's pooled connection (or a fresh one) with standard callbacks."""
+        return await _pool(self.hass).acquire(
+            self.host,
             on_audio=lambda data: self._on_audio(data),
             on_disconnected=lambda: self._on_disconnected(),
             on_ringing=lambda: self._on_ringing(),
             on_answered=lambda: self._on_answered(),
             on_stop_received=lambda: self._on_stop_received(),
             on_error_received=lambda code: self._on_error_received(code),
+            on_latency=lambda stats: _publish_latency(self.hass, self.device_id, stats),
         )
 
+    async def _release_tcp_client(self) -> None:
+        """Hand the connection back to the pool - parked for the next call, or closed."""
+        client, self._tcp_client = self._tcp_client, None
+        await _pool(self.hass).release(client)
+
     async def start(self) -> str:
         """Start the intercom session.
 
@@ -150,9 +186,8 @@ class IntercomSession:
         if self._active:
             return "streaming"
 
-        self._tcp_client = self._create_tcp_client()
-
-        if not await self._tcp_client.connect():
+        self._tcp_client = await self._acquire_tcp_client()
+        if self._tcp_client is None:
             return "error"
 
         # Fire "calling" state - we're calling, waiting for response
@@ -178,7 +213,7 @@ class IntercomSession:
             self._ringing = True
             return "ringing"
         else:
-            await self._tcp_client.disconnect()
+            await self._release_tcp_client()
             return "error"
 
     async def stop(self) -> None:
@@ -205,8 +240,7 @@ class IntercomSession:
 
         if self._tcp_client:
             await self._tcp_client.stop_stream()
-            await self._tcp_client.disconnect()
-            self._tcp_client = None
+            await self._release_tcp_client()
 
     async def answer(self) -> bool:
         """Answer a ringing call (send ANSWER to ESP).
@@ -228,7 +262,7 @@ class IntercomSession:
         """Answer an ESP-initiated call (ESP called Home Assistant).
 
         This is for when ESP is in OUTGOING state calling us.
-        We connect and send ANSWER (not START).
+        We send ANSWER (not START) on the pooled or a fresh connection.
 
         Returns:
             "streaming" - Answer sent, streaming started
@@ -237,36 +271,25 @@ class IntercomSession:
         if self._active:
             return "streaming"
 
-        self._tcp_client = self._create_tcp_client()
-
-        if not await self._tcp_client.connect():
+        self._tcp_client = await self._acquire_tcp_client()
+        if self._tcp_client is None:
             return "error"
 
         # Send ANSWER directly (not via send_answer which checks _ringing)
         # We're answering an ESP-initiated call - _ringing is not set because
-        # this is a fresh TCP connection to an ESP that called us
-        from .const import MSG_ANSWER
-        result = await self._tcp_client._send_message(MSG_ANSWER)
-        if result:
-            # Mark that we're awaiting PONG as answer confirmation
-            self._tcp_client._awaiting_answer_ack = True
-
-            # Wait briefly for PONG from ESP
-            for _ in range(50):  # 500ms max wait
-                await asyncio.sleep(0.01)
-                if self._active:
-                    _LOGGER.debug("answer_esp_call: PONG received, streaming")
-                    return "streaming"
-
-            # Timeout - start streaming anyway (ESP might not send PONG)
-            _LOGGER.warning("answer_esp_call: no PONG, assuming stream started")
-            self._tcp_client._awaiting_answer_ack = False
+        # this connection never saw the call's START.
+        # answer_call() also offers our codecs and waits for the PONG.
+        result = await self._tcp_client.answer_call()
+        if result != "streaming":
+            await self._release_tcp_client()
+            return "error"
+
+        if not self._active:
+            # No PONG (older firmware): on_answered never ran, start TX here
             self._active = True
             self._tx_task = asyncio.create_task(self._tx_sender())
-            return "streaming"
-        else:
-            await self._tcp_client.disconnect()
-            return "error"
+        _LOGGER.debug("answer_esp_call: streaming")
+        return "streaming"
 
     async def _tx_sender(self) -> None:
         """Single task that sends audio from queue to TCP."""
@@ -289,10 +312,13 @@ class IntercomSession:
 
 
 class BridgeSession:
-    """Manages audio bridge between two ESP devices (full mode).
+    """Manages a call between two ESP devices (full mode).
 
-    Uses queues + dedicated sender tasks instead of task-per-packet
-    to prevent race conditions during hangup/stop.
+    Direct first: HA sends DIAL to the source, which connects to the dest itself
+    and streams peer to peer; HA keeps only the source signalling link.
+    Relay otherwise (dest unreachable from the source, older firmware): one
+    FrameRelay per direction. Legs with the same codec over TCP forward the framed
+    messages untouched; anything else (UDP leg, transcoding) relays payloads.
     """
 
     def __init__(
@@ -319,50 +345,36 @@ class BridgeSession:
         self._source_client: Optional[IntercomTcpClient] = None
         self._dest_client: Optional[IntercomTcpClient] = None
         self._active = False
+        self._direct = False  # ESP<->ESP audio, HA signalling only
 
-        # Audio queues for each direction (prevents task-per-packet storm)
-        self._q_source_to_dest: asyncio.Queue = asyncio.Queue(maxsize=AUDIO_QUEUE_SIZE)
-        self._q_dest_to_source: asyncio.Queue = asyncio.Queue(maxsize=AUDIO_QUEUE_SIZE)
-
-        # Sender tasks
-        self._sender_s2d: Optional[asyncio.Task] = None
-        self._sender_d2s: Optional[asyncio.Task] = None
+        # One relay per direction (queue + sender task, no task-per-packet)
+        self._relay_s2d = FrameRelay("s2d")
+        self._relay_d2s = FrameRelay("d2s")
+        self._raw_relay = False  # Both legs TCP with the same codec: forward framed bytes
 
         # Stop lock to prevent race conditions
         self._stop_lock = asyncio.Lock()
 
-    def _push_audio(self, queue: asyncio.Queue, data: bytes) -> None:
-        """Push audio to queue, dropping if full (non-blocking)."""
-        try:
-            queue.put_nowait(data)
-        except asyncio.QueueFull:
-            pass  # Drop silently - low latency > perfect audio
-
-    async def _sender_loop(
-        self,
-        queue: asyncio.Queue,
-        client: IntercomTcpClient,
-        direction: str
-    ) -> None:
-        """Dedicated sender task - pulls from queue and sends to client."""
-        _LOGGER.debug("Bridge sender %s started", direction)
-        try:
-            while self._active:
-                try:
-                    # Wait for audio with timeout to allow checking _active
-                    data = await asyncio.wait_for(queue.get(), timeout=1.0)
-                    if self._active and client:
-                        await client.send_audio(data)
-                except asyncio.TimeoutError:
-                    continue  # Check _active and loop
-        except asyncio.CancelledError:
-            pass
-        except Exception as e:
-            _LOGGER.error("Bridge sender %s fatal error: %s - stopping bridge", direction, e)
-            # Trigger bridge stop on sender failure
-            asyncio.create_task(self.stop())
-        finally:
-            _LOGGER.debug("Bridge sender %s stopped", direction)
+    @property
+    def is_direct(self) -> bool:
+        """Return True if the ESPs stream to each other without HA in the audio path."""
+        return self._direct
+
+    @property
+    def stats(self) -> Dict[str, Any]:
+        """Relay queue depth/latency per direction (empty for direct calls)."""
+        if self._direct:
+            return {"direct": True}
+        stats = {"direct": False, "s2d": self._relay_s2d.stats, "d2s": self._relay_d2s.stats}
+        # Mouth to ear through HA: one ESP's mic to HA, the relay queue, HA to the other ESP's speaker
+        src = self._source_client.latency if self._source_client else None
+        dst = self._dest_client.latency if self._dest_client else None
+        if src and dst:
+            stats["s2d"]["mouth_to_ear_ms"] = round(
+                src["esp_to_ha_ms"] + stats["s2d"]["latency_avg_ms"] + dst["ha_to_esp_ms"])
+            stats["d2s"]["mouth_to_ear_ms"] = round(
+                dst["esp_to_ha_ms"] + stats["d2s"]["latency_avg_ms"] + src["ha_to_esp_ms"])
+        return stats
 
     async def start(self) -> str:
         """Start the bridge session.
@@ -377,14 +389,14 @@ class BridgeSession:
 
         bridge = self
 
-        # Audio callbacks now push to queue instead of creating tasks
+        # Audio callbacks push to the relays (frames or payloads, see _raw_relay)
         def on_source_audio(data: bytes) -> None:
             if bridge._active:
-                bridge._push_audio(bridge._q_source_to_dest, data)
+                bridge._relay_s2d.push(data)
 
         def on_dest_audio(data: bytes) -> None:
             if bridge._active:
-                bridge._push_audio(bridge._q_dest_to_source, data)
+                bridge._relay_d2s.push(data)
 
         def on_source_disconnected() -> None:
             _LOGGER.debug("Bridge source disconnected: %s", bridge.bridge_id)
@@ -396,13 +408,21 @@ class BridgeSession:
             asyncio.create_task(bridge.stop())
             bridge._fire_state_event("disconnected")
 
+        def on_source_ringing() -> None:
+            # Direct call: the source reports the dest ringing
+            if bridge._direct:
+                _LOGGER.info("Bridge dest ringing (direct): %s", bridge.bridge_id)
+                bridge._fire_state_event("ringing")
+
         def on_source_answered() -> None:
             _LOGGER.debug("Bridge source answered: %s", bridge.bridge_id)
+            if bridge._direct:
+                bridge._fire_state_event("connected")
 
         def on_dest_answered() -> None:
             _LOGGER.debug("Bridge dest answered: %s", bridge.bridge_id)
             # When dest answers, start the sender tasks
-            if bridge._active and not bridge._sender_s2d:
+            if bridge._active and not bridge._relay_s2d.running:
                 bridge._start_sender_tasks()
 
         def on_source_stop() -> None:
@@ -429,58 +449,80 @@ class BridgeSession:
             asyncio.create_task(bridge.stop())
             bridge._fire_state_event("disconnected")
 
-        # Create TCP clients for both ESPs
-        self._source_client = IntercomTcpClient(
-            host=self.source_host,
-            port=INTERCOM_PORT,
+        pool = _pool(self.hass)
+
+        # Fire "calling" state - bridge is being set up
+        self._fire_state_event("calling")
+
+        # Lease the source's connection (pooled links are already up)
+        self._source_client = await pool.acquire(
+            self.source_host,
             on_audio=on_source_audio,
             on_disconnected=on_source_disconnected,
-            on_ringing=lambda: None,  # Source doesn't ring
+            on_ringing=on_source_ringing,  # Source itself never rings
             on_answered=on_source_answered,
             on_stop_received=on_source_stop,
             on_error_received=on_source_error,
+            on_latency=lambda stats: _publish_latency(self.hass, self.source_device_id, stats),
         )
+        if self._source_client is None:
+            _LOGGER.error("Bridge: failed to connect to source %s", self.source_host)
+            return "error"
 
-        self._dest_client = IntercomTcpClient(
-            host=self.dest_host,
-            port=INTERCOM_PORT,
+        if await self._start_direct():
+            return "ringing"  # Waiting for the dest - RING/ANSWER arrive through the source
+
+        # Relay: the dest leg too (never leased for direct calls - the source is the dest's client)
+        self._dest_client = await pool.acquire(
+            self.dest_host,
             on_audio=on_dest_audio,
             on_disconnected=on_dest_disconnected,
             on_ringing=on_dest_ringing,
             on_answered=on_dest_answered,
             on_stop_received=on_dest_stop,
             on_error_received=on_dest_error,
+            on_latency=lambda stats: _publish_latency(self.hass, self.dest_device_id, stats),
         )
-
-        # Fire "calling" state - bridge is being set up
-        self._fire_state_event("calling")
-
-        # Connect to both ESPs
-        source_connected = await self._source_client.connect()
-        if not source_connected:
-            _LOGGER.error("Bridge: failed to connect to source %s", self.source_host)
-            return "error"
-
-        dest_connected = await self._dest_client.connect()
-        if not dest_connected:
+        if self._dest_client is None:
             _LOGGER.error("Bridge: failed to connect to dest %s", self.dest_host)
-            await self._source_client.disconnect()
+            await self._release_clients()
             return "error"
 
         # Start streaming on both
         # Source (caller) uses NO_RING flag - should never ring, always start streaming
         # Both receive the other's name so they know who they're talking to
         source_result = await self._source_client.start_stream(flags=FLAG_NO_RING, caller_name=self.dest_name)
+        # Dest is offered the framing the source picked: frames relay end to end unchanged
+        self._dest_client.match_framing(self._source_client.codec, self._source_client.frame_ms)
         dest_result = await self._dest_client.start_stream(caller_name=self.source_name)
 
         if source_result == "error" or dest_result == "error":
             _LOGGER.error("Bridge: failed to start stream")
-            await self._source_client.disconnect()
-            await self._dest_client.disconnect()
+            await self._source_client.stop_stream()
+            await self._dest_client.stop_stream()
+            await self._release_clients()
             return "error"
 
         self._active = True
 
+        # Both legs negotiated at START: same codec and framing relays raw codec
+        # frames, otherwise each client transcodes through PCM. With both legs on
+        # TCP the framed messages themselves are forwarded, header included - DTX
+        # silence descriptors too, so both ESPs must understand them.
+        if (self._source_client.codec == self._dest_client.codec
+                and self._source_client.frame_ms == self._dest_client.frame_ms):
+            self._source_client.set_pcm_audio(False)
+            self._dest_client.set_pcm_audio(False)
+            if (not self._source_client.is_datagram and not self._dest_client.is_datagram
+                    and self._source_client.dtx == self._dest_client.dtx):
+                self._raw_relay = True
+                self._source_client.set_frame_sink(on_source_audio)
+                self._dest_client.set_frame_sink(on_dest_audio)
+        _LOGGER.debug("Bridge codecs: source=%s/%dms dest=%s/%dms (%s relay)",
+                      CODEC_NAMES.get(self._source_client.codec, "?"), self._source_client.frame_ms,
+                      CODEC_NAMES.get(self._dest_client.codec, "?"), self._dest_client.frame_ms,
+                      "frame" if self._raw_relay else "payload")
+
         # If dest is ringing, don't start senders yet - wait for answer
         if dest_result == "ringing":
             _LOGGER.info("Bridge waiting for dest to answer: %s <-> %s",
@@ -495,16 +537,43 @@ class BridgeSession:
 
         return "connected"
 
+    async def _start_direct(self) -> bool:
+        """Ask the source to call the dest itself. False = relay the call through HA."""
+        try:
+            dest_ip = await self.hass.async_add_executor_job(socket.gethostbyname, self.dest_host)
+        except OSError as err:
+            _LOGGER.debug("Bridge: cannot resolve %s (%s) - relaying", self.dest_host, err)
+            return False
+
+        result = await self._source_client.dial(dest_ip, INTERCOM_PORT, self.dest_name)
+        if result != "dialing":
+            _LOGGER.info("Bridge: direct call %s -> %s %s - relaying through HA",
+                         self.source_host, self.dest_host, result)
+            return False
+
+        self._direct = True
+        self._active = True
+        _LOGGER.info("Bridge started (direct): %s -> %s", self.source_host, self.dest_host)
+        return True
+
+    async def _release_clients(self) -> None:
+        """Hand both legs back to the connection pool."""
+        pool = _pool(self.hass)
+        source, self._source_client = self._source_client, None
+        dest, self._dest_client = self._dest_client, None
+        await pool.release(source)
+        await pool.release(dest)
+
     def _start_sender_tasks(self) -> None:
-        """Start the audio sender tasks."""
-        if self._sender_s2d is None and self._dest_client:
-            self._sender_s2d = asyncio.create_task(
-                self._sender_loop(self._q_source_to_dest, self._dest_client, "s2d")
-            )
-        if self._sender_d2s is None and self._source_client:
-            self._sender_d2s = asyncio.create_task(
-                self._sender_loop(self._q_dest_to_source, self._source_client, "d2s")
-            )
+        """Start the audio relays."""
+        def on_relay_error() -> None:
+            # Sender failure ends the bridge
+            asyncio.create_task(self.stop())
+
+        if self._dest_client:
+            self._relay_s2d.start(self._dest_client, self._raw_relay, on_relay_error)
+        if self._source_client:
+            self._relay_d2s.start(self._source_client, self._raw_relay, on_relay_error)
         self._fire_state_event("connected")
 
     def _fire_state_event(self, state: str) -> None:
@@ -527,39 +596,18 @@ class BridgeSession:
 
             self._active = False
 
-            # Cancel sender tasks first
-            for task in [self._sender_s2d, self._sender_d2s]:
-                if task:
-                    task.cancel()
-                    try:
-                        await asyncio.wait_for(task, timeout=1.0)
-                    except (asyncio.CancelledError, asyncio.TimeoutError):
-                        pass
-            self._sender_s2d = None
-            self._sender_d2s = None
-
-            # Clear queues
-            while not self._q_source_to_dest.empty():
-                try:
-                    self._q_source_to_dest.get_nowait()
-                except asyncio.QueueEmpty:
-                    break
-            while not self._q_dest_to_source.empty():
-                try:
-                    self._q_dest_to_source.get_nowait()
-                except asyncio.QueueEmpty:
-                    break
+            # Stop the relays first (cancels the senders, drops queued frames)
+            if not self._direct:
+                _LOGGER.debug("Bridge relay stats %s: %s", self.bridge_id, self.stats)
+            await self._relay_s2d.stop()
+            await self._relay_d2s.stop()
 
             # Stop TCP clients
             if self._source_client:
                 await self._source_client.stop_stream()
-                await self._source_client.disconnect()
-                self._source_client = None
-
             if self._dest_client:
                 await self._dest_client.stop_stream()
-                await self._dest_client.disconnect()
-                self._dest_client = None
+            await self._release_clients()
 
             # Remove from global _bridges dict to allow new bridges
             _bridges.pop(self.bridge_id, None)
@@ -568,8 +616,85 @@ class BridgeSession:
             self._fire_state_event("idle")
 
 
+class _BinaryAudioSink:
+    """One card on the binary audio channel.
+
+    Frames are queued for a dedicated sender task (the TCP client callback is sync),
+    so a slow tablet drops frames instead of stalling the event loop. seq advances on
+    drops too - the card sees the gap.
+    """
+
+    def __init__(self, ws: web.WebSocketResponse):
+        self._ws = ws
+        self._queue: asyncio.Queue = asyncio.Queue(maxsize=AUDIO_QUEUE_SIZE)
+        self._seq = 0
+        self._task = asyncio.create_task(self._sender())
+
+    def push(self, pcm: bytes) -> None:
+        frame = struct.pack("<BBH", AUDIO_FRAME_KIND_AUDIO, CODEC_PCM, self._seq) + pcm
+        self._seq = (self._seq + 1) & 0xFFFF
+        try:
+            self._queue.put_nowait(frame)
+        except asyncio.QueueFull:
+            pass  # Drop - low latency > perfect audio
+
+    async def _sender(self) -> None:
+        try:
+            while not self._ws.closed:
+                frame = await self._queue.get()
+                await self._ws.send_bytes(frame)
+        except asyncio.CancelledError:
+            pass
+        except Exception as err:
+            _LOGGER.debug("Binary audio sender stopped: %s", err)
+
+    def close(self) -> None:
+        self._task.cancel()
+
+
+class AudioChannelView(HomeAssistantView):
+    """Binary audio websocket between the card and HA - no JSON, no base64.
+
+    The card connects with a signed path (auth/sign_path). Each websocket message
+    is one frame: <BBH> kind, codec, seq + PCM s16le 16 kHz mono, both directions.
+    The browser always gets PCM: HA transcodes Opus calls as for the JSON path.
+    """
+
+    url = AUDIO_CHANNEL_URL
+    name = "api:intercom_native:audio"
+    requires_auth = True
+
+    async def get(self, request: web.Request, device_id: str) -> web.WebSocketResponse:
+        ws = web.WebSocketResponse(heartbeat=30, max_msg_size=AUDIO_FRAME_MAX_SIZE)
+        await ws.prepare(request)
+
+        sink = _BinaryAudioSink(ws)
+        _binary_subscribers.setdefault(device_id, set()).add(sink)
+        _LOGGER.debug("Binary audio channel opened: %s", device_id)
+        try:
+            async for msg in ws:
+                if msg.type != WSMsgType.BINARY or len(msg.data) <= AUDIO_FRAME_HEADER_SIZE:
+                    continue
+                kind, codec, _seq = struct.unpack_from("<BBH", msg.data)
+                if kind != AUDIO_FRAME_KIND_AUDIO or codec != CODEC_PCM:
+                    continue
+                session = _sessions.get(device_id)
+                if session and session._active:
+                    session.queue_audio(msg.data[AUDIO_FRAME_HEADER_SIZE:])
+        finally:
+            sink.close()
+            sinks = _binary_subscribers.get(device_id)
+            if sinks:
+                sinks.discard(sink)
+                if not sinks:
+                    _binary_subscribers.pop(device_id, None)
+            _LOGGER.debug("Binary audio channel closed: %s", device_id)
+        return ws
+
+
 def async_register_websocket_api(hass: HomeAssistant) -> None:
-    """Register WebSocket API commands."""
+    """Register WebSocket API commands and the binary audio channel."""
+    hass.http.register_view(AudioChannelView())
     websocket_api.async_register_command(hass, websocket_start)
     websocket_api.async_register_command(hass, websocket_stop)
     websocket_api.async_register_command(hass, websocket_answer)
@@ -578,6 +703,7 @@ def async_register_websocket_api(hass: HomeAssistant) -> None:
     websocket_api.async_register_command(hass, websocket_list_devices)
     websocket_api.async_register_command(hass, websocket_bridge)
     websocket_api.async_register_command(hass, websocket_bridge_stop)
+    websocket_api.async_register_command(hass, websocket_bridge_stats)
     websocket_api.async_register_command(hass, websocket_decline)
     websocket_api.async_register_command(hass, websocket_subscribe_audio)
 
@@ -706,6 +832,10 @@ async def websocket_answer(
 
     # Check bridges - device_id might be the dest (callee) of a bridge
     for bridge in _bridges.values():
+        if bridge.dest_device_id == device_id and bridge.is_direct:
+            # The source ESP holds the dest's call connection, HA can't answer for it
+            connection.send_error(msg_id, "direct_call", "Direct ESP call - answer on the device")
+            return
         if bridge.dest_device_id == device_id and bridge._dest_client:
             result = await bridge._dest_client.send_answer()
             if result:
@@ -778,7 +908,7 @@ def websocket_audio(
     connection: websocket_api.ActiveConnection,
     msg: Dict[str, Any],
 ) -> None:
-    """Handle audio from browser (JSON with base64) - non-blocking."""
+    """Handle audio from browser (JSON with base64, fallback for AudioChannelView) - non-blocking."""
     device_id = msg["device_id"]
     audio_b64 = msg["audio"]
 
@@ -812,6 +942,11 @@ async def websocket_list_devices(
     connection.send_result(msg["id"], {"devices": devices})
 
 
+async def intercom_hosts(hass: HomeAssistant) -> list:
+    """Hosts of all intercom devices (what the connection pool keeps warm)."""
+    return [device["host"] for device in await _get_intercom_devices(hass)]
+
+
 async def _get_intercom_devices(hass: HomeAssistant) -> list:
     """Get all intercom devices with their info."""
     from homeassistant.helpers import entity_registry as er
@@ -1001,6 +1136,28 @@ async def websocket_bridge_stop(
     connection.send_result(msg_id, {"success": True})
 
 
+@websocket_api.websocket_command(
+    {
+        vol.Required("type"): WS_TYPE_BRIDGE_STATS,
+        vol.Optional("bridge_id"): str,
+    }
+)
+@callback
+def websocket_bridge_stats(
+    hass: HomeAssistant,
+    connection: websocket_api.ActiveConnection,
+    msg: Dict[str, Any],
+) -> None:
+    """Relay queue depth/latency of active bridges (all, or one bridge_id)."""
+    bridge_id = msg.get("bridge_id")
+    stats = {
+        bid: bridge.stats
+        for bid, bridge in _bridges.items()
+        if bridge_id is None or bid == bridge_id
+    }
+    connection.send_result(msg["id"], {"bridges": stats})
+
+
 WS_TYPE_SUBSCRIBE_AUDIO = f"{DOMAIN}/subscribe_audio"
 WS_TYPE_DECLINE = f"{DOMAIN}/decline"
 
@@ -0,0 +1,50 @@
+"""On-target micro-benchmarks for the per-frame audio kernels.
+
+Times the audio_kernels loops, intercom_api's AEC frame accumulator and TCP
+framing, the i2s_audio_duplex FIR decimator, interpolator and fused RX kernel,
+and ESP-SR AEC (when those components are in the build) over synthetic 32 ms
+frames and logs cycles per frame. The same fixtures run on the host (host/). Run with the audio_benchmark.run action or run_on_boot.
+"""
+
+from esphome import automation
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_ID
+
+CODEOWNERS = ["@n-IA-hane"]
+DEPENDENCIES = ["esp32"]
+AUTO_LOAD = ["audio_kernels"]
+
+CONF_FRAMES = "frames"
+CONF_RUN_ON_BOOT = "run_on_boot"
+
+audio_benchmark_ns = cg.esphome_ns.namespace("audio_benchmark")
+AudioBenchmark = audio_benchmark_ns.class_("AudioBenchmark", cg.Component)
+RunAction = audio_benchmark_ns.class_("RunAction", automation.Action)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(AudioBenchmark),
+        cv.Optional(CONF_FRAMES, default=200): cv.int_range(min=1, max=10000),
+        cv.Optional(CONF_RUN_ON_BOOT, default=False): cv.boolean,
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    cg.add(var.set_frames(config[CONF_FRAMES]))
+    cg.add(var.set_run_on_boot(config[CONF_RUN_ON_BOOT]))
+
+
+@automation.register_action(
+    "audio_benchmark.run",
+    RunAction,
+    automation.maybe_simple_id({cv.GenerateID(): cv.use_id(AudioBenchmark)}),
+)
+async def audio_benchmark_run_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    parent = await cg.get_variable(config[CONF_ID])
+    cg.add(var.set_parent(parent))
+    return var
@@ -0,0 +1,409 @@
+#include "audio_benchmark.h"
+
+#ifdef USE_ESP32
+
+#include <cmath>
+#include <cstring>
+
+#include <esp_cpu.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace audio_benchmark {
+
+static const char *const TAG = "audio_benchmark";
+
+static const uint32_t SAMPLE_RATE = 16000;      // Kernel output rate (intercom / AEC rate)
+static const float BENCH_GAIN = 0.7f;           // Not unity: scale_copy would collapse to a memcpy
+static const uint32_t VAD_HANGOVER_MS = 240;    // As intercom_api's DTX
+static const float NOISE_LEVEL_DBFS = -50.0f;   // Typical comfort-noise level
+static const size_t DUPLEX_CHUNK_SAMPLES = 256;  // i2s_audio_duplex frame_duration default (16 ms)
+#ifdef USE_ESP_AEC
+static const int AEC_FILTER_LENGTH = 4;         // esp_aec default
+#endif
+
+const char *bench_kernel_to_str(BenchKernel kernel) {
+  switch (kernel) {
+    case BenchKernel::SCALE_COPY:
+      return "scale_copy";
+    case BenchKernel::DC_BLOCK_GAIN:
+      return "dc_block_gain";
+    case BenchKernel::DEINTERLEAVE:
+      return "deinterleave";
+    case BenchKernel::PEAK_ABS:
+      return "peak_abs";
+    case BenchKernel::ENERGY_VAD:
+      return "energy_vad";
+    case BenchKernel::NOISE_SOURCE:
+      return "noise_source";
+    case BenchKernel::SPSC_RING:
+      return "spsc_ring";
+    case BenchKernel::MIX_ADD:
+      return "mix_add";
+    case BenchKernel::AEC_ACCUMULATOR:
+      return "aec_accumulator";
+    case BenchKernel::FRAMING:
+      return "framing";
+    case BenchKernel::FIR_FLOAT:
+      return "fir_float";
+    case BenchKernel::FIR_Q15:
+      return "fir_q15";
+    case BenchKernel::RX_FUSED:
+      return "rx_fused";
+    case BenchKernel::INTERP_FLOAT:
+      return "interp_float";
+    case BenchKernel::INTERP_Q15:
+      return "interp_q15";
+    case BenchKernel::AEC_SR_LOW_COST:
+      return "aec_sr_low_cost";
+    case BenchKernel::AEC_VOIP_LOW_COST:
+      return "aec_voip_low_cost";
+    default:
+      return "unknown";
+  }
+}
+
+void AudioBenchmark::setup() {
+  if (this->run_on_boot_) this->start();
+}
+
+void AudioBenchmark::dump_config() {
+  ESP_LOGCONFIG(TAG, "Audio Benchmark:");
+  ESP_LOGCONFIG(TAG, "  Frames per Kernel: %u (%u samples, %u ms)", (unsigned) this->frames_,
+                (unsigned) FRAME_SAMPLES, (unsigned) (FRAME_SAMPLES * 1000 / SAMPLE_RATE));
+  ESP_LOGCONFIG(TAG, "  Run on Boot: %s", YESNO(this->run_on_boot_));
+#ifdef USE_I2S_AUDIO_DUPLEX
+#ifdef USE_I2S_DUPLEX_Q15_FIR
+  ESP_LOGCONFIG(TAG, "  FIR Decimator / Interpolator: float + Q15 (esp-dsp)");
+#else
+  ESP_LOGCONFIG(TAG, "  FIR Decimator / Interpolator: float");
+#endif
+#endif
+#ifdef USE_ESP_AEC
+  ESP_LOGCONFIG(TAG, "  AEC: sr_low_cost, voip_low_cost");
+#endif
+#ifdef USE_INTERCOM_API
+  ESP_LOGCONFIG(TAG, "  Framing: intercom_api over loopback TCP");
+#endif
+}
+
+bool AudioBenchmark::start() {
+  if (this->running_) {
+    ESP_LOGW(TAG, "Benchmark already running");
+    return false;
+  }
+  if (!this->allocate_()) {
+    ESP_LOGE(TAG, "Failed to allocate benchmark buffers");
+    this->release_();
+    return false;
+  }
+  for (auto &result : this->results_) result = BenchResult{};
+  this->current_ = 0;
+  this->kernel_active_ = false;
+  this->running_ = true;
+  ESP_LOGI(TAG, "Benchmark started: %u frames per kernel", (unsigned) this->frames_);
+  return true;
+}
+
+void AudioBenchmark::loop() {
+  if (!this->running_) return;
+
+  // Whole frames only: one slow kernel (AEC) may overrun the budget by a frame
+  const int64_t deadline = esp_timer_get_time() + BATCH_BUDGET_US;
+  do {
+    if (this->current_ >= static_cast<uint8_t>(BenchKernel::COUNT)) {
+      this->report_();
+      this->release_();
+      this->running_ = false;
+      return;
+    }
+    const BenchKernel kernel = static_cast<BenchKernel>(this->current_);
+    BenchResult &result = this->results_[this->current_];
+
+    if (!this->kernel_active_) {
+      result.samples = this->begin_kernel_(kernel);
+      result.supported = result.samples > 0;
+      if (!result.supported) {
+        this->end_kernel_();
+        this->current_++;
+        continue;
+      }
+      this->kernel_active_ = true;
+      this->heap_before_ = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    }
+
+    const int64_t start_us = esp_timer_get_time();
+    const uint32_t cycles = this->run_frame_(kernel);
+    result.total_us += static_cast<uint64_t>(esp_timer_get_time() - start_us);
+    result.total_cycles += cycles;
+    if (cycles < result.min_cycles) result.min_cycles = cycles;
+    if (cycles > result.max_cycles) result.max_cycles = cycles;
+    result.frames++;
+
+    if (result.frames >= this->frames_) {
+      result.heap_delta =
+          static_cast<int32_t>(this->heap_before_) - static_cast<int32_t>(heap_caps_get_free_size(MALLOC_CAP_8BIT));
+      this->end_kernel_();
+      this->kernel_active_ = false;
+      this->current_++;
+    }
+  } while (esp_timer_get_time() < deadline);
+}
+
+bool AudioBenchmark::allocate_() {
+  // Internal SRAM, 16-byte aligned: where the audio paths keep their HOT buffers
+  auto alloc = [](size_t samples) {
+    return static_cast<int16_t *>(heap_caps_aligned_alloc(16, samples * sizeof(int16_t), MALLOC_CAP_INTERNAL));
+  };
+  this->in_ = alloc(FRAME_SAMPLES * FIR_RATIO);
+  this->ref_ = alloc(FRAME_SAMPLES);
+  this->out_ = alloc(FRAME_SAMPLES);
+  this->out2_ = alloc(FRAME_SAMPLES);
+  this->bus_out_ = alloc(FRAME_SAMPLES * FIR_RATIO);
+  this->ring_ = audio_kernels::SpscRing::create(FRAME_SAMPLES * sizeof(int16_t) * 2, false);
+  if (this->in_ == nullptr || this->ref_ == nullptr || this->out_ == nullptr || this->out2_ == nullptr ||
+      this->bus_out_ == nullptr || this->ring_ == nullptr) {
+    return false;
+  }
+
+  // Two voice-band tones at about -12 dBFS over -50 dBFS noise; the bus-rate frame
+  // carries the same tones, so the decimator output matches ref_ in content
+  audio_kernels::NoiseSource noise;
+  noise.fill(this->in_, FRAME_SAMPLES * FIR_RATIO, NOISE_LEVEL_DBFS);
+  const float bus_rate = static_cast<float>(SAMPLE_RATE * FIR_RATIO);
+  for (size_t i = 0; i < FRAME_SAMPLES * FIR_RATIO; i++) {
+    const float t = static_cast<float>(i) / bus_rate;
+    const float tone = 5000.0f * sinf(2.0f * static_cast<float>(M_PI) * 440.0f * t) +
+                       3000.0f * sinf(2.0f * static_cast<float>(M_PI) * 1250.0f * t);
+    this->in_[i] = audio_kernels::saturate16(static_cast<int32_t>(tone) + this->in_[i]);
+  }
+  for (size_t i = 0; i < FRAME_SAMPLES; i++) this->ref_[i] = this->in_[i * FIR_RATIO];
+  return true;
+}
+
+void AudioBenchmark::release_() {
+  heap_caps_free(this->in_);
+  heap_caps_free(this->ref_);
+  heap_caps_free(this->out_);
+  heap_caps_free(this->out2_);
+  heap_caps_free(this->bus_out_);
+  this->in_ = this->ref_ = this->out_ = this->out2_ = this->bus_out_ = nullptr;
+  this->ring_.reset();
+}
+
+uint32_t AudioBenchmark::begin_kernel_(BenchKernel kernel) {
+  switch (kernel) {
+    case BenchKernel::SCALE_COPY:
+    case BenchKernel::DC_BLOCK_GAIN:
+      this->gain_ = audio_kernels::Gain::from_float(BENCH_GAIN);
+      this->dc_.reset();
+      return FRAME_SAMPLES;
+    case BenchKernel::DEINTERLEAVE:
+    case BenchKernel::PEAK_ABS:
+    case BenchKernel::NOISE_SOURCE:
+      return FRAME_SAMPLES;
+    case BenchKernel::ENERGY_VAD:
+      this->vad_.init(SAMPLE_RATE, VAD_HANGOVER_MS);
+      return FRAME_SAMPLES;
+    case BenchKernel::SPSC_RING:
+      this->ring_->reset();
+      return FRAME_SAMPLES;
+    case BenchKernel::MIX_ADD:
+      memcpy(this->out_, this->ref_, FRAME_SAMPLES * sizeof(int16_t));
+      return FRAME_SAMPLES;
+    case BenchKernel::AEC_ACCUMULATOR:
+      // One sr_low_cost frame (512 samples) per timed frame
+      this->accumulator_.reset(new AecAccumulator());
+      return this->accumulator_->init(FRAME_SAMPLES, DUPLEX_CHUNK_SAMPLES) ? FRAME_SAMPLES : 0;
+#ifdef USE_INTERCOM_API
+    case BenchKernel::FRAMING:
+      this->framing_.reset(new FramingLoopback());
+      if (!this->framing_->open()) {
+        ESP_LOGW(TAG, "%s: loopback TCP connection failed", bench_kernel_to_str(kernel));
+        return 0;
+      }
+      return FRAME_SAMPLES;
+#endif
+#ifdef USE_I2S_AUDIO_DUPLEX
+    case BenchKernel::FIR_FLOAT:
+      this->fir_.reset(new i2s_audio_duplex::FirDecimator());
+      this->fir_->init(FIR_RATIO);
+      return FRAME_SAMPLES;
+    case BenchKernel::INTERP_FLOAT:
+      this->interp_.reset(new i2s_audio_duplex::FirInterpolator());
+      this->interp_->init(FIR_RATIO);
+      return FRAME_SAMPLES;
+    case BenchKernel::RX_FUSED:
+      // in_ read as stereo: half the frame per channel. Decimators on the backend the audio task uses
+      this->fir_.reset(new i2s_audio_duplex::FirDecimator());
+      this->fir_->init(FIR_RATIO);
+      this->ref_fir_.reset(new i2s_audio_duplex::FirDecimator());
+      this->ref_fir_->init(FIR_RATIO);
+      this->gain_ = audio_kernels::Gain::from_float(BENCH_GAIN);
+      this->dc_.reset();
+      return FRAME_SAMPLES / 2;
+#endif
+#ifdef USE_I2S_DUPLEX_Q15_FIR
+    case BenchKernel::FIR_Q15:
+      this->fir_.reset(new i2s_audio_duplex::FirDecimator());
+      this->fir_->init(FIR_RATIO);
+      return this->fir_->is_q15_enabled() ? FRAME_SAMPLES : 0;  // esp-dsp init failed
+    case BenchKernel::INTERP_Q15:
+      this->interp_.reset(new i2s_audio_duplex::FirInterpolator());
+      this->interp_->init(FIR_RATIO);
+      return this->interp_->is_q15_enabled() ? FRAME_SAMPLES : 0;
+#endif
+#ifdef USE_ESP_AEC
+    case BenchKernel::AEC_SR_LOW_COST:
+    case BenchKernel::AEC_VOIP_LOW_COST: {
+      const aec_mode_t mode =
+          kernel == BenchKernel::AEC_SR_LOW_COST ? AEC_MODE_SR_LOW_COST : AEC_MODE_VOIP_LOW_COST;
+      this->aec_ = aec_create(SAMPLE_RATE, AEC_FILTER_LENGTH, 1, mode);
+      if (this->aec_ == nullptr) {
+        ESP_LOGW(TAG, "%s: aec_create failed", bench_kernel_to_str(kernel));
+        return 0;
+      }
+      const int chunk = aec_get_chunksize(this->aec_);
+      return chunk > 0 && static_cast<size_t>(chunk) <= FRAME_SAMPLES ? static_cast<uint32_t>(chunk) : 0;
+    }
+#endif
+    default:
+      return 0;  // Not compiled into this firmware
+  }
+}
+
+void AudioBenchmark::end_kernel_() {
+  this->accumulator_.reset();
+#ifdef USE_INTERCOM_API
+  this->framing_.reset();
+#endif
+#ifdef USE_I2S_AUDIO_DUPLEX
+  this->fir_.reset();
+  this->ref_fir_.reset();
+  this->interp_.reset();
+#endif
+#ifdef USE_ESP_AEC
+  if (this->aec_ != nullptr) {
+    aec_destroy(this->aec_);
+    this->aec_ = nullptr;
+  }
+#endif
+}
+
+uint32_t AudioBenchmark::run_frame_(BenchKernel kernel) {
+  const size_t n = FRAME_SAMPLES;
+  const uint32_t start = esp_cpu_get_cycle_count();
+  switch (kernel) {
+    case BenchKernel::SCALE_COPY:
+      audio_kernels::scale_copy(this->ref_, this->out_, n, this->gain_);
+      break;
+    case BenchKernel::DC_BLOCK_GAIN:
+      audio_kernels::dc_block_gain(this->ref_, this->out_, n, this->dc_, this->gain_);
+      break;
+    case BenchKernel::DEINTERLEAVE: {
+      static const uint8_t SLOTS[2] = {0, 1};
+      int16_t *const dst[2] = {this->out_, this->out2_};
+      audio_kernels::deinterleave(this->in_, n, 2, SLOTS, dst, 2);
+      break;
+    }
+    case BenchKernel::PEAK_ABS:
+      this->sink_ = audio_kernels::peak_abs(this->ref_, n);
+      break;
+    case BenchKernel::ENERGY_VAD:
+      this->sink_ = this->vad_.process(this->ref_, n) ? 1 : 0;
+      break;
+    case BenchKernel::NOISE_SOURCE:
+      this->noise_.fill(this->out_, n, NOISE_LEVEL_DBFS);
+      break;
+    case BenchKernel::SPSC_RING:
+      this->ring_->write(this->ref_, n * sizeof(int16_t));
+      this->ring_->read(this->out_, n * sizeof(int16_t));
+      break;
+    case BenchKernel::MIX_ADD:
+      // Ramp (the costlier case): full gain down to -15 dB, as when a stream ducks
+      audio_kernels::mix_add(this->ref_, this->out_, n, 32767, 5827);
+      break;
+    case BenchKernel::AEC_ACCUMULATOR:
+      this->sink_ = this->accumulator_->run(this->in_, this->ref_, this->out_, this->out2_);
+      break;
+#ifdef USE_INTERCOM_API
+    case BenchKernel::FRAMING:
+      // A PCM frame: header + 1024 payload bytes through lwIP and back
+      this->sink_ = this->framing_->round_trip(reinterpret_cast<const uint8_t *>(this->ref_), n * sizeof(int16_t));
+      break;
+#endif
+#ifdef USE_I2S_AUDIO_DUPLEX
+    case BenchKernel::FIR_FLOAT:
+      this->fir_->process_float(this->in_, this->out_, n * FIR_RATIO);
+      break;
+    case BenchKernel::INTERP_FLOAT:
+      this->interp_->process_float(this->ref_, this->bus_out_, n);
+      break;
+    case BenchKernel::RX_FUSED: {
+      static const uint8_t SLOTS[2] = {1, 0};  // Mic on the right, reference on the left
+      static const i2s_audio_duplex::RxKernelFn KERNEL =
+          i2s_audio_duplex::select_rx_kernel(false, i2s_audio_duplex::RxLayout::STEREO, true, FIR_RATIO);
+      i2s_audio_duplex::RxKernelJob job;
+      job.src = this->in_;
+      job.out_frames = n / 2;
+      job.ratio = FIR_RATIO;
+      job.slots = SLOTS;
+      job.out[0] = this->out_;
+      job.out[1] = this->out2_;
+      job.fir[0] = this->fir_.get();
+      job.fir[1] = this->ref_fir_.get();
+      job.dc[0] = &this->dc_;
+      job.gain = this->gain_;
+      job.scratch = this->bus_out_;
+      KERNEL(job);
+      break;
+    }
+#endif
+#ifdef USE_I2S_DUPLEX_Q15_FIR
+    case BenchKernel::FIR_Q15:
+      this->fir_->process(this->in_, this->out_, n * FIR_RATIO);
+      break;
+    case BenchKernel::INTERP_Q15:
+      this->interp_->process(this->ref_, this->bus_out_, n);
+      break;
+#endif
+#ifdef USE_ESP_AEC
+    case BenchKernel::AEC_SR_LOW_COST:
+    case BenchKernel::AEC_VOIP_LOW_COST:
+      // Mic = bus-rate samples (same tones, different phase), so the filter has work to do
+      aec_process(this->aec_, this->in_, this->ref_, this->out_);
+      break;
+#endif
+    default:
+      break;
+  }
+  return esp_cpu_get_cycle_count() - start;
+}
+
+void AudioBenchmark::report_() {
+  ESP_LOGI(TAG, "Benchmark results (%u frames per kernel, cycles per frame):", (unsigned) this->frames_);
+  ESP_LOGI(TAG, "  %-18s %7s %9s %9s %9s %7s %9s %7s %6s", "kernel", "samples", "min", "avg", "max", "cyc/smp",
+           "avg us", "budget", "heap");
+  for (size_t i = 0; i < static_cast<size_t>(BenchKernel::COUNT); i++) {
+    const BenchResult &r = this->results_[i];
+    const char *name = bench_kernel_to_str(static_cast<BenchKernel>(i));
+    if (!r.supported) {
+      ESP_LOGI(TAG, "  %-18s (not available)", name);
+      continue;
+    }
+    // Share of the real-time frame this kernel's output covers (32 ms at 512 samples)
+    const float frame_us = static_cast<float>(r.samples) * 1e6f / static_cast<float>(SAMPLE_RATE);
+    ESP_LOGI(TAG, "  %-18s %7u %9u %9u %9u %7u %9.1f %6.2f%% %6d", name, (unsigned) r.samples,
+             (unsigned) r.min_cycles, (unsigned) r.avg_cycles(), (unsigned) r.max_cycles,
+             (unsigned) (r.avg_cycles() / r.samples), r.avg_us(), r.avg_us() * 100.0f / frame_us,
+             (int) r.heap_delta);
+  }
+}
+
+}  // namespace audio_benchmark
+}  // namespace esphome
+
+#endif  // USE_ESP32
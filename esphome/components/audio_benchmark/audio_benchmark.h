@@ -0,0 +1,148 @@
+#pragma once
+
+#include "esphome/core/automation.h"
+#include "esphome/core/component.h"
+
+#ifdef USE_ESP32
+
+#include <cstddef>
+#include <cstdint>
+
+#include <memory>
+
+#include "esphome/components/audio_kernels/audio_kernels.h"
+#include "esphome/components/audio_kernels/spsc_ring.h"
+#include "bench_fixtures.h"
+#ifdef USE_I2S_AUDIO_DUPLEX
+#include "esphome/components/i2s_audio_duplex/i2s_audio_duplex.h"
+#endif
+#ifdef USE_ESP_AEC
+#include <esp_aec.h>
+#endif
+
+namespace esphome {
+namespace audio_benchmark {
+
+// Kernels timed by one run, in run order. Entries whose code is not compiled in
+// (no i2s_audio_duplex, no Q15 FIR, no ESP-SR, no intercom_api) are skipped and logged as such.
+enum class BenchKernel : uint8_t {
+  SCALE_COPY = 0,    // audio_kernels::scale_copy, Q15 gain (mic gain, speaker volume)
+  DC_BLOCK_GAIN,     // audio_kernels::dc_block_gain (intercom mic path, duplex RX path)
+  DEINTERLEAVE,      // audio_kernels::deinterleave, stereo bus frame into mic + reference
+  PEAK_ABS,          // audio_kernels::peak_abs (reference activity)
+  ENERGY_VAD,        // audio_kernels::EnergyVad (DTX)
+  NOISE_SOURCE,      // audio_kernels::NoiseSource (comfort noise)
+  SPSC_RING,         // audio_kernels::SpscRing write + read of one frame
+  MIX_ADD,           // audio_kernels::mix_add, one stream onto the duplex TX mix with a ducking ramp
+  AEC_ACCUMULATOR,   // tx_task_()'s AEC frame accumulator (AecAccumulator): 16 ms chunks in, one AEC frame out
+  FRAMING,           // intercom_api send_frame() + receive_frame() of one AUDIO frame over loopback TCP
+  FIR_FLOAT,         // i2s_audio_duplex FirDecimator, float path, 48 -> 16 kHz
+  FIR_Q15,           // i2s_audio_duplex FirDecimator, esp-dsp Q15 path (USE_I2S_DUPLEX_Q15_FIR)
+  RX_FUSED,          // i2s_audio_duplex fused RX kernel, 48 kHz stereo -> 16 kHz mic (DC block) + reference
+  INTERP_FLOAT,      // i2s_audio_duplex FirInterpolator, float path, 16 -> 48 kHz (speaker_rate: output)
+  INTERP_Q15,        // i2s_audio_duplex FirInterpolator, esp-dsp Q15 phases (USE_I2S_DUPLEX_Q15_FIR)
+  AEC_SR_LOW_COST,   // ESP-SR aec_process(), own instance (not the one the audio task runs)
+  AEC_VOIP_LOW_COST,
+  COUNT,
+};
+
+const char *bench_kernel_to_str(BenchKernel kernel);
+
+struct BenchResult {
+  bool supported{false};
+  uint32_t frames{0};
+  uint32_t samples{0};  // Output samples per frame (interpolators: 16 kHz input samples)
+  uint32_t min_cycles{UINT32_MAX};
+  uint32_t max_cycles{0};
+  uint64_t total_cycles{0};
+  uint64_t total_us{0};
+  int32_t heap_delta{0};  // Free heap lost over the timed frames (0 = no per-frame allocation)
+
+  uint32_t avg_cycles() const { return this->frames > 0 ? static_cast<uint32_t>(this->total_cycles / this->frames) : 0; }
+  float avg_us() const { return this->frames > 0 ? static_cast<float>(this->total_us) / this->frames : 0.0f; }
+};
+
+// On-target micro-benchmarks for the per-frame audio kernels (audio_benchmark.run).
+//
+// Every kernel runs `frames` times over the same synthetic 32 ms frame (speech-like
+// tones plus noise at 16 kHz, 48 kHz for the FIR input) and is timed per frame with
+// the CPU cycle counter, and the free heap is compared across the timed frames to
+// catch per-frame allocations. loop() spends at most BATCH_BUDGET_US per call on it, so
+// the rest of the main loop and the audio tasks keep running; the results are
+// logged when the last kernel is done and stay readable through get_result().
+// Scratch buffers come from internal SRAM for the run and are freed afterwards.
+class AudioBenchmark : public Component {
+ public:
+  static constexpr size_t FRAME_SAMPLES = 512;  // 32 ms at 16 kHz, the intercom chunk
+  static constexpr uint32_t FIR_RATIO = 3;      // 48 kHz bus -> 16 kHz
+  static constexpr uint32_t BATCH_BUDGET_US = 4000;
+
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::LATE; }
+
+  void set_frames(uint32_t frames) { this->frames_ = frames; }
+  void set_run_on_boot(bool run) { this->run_on_boot_ = run; }
+
+  // Start a run; false while one is in progress or when the scratch buffers can't be allocated
+  bool start();
+  bool is_running() const { return this->running_; }
+  const BenchResult &get_result(BenchKernel kernel) const { return this->results_[static_cast<size_t>(kernel)]; }
+
+ protected:
+  bool allocate_();
+  void release_();
+  // Prepare state for one kernel; returns its output samples per frame, 0 when not available
+  uint32_t begin_kernel_(BenchKernel kernel);
+  void end_kernel_();
+  // One timed frame of the current kernel, returns its cycles
+  uint32_t run_frame_(BenchKernel kernel);
+  void report_();
+
+  uint32_t frames_{200};
+  bool run_on_boot_{false};
+  bool running_{false};
+  uint8_t current_{0};
+  bool kernel_active_{false};
+  BenchResult results_[static_cast<size_t>(BenchKernel::COUNT)];
+
+  // Scratch (run only)
+  int16_t *in_{nullptr};   // FRAME_SAMPLES * FIR_RATIO (bus-rate frame, or interleaved stereo)
+  int16_t *ref_{nullptr};  // FRAME_SAMPLES
+  int16_t *out_{nullptr};  // FRAME_SAMPLES
+  int16_t *out2_{nullptr};  // FRAME_SAMPLES (second deinterleave channel)
+  int16_t *bus_out_{nullptr};  // FRAME_SAMPLES * FIR_RATIO (interpolator output, RX kernel scratch)
+  uint8_t *ring_storage_{nullptr};
+  std::unique_ptr<audio_kernels::SpscRing> ring_;
+  std::unique_ptr<AecAccumulator> accumulator_;
+#ifdef USE_INTERCOM_API
+  std::unique_ptr<FramingLoopback> framing_;
+#endif
+
+  // Kernel state (reset per kernel)
+  audio_kernels::Gain gain_;
+  audio_kernels::DcBlocker dc_;
+  audio_kernels::EnergyVad vad_;
+  audio_kernels::NoiseSource noise_;
+#ifdef USE_I2S_AUDIO_DUPLEX
+  std::unique_ptr<i2s_audio_duplex::FirDecimator> fir_;
+  std::unique_ptr<i2s_audio_duplex::FirDecimator> ref_fir_;  // Second channel of RX_FUSED
+  std::unique_ptr<i2s_audio_duplex::FirInterpolator> interp_;
+#endif
+#ifdef USE_ESP_AEC
+  aec_handle_t *aec_{nullptr};  // Own instance, created per kernel (never the one the audio task runs)
+#endif
+  size_t heap_before_{0};
+  volatile int32_t sink_{0};  // Keeps results of side-effect-free kernels alive
+};
+
+template<typename... Ts> class RunAction : public Action<Ts...>, public Parented<AudioBenchmark> {
+ public:
+  void play(const Ts &...x) override { this->parent_->start(); }
+};
+
+}  // namespace audio_benchmark
+}  // namespace esphome
+
+#endif  // USE_ESP32
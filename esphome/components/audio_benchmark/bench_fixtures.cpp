@@ -0,0 +1,111 @@
+#include "bench_fixtures.h"
+
+#ifdef USE_ESP32
+
+#include <algorithm>
+#include <cstring>
+
+#include "esphome/components/audio_kernels/audio_kernels.h"
+#ifdef USE_INTERCOM_API
+#include <fcntl.h>
+#include <lwip/sockets.h>
+#endif
+
+namespace esphome {
+namespace audio_benchmark {
+
+bool AecAccumulator::init(size_t frame_samples, size_t chunk_samples) {
+  if (chunk_samples == 0 || chunk_samples > frame_samples || frame_samples * sizeof(int16_t) > RING_BYTES) {
+    return false;
+  }
+  this->frame_samples_ = frame_samples;
+  this->chunk_samples_ = chunk_samples;
+  this->mic_ring_ = audio_kernels::SpscRing::create(RING_BYTES, false);
+  this->ref_ring_ = audio_kernels::SpscRing::create(RING_BYTES, false);
+  return this->mic_ring_ != nullptr && this->ref_ring_ != nullptr;
+}
+
+void AecAccumulator::reset() {
+  this->mic_ring_->reset();
+  this->ref_ring_->reset();
+}
+
+int32_t AecAccumulator::run(const int16_t *mic, const int16_t *ref, int16_t *mic_out, int16_t *ref_out) {
+  // Producers: the mic callback and the speaker path, one duplex frame at a time
+  for (size_t done = 0; done < this->frame_samples_; done += this->chunk_samples_) {
+    const size_t n = std::min(this->chunk_samples_, this->frame_samples_ - done);
+    this->mic_ring_->write(mic + done, n * sizeof(int16_t));
+    this->ref_ring_->write(ref + done, n * sizeof(int16_t));
+  }
+
+  // Consumer: tx_task_()
+  const size_t frame_bytes = this->frame_samples_ * sizeof(int16_t);
+  if (this->mic_ring_->available() < frame_bytes || this->mic_ring_->read(mic_out, frame_bytes) != frame_bytes) {
+    return -1;
+  }
+  if (this->ref_ring_->available() < frame_bytes) {
+    memset(ref_out, 0, frame_bytes);
+    return 0;
+  }
+  this->ref_ring_->read(ref_out, frame_bytes);
+  return audio_kernels::peak_abs(ref_out, this->frame_samples_);
+}
+
+#ifdef USE_INTERCOM_API
+bool FramingLoopback::open() {
+  this->release();
+
+  // Listener on an ephemeral loopback port; connect() completes against its backlog,
+  // so one task can set up both ends
+  int listener = socket(AF_INET, SOCK_STREAM, 0);
+  if (listener < 0) return false;
+  struct sockaddr_in addr {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = 0;
+  socklen_t addr_len = sizeof(addr);
+  if (bind(listener, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0 || listen(listener, 1) < 0 ||
+      getsockname(listener, reinterpret_cast<struct sockaddr *>(&addr), &addr_len) < 0) {
+    close(listener);
+    return false;
+  }
+
+  this->tx_ = socket(AF_INET, SOCK_STREAM, 0);
+  if (this->tx_ >= 0 && connect(this->tx_, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) == 0) {
+    this->rx_ = accept(listener, nullptr, nullptr);
+  }
+  close(listener);
+  if (this->tx_ < 0 || this->rx_ < 0) {
+    this->release();
+    return false;
+  }
+
+  // As the call sockets: no Nagle, non-blocking on both ends
+  int nodelay = 1;
+  setsockopt(this->tx_, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+  fcntl(this->tx_, F_SETFL, fcntl(this->tx_, F_GETFL, 0) | O_NONBLOCK);
+  fcntl(this->rx_, F_SETFL, fcntl(this->rx_, F_GETFL, 0) | O_NONBLOCK);
+  return true;
+}
+
+void FramingLoopback::release() {
+  if (this->tx_ >= 0) close(this->tx_);
+  if (this->rx_ >= 0) close(this->rx_);
+  this->tx_ = this->rx_ = -1;
+}
+
+bool FramingLoopback::round_trip(const uint8_t *payload, size_t len) {
+  if (intercom_api::send_frame(this->tx_, intercom_api::MessageType::AUDIO, intercom_api::MessageFlags::NONE, payload,
+                               len, false) != intercom_api::FrameSendResult::SENT) {
+    return false;
+  }
+  intercom_api::MessageHeader header;
+  return intercom_api::receive_frame(this->rx_, header, this->rx_buffer_, sizeof(this->rx_buffer_)) &&
+         header.length == len;
+}
+#endif
+
+}  // namespace audio_benchmark
+}  // namespace esphome
+
+#endif  // USE_ESP32
@@ -0,0 +1,73 @@
+#pragma once
+
+#ifdef USE_ESP32
+
+#include <cstddef>
+#include <cstdint>
+
+#include <memory>
+
+#include "esphome/components/audio_kernels/spsc_ring.h"
+#ifdef USE_INTERCOM_API
+#include "esphome/components/intercom_api/intercom_framing.h"
+#endif
+
+namespace esphome {
+namespace audio_benchmark {
+
+// Fixtures for the benchmark kernels that are more than one call: the same code runs in
+// AudioBenchmark on the device and in the host micro-benchmarks (host/), so both time
+// the same sequence.
+
+// tx_task_()'s AEC frame accumulator, aec_process() left out (it is timed on its own):
+// the mic callback writes duplex-sized chunks into the mic ring and the speaker path the
+// reference ring; once the mic ring holds a whole AEC frame, one frame of mic and one of
+// reference come out (silence when the reference ring runs short) and the reference peak
+// decides whether anything is playing (DTX gate).
+class AecAccumulator {
+ public:
+  static constexpr size_t RING_BYTES = 4096;  // intercom_api's mic_buffer_ (TX_BUFFER_SIZE, ~128 ms)
+
+  // Both rings in internal RAM; false when they can't be allocated or chunk > frame
+  bool init(size_t frame_samples, size_t chunk_samples);
+  void reset();
+  size_t frame_samples() const { return this->frame_samples_; }
+
+  // One AEC frame: frame / chunk chunk writes per ring, then the frame pair into mic_out
+  // and ref_out. Returns the reference peak, -1 when the mic ring did not hold a frame.
+  int32_t run(const int16_t *mic, const int16_t *ref, int16_t *mic_out, int16_t *ref_out);
+
+ protected:
+  std::unique_ptr<audio_kernels::SpscRing> mic_ring_;
+  std::unique_ptr<audio_kernels::SpscRing> ref_ring_;
+  size_t frame_samples_{0};
+  size_t chunk_samples_{0};
+};
+
+#ifdef USE_INTERCOM_API
+// A connected TCP pair on the loopback interface: each round_trip() sends one AUDIO
+// frame through intercom_api::send_frame() and reads it back through receive_frame(),
+// both sockets non-blocking as on a call.
+class FramingLoopback {
+ public:
+  ~FramingLoopback() { this->release(); }
+
+  bool open();
+  void release();
+  // False when the frame did not come back whole (or came back different in size)
+  bool round_trip(const uint8_t *payload, size_t len);
+  // The two ends, for callers framing their own messages (host replay driver)
+  int tx_socket() const { return this->tx_; }
+  int rx_socket() const { return this->rx_; }
+
+ protected:
+  int tx_{-1};
+  int rx_{-1};
+  uint8_t rx_buffer_[intercom_api::MAX_MESSAGE_SIZE];
+};
+#endif
+
+}  // namespace audio_benchmark
+}  // namespace esphome
+
+#endif  // USE_ESP32
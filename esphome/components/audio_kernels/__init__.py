@@ -0,0 +1,31 @@
+"""Shared 16-bit PCM kernels (gain, DC block, fused copies), the lock-free
+SPSC audio ring, the AEC reference delay estimator and the AecOwner interface.
+Also the frame_duration validator shared by i2s_audio_duplex and intercom_api.
+
+Header-only; AUTO_LOADed by intercom_api and i2s_audio_duplex so the
+per-frame sample loops live in one place.
+"""
+
+import esphome.config_validation as cv
+
+CODEOWNERS = ["@n-IA-hane"]
+
+# Frame durations every audio stage supports (duplex frame, intercom TX frame, call
+# negotiation), so one frame size can run end to end without rechunking
+FRAME_DURATIONS_MS = (10, 16, 20, 32)
+
+CONFIG_SCHEMA = cv.Schema({})
+
+
+def frame_duration(value):
+    """Validate a frame_duration option: one of FRAME_DURATIONS_MS."""
+    value = cv.positive_time_period_milliseconds(value)
+    if value.total_milliseconds not in FRAME_DURATIONS_MS:
+        raise cv.Invalid(
+            "frame_duration must be one of " + ", ".join(f"{ms}ms" for ms in FRAME_DURATIONS_MS)
+        )
+    return value
+
+
+async def to_code(config):
+    pass
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+
+namespace esphome {
+namespace audio_kernels {
+
+// A component that owns the I2S bus and runs echo cancellation on it (i2s_audio_duplex).
+//
+// It feeds the AecProcessor from its own reference tap (the samples it just wrote to
+// the DAC), so consumers of its microphone already get echo-cancelled frames. Components
+// that only move audio (intercom_api) control the AEC through this interface instead of
+// running a second AecProcessor pass on the same frames.
+class AecOwner {
+ public:
+  virtual ~AecOwner() = default;
+
+  // An AecProcessor is attached (aec_id configured on the owner)
+  virtual bool has_aec() const = 0;
+  virtual void set_aec_enabled(bool enabled) = 0;
+  virtual bool is_aec_enabled() const = 0;
+  // Reference delay the owner currently applies (configured, or the latest estimate)
+  virtual uint32_t get_aec_reference_delay_ms() const = 0;
+  // Duration of the mic frames it hands out: the AEC chunk while an AEC runs, else its
+  // configured frame_duration. Consumers frame their own audio to match.
+  virtual uint32_t get_frame_duration_ms() const = 0;
+};
+
+}  // namespace audio_kernels
+}  // namespace esphome
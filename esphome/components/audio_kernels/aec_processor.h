@@ -5,7 +5,7 @@
 namespace esphome {
 
 /// Abstract interface for acoustic echo cancellation processors.
-/// Implemented by esp_aec::EspAec (single-mic AEC) and esp_afe::EspAfe (full AFE pipeline).
+/// Implemented by esp_aec::EspAec (single-mic AEC) and esp_afe::EspAfe (multi-mic AFE pipeline).
 /// i2s_audio_duplex uses this interface so it works with any AEC backend.
 class AecProcessor {
  public:
@@ -14,8 +14,19 @@ class AecProcessor {
   virtual bool is_initialized() const = 0;
 
   /// Frame size in samples (not bytes). Typically 512 samples = 32ms at 16kHz.
+  /// May change at runtime after a mode switch: consumers re-read it at each frame
+  /// boundary and pass the size they filled to process(). A frame of the previous
+  /// size is still processed by the previous instance until the switch lands.
   virtual int get_frame_size() const = 0;
 
+  /// Largest frame size this processor can switch to at runtime. Consumers size their
+  /// AEC buffers for it once, so a switch never reallocates. Default: get_frame_size().
+  virtual int get_max_frame_size() const { return this->get_frame_size(); }
+
+  /// Consumers report how long the task running the AEC was busy for one frame
+  /// (processing only, blocking I/O excluded) - feeds load-adaptive backends.
+  virtual void report_frame_load(uint32_t busy_us, int frame_size) {}
+
   /// Number of microphone channels this processor expects. Default: 1 (single-mic AEC).
   virtual int get_mic_num() const { return 1; }
 
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include <esp_heap_caps.h>
+
+#include "spsc_ring.h"
+
+namespace esphome {
+namespace audio_kernels {
+
+// Boot-time memory for the audio components (i2s_audio_duplex, intercom_api).
+//
+// During setup() each component lists every buffer it will ever use in an ArenaLayout,
+// sized from its configuration for the largest frame it can reach, and commits the layout
+// to the shared AudioArena once. The arena takes one slab per placement, carves the
+// buffers out of it on CACHE_LINE boundaries and never gives them back: starting and
+// stopping audio, toggling AEC or switching AEC modes reuse the same memory, so the heap
+// shared with Wi-Fi and LVGL is not fragmented by audio after boot.
+//
+// Placement follows how often the DSP touches a buffer:
+//  - HOT: worked on sample by sample several times per frame (AEC in/out, FIR decimator
+//    input, PCM handed to a codec). Internal SRAM; spills to PSRAM only when internal
+//    memory is exhausted.
+//  - BULK: one pass per frame or less (I2S staging, ring storage, pipeline slots, network
+//    frames, jitter slots). PSRAM when the board has it, else internal SRAM.
+enum class ArenaPlacement : uint8_t { HOT = 0, BULK = 1 };
+
+class ArenaLayout {
+ public:
+  static constexpr size_t MAX_ENTRIES = 48;
+
+  // Buffer of `bytes` assigned to `ptr` on commit (zero-filled). bytes == 0 leaves ptr as is.
+  template<typename T> void add(T *&ptr, size_t bytes, ArenaPlacement placement) {
+    this->push_(reinterpret_cast<void **>(&ptr), nullptr, bytes, bytes, placement);
+  }
+  // SpscRing of usable `size` created in `ring` over arena storage on commit
+  void add_ring(std::unique_ptr<SpscRing> &ring, size_t size, ArenaPlacement placement) {
+    this->push_(nullptr, &ring, SpscRing::storage_size(size), size, placement);
+  }
+
+  // Rounded slab size per placement
+  size_t get_bytes(ArenaPlacement placement) const { return this->bytes_[static_cast<uint8_t>(placement)]; }
+  size_t get_bytes() const { return this->bytes_[0] + this->bytes_[1]; }
+  bool overflowed() const { return this->overflow_; }
+
+ protected:
+  friend class AudioArena;
+
+  struct Entry {
+    void **ptr;
+    std::unique_ptr<SpscRing> *ring;
+    size_t bytes;  // Rounded to CACHE_LINE
+    size_t size;   // Ring: usable size
+    ArenaPlacement placement;
+  };
+
+  void push_(void **ptr, std::unique_ptr<SpscRing> *ring, size_t bytes, size_t size, ArenaPlacement placement);
+
+  Entry entries_[MAX_ENTRIES];
+  size_t count_{0};
+  size_t bytes_[2]{};
+  bool overflow_{false};
+};
+
+class AudioArena {
+ public:
+  static constexpr size_t CACHE_LINE = 32;  // ESP32 / ESP32-S3 data cache line (also covers 16-byte SIMD loads)
+  static constexpr size_t MAX_OWNERS = 4;
+
+  // What one component committed, by where the memory actually landed
+  struct Owner {
+    const char *name{nullptr};
+    size_t internal_bytes{0};
+    size_t psram_bytes{0};
+    size_t spilled_bytes{0};  // HOT buffers that did not fit in internal SRAM
+    uint8_t buffers{0};
+  };
+
+  static AudioArena &get() {
+    static AudioArena arena;
+    return arena;
+  }
+
+  // Allocate every buffer in `layout` for `owner` (setup() only). On failure nothing
+  // stays allocated and the layout's pointers are left untouched.
+  bool commit(const char *owner, ArenaLayout &layout) {
+    if (layout.overflowed() || this->owner_count_ >= MAX_OWNERS) return false;
+    Owner &rec = this->owners_[this->owner_count_];
+    rec = Owner{};
+    rec.name = owner;
+
+    uint8_t *slabs[2]{};
+    for (uint8_t p = 0; p < 2; p++) {
+      const size_t bytes = layout.bytes_[p];
+      if (bytes == 0) continue;
+      bool internal = false;
+      slabs[p] = alloc_slab_(bytes, static_cast<ArenaPlacement>(p), internal);
+      if (slabs[p] == nullptr) {
+        if (slabs[0] != nullptr) heap_caps_free(slabs[0]);
+        return false;
+      }
+      memset(slabs[p], 0, bytes);
+      (internal ? rec.internal_bytes : rec.psram_bytes) += bytes;
+      if (!internal && p == static_cast<uint8_t>(ArenaPlacement::HOT)) rec.spilled_bytes += bytes;
+    }
+
+    size_t offset[2]{};
+    for (size_t i = 0; i < layout.count_; i++) {
+      ArenaLayout::Entry &e = layout.entries_[i];
+      const uint8_t p = static_cast<uint8_t>(e.placement);
+      uint8_t *at = slabs[p] + offset[p];
+      offset[p] += e.bytes;
+      if (e.ring != nullptr) {
+        *e.ring = SpscRing::create_in(at, e.size);
+      } else {
+        *e.ptr = at;
+      }
+    }
+    rec.buffers = static_cast<uint8_t>(layout.count_);
+    this->owner_count_++;
+    return true;
+  }
+
+  const Owner *find(const char *owner) const {
+    for (size_t i = 0; i < this->owner_count_; i++) {
+      if (strcmp(this->owners_[i].name, owner) == 0) return &this->owners_[i];
+    }
+    return nullptr;
+  }
+  // Totals over every committed component
+  size_t get_internal_bytes() const {
+    size_t total = 0;
+    for (size_t i = 0; i < this->owner_count_; i++) total += this->owners_[i].internal_bytes;
+    return total;
+  }
+  size_t get_psram_bytes() const {
+    size_t total = 0;
+    for (size_t i = 0; i < this->owner_count_; i++) total += this->owners_[i].psram_bytes;
+    return total;
+  }
+
+ protected:
+  AudioArena() = default;
+
+  static uint8_t *alloc_slab_(size_t bytes, ArenaPlacement placement, bool &internal) {
+    constexpr uint32_t INTERNAL = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+    constexpr uint32_t PSRAM = MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT;
+    const bool psram_first = placement == ArenaPlacement::BULK;
+    void *slab = heap_caps_aligned_alloc(CACHE_LINE, bytes, psram_first ? PSRAM : INTERNAL);
+    internal = !psram_first;
+    if (slab == nullptr) {
+      slab = heap_caps_aligned_alloc(CACHE_LINE, bytes, psram_first ? INTERNAL : PSRAM);
+      internal = psram_first;
+    }
+    return static_cast<uint8_t *>(slab);
+  }
+
+  Owner owners_[MAX_OWNERS];
+  size_t owner_count_{0};
+};
+
+inline void ArenaLayout::push_(void **ptr, std::unique_ptr<SpscRing> *ring, size_t bytes, size_t size,
+                               ArenaPlacement placement) {
+  if (bytes == 0) return;
+  if (this->count_ >= MAX_ENTRIES) {
+    this->overflow_ = true;
+    return;
+  }
+  bytes = (bytes + AudioArena::CACHE_LINE - 1) & ~(AudioArena::CACHE_LINE - 1);
+  this->entries_[this->count_++] = Entry{ptr, ring, bytes, size, placement};
+  this->bytes_[static_cast<uint8_t>(placement)] += bytes;
+}
+
+}  // namespace audio_kernels
+}  // namespace esphome
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace esphome {
+namespace audio_kernels {
+
+// Per-frame 16-bit PCM kernels shared by intercom_api and i2s_audio_duplex.
+//
+// Gains are converted once per call to a Q15-style fixed-point multiplier, so the
+// inner loops are a 16x16->32 multiply, round, shift and saturate (MUL16S + CLAMPS
+// on Xtensa, auto-vectorized elsewhere) with no float conversion per sample.
+// Fused variants do DC block + gain and scale + copy in a single pass over the frame.
+// All kernels accept dst == src (in place).
+
+static inline int16_t saturate16(int32_t v) {
+  if (v > 32767) return 32767;
+  if (v < -32768) return -32768;
+  return static_cast<int16_t>(v);
+}
+
+// Float gain as a 16-bit mantissa and right shift: y = (x * mul + round) >> shift.
+// The shift is as large as the mantissa allows, so gains below 1.0 keep full Q15
+// precision and gains above 1.0 (amplification, up to ~32767x) are still exact to 15 bits.
+struct Gain {
+  int32_t mul{1 << 14};
+  uint8_t shift{14};
+
+  static Gain from_float(float gain) {
+    Gain g;
+    if (!(gain > 0.0f)) {
+      g.mul = 0;
+      g.shift = 0;
+      return g;
+    }
+    uint8_t shift = 15;
+    while (shift > 0 && gain * static_cast<float>(1 << shift) > 32767.0f) shift--;
+    long mul = lroundf(gain * static_cast<float>(1 << shift));
+    g.mul = static_cast<int32_t>(mul > 32767 ? 32767 : mul);
+    g.shift = shift;
+    return g;
+  }
+
+  bool is_unity() const { return this->mul == (1 << this->shift); }
+  int32_t rounding() const { return this->shift > 0 ? (1 << (this->shift - 1)) : 0; }
+  int16_t apply(int32_t sample) const {
+    return saturate16((sample * this->mul + this->rounding()) >> this->shift);
+  }
+};
+
+// dst[i] = sat(src[i] * gain). Unity gain is a memcpy (or nothing, in place).
+static inline void scale_copy(const int16_t *src, int16_t *dst, size_t n, const Gain &gain) {
+  if (gain.is_unity()) {
+    if (dst != src) memcpy(dst, src, n * sizeof(int16_t));
+    return;
+  }
+  const int32_t mul = gain.mul;
+  const int32_t rnd = gain.rounding();
+  const uint8_t shift = gain.shift;
+  for (size_t i = 0; i < n; i++) {
+    dst[i] = saturate16((static_cast<int32_t>(src[i]) * mul + rnd) >> shift);
+  }
+}
+
+static inline void scale_copy(const int16_t *src, int16_t *dst, size_t n, float gain) {
+  if (gain == 1.0f) {
+    if (dst != src) memcpy(dst, src, n * sizeof(int16_t));
+    return;
+  }
+  scale_copy(src, dst, n, Gain::from_float(gain));
+}
+
+// In-place gain (mic gain, speaker volume, reference scaling)
+static inline void apply_gain(int16_t *buf, size_t n, float gain) {
+  if (gain == 1.0f) return;
+  scale_copy(buf, buf, n, Gain::from_float(gain));
+}
+
+// DC-blocking high-pass, ~2.5 Hz at 16 kHz (musicdsp.org DC blocker in Q31:
+// y = x - x[-1] + y[-1] * (1 - 2^-10)). One instance per stream; reset() on a new stream.
+struct DcBlocker {
+  int32_t prev_input{0};
+  int32_t prev_output{0};
+
+  void reset() {
+    this->prev_input = 0;
+    this->prev_output = 0;
+  }
+};
+
+// Fused DC block + gain + saturate: dst[i] = sat(hpf(src[i]) * gain), one pass
+static inline void dc_block_gain(const int16_t *src, int16_t *dst, size_t n, DcBlocker &dc, const Gain &gain) {
+  int32_t prev_in = dc.prev_input;
+  int32_t prev_out = dc.prev_output;
+  const bool unity = gain.is_unity();
+  const int32_t mul = gain.mul;
+  const int32_t rnd = gain.rounding();
+  const uint8_t shift = gain.shift;
+  for (size_t i = 0; i < n; i++) {
+    int32_t input = static_cast<int32_t>(src[i]) * 65536;
+    int32_t output = input - prev_in + prev_out - (prev_out >> 10);
+    prev_in = input;
+    prev_out = output;
+    int32_t y = output >> 16;
+    dst[i] = unity ? saturate16(y) : saturate16((y * mul + rnd) >> shift);
+  }
+  dc.prev_input = prev_in;
+  dc.prev_output = prev_out;
+}
+
+static inline void dc_block_gain(const int16_t *src, int16_t *dst, size_t n, DcBlocker &dc, float gain) {
+  dc_block_gain(src, dst, n, dc, Gain::from_float(gain));
+}
+
+// Largest |sample| of a frame (speaker reference activity checks)
+static inline int32_t peak_abs(const int16_t *src, size_t n) {
+  int32_t peak = 0;
+  for (size_t i = 0; i < n; i++) {
+    const int32_t v = src[i] < 0 ? -static_cast<int32_t>(src[i]) : src[i];
+    if (v > peak) peak = v;
+  }
+  return peak;
+}
+
+// Split interleaved frames into per-channel buffers in one pass over the source:
+// dst[c][i] = src[i * stride + slots[c]] (TDM: every mic slot and the reference at once).
+static inline void deinterleave(const int16_t *src, size_t frames, size_t stride, const uint8_t *slots,
+                                int16_t *const *dst, size_t channels) {
+  for (size_t i = 0; i < frames; i++) {
+    const int16_t *frame = src + i * stride;
+    for (size_t c = 0; c < channels; c++) dst[c][i] = frame[slots[c]];
+  }
+}
+
+// Q15 mixing gain (0 .. 32767 = unity), for mix_add()
+static inline int32_t mix_gain_q15(float gain) {
+  if (!(gain > 0.0f)) return 0;
+  if (gain >= 1.0f) return 32767;
+  return static_cast<int32_t>(lroundf(gain * 32767.0f));
+}
+
+// Saturating mix of one source into a bus: dst[i] = sat(dst[i] + src[i] * gain), the Q15 gain
+// moving linearly from `from` to `to` across the frame, so ducking and volume steps don't
+// click. A steady gain is one multiply-add per sample, unity a plain saturating add.
+static inline void mix_add(const int16_t *src, int16_t *dst, size_t n, int32_t from, int32_t to) {
+  if (n == 0 || (from == 0 && to == 0)) return;
+  if (from == to) {
+    if (to == 32767) {
+      for (size_t i = 0; i < n; i++) dst[i] = saturate16(static_cast<int32_t>(dst[i]) + src[i]);
+      return;
+    }
+    for (size_t i = 0; i < n; i++) {
+      dst[i] = saturate16(static_cast<int32_t>(dst[i]) + ((static_cast<int32_t>(src[i]) * to + (1 << 14)) >> 15));
+    }
+    return;
+  }
+  // Gain in Q15.16 so the per-sample step keeps its fraction over long frames
+  int32_t gain = from * 65536;
+  const int32_t step = (to - from) * 65536 / static_cast<int32_t>(n);
+  for (size_t i = 0; i < n; i++) {
+    gain += step;
+    const int32_t g = gain >> 16;
+    dst[i] = saturate16(static_cast<int32_t>(dst[i]) + ((static_cast<int32_t>(src[i]) * g + (1 << 14)) >> 15));
+  }
+}
+
+// Frame-energy voice activity detector (DTX). The noise floor follows the quietest
+// frames: it drops to a quieter frame at once and rises slowly (FLOOR_RISE_DB_PER_S), so
+// speech pauses pull it back down. A frame is speech when it is SPEECH_SNR_DB above the
+// floor and louder than MIN_SPEECH_DBFS; the decision is held for the hangover so word
+// endings and soft consonants are not cut. One instance per stream; reset() on a new one.
+struct EnergyVad {
+  static constexpr float SPEECH_SNR_DB = 9.0f;
+  static constexpr float MIN_SPEECH_DBFS = -55.0f;
+  static constexpr float FLOOR_RISE_DB_PER_S = 3.0f;
+  static constexpr float SILENCE_DBFS = -96.0f;  // Reported for all-zero frames
+
+  void init(uint32_t sample_rate, uint32_t hangover_ms) {
+    this->sample_rate_ = sample_rate;
+    this->hangover_samples_ = sample_rate * hangover_ms / 1000;
+    this->reset();
+  }
+  void reset() {
+    this->floor_dbfs_ = SILENCE_DBFS;
+    this->hold_ = 0;
+    this->primed_ = false;
+  }
+
+  // True while the stream carries speech (hangover included)
+  bool process(const int16_t *pcm, size_t n) {
+    if (n == 0) return this->hold_ > 0;
+    int64_t energy = 0;
+    for (size_t i = 0; i < n; i++) energy += static_cast<int32_t>(pcm[i]) * pcm[i];
+    float level = SILENCE_DBFS;
+    if (energy > 0) {
+      level = 10.0f * log10f(static_cast<float>(energy) / (static_cast<float>(n) * 32768.0f * 32768.0f));
+      if (level < SILENCE_DBFS) level = SILENCE_DBFS;
+    }
+
+    if (!this->primed_ || level < this->floor_dbfs_) {
+      this->floor_dbfs_ = level;
+      this->primed_ = true;
+    } else {
+      this->floor_dbfs_ += FLOOR_RISE_DB_PER_S * static_cast<float>(n) / static_cast<float>(this->sample_rate_);
+      if (this->floor_dbfs_ > level) this->floor_dbfs_ = level;
+    }
+
+    if (level > MIN_SPEECH_DBFS && level > this->floor_dbfs_ + SPEECH_SNR_DB) {
+      this->hold_ = this->hangover_samples_;
+      return true;
+    }
+    if (this->hold_ == 0) return false;
+    this->hold_ = this->hold_ > n ? this->hold_ - static_cast<uint32_t>(n) : 0;
+    return true;
+  }
+
+  // Current noise floor, dBFS (<= 0)
+  float get_floor_dbfs() const { return this->floor_dbfs_; }
+
+ protected:
+  uint32_t sample_rate_{16000};
+  uint32_t hangover_samples_{0};
+  uint32_t hold_{0};
+  float floor_dbfs_{SILENCE_DBFS};
+  bool primed_{false};
+};
+
+// Comfort noise for DTX gaps: white noise at a given RMS level (xorshift32, flat
+// spectrum, no float per sample). One instance per stream, so its sequence never repeats
+// across frames.
+struct NoiseSource {
+  uint32_t state{0x9E3779B9u};
+
+  // dst[i] = noise with an RMS of level_dbfs (dBFS, <= 0)
+  void fill(int16_t *dst, size_t n, float level_dbfs) {
+    // A full-scale uniform int16 has an RMS of 32768 / sqrt(3)
+    const Gain gain = Gain::from_float(powf(10.0f, level_dbfs / 20.0f) * 1.7320508f);
+    const int32_t mul = gain.mul;
+    const int32_t rnd = gain.rounding();
+    const uint8_t shift = gain.shift;
+    uint32_t x = this->state;
+    for (size_t i = 0; i < n; i++) {
+      x ^= x << 13;
+      x ^= x >> 17;
+      x ^= x << 5;
+      const int32_t r = static_cast<int16_t>(x >> 16);
+      dst[i] = saturate16((r * mul + rnd) >> shift);
+    }
+    this->state = x;
+  }
+};
+
+}  // namespace audio_kernels
+}  // namespace esphome
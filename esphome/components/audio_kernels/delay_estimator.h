@@ -0,0 +1,174 @@
+#pragma once
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace audio_kernels {
+
+// Mic-vs-reference lag estimation for AEC reference alignment.
+//
+// The audio task hands over the mic/reference frame pairs it feeds to the AEC
+// (capture()); they are averaged down DECIMATION x into a short window that starts
+// with the first frame carrying playback. Once full, the owning component's loop()
+// runs a normalized cross-correlation over +-max_lag a few lags per call
+// (compute_step()), so neither the audio task nor the main loop sees a long stall.
+// The result is the lag, in input-rate samples, by which the reference is still
+// early (delay it further) or, when negative, late (advance it). The audio task
+// picks it up with take_result() and pads or trims its reference ring buffer.
+//
+// The state hands the buffers over between threads:
+//   IDLE -> arm() -> CAPTURING (audio task) -> COMPUTING (loop()) -> DONE -> take_result() -> IDLE
+class DelayEstimator {
+ public:
+  static constexpr size_t DECIMATION = 4;           // 16 kHz -> 4 kHz, 0.25 ms resolution
+  static constexpr float MIN_CONFIDENCE = 0.3f;     // Normalized correlation peak to accept a lag
+  static constexpr int32_t MIN_REF_LEVEL = 100;     // Mean |ref| that starts a capture (~-50 dBFS)
+  static constexpr uint8_t MAX_ATTEMPTS = 3;        // Windows tried per arm() before giving up
+
+  enum State : uint8_t { IDLE = 0, CAPTURING, COMPUTING, DONE };
+
+  // window / max_lag in input-rate samples. Allocates (window + 2 * max_lag) / DECIMATION
+  // samples per signal; call before the audio task runs.
+  void init(size_t window_samples, size_t max_lag_samples) {
+    this->window_ = window_samples / DECIMATION;
+    this->max_lag_ = max_lag_samples / DECIMATION;
+    const size_t len = this->window_ + 2 * this->max_lag_;
+    this->mic_.assign(len, 0);
+    this->ref_.assign(len, 0);
+    this->state_.store(IDLE, std::memory_order_relaxed);
+  }
+  bool is_initialized() const { return !this->mic_.empty(); }
+
+  // Start a new estimate (new call/playback session). Ignored while one is in flight.
+  void arm() {
+    if (!this->is_initialized() || this->state_.load(std::memory_order_acquire) != IDLE) return;
+    this->attempts_ = 0;
+    this->restart_capture_();
+    uint8_t expected = IDLE;
+    this->state_.compare_exchange_strong(expected, CAPTURING, std::memory_order_release, std::memory_order_relaxed);
+  }
+
+  // Audio task: one mic/reference frame pair, exactly as passed to the AEC
+  void capture(const int16_t *mic, const int16_t *ref, size_t n) {
+    if (this->state_.load(std::memory_order_acquire) != CAPTURING) return;
+    if (!this->started_) {
+      int64_t level = 0;
+      for (size_t i = 0; i < n; i++) level += ref[i] < 0 ? -ref[i] : ref[i];
+      if (level < static_cast<int64_t>(MIN_REF_LEVEL) * static_cast<int64_t>(n)) return;  // Wait for playback
+      this->started_ = true;
+    }
+    const size_t len = this->mic_.size();
+    for (size_t i = 0; i < n; i++) {
+      this->acc_mic_ += mic[i];
+      this->acc_ref_ += ref[i];
+      if (++this->acc_count_ < DECIMATION) continue;
+      this->mic_[this->fill_] = static_cast<int16_t>(this->acc_mic_ / static_cast<int32_t>(DECIMATION));
+      this->ref_[this->fill_] = static_cast<int16_t>(this->acc_ref_ / static_cast<int32_t>(DECIMATION));
+      this->acc_mic_ = this->acc_ref_ = 0;
+      this->acc_count_ = 0;
+      if (++this->fill_ == len) {
+        this->begin_compute_();
+        this->state_.store(COMPUTING, std::memory_order_release);
+        return;
+      }
+    }
+  }
+
+  // loop(): correlate up to max_lags more lags. Cheap no-op unless a window is waiting.
+  void compute_step(size_t max_lags) {
+    if (this->state_.load(std::memory_order_acquire) != COMPUTING) return;
+    const int32_t last = static_cast<int32_t>(this->max_lag_);
+    const int16_t *mic = this->mic_.data() + this->max_lag_;
+    for (size_t step = 0; step < max_lags && this->next_lag_ <= last; step++, this->next_lag_++) {
+      // mic[k] against ref[k - lag]: a positive lag means the echo trails the reference
+      const int16_t *ref = this->ref_.data() + (this->max_lag_ - this->next_lag_);
+      int64_t dot = 0;
+      int64_t ref_energy = 0;
+      for (size_t k = 0; k < this->window_; k++) {
+        dot += static_cast<int32_t>(mic[k]) * ref[k];
+        ref_energy += static_cast<int32_t>(ref[k]) * ref[k];
+      }
+      if (ref_energy == 0) continue;
+      float ncc = static_cast<float>(dot) /
+                  sqrtf(static_cast<float>(this->mic_energy_) * static_cast<float>(ref_energy));
+      if (ncc < 0.0f) ncc = -ncc;  // Polarity depends on the board wiring
+      if (ncc > this->best_ncc_) {
+        this->best_ncc_ = ncc;
+        this->best_lag_ = this->next_lag_;
+      }
+    }
+    if (this->next_lag_ <= last) return;
+
+    if (this->best_ncc_ >= MIN_CONFIDENCE) {
+      this->result_lag_ = this->best_lag_ * static_cast<int32_t>(DECIMATION);
+      this->result_confidence_ = this->best_ncc_;
+      this->state_.store(DONE, std::memory_order_release);
+    } else if (++this->attempts_ < MAX_ATTEMPTS) {
+      this->restart_capture_();  // No clear echo in this window (quiet speech, low volume): try the next one
+      this->state_.store(CAPTURING, std::memory_order_release);
+    } else {
+      this->result_confidence_ = this->best_ncc_;
+      this->state_.store(IDLE, std::memory_order_release);
+    }
+  }
+
+  // Audio task: the accepted lag (input-rate samples) and its correlation, once
+  bool take_result(int32_t &lag, float &confidence) {
+    if (this->state_.load(std::memory_order_acquire) != DONE) return false;
+    lag = this->result_lag_;
+    confidence = this->result_confidence_;
+    this->state_.store(IDLE, std::memory_order_release);
+    return true;
+  }
+
+  State get_state() const { return static_cast<State>(this->state_.load(std::memory_order_relaxed)); }
+
+ protected:
+  void restart_capture_() {
+    this->fill_ = 0;
+    this->acc_mic_ = this->acc_ref_ = 0;
+    this->acc_count_ = 0;
+    this->started_ = false;
+  }
+
+  void begin_compute_() {
+    const int16_t *mic = this->mic_.data() + this->max_lag_;
+    int64_t energy = 0;
+    for (size_t k = 0; k < this->window_; k++) energy += static_cast<int32_t>(mic[k]) * mic[k];
+    this->mic_energy_ = energy > 0 ? energy : 1;
+    this->next_lag_ = -static_cast<int32_t>(this->max_lag_);
+    this->best_ncc_ = 0.0f;
+    this->best_lag_ = 0;
+  }
+
+  std::vector<int16_t> mic_;
+  std::vector<int16_t> ref_;
+  size_t window_{0};
+  size_t max_lag_{0};
+  std::atomic<uint8_t> state_{IDLE};
+
+  // Capture side (audio task while CAPTURING)
+  size_t fill_{0};
+  int32_t acc_mic_{0};
+  int32_t acc_ref_{0};
+  size_t acc_count_{0};
+  bool started_{false};
+
+  // Compute side (loop() while COMPUTING)
+  int64_t mic_energy_{1};
+  int32_t next_lag_{0};
+  int32_t best_lag_{0};
+  float best_ncc_{0.0f};
+  uint8_t attempts_{0};
+
+  // Result (written before DONE, read after)
+  int32_t result_lag_{0};
+  float result_confidence_{0.0f};
+};
+
+}  // namespace audio_kernels
+}  // namespace esphome
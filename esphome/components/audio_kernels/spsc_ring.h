@@ -0,0 +1,212 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include <esp_heap_caps.h>
+
+namespace esphome {
+namespace audio_kernels {
+
+// Lock-free single-producer / single-consumer byte ring for the per-frame audio hops.
+//
+// Exactly one task writes and one task reads; neither takes a lock or enters a critical
+// section (esphome::RingBuffer wraps xRingbuffer, which spins on every call). Storage is
+// a power of two, so positions are free-running uint32_t counters masked on access and
+// head - tail is the fill level; the usable size stays what was asked for, so a ring
+// used as a playout queue does not grow its latency. head_ and tail_ sit on their own
+// cache lines, so a producer and consumer on different cores don't share one.
+//
+// A full ring drops the newest bytes (write() returns what fitted): the producer never
+// touches bytes the consumer may be reading. write_span()/commit() and read_span()/
+// consume() give in-place access to the contiguous region up to the wrap point.
+//
+// Reference delay handling stays on the consumer side, so a reference ring is re-aligned
+// without a lock against its writer: pad_silence() makes the next n bytes read as zeros
+// (counted by available()), skip() drops bytes, reset() discards everything. reset() may
+// also be called by a third task while the consumer is parked (between calls).
+class SpscRing {
+ public:
+  static constexpr size_t CACHE_LINE = 32;  // ESP32 / ESP32-S3 data cache line
+
+  // Bytes of storage a ring of usable `size` needs (next power of two)
+  static size_t storage_size(size_t size) {
+    if (size == 0) return 0;
+    uint32_t storage = 1;
+    while (storage < size) storage <<= 1;
+    return storage;
+  }
+
+  // Mirrors RingBuffer::create(): PSRAM when available (psram=true), else internal RAM
+  static std::unique_ptr<SpscRing> create(size_t size, bool psram = true) {
+    const size_t storage = storage_size(size);
+    if (storage == 0) return nullptr;
+
+    uint8_t *buf = nullptr;
+    if (psram) buf = static_cast<uint8_t *>(heap_caps_malloc(storage, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+    if (buf == nullptr) buf = static_cast<uint8_t *>(heap_caps_malloc(storage, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+    if (buf == nullptr) return nullptr;
+
+    std::unique_ptr<SpscRing> ring = create_in(buf, size);
+    ring->owns_buf_ = true;
+    return ring;
+  }
+
+  // Ring over caller-owned storage of storage_size(size) bytes (audio arena), not freed here
+  static std::unique_ptr<SpscRing> create_in(uint8_t *storage, size_t size) {
+    if (storage == nullptr || size == 0) return nullptr;
+    std::unique_ptr<SpscRing> ring(new SpscRing());
+    ring->buf_ = storage;
+    ring->mask_ = static_cast<uint32_t>(storage_size(size)) - 1;
+    ring->size_ = static_cast<uint32_t>(size);
+    return ring;
+  }
+
+  ~SpscRing() {
+    if (this->owns_buf_ && this->buf_ != nullptr) heap_caps_free(this->buf_);
+  }
+  SpscRing(const SpscRing &) = delete;
+  SpscRing &operator=(const SpscRing &) = delete;
+
+  size_t size() const { return this->size_; }
+
+  // Consumer: bytes readable, pending silence included. The producer may call it on
+  // rings that never pad silence (wake-up thresholds).
+  size_t available() const {
+    return (this->head_.load(std::memory_order_acquire) - this->tail_.load(std::memory_order_relaxed)) +
+           this->silence_;
+  }
+
+  // Producer: bytes writable
+  size_t free() const {
+    return this->size_ - (this->head_.load(std::memory_order_relaxed) - this->tail_.load(std::memory_order_acquire));
+  }
+
+  // ── Producer ──
+
+  // Copy up to len bytes in; returns what fitted
+  size_t write(const void *data, size_t len) {
+    const uint32_t head = this->head_.load(std::memory_order_relaxed);
+    const uint32_t fill = head - this->tail_.load(std::memory_order_acquire);
+    const size_t n = std::min<size_t>(len, this->size_ - fill);
+    this->copy_in_(head, static_cast<const uint8_t *>(data), n);
+    this->head_.store(head + static_cast<uint32_t>(n), std::memory_order_release);
+    return n;
+  }
+
+  // Contiguous free region at the write position (len = its size, may be < free())
+  uint8_t *write_span(size_t &len) {
+    const uint32_t head = this->head_.load(std::memory_order_relaxed);
+    const uint32_t fill = head - this->tail_.load(std::memory_order_acquire);
+    const uint32_t pos = head & this->mask_;
+    len = std::min<size_t>(this->size_ - fill, this->mask_ + 1 - pos);
+    return this->buf_ + pos;
+  }
+  // Publish len bytes written through write_span()
+  void commit(size_t len) {
+    this->head_.store(this->head_.load(std::memory_order_relaxed) + static_cast<uint32_t>(len),
+                      std::memory_order_release);
+  }
+
+  // Run fn(src, dst, n) over 16-bit samples straight into the ring, one call per
+  // contiguous span (processing in place of a staging copy). Returns samples written.
+  template<typename F> size_t write_samples(const int16_t *src, size_t samples, F &&fn) {
+    size_t done = 0;
+    while (done < samples) {
+      size_t span_bytes;
+      uint8_t *span = this->write_span(span_bytes);
+      const size_t n = std::min(samples - done, span_bytes / sizeof(int16_t));
+      if (n == 0) break;  // Full: the rest is dropped
+      fn(src + done, reinterpret_cast<int16_t *>(span), n);
+      this->commit(n * sizeof(int16_t));
+      done += n;
+    }
+    return done;
+  }
+
+  // ── Consumer ──
+
+  // Copy up to len bytes out (pending silence first); returns bytes read
+  size_t read(void *data, size_t len) {
+    uint8_t *out = static_cast<uint8_t *>(data);
+    size_t done = 0;
+    if (this->silence_ > 0) {
+      done = std::min(len, this->silence_);
+      memset(out, 0, done);
+      this->silence_ -= done;
+    }
+    const uint32_t tail = this->tail_.load(std::memory_order_relaxed);
+    const uint32_t fill = this->head_.load(std::memory_order_acquire) - tail;
+    const size_t n = std::min<size_t>(len - done, fill);
+    this->copy_out_(tail, out + done, n);
+    this->tail_.store(tail + static_cast<uint32_t>(n), std::memory_order_release);
+    return done + n;
+  }
+
+  // Contiguous readable region (ring data only - callers that pad silence use read())
+  const uint8_t *read_span(size_t &len) const {
+    const uint32_t tail = this->tail_.load(std::memory_order_relaxed);
+    const uint32_t fill = this->head_.load(std::memory_order_acquire) - tail;
+    const uint32_t pos = tail & this->mask_;
+    len = std::min<size_t>(fill, this->mask_ + 1 - pos);
+    return this->buf_ + pos;
+  }
+  // Release len bytes obtained through read_span()
+  void consume(size_t len) {
+    this->tail_.store(this->tail_.load(std::memory_order_relaxed) + static_cast<uint32_t>(len),
+                      std::memory_order_release);
+  }
+
+  // Drop up to len bytes (pending silence first) - advances a reference stream
+  size_t skip(size_t len) {
+    size_t done = std::min(len, this->silence_);
+    this->silence_ -= done;
+    const uint32_t tail = this->tail_.load(std::memory_order_relaxed);
+    const uint32_t fill = this->head_.load(std::memory_order_acquire) - tail;
+    const size_t n = std::min<size_t>(len - done, fill);
+    this->tail_.store(tail + static_cast<uint32_t>(n), std::memory_order_release);
+    return done + n;
+  }
+
+  // Delay the stream: the next len bytes read are zeros
+  void pad_silence(size_t len) { this->silence_ += len; }
+
+  // Discard everything readable and any pending silence
+  void reset() {
+    this->silence_ = 0;
+    this->tail_.store(this->head_.load(std::memory_order_acquire), std::memory_order_release);
+  }
+
+ protected:
+  SpscRing() = default;
+
+  void copy_in_(uint32_t pos, const uint8_t *src, size_t n) {
+    const uint32_t at = pos & this->mask_;
+    const size_t first = std::min<size_t>(n, this->mask_ + 1 - at);
+    memcpy(this->buf_ + at, src, first);
+    if (n > first) memcpy(this->buf_, src + first, n - first);
+  }
+  void copy_out_(uint32_t pos, uint8_t *dst, size_t n) const {
+    const uint32_t at = pos & this->mask_;
+    const size_t first = std::min<size_t>(n, this->mask_ + 1 - at);
+    memcpy(dst, this->buf_ + at, first);
+    if (n > first) memcpy(dst + first, this->buf_, n - first);
+  }
+
+  // Fixed after create()
+  uint8_t *buf_{nullptr};
+  uint32_t mask_{0};
+  uint32_t size_{0};
+  bool owns_buf_{false};
+
+  alignas(CACHE_LINE) std::atomic<uint32_t> head_{0};  // Producer-owned
+  alignas(CACHE_LINE) std::atomic<uint32_t> tail_{0};  // Consumer-owned
+  size_t silence_{0};                                  // Consumer-owned
+};
+
+}  // namespace audio_kernels
+}  // namespace esphome
@@ -7,6 +7,7 @@ from esphome.components.esp32 import add_idf_component
 
 CODEOWNERS = ["@n-IA-hane"]
 DEPENDENCIES = ["esp32"]
+AUTO_LOAD = ["audio_kernels"]
 
 # Only available on ESP32-S3 or ESP32-P4 with ESP-SR
 _AEC_SUPPORTED_VARIANTS = ("ESP32S3", "ESP32P4")
@@ -28,6 +29,9 @@ EspAec = esp_aec_ns.class_("EspAec", cg.Component, AecProcessor)
 SetModeAction = esp_aec_ns.class_("SetModeAction", automation.Action)
 
 CONF_FILTER_LENGTH = "filter_length"
+CONF_ADAPTIVE_MODE = "adaptive_mode"
+CONF_MIN_HEADROOM = "min_headroom"
+CONF_RESTORE_HEADROOM = "restore_headroom"
 
 AEC_MODES = {
     "sr_low_cost": 0,      # AEC_MODE_SR_LOW_COST
@@ -36,6 +40,32 @@ AEC_MODES = {
     "voip_high_perf": 4,   # AEC_MODE_VOIP_HIGH_PERF
 }
 
+# aec_get_chunksize() at 16 kHz: consumers size their buffers for the largest reachable one
+AEC_MODE_FRAME_SIZES = {
+    "sr_low_cost": 512,
+    "sr_high_perf": 512,
+    "voip_low_cost": 256,
+    "voip_high_perf": 256,
+}
+MAX_FRAME_SIZE = max(AEC_MODE_FRAME_SIZES.values())
+
+
+def _validate_adaptive_mode(config):
+    if config[CONF_RESTORE_HEADROOM] <= config[CONF_MIN_HEADROOM]:
+        raise cv.Invalid(f"{CONF_RESTORE_HEADROOM} must be above {CONF_MIN_HEADROOM}")
+    return config
+
+
+ADAPTIVE_MODE_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.Optional(CONF_MIN_HEADROOM, default="20%"): cv.percentage,
+            cv.Optional(CONF_RESTORE_HEADROOM, default="50%"): cv.percentage,
+        }
+    ),
+    _validate_adaptive_mode,
+)
+
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -43,6 +73,8 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_SAMPLE_RATE, default=16000): cv.int_range(min=16000, max=16000),
             cv.Optional(CONF_FILTER_LENGTH, default=4): cv.int_range(min=1, max=8),
             cv.Optional(CONF_MODE, default="sr_low_cost"): cv.enum(AEC_MODES, lower=True),
+            # Load governor: sr_low_cost while the audio task runs out of headroom
+            cv.Optional(CONF_ADAPTIVE_MODE): ADAPTIVE_MODE_SCHEMA,
         }
     ).extend(cv.COMPONENT_SCHEMA),
     _validate_esp32_variant,
@@ -56,6 +88,13 @@ async def to_code(config):
     cg.add(var.set_sample_rate(config[CONF_SAMPLE_RATE]))
     cg.add(var.set_filter_length(config[CONF_FILTER_LENGTH]))
     cg.add(var.set_mode(config[CONF_MODE]))
+    cg.add(var.reserve_frame_size(AEC_MODE_FRAME_SIZES[config[CONF_MODE]]))
+
+    if adaptive := config.get(CONF_ADAPTIVE_MODE):
+        cg.add(var.set_adaptive_mode(True))
+        cg.add(var.set_min_headroom(adaptive[CONF_MIN_HEADROOM]))
+        cg.add(var.set_restore_headroom(adaptive[CONF_RESTORE_HEADROOM]))
+        cg.add(var.reserve_frame_size(AEC_MODE_FRAME_SIZES["sr_low_cost"]))
 
     # Add build flag to enable AEC code paths
     cg.add_define("USE_ESP_AEC")
@@ -78,6 +117,11 @@ async def set_mode_action_to_code(config, action_id, template_arg, args):
     var = cg.new_Pvariable(action_id, template_arg)
     parent = await cg.get_variable(config[CONF_ID])
     cg.add(var.set_parent(parent))
+    # Consumers allocate for the largest frame a switch can reach (a lambda can pick any mode)
+    if cg.is_template(config[CONF_MODE]):
+        cg.add(parent.reserve_frame_size(MAX_FRAME_SIZE))
+    else:
+        cg.add(parent.reserve_frame_size(AEC_MODE_FRAME_SIZES[config[CONF_MODE]]))
     templ = await cg.templatable(config[CONF_MODE], args, int)
     cg.add(var.set_mode(templ))
     return var
@@ -4,6 +4,7 @@
 
 #include <cstring>
 
+#include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -11,6 +12,9 @@ namespace esp_aec {
 
 static const char *const TAG = "esp_aec";
 
+static const uint32_t GOVERNOR_WINDOW_MS = 2000;    // Load averaged over this long per decision
+static const uint8_t GOVERNOR_RESTORE_WINDOWS = 3;  // Windows above restore_headroom before going back up
+
 void EspAec::setup() {
   ESP_LOGI(TAG, "Initializing AEC...");
 
@@ -25,15 +29,28 @@ void EspAec::setup() {
   }
 
   this->cached_frame_size_ = aec_get_chunksize(this->handle_);
+  this->frame_size_.store(this->cached_frame_size_, std::memory_order_relaxed);
+  this->active_mode_.store(this->mode_, std::memory_order_relaxed);
+  this->reserve_frame_size(this->cached_frame_size_);
+  this->governor_window_start_ms_ = millis();
   ESP_LOGI(TAG, "AEC initialized: sample_rate=%d, filter_length=%d, frame_size=%d samples (%dms)",
            this->sample_rate_, this->filter_length_, this->cached_frame_size_,
            this->cached_frame_size_ * 1000 / this->sample_rate_);
 }
 
 EspAec::~EspAec() {
-  if (this->handle_ != nullptr) {
-    aec_destroy(this->handle_);
-    this->handle_ = nullptr;
+  for (aec_handle_t **h : {&this->handle_, &this->pending_, &this->retired_}) {
+    if (*h != nullptr) {
+      aec_destroy(*h);
+      *h = nullptr;
+    }
+  }
+}
+
+void EspAec::loop() {
+  this->collect_retired_();
+  if (this->adaptive_) {
+    this->run_governor_();
   }
 }
 
@@ -41,40 +58,153 @@ void EspAec::dump_config() {
   ESP_LOGCONFIG(TAG, "ESP AEC (ESP-SR):");
   ESP_LOGCONFIG(TAG, "  Sample Rate: %d Hz", this->sample_rate_);
   ESP_LOGCONFIG(TAG, "  Filter Length: %d", this->filter_length_);
-  ESP_LOGCONFIG(TAG, "  Frame Size: %d samples", this->get_frame_size());
+  ESP_LOGCONFIG(TAG, "  Mode: %d", (int)this->get_active_mode());
+  ESP_LOGCONFIG(TAG, "  Frame Size: %d samples (max %d)", this->get_frame_size(), this->max_frame_size_);
+  if (this->adaptive_) {
+    ESP_LOGCONFIG(TAG, "  Adaptive Mode: sr_low_cost below %.0f%% headroom, back above %.0f%%",
+                  this->min_headroom_ * 100.0f, this->restore_headroom_ * 100.0f);
+  }
   ESP_LOGCONFIG(TAG, "  Initialized: %s", this->is_initialized() ? "YES" : "NO");
 }
 
 int EspAec::get_frame_size() const {
-  return this->cached_frame_size_;
+  return this->frame_size_.load(std::memory_order_relaxed);
 }
 
 bool EspAec::reinit(aec_mode_t new_mode) {
-  ESP_LOGI(TAG, "Reinitializing AEC: mode %d → %d", (int)this->mode_, (int)new_mode);
+  this->governor_fallback_ = false;  // An explicit choice wins over the governor
+  return this->switch_mode_(new_mode);
+}
+
+bool EspAec::switch_mode_(aec_mode_t new_mode) {
+  if (this->handle_ == nullptr) {
+    ESP_LOGW(TAG, "AEC not initialized, mode %d not applied", (int)new_mode);
+    return false;
+  }
 
-  if (this->handle_ != nullptr) {
-    aec_destroy(this->handle_);
-    this->handle_ = nullptr;
+  if (new_mode == this->get_active_mode()) {
+    // Back to the running mode before a pending switch landed: just drop the pending instance
+    this->lock_();
+    aec_handle_t *stale = this->pending_;
+    this->pending_ = nullptr;
+    this->has_pending_.store(false, std::memory_order_relaxed);
+    this->frame_size_.store(this->cached_frame_size_, std::memory_order_relaxed);
+    this->unlock_();
+    if (stale != nullptr) aec_destroy(stale);
+    this->mode_ = new_mode;
+    return true;
   }
 
-  this->mode_ = new_mode;
-  this->handle_ = aec_create(this->sample_rate_, this->filter_length_, 1, this->mode_);
+  ESP_LOGI(TAG, "Switching AEC mode %d -> %d", (int)this->mode_, (int)new_mode);
 
-  if (this->handle_ == nullptr) {
-    ESP_LOGE(TAG, "Failed to recreate AEC instance");
+  // Built here, off the audio path: aec_create() allocates and can take milliseconds
+  aec_handle_t *handle = aec_create(this->sample_rate_, this->filter_length_, 1, new_mode);
+  if (handle == nullptr) {
+    ESP_LOGE(TAG, "Failed to create AEC instance for mode %d", (int)new_mode);
+    return false;
+  }
+  const int frame_size = aec_get_chunksize(handle);
+  if (frame_size > this->max_frame_size_) {
+    aec_destroy(handle);
+    ESP_LOGE(TAG, "Mode %d needs %d-sample frames, AEC buffers are sized for %d", (int)new_mode, frame_size,
+             this->max_frame_size_);
     return false;
   }
 
-  this->cached_frame_size_ = aec_get_chunksize(this->handle_);
-  ESP_LOGI(TAG, "AEC reinitialized: mode=%d, frame_size=%d samples (%dms)",
-           (int)this->mode_, this->cached_frame_size_,
-           this->cached_frame_size_ * 1000 / this->sample_rate_);
+  this->lock_();
+  aec_handle_t *stale = this->pending_;  // Superseded before it landed
+  this->pending_ = handle;
+  this->pending_frame_size_ = frame_size;
+  this->pending_mode_ = new_mode;
+  this->frame_size_.store(frame_size, std::memory_order_relaxed);
+  this->has_pending_.store(true, std::memory_order_release);
+  this->unlock_();
+  if (stale != nullptr) aec_destroy(stale);
+
+  this->mode_ = new_mode;
+  ESP_LOGI(TAG, "AEC mode %d ready: frame_size=%d samples (%dms), swapped in at the next frame boundary",
+           (int)new_mode, frame_size, frame_size * 1000 / this->sample_rate_);
   return true;
 }
 
+// The instance process() swapped out is destroyed here, never in the audio task
+void EspAec::collect_retired_() {
+  if (!this->has_retired_.load(std::memory_order_acquire))
+    return;
+  this->lock_();
+  aec_handle_t *retired = this->retired_;
+  this->retired_ = nullptr;
+  this->has_retired_.store(false, std::memory_order_relaxed);
+  this->unlock_();
+  if (retired != nullptr) aec_destroy(retired);
+}
+
+void EspAec::report_frame_load(uint32_t busy_us, int frame_size) {
+  if (!this->adaptive_ || frame_size <= 0)
+    return;
+  this->load_busy_us_.fetch_add(busy_us, std::memory_order_relaxed);
+  this->load_budget_us_.fetch_add(static_cast<uint32_t>(static_cast<int64_t>(frame_size) * 1000000 / this->sample_rate_),
+                                  std::memory_order_relaxed);
+}
+
+// Headroom = share of the frame period the audio task was not busy, averaged per window
+void EspAec::run_governor_() {
+  const uint32_t now = millis();
+  if (now - this->governor_window_start_ms_ < GOVERNOR_WINDOW_MS)
+    return;
+  this->governor_window_start_ms_ = now;
+
+  const uint32_t busy = this->load_busy_us_.exchange(0, std::memory_order_relaxed);
+  const uint32_t budget = this->load_budget_us_.exchange(0, std::memory_order_relaxed);
+  if (budget == 0)
+    return;  // AEC idle in this window (no playback, mic stopped)
+  this->headroom_ = 1.0f - static_cast<float>(busy) / static_cast<float>(budget);
+  if (this->has_pending_.load(std::memory_order_relaxed))
+    return;  // Previous switch still landing
+
+  if (!this->governor_fallback_) {
+    if (this->headroom_ < this->min_headroom_ && this->mode_ != AEC_MODE_SR_LOW_COST) {
+      const aec_mode_t restore = this->mode_;
+      ESP_LOGW(TAG, "Audio task headroom %.0f%% < %.0f%%: falling back to sr_low_cost", this->headroom_ * 100.0f,
+               this->min_headroom_ * 100.0f);
+      if (this->switch_mode_(AEC_MODE_SR_LOW_COST)) {
+        this->governor_fallback_ = true;
+        this->governor_restore_mode_ = restore;
+        this->governor_restore_windows_ = 0;
+      }
+    }
+  } else if (this->headroom_ >= this->restore_headroom_) {
+    if (++this->governor_restore_windows_ >= GOVERNOR_RESTORE_WINDOWS) {
+      ESP_LOGI(TAG, "Audio task headroom back to %.0f%%: restoring mode %d", this->headroom_ * 100.0f,
+               (int)this->governor_restore_mode_);
+      if (this->switch_mode_(this->governor_restore_mode_)) {
+        this->governor_fallback_ = false;
+      }
+      this->governor_restore_windows_ = 0;
+    }
+  } else {
+    this->governor_restore_windows_ = 0;
+  }
+}
+
 void EspAec::process(const int16_t *mic_in, const int16_t *ref_in, int16_t *out, int frame_size) {
-  if (this->handle_ == nullptr) {
-    // Passthrough if not initialized
+  // Frame boundary: take a pending instance once the caller fills frames of its size.
+  // Never waits - if loop() holds the lock, the swap happens on a later frame.
+  if (this->has_pending_.load(std::memory_order_acquire) && this->try_lock_()) {
+    if (this->pending_ != nullptr && frame_size == this->pending_frame_size_ && this->retired_ == nullptr) {
+      this->retired_ = this->handle_;
+      this->handle_ = this->pending_;
+      this->cached_frame_size_ = this->pending_frame_size_;
+      this->active_mode_.store(this->pending_mode_, std::memory_order_relaxed);
+      this->pending_ = nullptr;
+      this->has_pending_.store(false, std::memory_order_relaxed);
+      this->has_retired_.store(true, std::memory_order_release);
+    }
+    this->unlock_();
+  }
+
+  if (this->handle_ == nullptr || frame_size != this->cached_frame_size_) {
+    // Passthrough if not initialized, or a frame of neither the old nor the new size
     memcpy(out, mic_in, frame_size * sizeof(int16_t));
     return;
   }
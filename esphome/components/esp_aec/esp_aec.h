@@ -1,6 +1,6 @@
 #pragma once
 
-#include "aec_processor.h"
+#include "esphome/components/audio_kernels/aec_processor.h"
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
 
@@ -8,12 +8,15 @@
 
 #include <esp_aec.h>
 
+#include <atomic>
+
 namespace esphome {
 namespace esp_aec {
 
 class EspAec : public Component, public AecProcessor {
  public:
   void setup() override;
+  void loop() override;
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::PROCESSOR; }
 
@@ -21,25 +24,78 @@ class EspAec : public Component, public AecProcessor {
   void set_sample_rate(int sample_rate) { this->sample_rate_ = sample_rate; }
   void set_filter_length(int filter_length) { this->filter_length_ = filter_length; }
   void set_mode(int mode) { this->mode_ = static_cast<aec_mode_t>(mode); }
+  // Largest frame any reachable mode uses (configured mode, set_mode targets, governor)
+  void reserve_frame_size(int frame_size) {
+    if (frame_size > this->max_frame_size_) this->max_frame_size_ = frame_size;
+  }
+  // Load governor: drop to sr_low_cost below min_headroom, return above restore_headroom
+  void set_adaptive_mode(bool adaptive) { this->adaptive_ = adaptive; }
+  void set_min_headroom(float headroom) { this->min_headroom_ = headroom; }
+  void set_restore_headroom(float headroom) { this->restore_headroom_ = headroom; }
 
   // AecProcessor interface
   bool is_initialized() const override { return this->handle_ != nullptr; }
   int get_frame_size() const override;
+  int get_max_frame_size() const override { return this->max_frame_size_; }
   void process(const int16_t *mic_in, const int16_t *ref_in, int16_t *out, int frame_size) override;
+  void report_frame_load(uint32_t busy_us, int frame_size) override;
 
-  /// Destroy and recreate AEC with a new mode. Returns true on success.
-  /// Caller must stop audio processing before calling this (frame size may change).
+  /// Switch to a new mode without stopping audio. The new instance is built here (main
+  /// loop), then swapped in by the first process() call whose frame size matches it.
+  /// Returns false if it could not be created. A manual switch cancels a governor fallback.
   bool reinit(aec_mode_t new_mode);
   aec_mode_t get_mode() const { return this->mode_; }
+  /// Mode of the instance process() currently runs (lags get_mode() until the swap)
+  aec_mode_t get_active_mode() const {
+    return static_cast<aec_mode_t>(this->active_mode_.load(std::memory_order_relaxed));
+  }
+  /// Share of the frame budget left in the last governor window (negative = overloaded)
+  float get_headroom() const { return this->headroom_; }
 
   ~EspAec() override;
 
  protected:
-  aec_handle_t *handle_{nullptr};
+  bool switch_mode_(aec_mode_t new_mode);
+  void collect_retired_();
+  void run_governor_();
+  // Try-lock around the handle hand-over: process() never waits on it, the main loop
+  // only holds it for a few pointer moves (never across aec_create/aec_destroy)
+  bool try_lock_() { return !this->swap_lock_.test_and_set(std::memory_order_acquire); }
+  void lock_() {
+    while (this->swap_lock_.test_and_set(std::memory_order_acquire)) {
+    }
+  }
+  void unlock_() { this->swap_lock_.clear(std::memory_order_release); }
+
+  aec_handle_t *handle_{nullptr};  // Active instance: only process() touches it after setup()
   int sample_rate_{16000};
   int filter_length_{4};
-  int cached_frame_size_{512};  // Overwritten by aec_get_chunksize() in setup()
-  aec_mode_t mode_{AEC_MODE_SR_LOW_COST};
+  int cached_frame_size_{512};  // Active instance's chunk size (process() side)
+  int max_frame_size_{0};
+  aec_mode_t mode_{AEC_MODE_SR_LOW_COST};  // Requested mode (main loop side)
+  std::atomic<int> active_mode_{AEC_MODE_SR_LOW_COST};
+  std::atomic<int> frame_size_{512};  // What consumers should fill next (pending or active)
+
+  // Hand-over between the main loop and process() (guarded by swap_lock_)
+  std::atomic_flag swap_lock_ = ATOMIC_FLAG_INIT;
+  std::atomic<bool> has_pending_{false};
+  std::atomic<bool> has_retired_{false};
+  aec_handle_t *pending_{nullptr};
+  int pending_frame_size_{0};
+  aec_mode_t pending_mode_{AEC_MODE_SR_LOW_COST};
+  aec_handle_t *retired_{nullptr};
+
+  // Governor (load reports from the audio task, evaluated in loop())
+  bool adaptive_{false};
+  float min_headroom_{0.2f};
+  float restore_headroom_{0.5f};
+  float headroom_{1.0f};
+  std::atomic<uint32_t> load_busy_us_{0};
+  std::atomic<uint32_t> load_budget_us_{0};
+  uint32_t governor_window_start_ms_{0};
+  uint8_t governor_restore_windows_{0};
+  bool governor_fallback_{false};       // Currently in sr_low_cost because of load
+  aec_mode_t governor_restore_mode_{AEC_MODE_SR_LOW_COST};
 };
 
 // Action: esp_aec.set_mode
@@ -0,0 +1,87 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_ID, CONF_MODE, CONF_TYPE
+from esphome.core import CORE
+from esphome.components.esp32 import add_idf_component
+
+CODEOWNERS = ["@n-IA-hane"]
+DEPENDENCIES = ["esp32", "psram"]
+AUTO_LOAD = ["audio_kernels"]
+
+# ESP-SR AFE: same SoCs as esp_aec
+_AFE_SUPPORTED_VARIANTS = ("ESP32S3", "ESP32P4")
+
+
+def _validate_esp32_variant(config):
+    if CORE.is_esp32:
+        import esphome.components.esp32 as esp32
+        variant = esp32.get_esp32_variant()
+        if variant not in _AFE_SUPPORTED_VARIANTS:
+            raise cv.Invalid(
+                f"esp_afe requires {' or '.join(_AFE_SUPPORTED_VARIANTS)}, got {variant}"
+            )
+    return config
+
+
+AecProcessor = cg.esphome_ns.class_("AecProcessor")
+
+esp_afe_ns = cg.esphome_ns.namespace("esp_afe")
+EspAfe = esp_afe_ns.class_("EspAfe", cg.Component, AecProcessor)
+
+CONF_MIC_NUM = "mic_num"
+CONF_AEC = "aec"
+CONF_BEAMFORMING = "beamforming"
+CONF_NOISE_SUPPRESSION = "noise_suppression"
+CONF_AGC = "agc"
+
+AFE_TYPES = {
+    "sr": 0,  # AFE_TYPE_SR: linear AEC + BSS, tuned for speech recognition / wake word
+    "vc": 1,  # AFE_TYPE_VC: voice communication, AEC with residual echo suppression
+}
+
+AFE_MODES = {
+    "low_cost": 0,   # AFE_MODE_LOW_COST
+    "high_perf": 1,  # AFE_MODE_HIGH_PERF
+}
+
+# Upper bound on the AFE feed chunk at 16 kHz (64 ms). The chunk depends on type, mode and
+# ESP-SR release and is only known once setup() builds the AFE, after i2s_audio_duplex has
+# sized its frame buffers (HARDWARE priority), so consumers are sized for this bound instead.
+# setup() fails with an error if the AFE ever asks for more.
+AFE_MAX_FRAME_SIZE = 1024
+
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(EspAfe),
+            cv.Optional(CONF_MIC_NUM, default=2): cv.int_range(min=1, max=4),
+            cv.Optional(CONF_TYPE, default="sr"): cv.enum(AFE_TYPES, lower=True),
+            cv.Optional(CONF_MODE, default="low_cost"): cv.enum(AFE_MODES, lower=True),
+            cv.Optional(CONF_AEC, default=True): cv.boolean,
+            cv.Optional(CONF_BEAMFORMING, default=True): cv.boolean,
+            cv.Optional(CONF_NOISE_SUPPRESSION, default=True): cv.boolean,
+            cv.Optional(CONF_AGC, default=False): cv.boolean,
+        }
+    ).extend(cv.COMPONENT_SCHEMA),
+    _validate_esp32_variant,
+)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    cg.add(var.set_mic_num(config[CONF_MIC_NUM]))
+    cg.add(var.set_type(config[CONF_TYPE]))
+    cg.add(var.set_mode(config[CONF_MODE]))
+    cg.add(var.set_aec_enabled(config[CONF_AEC]))
+    cg.add(var.set_se_enabled(config[CONF_BEAMFORMING]))
+    cg.add(var.set_ns_enabled(config[CONF_NOISE_SUPPRESSION]))
+    cg.add(var.set_agc_enabled(config[CONF_AGC]))
+    cg.add(var.reserve_frame_size(AFE_MAX_FRAME_SIZE))
+
+    # Consumers compile their AEC paths against AecProcessor
+    cg.add_define("USE_ESP_AEC")
+    cg.add_define("USE_ESP_AFE")
+
+    add_idf_component(name="espressif/esp-sr", ref="2.3.0")
@@ -0,0 +1,154 @@
+#include "esp_afe.h"
+
+#ifdef USE_ESP32
+
+#include <cstring>
+#include <string>
+
+#include <esp_afe_sr_models.h>
+#include <esp_heap_caps.h>
+
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace esp_afe {
+
+static const char *const TAG = "esp_afe";
+static const int SAMPLE_RATE = 16000;  // ESP-SR AFE input rate
+
+void EspAfe::setup() {
+  ESP_LOGI(TAG, "Initializing AFE (%d mics)...", this->mic_num_);
+
+  // One 'M' per mic, then the playback reference
+  std::string input_format(static_cast<size_t>(this->mic_num_), 'M');
+  input_format += 'R';
+
+  afe_config_t *config = afe_config_init(input_format.c_str(), nullptr, this->type_, this->mode_);
+  if (config == nullptr) {
+    ESP_LOGE(TAG, "Failed to create AFE config");
+    this->mark_failed();
+    return;
+  }
+  config->aec_init = this->aec_init_;
+  config->se_init = this->se_init_ && this->mic_num_ > 1;  // Beamforming needs two mics or more
+  config->ns_init = this->ns_init_;
+  config->agc_init = this->agc_init_;
+  config->vad_init = false;
+  config->wakenet_init = false;  // micro_wake_word runs on the output instead
+  config->memory_alloc_mode = AFE_MEMORY_ALLOC_MORE_PSRAM;
+
+  this->iface_ = esp_afe_handle_from_config(config);
+  if (this->iface_ != nullptr) {
+    this->data_ = this->iface_->create_from_config(config);
+  }
+  afe_config_free(config);
+  if (this->data_ == nullptr) {
+    ESP_LOGE(TAG, "Failed to create AFE instance");
+    this->mark_failed();
+    return;
+  }
+
+  // Fed and fetched in the same call: both sides must move one frame at a time
+  const int feed_size = this->iface_->get_feed_chunksize(this->data_);
+  const int fetch_size = this->iface_->get_fetch_chunksize(this->data_);
+  if (feed_size <= 0 || feed_size != fetch_size) {
+    ESP_LOGE(TAG, "AFE feed/fetch chunk sizes differ (%d/%d)", feed_size, fetch_size);
+    this->iface_->destroy(this->data_);
+    this->data_ = nullptr;
+    this->mark_failed();
+    return;
+  }
+  if (this->max_frame_size_ > 0 && feed_size > this->max_frame_size_) {
+    // Consumers already sized their buffers for max_frame_size_ and would drop every frame
+    ESP_LOGE(TAG, "AFE feed chunk is %d samples, consumers are sized for %d", feed_size, this->max_frame_size_);
+    this->iface_->destroy(this->data_);
+    this->data_ = nullptr;
+    this->mark_failed();
+    return;
+  }
+  this->frame_size_ = feed_size;
+
+  const size_t feed_bytes = static_cast<size_t>(this->frame_size_) * (this->mic_num_ + 1) * sizeof(int16_t);
+  this->feed_buffer_ = static_cast<int16_t *>(heap_caps_aligned_alloc(16, feed_bytes, MALLOC_CAP_SPIRAM));
+  if (this->feed_buffer_ == nullptr) {
+    this->feed_buffer_ = static_cast<int16_t *>(heap_caps_aligned_alloc(16, feed_bytes, MALLOC_CAP_INTERNAL));
+  }
+  if (this->feed_buffer_ == nullptr) {
+    ESP_LOGE(TAG, "Failed to allocate AFE feed buffer");
+    this->iface_->destroy(this->data_);
+    this->data_ = nullptr;
+    this->mark_failed();
+    return;
+  }
+
+  ESP_LOGI(TAG, "AFE initialized: format=%s, frame_size=%d samples (%dms)", input_format.c_str(),
+           this->frame_size_, this->frame_size_ * 1000 / SAMPLE_RATE);
+}
+
+EspAfe::~EspAfe() {
+  if (this->data_ != nullptr) {
+    this->iface_->destroy(this->data_);
+    this->data_ = nullptr;
+  }
+  if (this->feed_buffer_ != nullptr) {
+    heap_caps_free(this->feed_buffer_);
+    this->feed_buffer_ = nullptr;
+  }
+}
+
+void EspAfe::dump_config() {
+  ESP_LOGCONFIG(TAG, "ESP AFE (ESP-SR):");
+  ESP_LOGCONFIG(TAG, "  Mics: %d", this->mic_num_);
+  ESP_LOGCONFIG(TAG, "  Type: %s, Mode: %s", this->type_ == AFE_TYPE_VC ? "vc" : "sr",
+                this->mode_ == AFE_MODE_HIGH_PERF ? "high_perf" : "low_cost");
+  ESP_LOGCONFIG(TAG, "  AEC: %s, SE: %s, NS: %s, AGC: %s", YESNO(this->aec_init_),
+                YESNO(this->se_init_ && this->mic_num_ > 1), YESNO(this->ns_init_), YESNO(this->agc_init_));
+  ESP_LOGCONFIG(TAG, "  Frame Size: %d samples (max %d)", this->frame_size_, this->get_max_frame_size());
+  ESP_LOGCONFIG(TAG, "  Initialized: %s", this->is_initialized() ? "YES" : "NO");
+  const uint32_t passthrough = this->passthrough_frames_.load(std::memory_order_relaxed);
+  if (passthrough > 0) {
+    ESP_LOGCONFIG(TAG, "  Passthrough Frames: %u", (unsigned)passthrough);
+  }
+}
+
+void EspAfe::process(const int16_t *mic_in, const int16_t *ref_in, int16_t *out, int frame_size) {
+  const int16_t *mics[1] = {mic_in};
+  this->process_multi(mics, 1, ref_in, out, frame_size);
+}
+
+void EspAfe::process_multi(const int16_t *const *mic_channels, int num_mics, const int16_t *ref_in, int16_t *out,
+                           int frame_size) {
+  if (num_mics <= 0)
+    return;
+  if (this->data_ == nullptr || frame_size != this->frame_size_) {
+    memcpy(out, mic_channels[0], frame_size * sizeof(int16_t));
+    return;
+  }
+
+  // Interleave to the input format: mic 0..n-1, then the reference, per sample
+  const int stride = this->mic_num_ + 1;
+  for (int c = 0; c < this->mic_num_; c++) {
+    const int16_t *src = mic_channels[c < num_mics ? c : 0];
+    int16_t *dst = this->feed_buffer_ + c;
+    for (int i = 0; i < frame_size; i++) dst[i * stride] = src[i];
+  }
+  int16_t *ref_dst = this->feed_buffer_ + this->mic_num_;
+  for (int i = 0; i < frame_size; i++) ref_dst[i * stride] = ref_in[i];
+
+  this->iface_->feed(this->data_, this->feed_buffer_);
+
+  // Feed and fetch in step: the frame just fed is ready without waiting
+  afe_fetch_result_t *result = this->iface_->fetch_with_delay(this->data_, 0);
+  if (result == nullptr || result->data == nullptr ||
+      result->data_size < static_cast<int>(frame_size * sizeof(int16_t))) {
+    memcpy(out, mic_channels[0], frame_size * sizeof(int16_t));
+    this->passthrough_frames_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  memcpy(out, result->data, frame_size * sizeof(int16_t));
+}
+
+}  // namespace esp_afe
+}  // namespace esphome
+
+#endif  // USE_ESP32
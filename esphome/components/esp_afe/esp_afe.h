@@ -0,0 +1,77 @@
+#pragma once
+
+#include "esphome/components/audio_kernels/aec_processor.h"
+#include "esphome/core/component.h"
+
+#ifdef USE_ESP32
+
+#include <esp_afe_config.h>
+#include <esp_afe_sr_iface.h>
+
+#include <algorithm>
+#include <atomic>
+
+namespace esphome {
+namespace esp_afe {
+
+// ESP-SR audio front end: AEC + beamforming (SE) + noise suppression over several mics.
+//
+// Runs synchronously in the caller's task: process_multi() interleaves the mic channels
+// and the reference into the AFE's input format ("MM..R"), feeds one chunk and fetches
+// the processed mono frame straight away. With a single mic (or through process()) the
+// first channel is duplicated into the missing ones.
+class EspAfe : public Component, public AecProcessor {
+ public:
+  static constexpr int MAX_MICS = 4;
+
+  void setup() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::PROCESSOR; }
+
+  // Configuration setters (called from Python)
+  void set_mic_num(int mic_num) { this->mic_num_ = mic_num; }
+  void set_type(int type) { this->type_ = static_cast<afe_type_t>(type); }
+  void set_mode(int mode) { this->mode_ = static_cast<afe_mode_t>(mode); }
+  void set_aec_enabled(bool enabled) { this->aec_init_ = enabled; }
+  void set_se_enabled(bool enabled) { this->se_init_ = enabled; }
+  void set_ns_enabled(bool enabled) { this->ns_init_ = enabled; }
+  void set_agc_enabled(bool enabled) { this->agc_init_ = enabled; }
+  // Bound on the feed chunk setup() will find. Consumers that set up before this
+  // component (i2s_audio_duplex at HARDWARE priority) size their buffers from it.
+  void reserve_frame_size(int frame_size) {
+    if (frame_size > this->max_frame_size_) this->max_frame_size_ = frame_size;
+  }
+
+  // AecProcessor interface
+  bool is_initialized() const override { return this->data_ != nullptr; }
+  int get_frame_size() const override { return this->frame_size_; }
+  int get_max_frame_size() const override { return std::max(this->max_frame_size_, this->frame_size_); }
+  int get_mic_num() const override { return this->mic_num_; }
+  void process(const int16_t *mic_in, const int16_t *ref_in, int16_t *out, int frame_size) override;
+  void process_multi(const int16_t *const *mic_channels, int num_mics, const int16_t *ref_in, int16_t *out,
+                     int frame_size) override;
+
+  ~EspAfe() override;
+
+ protected:
+  esp_afe_sr_iface_t *iface_{nullptr};
+  esp_afe_sr_data_t *data_{nullptr};
+  int16_t *feed_buffer_{nullptr};  // One interleaved chunk (mic_num_ + 1 channels)
+  int frame_size_{512};            // Overwritten by get_feed_chunksize() in setup()
+  int max_frame_size_{0};          // reserve_frame_size(): setup() fails if the AFE needs more
+
+  int mic_num_{2};
+  afe_type_t type_{AFE_TYPE_SR};
+  afe_mode_t mode_{AFE_MODE_LOW_COST};
+  bool aec_init_{true};
+  bool se_init_{true};
+  bool ns_init_{true};
+  bool agc_init_{false};
+
+  std::atomic<uint32_t> passthrough_frames_{0};  // No output fetched: mic 1 passed through
+};
+
+}  // namespace esp_afe
+}  // namespace esphome
+
+#endif  // USE_ESP32
@@ -13,7 +13,8 @@ import esphome.config_validation as cv
 import esphome.final_validate as fv
 from esphome import pins
 from esphome.const import CONF_ID, CONF_NUM_CHANNELS, CONF_SAMPLE_RATE
-from esphome.components.esp32 import get_esp32_variant
+from esphome.components.audio_kernels import frame_duration
+from esphome.components.esp32 import add_idf_component, get_esp32_variant
 from esphome.components.esp32.const import (
     VARIANT_ESP32,
     VARIANT_ESP32C3,
@@ -28,7 +29,7 @@ from esphome.components.esp32.const import (
 
 CODEOWNERS = ["@n-IA-hane"]
 DEPENDENCIES = ["esp32"]
-AUTO_LOAD = ["switch", "number"]
+AUTO_LOAD = ["audio_kernels", "switch", "number", "sensor"]
 
 CONF_I2S_LRCLK_PIN = "i2s_lrclk_pin"
 CONF_I2S_BCLK_PIN = "i2s_bclk_pin"
@@ -36,8 +37,11 @@ CONF_I2S_MCLK_PIN = "i2s_mclk_pin"
 CONF_I2S_DIN_PIN = "i2s_din_pin"
 CONF_I2S_DOUT_PIN = "i2s_dout_pin"
 CONF_OUTPUT_SAMPLE_RATE = "output_sample_rate"
+CONF_FRAME_DURATION = "frame_duration"
+CONF_SPEAKER_RATE = "speaker_rate"
 CONF_AEC_ID = "aec_id"
 CONF_AEC_REF_DELAY_MS = "aec_reference_delay_ms"
+CONF_AEC_REF_DELAY_ESTIMATION = "aec_reference_delay_estimation"
 CONF_MIC_ATTENUATION = "mic_attenuation"
 CONF_USE_STEREO_AEC_REF = "use_stereo_aec_reference"
 CONF_REFERENCE_CHANNEL = "reference_channel"
@@ -54,17 +58,22 @@ CONF_USE_TDM_REFERENCE = "use_tdm_reference"
 CONF_TDM_TOTAL_SLOTS = "tdm_total_slots"
 CONF_TDM_MIC_SLOT = "tdm_mic_slot"
 CONF_TDM_REF_SLOT = "tdm_ref_slot"
+CONF_TDM_AUX_MIC_SLOTS = "tdm_aux_mic_slots"
 CONF_I2S_AUDIO_DUPLEX_ID = "i2s_audio_duplex_id"
 CONF_TASK_PRIORITY = "task_priority"
 CONF_TASK_CORE = "task_core"
 CONF_TASK_STACK_SIZE = "task_stack_size"
 CONF_BUFFERS_IN_PSRAM = "buffers_in_psram"
+CONF_AEC_PIPELINE = "aec_pipeline"
+CONF_AEC_TASK_PRIORITY = "aec_task_priority"
+CONF_AEC_TASK_CORE = "aec_task_core"
+CONF_IDLE_SUSPEND = "idle_suspend"
 
 i2s_audio_duplex_ns = cg.esphome_ns.namespace("i2s_audio_duplex")
 I2SAudioDuplex = i2s_audio_duplex_ns.class_("I2SAudioDuplex", cg.Component)
 
-# AecProcessor abstract interface (defined in esp_aec/aec_processor.h)
-# Both esp_aec::EspAec and future esp_afe::EspAfe inherit from this.
+# AecProcessor abstract interface (defined in audio_kernels/aec_processor.h)
+# Both esp_aec::EspAec and esp_afe::EspAfe inherit from this.
 AecProcessor = cg.esphome_ns.class_("AecProcessor")
 
 # I2S port count per SoC variant (from SOC_I2S_NUM in soc_caps.h)
@@ -102,6 +111,14 @@ def _validate_sample_rates(config):
             raise cv.Invalid(
                 f"Decimation ratio {ratio} (={sr}/{osr}) exceeds maximum of 6"
             )
+    if config[CONF_SPEAKER_RATE] == "output" and config.get(CONF_OUTPUT_SAMPLE_RATE) in (
+        None,
+        config[CONF_SAMPLE_RATE],
+    ):
+        raise cv.Invalid(
+            "speaker_rate: output needs an output_sample_rate below sample_rate "
+            "(without decimation the speaker already runs at the output rate)"
+        )
     return config
 
 
@@ -125,7 +142,15 @@ def _validate_tdm_config(config):
                 f"tdm_mic_slot ({mic_slot}) and tdm_ref_slot ({ref_slot}) must differ"
             )
 
-        max_slot = max(mic_slot, ref_slot)
+        aux_slots = config.get(CONF_TDM_AUX_MIC_SLOTS, [])
+        used = [mic_slot, ref_slot] + aux_slots
+        if len(set(used)) != len(used):
+            raise cv.Invalid(
+                f"tdm_aux_mic_slots {aux_slots} must differ from each other, "
+                f"tdm_mic_slot and tdm_ref_slot"
+            )
+
+        max_slot = max(used)
         if total_slots <= max_slot:
             raise cv.Invalid(
                 f"tdm_total_slots ({total_slots}) must be > {max_slot} "
@@ -183,9 +208,22 @@ CONFIG_SCHEMA = cv.All(
         # Output sample rate for mic/AEC/MWW/VA (decimated from bus rate)
         # If omitted, equals sample_rate (no decimation)
         cv.Optional(CONF_OUTPUT_SAMPLE_RATE): cv.int_range(min=8000, max=48000),
+        # Mic/speaker frame without an AEC (with aec_id the AEC chunk sets it).
+        # intercom_api frames its calls to match, so shorter frames cut call latency.
+        cv.Optional(CONF_FRAME_DURATION, default="16ms"): frame_duration,
+        # Rate the speaker platform takes: bus (mixer/resampler upsample to sample_rate) or
+        # output (output_sample_rate audio upsampled by the audio task's polyphase FIR; the
+        # speaker and AEC reference rings shrink by the ratio and the reference needs no decimation)
+        cv.Optional(CONF_SPEAKER_RATE, default="bus"): cv.one_of("bus", "output", lower=True),
+        # Stop I2S DMA after this long without a mic or speaker user (light sleep / DFS can
+        # then run); the next start_mic()/start_speaker() re-enables it. Omit to keep it running.
+        cv.Optional(CONF_IDLE_SUSPEND): cv.positive_time_period_milliseconds,
         cv.Optional(CONF_AEC_ID): cv.use_id(AecProcessor),
         # AEC reference delay: 80ms for separate I2S, 20-40ms for integrated codecs like ES8311
         cv.Optional(CONF_AEC_REF_DELAY_MS, default=80): cv.int_range(min=10, max=200),
+        # Mono reference mode: re-measure the delay (+-64ms around the current one) at the
+        # start of each playback session; aec_reference_delay_ms is then the starting point
+        cv.Optional(CONF_AEC_REF_DELAY_ESTIMATION, default=True): cv.boolean,
         # Pre-AEC mic attenuation: 0.1 = -20dB (for hot mics like ES8311 that overdrive)
         cv.Optional(CONF_MIC_ATTENUATION, default=1.0): cv.float_range(min=0.01, max=1.0),
         # ES8311 digital feedback: RX is stereo with L=DAC(reference), R=ADC(mic)
@@ -198,6 +236,10 @@ CONFIG_SCHEMA = cv.All(
         cv.Optional(CONF_TDM_TOTAL_SLOTS, default=4): cv.int_range(min=2, max=8),
         cv.Optional(CONF_TDM_MIC_SLOT, default=0): cv.int_range(min=0, max=7),
         cv.Optional(CONF_TDM_REF_SLOT, default=1): cv.int_range(min=0, max=7),
+        # More mic slots for a multi-mic AEC backend (esp_afe with mic_num > 1)
+        cv.Optional(CONF_TDM_AUX_MIC_SLOTS, default=[]): cv.All(
+            cv.ensure_list(cv.int_range(min=0, max=7)), cv.Length(max=3)
+        ),
         # Audio task tuning (advanced)
         cv.Optional(CONF_TASK_PRIORITY, default=19): cv.int_range(min=1, max=24),
         cv.Optional(CONF_TASK_CORE, default=0): cv.int_range(min=-1, max=1),
@@ -205,6 +247,10 @@ CONFIG_SCHEMA = cv.All(
         # Use PSRAM for non-DMA audio buffers (saves ~15KB internal RAM).
         # Requires PSRAM. DMA buffers (I2S RX/TX) always use internal RAM.
         cv.Optional(CONF_BUFFERS_IN_PSRAM, default=False): cv.boolean,
+        # Two-stage pipeline: AEC + mic callbacks on a second task, one frame behind I2S
+        cv.Optional(CONF_AEC_PIPELINE, default=False): cv.boolean,
+        cv.Optional(CONF_AEC_TASK_PRIORITY, default=18): cv.int_range(min=1, max=24),
+        cv.Optional(CONF_AEC_TASK_CORE, default=1): cv.int_range(min=-1, max=1),
     }).extend(cv.COMPONENT_SCHEMA),
     _validate_sample_rates,
     _validate_tdm_config,
@@ -243,10 +289,36 @@ def _final_validate(config):
             f"task_core={task_core} not available on {variant} (single-core SoC)"
         )
 
+    if config.get(CONF_AEC_PIPELINE, False):
+        if variant in SINGLE_CORE_VARIANTS:
+            raise cv.Invalid(
+                f"aec_pipeline needs a second core, {variant} is single-core"
+            )
+        if config.get(CONF_AEC_ID) is None:
+            raise cv.Invalid("aec_pipeline requires aec_id")
+        aec_task_core = config.get(CONF_AEC_TASK_CORE, 1)
+        if aec_task_core >= 0 and aec_task_core == task_core:
+            raise cv.Invalid(
+                "aec_task_core must differ from task_core (the pipeline splits the work across both cores)"
+            )
+
     # Cross-component validation: check for AEC conflict with intercom_api
     from esphome.core import CORE
     full_config = CORE.config or {}
 
+    # Multi-mic backend: one TDM slot per mic it expects
+    aec_id = config.get(CONF_AEC_ID)
+    afe_config = full_config.get("esp_afe")
+    if aec_id is not None and isinstance(afe_config, dict) and afe_config.get(CONF_ID) == aec_id:
+        mic_num = afe_config.get("mic_num", 1)
+        if mic_num > 1:
+            mics = 1 + len(config.get(CONF_TDM_AUX_MIC_SLOTS, []))
+            if not use_tdm or mics != mic_num:
+                raise cv.Invalid(
+                    f"esp_afe mic_num={mic_num} needs use_tdm_reference with "
+                    f"{mic_num - 1} tdm_aux_mic_slots (tdm_mic_slot is mic 1), got {mics if use_tdm else 0} mics"
+                )
+
     intercom_configs = full_config.get("intercom_api", [])
     if intercom_configs:
         has_duplex_aec = CONF_AEC_ID in config and config.get(CONF_AEC_ID) is not None
@@ -254,8 +326,8 @@ def _final_validate(config):
             if isinstance(ic, dict) and ic.get("aec_id") is not None and has_duplex_aec:
                 raise cv.Invalid(
                     "Both i2s_audio_duplex and intercom_api have aec_id configured. "
-                    "This causes a race condition on the AEC processor. "
-                    "Use aec_id on only ONE component (i2s_audio_duplex recommended)."
+                    "This runs echo cancellation twice on the same frames. "
+                    "Keep aec_id on i2s_audio_duplex only (intercom_api uses it via aec_owner)."
                 )
 
     return config
@@ -299,9 +371,23 @@ async def to_code(config):
     # Set output sample rate if specified (enables decimation)
     if CONF_OUTPUT_SAMPLE_RATE in config:
         cg.add(var.set_output_sample_rate(config[CONF_OUTPUT_SAMPLE_RATE]))
+        # ESP32-S3: Q15 decimator on esp-dsp's PIE-optimized dsps_fird_s16.
+        # Other variants keep the float FIR (no PIE, and the plain ESP32 FPU is fast enough).
+        if (
+            config[CONF_OUTPUT_SAMPLE_RATE] != config[CONF_SAMPLE_RATE]
+            and get_esp32_variant() == VARIANT_ESP32S3
+        ):
+            add_idf_component(name="espressif/esp-dsp", ref="1.5.2")
+            cg.add_define("USE_I2S_DUPLEX_Q15_FIR")
+
+    cg.add(var.set_frame_duration_ms(config[CONF_FRAME_DURATION]))
+    cg.add(var.set_speaker_output_rate(config[CONF_SPEAKER_RATE] == "output"))
+    if CONF_IDLE_SUSPEND in config:
+        cg.add(var.set_idle_suspend_ms(config[CONF_IDLE_SUSPEND].total_milliseconds))
 
     # Set AEC reference delay (must be set BEFORE set_aec for buffer sizing)
     cg.add(var.set_aec_reference_delay_ms(config[CONF_AEC_REF_DELAY_MS]))
+    cg.add(var.set_aec_reference_delay_estimation(config[CONF_AEC_REF_DELAY_ESTIMATION]))
 
     # Set mic attenuation for hot mics (applied BEFORE AEC)
     cg.add(var.set_mic_attenuation(config[CONF_MIC_ATTENUATION]))
@@ -318,12 +404,17 @@ async def to_code(config):
         cg.add(var.set_tdm_total_slots(config[CONF_TDM_TOTAL_SLOTS]))
         cg.add(var.set_tdm_mic_slot(config[CONF_TDM_MIC_SLOT]))
         cg.add(var.set_tdm_ref_slot(config[CONF_TDM_REF_SLOT]))
+        for slot in config[CONF_TDM_AUX_MIC_SLOTS]:
+            cg.add(var.add_tdm_aux_mic_slot(slot))
 
     # Audio task tuning
     cg.add(var.set_task_priority(config[CONF_TASK_PRIORITY]))
     cg.add(var.set_task_core(config[CONF_TASK_CORE]))
     cg.add(var.set_task_stack_size(config[CONF_TASK_STACK_SIZE]))
     cg.add(var.set_buffers_in_psram(config[CONF_BUFFERS_IN_PSRAM]))
+    cg.add(var.set_aec_pipeline(config[CONF_AEC_PIPELINE]))
+    cg.add(var.set_aec_task_priority(config[CONF_AEC_TASK_PRIORITY]))
+    cg.add(var.set_aec_task_core(config[CONF_AEC_TASK_CORE]))
 
     # Link AEC if configured
     if CONF_AEC_ID in config:
@@ -0,0 +1,100 @@
+#pragma once
+
+#ifdef USE_ESP32
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <esp_timer.h>
+
+namespace esphome {
+namespace i2s_audio_duplex {
+
+// Audio task metrics. Relaxed atomics written by audio_task_ (plus play() for the
+// drop counter), read by DuplexMetricsSensor and dump_metrics(). No logging, no locks.
+
+// Execution time of one audio_task_ stage
+struct StageTimer {
+  std::atomic<uint32_t> last_us{0};
+  std::atomic<uint32_t> peak_us{0};   // Since the last take_peak()
+  std::atomic<uint32_t> total_us{0};  // Wraps - readers diff two snapshots
+  std::atomic<uint32_t> count{0};
+
+  void record(uint32_t us) {
+    this->last_us.store(us, std::memory_order_relaxed);
+    if (us > this->peak_us.load(std::memory_order_relaxed)) {
+      this->peak_us.store(us, std::memory_order_relaxed);
+    }
+    this->total_us.fetch_add(us, std::memory_order_relaxed);
+    this->count.fetch_add(1, std::memory_order_relaxed);
+  }
+  uint32_t take_peak() { return this->peak_us.exchange(0, std::memory_order_relaxed); }
+};
+
+// Times the enclosing scope into a StageTimer
+class ScopedStage {
+ public:
+  explicit ScopedStage(StageTimer &timer) : timer_(timer), start_us_(esp_timer_get_time()) {}
+  ~ScopedStage() { this->timer_.record(static_cast<uint32_t>(esp_timer_get_time() - this->start_us_)); }
+  ScopedStage(const ScopedStage &) = delete;
+  ScopedStage &operator=(const ScopedStage &) = delete;
+
+ protected:
+  StageTimer &timer_;
+  int64_t start_us_;
+};
+
+// Ring buffer fill watermarks in bytes
+struct FillWatermark {
+  std::atomic<uint32_t> high{0};
+  std::atomic<uint32_t> low{UINT32_MAX};
+
+  void sample(size_t fill) {
+    uint32_t f = static_cast<uint32_t>(fill);
+    if (f > this->high.load(std::memory_order_relaxed)) this->high.store(f, std::memory_order_relaxed);
+    if (f < this->low.load(std::memory_order_relaxed)) this->low.store(f, std::memory_order_relaxed);
+  }
+  // Watermarks since the last take(); false if the ring was not sampled in that window
+  bool take(uint32_t &high_out, uint32_t &low_out) {
+    high_out = this->high.exchange(0, std::memory_order_relaxed);
+    low_out = this->low.exchange(UINT32_MAX, std::memory_order_relaxed);
+    return low_out != UINT32_MAX;
+  }
+};
+
+enum class DuplexStage : uint8_t {
+  I2S_READ = 0,  // i2s_channel_read() - mostly waiting on DMA
+  DECIMATE,      // Fused RX kernel: deinterleave, FirDecimator, DC block + attenuation
+  AEC,           // aec_->process()
+  CALLBACKS,     // Raw + post-AEC mic callbacks (MWW, VA, intercom)
+  I2S_WRITE,     // i2s_channel_write() - mostly waiting on DMA
+  COUNT,
+};
+
+enum class DuplexRing : uint8_t {
+  SPEAKER = 0,  // speaker_buffer_ (sampled by the TX path)
+  AEC_REF,      // speaker_ref_buffer_ (sampled before AEC, mono reference mode)
+  COUNT,
+};
+
+struct DuplexMetrics {
+  StageTimer stages[static_cast<size_t>(DuplexStage::COUNT)];
+  FillWatermark rings[static_cast<size_t>(DuplexRing::COUNT)];
+
+  std::atomic<uint32_t> play_dropped_bytes{0};  // play() found speaker_buffer_ full
+  std::atomic<uint32_t> speaker_underruns{0};   // TX frame padded with silence while playing
+  std::atomic<uint32_t> ref_underruns{0};       // AEC ran on a silent reference (ref buffer low)
+  std::atomic<uint32_t> i2s_errors{0};          // i2s_channel_read/write failures
+  std::atomic<uint32_t> pipeline_overruns{0};   // RX frames dropped: aec_task_ still held both slots
+  std::atomic<uint32_t> idle_suspends{0};       // I2S DMA stopped with no mic/speaker user (idle_suspend)
+  StageTimer resume;                            // Wake-up to I2S running again after an idle suspend
+
+  StageTimer &stage(DuplexStage s) { return this->stages[static_cast<size_t>(s)]; }
+  FillWatermark &ring(DuplexRing r) { return this->rings[static_cast<size_t>(r)]; }
+};
+
+}  // namespace i2s_audio_duplex
+}  // namespace esphome
+
+#endif  // USE_ESP32
@@ -0,0 +1,111 @@
+#include "fir_filters.h"
+
+#ifdef USE_I2S_DUPLEX_Q15_FIR
+
+#include <cmath>
+
+namespace esphome {
+namespace i2s_audio_duplex {
+
+// ── Q15 paths (ESP32-S3, esp-dsp) ──
+
+FirDecimator::~FirDecimator() {
+  if (this->q15_ready_) dsps_fird_s16_aexx_free(&this->fir_);
+}
+
+void FirDecimator::init_q15_() {
+  if (this->q15_ready_) {
+    dsps_fird_s16_aexx_free(&this->fir_);
+    this->q15_ready_ = false;
+  }
+  this->q15_enabled_ = false;
+  if (this->ratio_ <= 1) return;
+
+  // Same tap order as FIR_COEFFS (oldest sample first); unity DC gain -> sum ~32768
+  for (size_t t = 0; t < FIR_NUM_TAPS; t++) {
+    long q = lroundf(FIR_COEFFS[t] * 32768.0f);
+    if (q > 32767) q = 32767;
+    if (q < -32768) q = -32768;
+    this->q15_coeffs_[t] = static_cast<int16_t>(q);
+  }
+  memset(this->q15_delay_, 0, sizeof(this->q15_delay_));
+
+  // shift=0: Q15 x Q15 accumulated in 40 bits, rounded back to Q15
+  if (dsps_fird_init_s16(&this->fir_, this->q15_coeffs_, this->q15_delay_, FIR_NUM_TAPS,
+                         static_cast<int16_t>(this->ratio_), 0, 0) != ESP_OK) {
+    return;
+  }
+  this->q15_ready_ = true;
+  this->q15_enabled_ = true;
+}
+
+void FirDecimator::reset_q15_() {
+  if (!this->q15_ready_) return;
+  memset(this->q15_delay_, 0, sizeof(this->q15_delay_));
+  this->fir_.pos = 0;
+  this->fir_.d_pos = 0;
+}
+
+FirInterpolator::~FirInterpolator() { this->free_q15_(); }
+
+void FirInterpolator::free_q15_() {
+  for (uint32_t p = 0; p < this->q15_phases_; p++) dsps_fird_s16_aexx_free(&this->fir_[p]);
+  this->q15_phases_ = 0;
+  this->q15_ready_ = false;
+}
+
+void FirInterpolator::init_q15_() {
+  this->free_q15_();
+  this->q15_enabled_ = false;
+  if (this->ratio_ <= 1) return;
+
+  // esp-dsp takes the oldest tap first: reverse each phase (unused taps stay zero).
+  // Phase gains reach ratio * 0.31, so past ratio 3 they no longer fit in Q15.
+  memset(this->q15_coeffs_, 0, sizeof(this->q15_coeffs_));
+  for (uint32_t p = 0; p < this->ratio_; p++) {
+    for (size_t k = 0; k < this->phase_taps_; k++) {
+      long q = lroundf(this->phase_coeffs_[p][k] * 32768.0f);
+      if (q > 32767 || q < -32768) return;
+      this->q15_coeffs_[p][INTERP_PHASE_TAPS - 1 - k] = static_cast<int16_t>(q);
+    }
+  }
+  memset(this->q15_delay_, 0, sizeof(this->q15_delay_));
+
+  for (uint32_t p = 0; p < this->ratio_; p++) {
+    if (dsps_fird_init_s16(&this->fir_[p], this->q15_coeffs_[p], this->q15_delay_[p], INTERP_PHASE_TAPS, 1, 0, 0) !=
+        ESP_OK) {
+      this->free_q15_();
+      return;
+    }
+    this->q15_phases_ = p + 1;
+  }
+  this->q15_ready_ = true;
+  this->q15_enabled_ = true;
+}
+
+void FirInterpolator::reset_q15_() {
+  if (!this->q15_ready_) return;
+  memset(this->q15_delay_, 0, sizeof(this->q15_delay_));
+  for (uint32_t p = 0; p < this->q15_phases_; p++) {
+    this->fir_[p].pos = 0;
+    this->fir_[p].d_pos = 0;
+  }
+}
+
+void FirInterpolator::process_q15_(const int16_t *in, int16_t *out, size_t in_count) {
+  for (size_t done = 0; done < in_count;) {
+    const size_t n = std::min(Q15_BLOCK, in_count - done);
+    for (uint32_t p = 0; p < this->ratio_; p++) {
+      dsps_fird_s16(&this->fir_[p], in + done, this->q15_out_[p], static_cast<int32_t>(n));
+    }
+    for (size_t i = 0; i < n; i++) {
+      for (uint32_t p = 0; p < this->ratio_; p++) *out++ = this->q15_out_[p][i];
+    }
+    done += n;
+  }
+}
+
+}  // namespace i2s_audio_duplex
+}  // namespace esphome
+
+#endif  // USE_I2S_DUPLEX_Q15_FIR
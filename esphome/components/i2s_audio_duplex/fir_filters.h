@@ -0,0 +1,252 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#ifdef USE_I2S_DUPLEX_Q15_FIR
+#include <dsps_fir.h>
+#endif
+
+namespace esphome {
+namespace i2s_audio_duplex {
+
+// Anti-alias FIR filters between the I2S bus rate and the output rate. Plain C++ without
+// ESP-IDF (esp-dsp only with USE_I2S_DUPLEX_Q15_FIR), so the host harness builds them too.
+
+// FIR coefficients: 32-tap (31 original + 1 zero pad), cutoff=7500Hz, fs=48kHz, Kaiser beta=8.0
+// Unity DC gain, ~35dB stopband attenuation (adequate for speech), symmetric (linear phase)
+// Padded to power-of-2 so modulo can use bitmask (& 0x1F) instead of division
+static constexpr size_t FIR_NUM_TAPS = 32;
+static constexpr float FIR_COEFFS[FIR_NUM_TAPS] = {
+    4.1270231666e-05f, 2.1633893589e-04f, 1.2531119530e-04f, -9.9999988238e-04f,
+    -2.6821920740e-03f, -1.8518117881e-03f, 4.4563387256e-03f, 1.2653483833e-02f,
+    1.0683467077e-02f, -1.0893520506e-02f, -4.0743026823e-02f, -4.2934182572e-02f,
+    1.7799016112e-02f, 1.3755146771e-01f, 2.6031620059e-01f, 3.1252367847e-01f,
+    2.6031620059e-01f, 1.3755146771e-01f, 1.7799016112e-02f, -4.2934182572e-02f,
+    -4.0743026823e-02f, -1.0893520506e-02f, 1.0683467077e-02f, 1.2653483833e-02f,
+    4.4563387256e-03f, -1.8518117881e-03f, -2.6821920740e-03f, -9.9999988238e-04f,
+    1.2531119530e-04f, 2.1633893589e-04f, 4.1270231666e-05f, 0.0f,
+};
+
+// Lightweight FIR decimator: consumes (in_count) samples at high rate,
+// produces (in_count / ratio) samples at low rate.
+// Uses float accumulation for robustness (ESP32-S3 has hardware FPU).
+// When ratio == 1, process() is a simple memcpy (zero overhead for legacy configs).
+//
+// With USE_I2S_DUPLEX_Q15_FIR (ESP32-S3), process() runs a Q15 polyphase path on
+// esp-dsp dsps_fird_s16 instead: only the decimated outputs are computed, with PIE
+// vector MACs over a 16-byte aligned delay line. The float path stays as the
+// reference for the boot self-check (I2SAudioDuplex::check_fir_backend_()).
+class FirDecimator {
+ public:
+#ifdef USE_I2S_DUPLEX_Q15_FIR
+  ~FirDecimator();
+#endif
+
+  void init(uint32_t ratio) {
+    this->ratio_ = ratio;
+#ifdef USE_I2S_DUPLEX_Q15_FIR
+    this->init_q15_();
+#endif
+    this->reset();
+  }
+
+  void reset() {
+    memset(this->delay_line_, 0, sizeof(this->delay_line_));
+    this->delay_pos_ = 0;
+#ifdef USE_I2S_DUPLEX_Q15_FIR
+    this->reset_q15_();
+#endif
+  }
+
+  // Decimate in_count input samples to (in_count / ratio) output samples.
+  // in_count MUST be a multiple of ratio.
+  void process(const int16_t *in, int16_t *out, size_t in_count) {
+    if (this->ratio_ <= 1) {
+      memcpy(out, in, in_count * sizeof(int16_t));
+      return;
+    }
+#ifdef USE_I2S_DUPLEX_Q15_FIR
+    if (this->q15_enabled_) {
+      dsps_fird_s16(&this->fir_, in, out, static_cast<int32_t>(in_count / this->ratio_));
+      return;
+    }
+#endif
+    this->process_float(in, out, in_count);
+  }
+
+  // Float path (all variants; the only path without USE_I2S_DUPLEX_Q15_FIR)
+  void process_float(const int16_t *in, int16_t *out, size_t in_count) {
+    size_t out_count = in_count / this->ratio_;
+    for (size_t o = 0; o < out_count; o++) {
+      // Push ratio_ new samples into the delay line
+      for (uint32_t r = 0; r < this->ratio_; r++) {
+        this->delay_line_[this->delay_pos_] = static_cast<float>(*in++);
+        this->delay_pos_ = (this->delay_pos_ + 1) & (FIR_NUM_TAPS - 1);
+      }
+
+      // Convolve: FIR filter output
+      float acc = 0.0f;
+      uint32_t idx = this->delay_pos_;
+      for (size_t t = 0; t < FIR_NUM_TAPS; t++) {
+        acc += this->delay_line_[idx] * FIR_COEFFS[t];
+        idx = (idx + 1) & (FIR_NUM_TAPS - 1);
+      }
+
+      // Clamp to int16 range
+      if (acc > 32767.0f) acc = 32767.0f;
+      if (acc < -32768.0f) acc = -32768.0f;
+      out[o] = static_cast<int16_t>(acc);
+    }
+  }
+
+#ifdef USE_I2S_DUPLEX_Q15_FIR
+  // False falls back to process_float() (self-check mismatch or esp-dsp init failure)
+  void set_q15_enabled(bool enabled) { this->q15_enabled_ = enabled && this->q15_ready_; }
+  bool is_q15_enabled() const { return this->q15_enabled_; }
+#endif
+
+ private:
+#ifdef USE_I2S_DUPLEX_Q15_FIR
+  void init_q15_();
+  void reset_q15_();
+#endif
+
+  uint32_t ratio_{1};
+  float delay_line_[FIR_NUM_TAPS]{};
+  uint32_t delay_pos_{0};
+
+#ifdef USE_I2S_DUPLEX_Q15_FIR
+  // dsps_fird_s16 on the S3 needs 16-byte aligned coefficients and delay line,
+  // and a tap count divisible by 8 (FIR_NUM_TAPS = 32)
+  alignas(16) int16_t q15_coeffs_[FIR_NUM_TAPS]{};
+  alignas(16) int16_t q15_delay_[FIR_NUM_TAPS]{};
+  fir_s16_t fir_{};
+  bool q15_ready_{false};
+  bool q15_enabled_{false};
+#endif
+};
+
+// Polyphase FIR interpolator, the mirror of FirDecimator: consumes (in_count) samples at
+// low rate, produces (in_count * ratio) samples at high rate. FIR_COEFFS is split into
+// `ratio` phases (gain x ratio for the zero stuffing), so only real input samples are
+// multiplied and no zero-stuffed frame is ever built. Used by the TX path when the speaker
+// rings run at the output rate (speaker_rate: output).
+//
+// With USE_I2S_DUPLEX_Q15_FIR (ESP32-S3), each phase runs on esp-dsp dsps_fird_s16 (decim 1,
+// PIE vector MACs) over blocks of Q15_BLOCK input samples, as long as the phase gains fit in
+// Q15 (ratio <= 3). The float path stays as the reference for the boot self-check
+// (I2SAudioDuplex::check_interpolator_backend_()).
+static constexpr size_t INTERP_PHASE_TAPS = 16;  // ceil(FIR_NUM_TAPS / 2), padded for esp-dsp
+static constexpr uint32_t MAX_INTERP_RATIO = 6;  // Same limit as the decimation ratio
+
+class FirInterpolator {
+ public:
+#ifdef USE_I2S_DUPLEX_Q15_FIR
+  ~FirInterpolator();
+#endif
+
+  void init(uint32_t ratio) {
+    this->ratio_ = std::min<uint32_t>(std::max<uint32_t>(ratio, 1), MAX_INTERP_RATIO);
+    this->phase_taps_ = (FIR_NUM_TAPS + this->ratio_ - 1) / this->ratio_;
+    if (this->phase_taps_ > INTERP_PHASE_TAPS) this->phase_taps_ = INTERP_PHASE_TAPS;
+    // Phase p, tap k weighs the k-th newest input: y[n*ratio + p] = sum_k h[k*ratio + p] * x[n - k]
+    memset(this->phase_coeffs_, 0, sizeof(this->phase_coeffs_));
+    for (uint32_t p = 0; p < this->ratio_; p++) {
+      for (size_t k = 0; k < this->phase_taps_ && k * this->ratio_ + p < FIR_NUM_TAPS; k++) {
+        this->phase_coeffs_[p][k] = FIR_COEFFS[k * this->ratio_ + p] * static_cast<float>(this->ratio_);
+      }
+    }
+#ifdef USE_I2S_DUPLEX_Q15_FIR
+    this->init_q15_();
+#endif
+    this->reset();
+  }
+
+  void reset() {
+    memset(this->delay_line_, 0, sizeof(this->delay_line_));
+    this->delay_pos_ = 0;
+#ifdef USE_I2S_DUPLEX_Q15_FIR
+    this->reset_q15_();
+#endif
+  }
+
+  // Interpolate in_count input samples to (in_count * ratio) output samples
+  void process(const int16_t *in, int16_t *out, size_t in_count) {
+    if (this->ratio_ <= 1) {
+      memcpy(out, in, in_count * sizeof(int16_t));
+      return;
+    }
+#ifdef USE_I2S_DUPLEX_Q15_FIR
+    if (this->q15_enabled_) {
+      this->process_q15_(in, out, in_count);
+      return;
+    }
+#endif
+    this->process_float(in, out, in_count);
+  }
+
+  // Float path (all variants; the only path without USE_I2S_DUPLEX_Q15_FIR)
+  void process_float(const int16_t *in, int16_t *out, size_t in_count) {
+    for (size_t i = 0; i < in_count; i++) {
+      this->delay_line_[this->delay_pos_] = static_cast<float>(in[i]);
+
+      // One output per phase, each a short convolution over the newest inputs
+      for (uint32_t p = 0; p < this->ratio_; p++) {
+        const float *coeffs = this->phase_coeffs_[p];
+        float acc = 0.0f;
+        uint32_t idx = this->delay_pos_;
+        for (size_t k = 0; k < this->phase_taps_; k++) {
+          acc += this->delay_line_[idx] * coeffs[k];
+          idx = (idx - 1) & (INTERP_PHASE_TAPS - 1);
+        }
+
+        // Clamp to int16 range
+        if (acc > 32767.0f) acc = 32767.0f;
+        if (acc < -32768.0f) acc = -32768.0f;
+        *out++ = static_cast<int16_t>(acc);
+      }
+      this->delay_pos_ = (this->delay_pos_ + 1) & (INTERP_PHASE_TAPS - 1);
+    }
+  }
+
+  uint32_t get_ratio() const { return this->ratio_; }
+
+#ifdef USE_I2S_DUPLEX_Q15_FIR
+  // False falls back to process_float() (self-check mismatch, gains past Q15 or esp-dsp init failure)
+  void set_q15_enabled(bool enabled) { this->q15_enabled_ = enabled && this->q15_ready_; }
+  bool is_q15_enabled() const { return this->q15_enabled_; }
+#endif
+
+ private:
+#ifdef USE_I2S_DUPLEX_Q15_FIR
+  void init_q15_();
+  void reset_q15_();
+  void free_q15_();
+  void process_q15_(const int16_t *in, int16_t *out, size_t in_count);
+#endif
+
+  uint32_t ratio_{1};
+  size_t phase_taps_{INTERP_PHASE_TAPS};
+  float phase_coeffs_[MAX_INTERP_RATIO][INTERP_PHASE_TAPS]{};
+  float delay_line_[INTERP_PHASE_TAPS]{};
+  uint32_t delay_pos_{0};
+
+#ifdef USE_I2S_DUPLEX_Q15_FIR
+  // Per phase: a decim-1 dsps_fird_s16 over its own delay line, oldest tap first. The
+  // phase outputs of one block are interleaved from q15_out_ into the high-rate frame.
+  static constexpr size_t Q15_BLOCK = 32;
+  alignas(16) int16_t q15_coeffs_[MAX_INTERP_RATIO][INTERP_PHASE_TAPS]{};
+  alignas(16) int16_t q15_delay_[MAX_INTERP_RATIO][INTERP_PHASE_TAPS]{};
+  alignas(16) int16_t q15_out_[MAX_INTERP_RATIO][Q15_BLOCK]{};
+  fir_s16_t fir_[MAX_INTERP_RATIO]{};
+  uint32_t q15_phases_{0};  // Phases with an initialized fir_ (freed on init / destruction)
+  bool q15_ready_{false};
+  bool q15_enabled_{false};
+#endif
+};
+
+}  // namespace i2s_audio_duplex
+}  // namespace esphome
@@ -0,0 +1,122 @@
+#pragma once
+
+#ifdef USE_ESP32
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace esphome {
+namespace i2s_audio_duplex {
+
+// Single-producer, multi-reader pool of mic frames (one per tap: pre-AEC and post-AEC).
+//
+// audio_task_ publishes each frame once into the next slot; every consumer reads it
+// through its own Reader cursor instead of keeping a private copy. Two kinds of reader:
+//  - Listener (on_frame set): called inline by audio_task_ right after publish() with the
+//    slot itself, so microphone::Microphone consumers get a std::vector without a copy.
+//    Same real-time rules as MicDataCallback.
+//  - Polled (on_frame empty): notified (notify_task) after each publish and drains with
+//    read() from its own task. A reader that falls more than depth - 1 frames behind is
+//    moved forward to the oldest live frame and its overruns counter grows; nobody waits
+//    for it and nobody copies on its behalf.
+class FramePool {
+ public:
+  struct Reader {
+    std::function<void(const std::vector<uint8_t> &)> on_frame;
+    TaskHandle_t notify_task{nullptr};
+    uint32_t cursor{0};                  // Sequence number of the next frame to read
+    std::atomic<uint32_t> overruns{0};   // Frames skipped because this reader lagged
+  };
+
+  // Registration happens in setup(), before the audio task runs
+  void add_reader(Reader *reader) { this->readers_.push_back(reader); }
+  bool has_readers() const { return !this->readers_.empty(); }
+  bool has_polled_readers() const {
+    for (const Reader *r : this->readers_) {
+      if (!r->on_frame) return true;
+    }
+    return false;
+  }
+
+  // Called at audio task start. Listener-only pools need a single slot; polled readers
+  // get `depth` slots of slack. Storage is only reallocated when the frame size changes.
+  void init(size_t depth, size_t frame_bytes) {
+    if (depth < 1) depth = 1;
+    if (this->slots_.size() != depth || this->frame_bytes_ != frame_bytes) {
+      this->slots_.assign(depth, std::vector<uint8_t>());
+      for (auto &slot : this->slots_) slot.reserve(frame_bytes);
+      this->silence_.assign(frame_bytes, 0);
+      this->frame_bytes_ = frame_bytes;
+    }
+    uint32_t head = this->head_.load(std::memory_order_relaxed);
+    for (Reader *r : this->readers_) r->cursor = head;
+  }
+
+  // Producer (audio_task_): copy one frame into the next slot, make it visible, deliver
+  void publish(const uint8_t *data, size_t len) {
+    if (this->slots_.empty()) return;
+    if (len > this->frame_bytes_) len = this->frame_bytes_;
+    uint32_t head = this->head_.load(std::memory_order_relaxed);
+    std::vector<uint8_t> &slot = this->slots_[head % this->slots_.size()];
+    slot.assign(data, data + len);  // Within reserved capacity: no allocation
+    this->head_.store(head + 1, std::memory_order_release);
+
+    for (Reader *r : this->readers_) {
+      if (r->on_frame) {
+        r->cursor = head + 1;
+        r->on_frame(slot);
+      } else if (r->notify_task != nullptr) {
+        xTaskNotifyGive(r->notify_task);
+      }
+    }
+  }
+
+  // Polled reader: next unread frame, or nullptr when caught up. The frame stays valid
+  // until still_valid() turns false (the producer wrapped around onto it).
+  const std::vector<uint8_t> *read(Reader &reader) {
+    if (this->slots_.empty()) return nullptr;
+    uint32_t head = this->head_.load(std::memory_order_acquire);
+    if (head == reader.cursor) return nullptr;
+    const uint32_t live = static_cast<uint32_t>(this->slots_.size()) - 1;  // Slot at head is being written
+    uint32_t lag = head - reader.cursor;
+    if (lag > live) {
+      reader.overruns.fetch_add(lag - live, std::memory_order_relaxed);
+      this->overruns_.fetch_add(lag - live, std::memory_order_relaxed);
+      reader.cursor = head - live;
+      if (live == 0) return nullptr;
+    }
+    return &this->slots_[reader.cursor++ % this->slots_.size()];
+  }
+
+  // After consuming the frame returned by the last read(): false if it was overwritten meanwhile
+  bool still_valid(const Reader &reader) const {
+    uint32_t head = this->head_.load(std::memory_order_acquire);
+    return head - (reader.cursor - 1) < this->slots_.size();
+  }
+
+  // Zero frame of the current frame size (muted microphones)
+  const std::vector<uint8_t> &silence() const { return this->silence_; }
+
+  uint32_t get_published() const { return this->head_.load(std::memory_order_relaxed); }
+  uint32_t get_overruns() const { return this->overruns_.load(std::memory_order_relaxed); }
+  size_t get_depth() const { return this->slots_.size(); }
+
+ protected:
+  std::vector<Reader *> readers_;
+  std::vector<std::vector<uint8_t>> slots_;
+  std::vector<uint8_t> silence_;
+  size_t frame_bytes_{0};
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> overruns_{0};
+};
+
+}  // namespace i2s_audio_duplex
+}  // namespace esphome
+
+#endif  // USE_ESP32
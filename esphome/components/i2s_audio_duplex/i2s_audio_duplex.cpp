@@ -9,9 +9,16 @@
 #include "esphome/core/log.h"
 
 #ifdef USE_ESP_AEC
-#include "../esp_aec/aec_processor.h"
+#include "esphome/components/audio_kernels/aec_processor.h"
+#endif
+
+#ifdef USE_I2S_DUPLEX_Q15_FIR
+#include <esp_cpu.h>
+#include <esp_heap_caps.h>
+
+#include <cmath>
+#include <cstdlib>
 #endif
-#include "audio_utils.h"
 
 namespace esphome {
 namespace i2s_audio_duplex {
@@ -55,12 +62,176 @@ static i2s_tdm_slot_config_t get_tdm_slot_config(uint8_t fmt, i2s_data_bit_width
 // Audio parameters
 static const size_t DMA_BUFFER_COUNT = 8;
 static const size_t DMA_BUFFER_SIZE = 512;
-static const size_t DEFAULT_FRAME_SIZE = 256;  // samples per frame at output rate (used when no AEC)
+static const size_t DEFAULT_FRAME_SIZE = 256;  // samples per frame at output rate (FIR self-check)
 static const size_t SPEAKER_BUFFER_BASE = 8192; // base speaker buffer, scaled by decimation_ratio_
 
 // I2S new driver uses milliseconds directly, NOT FreeRTOS ticks
 static const uint32_t I2S_IO_TIMEOUT_MS = 50;
 
+// Mic frame pool slack for polled readers (frames, ~128ms at 16ms frames).
+// Listener-only taps need one slot: listeners consume inline before the next publish.
+static const size_t FRAME_POOL_POLLED_DEPTH = 8;
+
+// AEC reference delay estimation (mono reference mode): a 256ms correlation window,
+// +-64ms around the current delay, 16 lags per loop() (~1ms of the main loop each)
+static const uint32_t AEC_DELAY_WINDOW_MS = 256;
+static const uint32_t AEC_DELAY_SEARCH_MS = 64;
+static const size_t AEC_DELAY_LAGS_PER_LOOP = 16;
+
+#ifdef USE_I2S_DUPLEX_Q15_FIR
+// ── Q15 FIR self-checks (ESP32-S3, esp-dsp) ──
+
+// Self-check tolerance: Q15 coefficient rounding costs a few LSB at most,
+// a broken kernel (wrong length, tap order, alignment) is off by thousands
+static constexpr int32_t FIR_Q15_MAX_ERROR_LSB = 16;
+
+// Run one output frame through the Q15 and float paths on the same input and compare.
+// Keeps the Q15 path only if it matches; the cycle counts are reported in dump_config().
+void I2SAudioDuplex::check_fir_backend_() {
+  const size_t out_count = DEFAULT_FRAME_SIZE;
+  const size_t in_count = out_count * this->decimation_ratio_;
+
+  int16_t *in = static_cast<int16_t *>(heap_caps_aligned_alloc(16, in_count * sizeof(int16_t), MALLOC_CAP_INTERNAL));
+  int16_t *out_q15 = static_cast<int16_t *>(heap_caps_aligned_alloc(16, out_count * sizeof(int16_t), MALLOC_CAP_INTERNAL));
+  int16_t *out_float = static_cast<int16_t *>(heap_caps_malloc(out_count * sizeof(int16_t), MALLOC_CAP_INTERNAL));
+  bool ok = in != nullptr && out_q15 != nullptr && out_float != nullptr;
+
+  if (ok) {
+    FirDecimator q15;
+    FirDecimator ref;
+    q15.init(this->decimation_ratio_);
+    ref.init(this->decimation_ratio_);
+    ok = q15.is_q15_enabled();
+
+    // Passband tone + tone in the transition band, near -6 dBFS combined
+    const float w1 = 2.0f * static_cast<float>(M_PI) * 1000.0f / static_cast<float>(this->sample_rate_);
+    const float w2 = 2.0f * static_cast<float>(M_PI) * 7000.0f / static_cast<float>(this->sample_rate_);
+    uint32_t best_q15 = UINT32_MAX;
+    uint32_t best_float = UINT32_MAX;
+    int32_t max_error = 0;
+    size_t n = 0;
+
+    // Several frames so the delay lines carry across process() calls; keep the fastest run
+    for (int frame = 0; ok && frame < 4; frame++) {
+      for (size_t i = 0; i < in_count; i++, n++) {
+        in[i] = static_cast<int16_t>(10000.0f * sinf(w1 * n) + 6000.0f * sinf(w2 * n));
+      }
+
+      uint32_t start = esp_cpu_get_cycle_count();
+      q15.process(in, out_q15, in_count);
+      uint32_t q15_cycles = esp_cpu_get_cycle_count() - start;
+
+      start = esp_cpu_get_cycle_count();
+      ref.process_float(in, out_float, in_count);
+      uint32_t float_cycles = esp_cpu_get_cycle_count() - start;
+
+      if (q15_cycles < best_q15) best_q15 = q15_cycles;
+      if (float_cycles < best_float) best_float = float_cycles;
+      for (size_t i = 0; i < out_count; i++) {
+        int32_t err = std::abs(static_cast<int32_t>(out_q15[i]) - static_cast<int32_t>(out_float[i]));
+        if (err > max_error) max_error = err;
+      }
+    }
+
+    if (ok) {
+      this->fir_q15_cycles_ = best_q15;
+      this->fir_float_cycles_ = best_float;
+      this->fir_q15_max_error_ = max_error;
+      ok = max_error <= FIR_Q15_MAX_ERROR_LSB;
+    }
+  }
+
+  heap_caps_free(in);
+  heap_caps_free(out_q15);
+  heap_caps_free(out_float);
+
+  if (ok) {
+    ESP_LOGD(TAG, "FIR decimator: Q15 %u cycles vs float %u cycles per %u-sample frame (max error %d LSB)",
+             (unsigned)this->fir_q15_cycles_, (unsigned)this->fir_float_cycles_, (unsigned)out_count,
+             (int)this->fir_q15_max_error_);
+  } else {
+    ESP_LOGW(TAG, "FIR decimator: Q15 self-check failed (max error %d LSB), using float path",
+             (int)this->fir_q15_max_error_);
+  }
+  this->mic_decimator_.set_q15_enabled(ok);
+  this->ref_decimator_.set_q15_enabled(ok);
+  this->play_ref_decimator_.set_q15_enabled(ok);
+  for (auto &dec : this->aux_mic_decimators_) dec.set_q15_enabled(ok);
+}
+
+// Same check for the TX interpolator (speaker_rate: output): one output-rate frame through
+// the Q15 and float phases, Q15 kept only if it matches.
+void I2SAudioDuplex::check_interpolator_backend_() {
+  const size_t in_count = DEFAULT_FRAME_SIZE;
+  const size_t out_count = in_count * this->decimation_ratio_;
+
+  int16_t *in = static_cast<int16_t *>(heap_caps_aligned_alloc(16, in_count * sizeof(int16_t), MALLOC_CAP_INTERNAL));
+  int16_t *out_q15 = static_cast<int16_t *>(heap_caps_aligned_alloc(16, out_count * sizeof(int16_t), MALLOC_CAP_INTERNAL));
+  int16_t *out_float = static_cast<int16_t *>(heap_caps_malloc(out_count * sizeof(int16_t), MALLOC_CAP_INTERNAL));
+  bool ok = in != nullptr && out_q15 != nullptr && out_float != nullptr;
+  bool supported = false;
+
+  if (ok) {
+    FirInterpolator q15;
+    FirInterpolator ref;
+    q15.init(this->decimation_ratio_);
+    ref.init(this->decimation_ratio_);
+    supported = ok = q15.is_q15_enabled();
+
+    // Same passband + transition band tones, at the output rate
+    const float out_rate = static_cast<float>(this->get_output_sample_rate());
+    const float w1 = 2.0f * static_cast<float>(M_PI) * 1000.0f / out_rate;
+    const float w2 = 2.0f * static_cast<float>(M_PI) * 7000.0f / out_rate;
+    uint32_t best_q15 = UINT32_MAX;
+    uint32_t best_float = UINT32_MAX;
+    int32_t max_error = 0;
+    size_t n = 0;
+
+    for (int frame = 0; ok && frame < 4; frame++) {
+      for (size_t i = 0; i < in_count; i++, n++) {
+        in[i] = static_cast<int16_t>(10000.0f * sinf(w1 * n) + 6000.0f * sinf(w2 * n));
+      }
+
+      uint32_t start = esp_cpu_get_cycle_count();
+      q15.process(in, out_q15, in_count);
+      uint32_t q15_cycles = esp_cpu_get_cycle_count() - start;
+
+      start = esp_cpu_get_cycle_count();
+      ref.process_float(in, out_float, in_count);
+      uint32_t float_cycles = esp_cpu_get_cycle_count() - start;
+
+      if (q15_cycles < best_q15) best_q15 = q15_cycles;
+      if (float_cycles < best_float) best_float = float_cycles;
+      for (size_t i = 0; i < out_count; i++) {
+        int32_t err = std::abs(static_cast<int32_t>(out_q15[i]) - static_cast<int32_t>(out_float[i]));
+        if (err > max_error) max_error = err;
+      }
+    }
+
+    if (ok) {
+      this->interp_q15_cycles_ = best_q15;
+      this->interp_float_cycles_ = best_float;
+      this->interp_q15_max_error_ = max_error;
+      ok = max_error <= FIR_Q15_MAX_ERROR_LSB;
+    }
+  }
+
+  heap_caps_free(in);
+  heap_caps_free(out_q15);
+  heap_caps_free(out_float);
+
+  if (ok) {
+    ESP_LOGD(TAG, "FIR interpolator: Q15 %u cycles vs float %u cycles per %u-sample frame (max error %d LSB)",
+             (unsigned)this->interp_q15_cycles_, (unsigned)this->interp_float_cycles_, (unsigned)in_count,
+             (int)this->interp_q15_max_error_);
+  } else if (supported) {
+    ESP_LOGW(TAG, "FIR interpolator: Q15 self-check failed (max error %d LSB), using float path",
+             (int)this->interp_q15_max_error_);
+  }
+  this->play_interpolator_.set_q15_enabled(ok);
+}
+#endif  // USE_I2S_DUPLEX_Q15_FIR
+
 void I2SAudioDuplex::setup() {
   ESP_LOGCONFIG(TAG, "Setting up I2S Audio Duplex...");
 
@@ -82,37 +253,91 @@ void I2SAudioDuplex::setup() {
     this->mic_decimator_.init(this->decimation_ratio_);
     this->ref_decimator_.init(this->decimation_ratio_);
     this->play_ref_decimator_.init(this->decimation_ratio_);
+    for (auto &dec : this->aux_mic_decimators_) dec.init(this->decimation_ratio_);
+    if (this->speaker_output_rate_) this->play_interpolator_.init(this->decimation_ratio_);
+#ifdef USE_I2S_DUPLEX_Q15_FIR
+    this->check_fir_backend_();
+    if (this->speaker_output_rate_) this->check_interpolator_backend_();
+#endif
     ESP_LOGI(TAG, "Multi-rate: bus=%uHz, output=%uHz, ratio=%u",
              (unsigned)this->sample_rate_, (unsigned)this->output_sample_rate_,
              (unsigned)this->decimation_ratio_);
   }
 
-  // Speaker ring buffer: stores data at bus rate (e.g. 48kHz).
-  // Scale buffer size with decimation ratio to accommodate higher data rate.
-  this->speaker_buffer_size_ = SPEAKER_BUFFER_BASE * this->decimation_ratio_;
-  this->speaker_buffer_ = RingBuffer::create(this->speaker_buffer_size_);
-  if (!this->speaker_buffer_) {
-    ESP_LOGE(TAG, "Failed to create speaker ring buffer (%u bytes)", (unsigned)this->speaker_buffer_size_);
+  // ── Audio arena: rings and every audio task buffer, allocated once here ──
+  audio_kernels::ArenaLayout layout;
+
+  // Speaker ring buffer: stores data at the speaker rate, the bus rate (e.g. 48kHz) unless
+  // speaker_rate: output. Scale buffer size with the ratio to accommodate the higher data rate.
+  const uint32_t speaker_rate = this->get_speaker_sample_rate();
+  this->speaker_buffer_size_ = SPEAKER_BUFFER_BASE * (this->is_speaker_output_rate() ? 1 : this->decimation_ratio_);
+  layout.add_ring(this->speaker_buffer_, this->speaker_buffer_size_, audio_kernels::ArenaPlacement::BULK);
+  // TX mixer: stream 0 plays from speaker_buffer_, every further stream gets a ring of the same size
+  for (uint8_t i = 1; i < this->tx_stream_count_; i++) {
+    layout.add_ring(this->tx_streams_[i].own_ring, this->speaker_buffer_size_, audio_kernels::ArenaPlacement::BULK);
+  }
+
+  // AEC reference buffer (mono mode only — stereo/TDM get ref from I2S RX).
+  // Stores data at the speaker rate; a bus-rate reference is decimated in audio_task before AEC.
+  const size_t delay_bytes = (speaker_rate * this->aec_ref_delay_ms_ / 1000) * BYTES_PER_SAMPLE;
+  size_t ref_buffer_size = 0;
+  if (this->aec_ != nullptr && !this->use_stereo_aec_ref_ && !this->use_tdm_ref_) {
+    // Estimation may move the delay up to AEC_DELAY_SEARCH_MS past the configured value
+    size_t max_delay_bytes = delay_bytes;
+    if (this->aec_delay_estimation_) {
+      max_delay_bytes += (speaker_rate * AEC_DELAY_SEARCH_MS / 1000) * BYTES_PER_SAMPLE;
+    }
+    ref_buffer_size = max_delay_bytes + this->speaker_buffer_size_;
+    this->aec_ref_delay_max_bytes_ = max_delay_bytes;
+    layout.add_ring(this->speaker_ref_buffer_, ref_buffer_size, audio_kernels::ArenaPlacement::BULK);
+  }
+
+  this->plan_task_buffers_(layout);
+  if (!audio_kernels::AudioArena::get().commit(TAG, layout)) {
+    ESP_LOGE(TAG, "Failed to allocate audio buffers (%u bytes internal, %u bytes PSRAM-preferred)",
+             (unsigned)layout.get_bytes(audio_kernels::ArenaPlacement::HOT),
+             (unsigned)layout.get_bytes(audio_kernels::ArenaPlacement::BULK));
     this->mark_failed();
     return;
   }
+  this->tx_streams_[0].ring = this->speaker_buffer_.get();
+  for (uint8_t i = 1; i < this->tx_stream_count_; i++) {
+    this->tx_streams_[i].ring = this->tx_streams_[i].own_ring.get();
+  }
 
-  // AEC reference buffer (mono mode only — stereo/TDM get ref from I2S RX).
-  // Stores data at bus rate; decimated to output rate in audio_task before AEC.
-  if (this->aec_ != nullptr && !this->speaker_ref_buffer_ &&
-      !this->use_stereo_aec_ref_ && !this->use_tdm_ref_) {
-    size_t delay_bytes = (this->sample_rate_ * this->aec_ref_delay_ms_ / 1000) * BYTES_PER_SAMPLE;
-    size_t ref_buffer_size = delay_bytes + this->speaker_buffer_size_;
-    this->speaker_ref_buffer_ = RingBuffer::create(ref_buffer_size);
-    if (this->speaker_ref_buffer_) {
-      ESP_LOGD(TAG, "AEC reference buffer: %u bytes (delay=%ums)", (unsigned)ref_buffer_size,
-               (unsigned)this->aec_ref_delay_ms_);
-    } else {
-      ESP_LOGE(TAG, "Failed to create AEC speaker reference buffer");
+  if (this->speaker_ref_buffer_) {
+    this->aec_ref_delay_bytes_.store(delay_bytes, std::memory_order_relaxed);
+    if (this->aec_delay_estimation_) {
+      // Estimator runs at the AEC (output) rate
+      const uint32_t out_rate = this->get_output_sample_rate();
+      this->delay_estimator_.init(out_rate * AEC_DELAY_WINDOW_MS / 1000, out_rate * AEC_DELAY_SEARCH_MS / 1000);
     }
+    ESP_LOGD(TAG, "AEC reference buffer: %u bytes (delay=%ums%s)", (unsigned)ref_buffer_size,
+             (unsigned)this->aec_ref_delay_ms_, this->aec_delay_estimation_ ? ", estimated" : "");
   }
 
-  ESP_LOGI(TAG, "I2S Audio Duplex ready (speaker_buf=%u bytes)", (unsigned)this->speaker_buffer_size_);
+  ESP_LOGI(TAG, "I2S Audio Duplex ready (speaker_buf=%u bytes%s)", (unsigned)this->speaker_buffer_size_,
+           this->is_mixing() ? " per stream" : "");
+}
+
+void I2SAudioDuplex::loop() {
+  // Delay estimation: correlate a captured window a slice at a time (no-op otherwise)
+  this->delay_estimator_.compute_step(AEC_DELAY_LAGS_PER_LOOP);
+}
+
+uint32_t I2SAudioDuplex::get_aec_reference_delay_ms() const {
+  const uint32_t speaker_rate = this->get_speaker_sample_rate();
+  if (this->speaker_ref_buffer_ == nullptr || speaker_rate == 0) return this->aec_ref_delay_ms_;
+  return this->aec_ref_delay_bytes_.load(std::memory_order_relaxed) / BYTES_PER_SAMPLE * 1000 / speaker_rate;
+}
+
+uint32_t I2SAudioDuplex::get_frame_duration_ms() const {
+#ifdef USE_ESP_AEC
+  if (this->aec_ != nullptr && this->aec_->is_initialized()) {
+    return static_cast<uint32_t>(this->aec_->get_frame_size()) * 1000 / this->get_output_sample_rate();
+  }
+#endif
+  return this->frame_duration_ms_;
 }
 
 void I2SAudioDuplex::set_aec(AecProcessor *aec) {
@@ -150,18 +375,74 @@ void I2SAudioDuplex::dump_config() {
   if (this->decimation_ratio_ > 1) {
     ESP_LOGCONFIG(TAG, "  Output Rate: %u Hz (decimation x%u)",
                   (unsigned)this->get_output_sample_rate(), (unsigned)this->decimation_ratio_);
+#ifdef USE_I2S_DUPLEX_Q15_FIR
+    if (this->mic_decimator_.is_q15_enabled()) {
+      ESP_LOGCONFIG(TAG, "  FIR Decimator: Q15 esp-dsp (%u cycles/frame, float %u)",
+                    (unsigned)this->fir_q15_cycles_, (unsigned)this->fir_float_cycles_);
+    } else {
+      ESP_LOGCONFIG(TAG, "  FIR Decimator: float (Q15 self-check failed)");
+    }
+#endif
+    if (this->is_speaker_output_rate()) {
+#ifdef USE_I2S_DUPLEX_Q15_FIR
+      if (this->play_interpolator_.is_q15_enabled()) {
+        ESP_LOGCONFIG(TAG, "  Speaker Input: %u Hz, FIR interpolator Q15 esp-dsp (%u cycles/frame, float %u)",
+                      (unsigned)this->get_speaker_sample_rate(), (unsigned)this->interp_q15_cycles_,
+                      (unsigned)this->interp_float_cycles_);
+      } else
+#endif
+      {
+        ESP_LOGCONFIG(TAG, "  Speaker Input: %u Hz, FIR interpolator float", (unsigned)this->get_speaker_sample_rate());
+      }
+    }
   }
+  ESP_LOGCONFIG(TAG, "  Frame: %u ms%s", (unsigned)this->get_frame_duration_ms(),
+                this->aec_ != nullptr ? " (AEC chunk)" : "");
   ESP_LOGCONFIG(TAG, "  Speaker Buffer: %u bytes", (unsigned)this->speaker_buffer_size_);
+  if (this->is_mixing()) {
+    ESP_LOGCONFIG(TAG, "  TX Mixer: %u streams", (unsigned)this->tx_stream_count_);
+    for (uint8_t i = 0; i < this->tx_stream_count_; i++) {
+      const TxStream &s = this->tx_streams_[i];
+      ESP_LOGCONFIG(TAG, "    %s: priority %u, ducking %.1f dB", s.name, (unsigned)s.priority,
+                    s.duck_gain > 0.0f ? 20.0f * log10f(s.duck_gain) : -100.0f);
+    }
+  }
+  const audio_kernels::AudioArena &arena = audio_kernels::AudioArena::get();
+  if (const audio_kernels::AudioArena::Owner *budget = arena.find(TAG)) {
+    ESP_LOGCONFIG(TAG, "  Audio Arena: %u bytes internal, %u bytes PSRAM, %u buffers (frames up to %u samples)",
+                  (unsigned)budget->internal_bytes, (unsigned)budget->psram_bytes, (unsigned)budget->buffers,
+                  (unsigned)this->task_max_frame_size_);
+    if (budget->spilled_bytes > 0) {
+      ESP_LOGW(TAG, "  Audio Arena: %u bytes of hot buffers spilled to PSRAM (internal RAM exhausted)",
+               (unsigned)budget->spilled_bytes);
+    }
+    ESP_LOGCONFIG(TAG, "  Audio Arena (all components): %u bytes internal, %u bytes PSRAM",
+                  (unsigned)arena.get_internal_bytes(), (unsigned)arena.get_psram_bytes());
+  }
   if (this->use_stereo_aec_ref_) {
     ESP_LOGCONFIG(TAG, "  Stereo AEC Reference: %s channel", this->ref_channel_right_ ? "RIGHT" : "LEFT");
   }
   if (this->use_tdm_ref_) {
     ESP_LOGCONFIG(TAG, "  TDM Reference: %u slots, mic_slot=%u, ref_slot=%u",
                   this->tdm_total_slots_, this->tdm_mic_slot_, this->tdm_ref_slot_);
+    for (uint8_t i = 0; i < this->tdm_aux_mic_count_; i++) {
+      ESP_LOGCONFIG(TAG, "  TDM Aux Mic %u: slot %u", (unsigned)(i + 2), this->tdm_aux_mic_slots_[i]);
+    }
   }
   ESP_LOGCONFIG(TAG, "  AEC: %s", this->aec_ != nullptr ? "enabled" : "disabled");
+  if (this->speaker_ref_buffer_ != nullptr) {
+    ESP_LOGCONFIG(TAG, "  AEC Reference Delay: %ums%s", (unsigned)this->get_aec_reference_delay_ms(),
+                  this->delay_estimator_.is_initialized() ? " (estimated per session)" : "");
+  }
+  if (this->idle_suspend_ms_ > 0) {
+    ESP_LOGCONFIG(TAG, "  Idle Suspend: after %u ms without mic or speaker users", (unsigned)this->idle_suspend_ms_);
+  }
   ESP_LOGCONFIG(TAG, "  Task: priority=%u, core=%d, stack=%u",
                 this->task_priority_, this->task_core_, (unsigned)this->task_stack_size_);
+  if (this->aec_pipeline_ && this->aec_ != nullptr) {
+    ESP_LOGCONFIG(TAG, "  AEC Pipeline Task: priority=%u, core=%d (mic path +1 frame)",
+                  this->aec_task_priority_, this->aec_task_core_);
+  }
 }
 
 bool I2SAudioDuplex::init_i2s_duplex_() {
@@ -421,18 +702,15 @@ void I2SAudioDuplex::deinit_i2s_() {
 void I2SAudioDuplex::prefill_aec_ref_buffer_() {
 #ifdef USE_ESP_AEC
   if (this->speaker_ref_buffer_ != nullptr && this->aec_ != nullptr &&
-      this->aec_ref_delay_ms_ > 0 && !this->use_stereo_aec_ref_ && !this->use_tdm_ref_) {
+      !this->use_stereo_aec_ref_ && !this->use_tdm_ref_) {
+    // Reader side (audio_task_, or start() before it runs): the delay is silence read
+    // ahead of the reference, so play() keeps writing without a lock.
+    // Last estimate if there is one: a new session starts where the previous one settled
     this->speaker_ref_buffer_->reset();
-    size_t delay_bytes = (this->sample_rate_ * this->aec_ref_delay_ms_ / 1000) * BYTES_PER_SAMPLE;
-    static constexpr uint8_t silence[64] = {};
-    size_t remaining = delay_bytes;
-    while (remaining > 0) {
-      size_t chunk = std::min(remaining, sizeof(silence));
-      this->speaker_ref_buffer_->write_without_replacement(silence, chunk, 0, true);
-      remaining -= chunk;
-    }
+    this->speaker_ref_buffer_->pad_silence(this->aec_ref_delay_bytes_.load(std::memory_order_relaxed));
+    this->delay_estimator_.arm();  // Re-measure in the first seconds of this session's playback
     ESP_LOGD(TAG, "AEC reference buffer pre-filled with %ums of silence",
-             (unsigned)this->aec_ref_delay_ms_);
+             (unsigned)this->get_aec_reference_delay_ms());
   }
 #endif
 }
@@ -461,6 +739,8 @@ void I2SAudioDuplex::start() {
   this->mic_decimator_.reset();
   this->ref_decimator_.reset();
   this->play_ref_decimator_.reset();
+  this->play_interpolator_.reset();
+  for (auto &dec : this->aux_mic_decimators_) dec.reset();
 
   this->prefill_aec_ref_buffer_();
 #ifdef USE_ESP_AEC
@@ -502,20 +782,24 @@ void I2SAudioDuplex::stop() {
 
   this->mic_ref_count_.store(0, std::memory_order_relaxed);
   this->speaker_running_.store(false, std::memory_order_relaxed);
+  this->speaker_in_use_.store(false);
+  for (auto &stream : this->tx_streams_) stream.running.store(false, std::memory_order_relaxed);
   this->duplex_running_.store(false, std::memory_order_relaxed);
+  this->wake_suspended_task_();  // Idle-suspended: it exits without enabling the channels again
 
   delay(60);
 
+  // A suspended task already disabled the channels (ESP_ERR_INVALID_STATE)
   esp_err_t err;
   if (this->tx_handle_) {
     err = i2s_channel_disable(this->tx_handle_);
-    if (err != ESP_OK) {
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
       ESP_LOGW(TAG, "TX channel disable failed: %s", esp_err_to_name(err));
     }
   }
   if (this->rx_handle_) {
     err = i2s_channel_disable(this->rx_handle_);
-    if (err != ESP_OK) {
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
       ESP_LOGW(TAG, "RX channel disable failed: %s", esp_err_to_name(err));
     }
   }
@@ -545,7 +829,8 @@ void I2SAudioDuplex::start_mic() {
   if (!this->duplex_running_.load(std::memory_order_relaxed)) {
     this->start();
   }
-  this->mic_ref_count_.fetch_add(1, std::memory_order_relaxed);
+  this->mic_ref_count_.fetch_add(1);  // Sequentially consistent: see suspended_
+  this->wake_suspended_task_();
 }
 
 void I2SAudioDuplex::stop_mic() {
@@ -555,11 +840,21 @@ void I2SAudioDuplex::stop_mic() {
   }
 }
 
-void I2SAudioDuplex::start_speaker() {
+void I2SAudioDuplex::start_speaker(uint8_t stream) {
   if (!this->duplex_running_.load(std::memory_order_relaxed)) {
     this->start();
   }
+  const bool first = !this->speaker_in_use_.load();
+  if (this->is_mixing() && stream < this->tx_stream_count_) {
+    this->tx_streams_[stream].reset_requested.store(true, std::memory_order_relaxed);
+    this->tx_streams_[stream].running.store(true, std::memory_order_relaxed);
+  }
   this->speaker_running_.store(true, std::memory_order_relaxed);
+  this->speaker_in_use_.store(true);  // Sequentially consistent: see suspended_
+  this->wake_suspended_task_();
+  if (this->is_mixing() && !first) {
+    return;  // Joins streams that already play: the reference keeps its alignment
+  }
 
   this->play_ref_decimator_.reset();
 
@@ -568,46 +863,125 @@ void I2SAudioDuplex::start_speaker() {
   this->request_ref_prefill_.store(true, std::memory_order_relaxed);
 }
 
-void I2SAudioDuplex::stop_speaker() {
+void I2SAudioDuplex::stop_speaker(uint8_t stream) {
+  if (this->is_mixing() && stream < this->tx_stream_count_) {
+    this->tx_streams_[stream].running.store(false, std::memory_order_relaxed);
+    this->tx_streams_[stream].reset_requested.store(true, std::memory_order_relaxed);
+    for (uint8_t i = 0; i < this->tx_stream_count_; i++) {
+      if (this->tx_streams_[i].running.load(std::memory_order_relaxed)) return;  // The mix goes on
+    }
+  }
   this->speaker_running_.store(false, std::memory_order_relaxed);
+  this->speaker_in_use_.store(false);
   // Request audio task to reset ring buffers (avoids concurrent access).
   this->request_speaker_reset_.store(true, std::memory_order_relaxed);
 }
 
-size_t I2SAudioDuplex::play(const uint8_t *data, size_t len, TickType_t ticks_to_wait) {
-  if (!this->speaker_buffer_) {
+bool I2SAudioDuplex::in_use_() const {
+  return this->mic_ref_count_.load() > 0 || this->speaker_in_use_.load();
+}
+
+void I2SAudioDuplex::wake_suspended_task_() {
+  if (this->suspended_.load() && this->audio_task_handle_ != nullptr) {
+    this->wake_request_us_.store(static_cast<uint32_t>(esp_timer_get_time()), std::memory_order_relaxed);
+    xTaskNotifyGive(this->audio_task_handle_);
+  }
+}
+
+uint8_t I2SAudioDuplex::add_tx_stream(const char *name, uint8_t priority, float duck_gain) {
+  if (this->tx_stream_count_ >= MAX_TX_STREAMS) {
+    ESP_LOGE(TAG, "Only %u duplex speakers can share the bus - %s shares the last stream", (unsigned)MAX_TX_STREAMS,
+             name);
+    return MAX_TX_STREAMS - 1;
+  }
+  TxStream &stream = this->tx_streams_[this->tx_stream_count_];
+  stream.name = name;
+  stream.priority = priority;
+  stream.duck_gain = duck_gain;
+  return this->tx_stream_count_++;
+}
+
+void I2SAudioDuplex::set_stream_volume(uint8_t stream, float volume) {
+  if (!this->is_mixing()) {
+    this->set_speaker_volume(volume);
+  } else if (stream < this->tx_stream_count_) {
+    this->tx_streams_[stream].volume.store(volume, std::memory_order_relaxed);
+  }
+}
+
+void I2SAudioDuplex::set_stream_paused(uint8_t stream, bool paused) {
+  if (!this->is_mixing()) {
+    this->set_speaker_paused(paused);
+  } else if (stream < this->tx_stream_count_) {
+    this->tx_streams_[stream].paused.store(paused, std::memory_order_relaxed);
+  }
+}
+
+size_t I2SAudioDuplex::play_stream(uint8_t stream, const uint8_t *data, size_t len, TickType_t ticks_to_wait) {
+  audio_kernels::SpscRing *ring = stream < MAX_TX_STREAMS ? this->tx_streams_[stream].ring : nullptr;
+  if (ring == nullptr) {
     return 0;
   }
 
-  // Data arrives at bus rate (e.g. 48kHz from mixer/resampler). Write directly.
-  size_t written = this->speaker_buffer_->write_without_replacement((void *) data, len, ticks_to_wait, true);
+  // Data arrives at the speaker rate (bus rate from a mixer/resampler, or the output rate). Write directly.
+  size_t written = ring->write(data, len);
+  if (written < len && ticks_to_wait > 0) {
+    // The SPSC ring never blocks: wait for audio_task_ to drain frames, up to ticks_to_wait
+    const TickType_t start = xTaskGetTickCount();
+    while (written < len && xTaskGetTickCount() - start < ticks_to_wait) {
+      vTaskDelay(1);
+      written += ring->write(data + written, len - written);
+    }
+  }
+  if (written < len) {
+    this->metrics_.play_dropped_bytes.fetch_add(len - written, std::memory_order_relaxed);
+  }
 
   if (written > 0) {
-    this->last_speaker_audio_ms_.store(millis(), std::memory_order_relaxed);
+    const uint32_t now = millis();
+    this->last_speaker_audio_ms_.store(now, std::memory_order_relaxed);
+    this->tx_streams_[stream].last_audio_ms.store(now, std::memory_order_relaxed);
   }
 
 #ifdef USE_ESP_AEC
-  // Write bus-rate reference for AEC (mono mode only — stereo/TDM get ref from I2S RX).
-  // Reference is decimated to output rate in audio_task before feeding to AEC.
+  // Write the reference for AEC (mono mode only — stereo/TDM get ref from I2S RX).
+  // A bus-rate reference is decimated to output rate in audio_task before feeding to AEC;
+  // at the output rate (speaker_rate: output) it goes to the AEC as is.
+  // Mixing: the TX path writes the mixed frame instead (see process_tx_path_).
   if (this->speaker_ref_buffer_ != nullptr && written > 0 && this->speaker_running_.load(std::memory_order_relaxed) &&
-      !this->use_stereo_aec_ref_ && !this->use_tdm_ref_) {
-    this->speaker_ref_buffer_->write_without_replacement((void *) data, written, 0, true);
+      !this->use_stereo_aec_ref_ && !this->use_tdm_ref_ && !this->is_mixing()) {
+    this->speaker_ref_buffer_->write(data, written);
   }
 #endif
 
   return written;
 }
 
-void I2SAudioDuplex::audio_task(void *param) {
-  I2SAudioDuplex *self = static_cast<I2SAudioDuplex *>(param);
-  self->audio_task_();
-  vTaskDelete(nullptr);
+// Frame-size dependent ctx fields. Called with the largest frame before allocating,
+// then again whenever the AEC switches to a mode with another frame size.
+void I2SAudioDuplex::size_frames_(AudioTaskCtx &ctx, size_t out_frame_size) {
+  ctx.out_frame_size = out_frame_size;
+  ctx.bus_frame_size = out_frame_size * ctx.ratio;
+  ctx.out_frame_bytes = ctx.out_frame_size * sizeof(int16_t);
+  ctx.bus_frame_bytes = ctx.bus_frame_size * sizeof(int16_t);
+  ctx.spk_frame_bytes = ctx.spk_output_rate ? ctx.out_frame_bytes : ctx.bus_frame_bytes;
+  if (ctx.use_tdm_ref) {
+    ctx.rx_frame_bytes = ctx.bus_frame_size * ctx.tdm_total_slots * ctx.i2s_bps;
+    ctx.tdm_tx_frame_bytes = ctx.bus_frame_size * ctx.tdm_total_slots * ctx.i2s_bps;
+  } else if (ctx.use_stereo_aec_ref) {
+    ctx.rx_frame_bytes = ctx.bus_frame_size * 2 * ctx.i2s_bps;
+  } else {
+    ctx.rx_frame_bytes = ctx.bus_frame_size * ctx.i2s_bps;
+  }
 }
 
-void I2SAudioDuplex::audio_task_() {
-  AudioTaskCtx ctx{};
+// Everything audio_task_ (and aec_task_ when pipelined) will touch, sized for the largest
+// frame the AEC can switch to. Each task run starts from a copy of task_ctx_, so starting
+// and stopping audio never touches the heap.
+void I2SAudioDuplex::plan_task_buffers_(audio_kernels::ArenaLayout &layout) {
+  AudioTaskCtx &ctx = this->task_ctx_;
 
-  // ── Populate invariants ──
+  // ── Invariants ──
   ctx.ratio = this->decimation_ratio_;
   ctx.i2s_bps = (this->bits_per_sample_ > 16) ? 4 : 2;
   ctx.num_ch = this->num_channels_;
@@ -615,137 +989,198 @@ void I2SAudioDuplex::audio_task_() {
   ctx.use_tdm_ref = this->use_tdm_ref_;
   ctx.ref_channel_right = this->ref_channel_right_;
   ctx.correct_dc_offset = this->correct_dc_offset_;
+  ctx.spk_output_rate = this->is_speaker_output_rate();
+  ctx.tx_mixing = this->is_mixing();
   ctx.tdm_total_slots = this->tdm_total_slots_;
   ctx.tdm_mic_slot = this->tdm_mic_slot_;
   ctx.tdm_ref_slot = this->tdm_ref_slot_;
+  ctx.mic_separate = (ctx.ratio > 1) || ctx.use_stereo_aec_ref || ctx.use_tdm_ref;
 
-  ESP_LOGD(TAG, "Audio task started (stereo=%s, tdm=%s, decimation=%ux)",
-           ctx.use_stereo_aec_ref ? "YES" : "no",
-           ctx.use_tdm_ref ? "YES" : "no", (unsigned)ctx.ratio);
+  // Largest frame: the AEC initializes after this component (setup priority), so it is
+  // asked for the largest frame its configuration can reach rather than the current one
+  const size_t own_frame_size = this->get_output_sample_rate() * this->frame_duration_ms_ / 1000;
+  size_t max_frame_size = own_frame_size;
 
-  // Determine output frame size: use AEC's required chunk size if available, otherwise default.
-  ctx.out_frame_size = DEFAULT_FRAME_SIZE;
+  // Multi-mic backend on a TDM codec: every mic slot goes to process_multi()
 #ifdef USE_ESP_AEC
-  if (this->aec_ != nullptr && this->aec_->is_initialized()) {
-    ctx.out_frame_size = this->aec_->get_frame_size();
-    uint32_t out_rate = this->get_output_sample_rate();
-    ESP_LOGD(TAG, "AEC frame size: %u samples (%ums @ %uHz)",
-             (unsigned)ctx.out_frame_size, (unsigned)(ctx.out_frame_size * 1000 / out_rate), (unsigned)out_rate);
+  if (this->aec_ != nullptr) {
+    max_frame_size = std::max<size_t>(max_frame_size, this->aec_->get_max_frame_size());
+  }
+  if (ctx.use_tdm_ref && this->aec_ != nullptr && this->aec_->get_mic_num() > 1) {
+    const size_t wanted = static_cast<size_t>(this->aec_->get_mic_num());
+    ctx.tdm_mic_count = static_cast<uint8_t>(std::min<size_t>({wanted, MAX_TDM_MICS, 1u + this->tdm_aux_mic_count_}));
+    if (ctx.tdm_mic_count < wanted) {
+      ESP_LOGW(TAG, "AEC expects %u mics, %u TDM mic slots configured", (unsigned)wanted,
+               (unsigned)ctx.tdm_mic_count);
+    }
   }
 #endif
-
-  // ── Frame sizing ──
-  ctx.bus_frame_size = ctx.out_frame_size * ctx.ratio;
-  ctx.out_frame_bytes = ctx.out_frame_size * sizeof(int16_t);
-  ctx.bus_frame_bytes = ctx.bus_frame_size * sizeof(int16_t);
-  ctx.aec_delay_bytes = (this->sample_rate_ * this->aec_ref_delay_ms_ / 1000) * BYTES_PER_SAMPLE;
-
-  if (ctx.use_tdm_ref) {
-    ctx.rx_frame_bytes = ctx.bus_frame_size * ctx.tdm_total_slots * ctx.i2s_bps;
-  } else if (ctx.use_stereo_aec_ref) {
-    ctx.rx_frame_bytes = ctx.bus_frame_size * 2 * ctx.i2s_bps;
-  } else {
-    ctx.rx_frame_bytes = ctx.bus_frame_size * ctx.i2s_bps;
-  }
-
-  // ── Buffer allocations ──
-  // AEC buffers use 16-byte alignment (ESP-SR may use SIMD internally)
-  static constexpr size_t AEC_ALIGN = 16;
-
-  // ESP-IDF new I2S driver manages its own internal DMA ring buffers.
-  // i2s_channel_read/write use memcpy to/from user buffers (verified in i2s_common.c:1337,1387).
-  // User buffers do NOT need MALLOC_CAP_DMA — they can safely be in PSRAM.
-  // With buffers_in_psram=true, all buffers go to PSRAM (~28KB internal heap saved).
-  // Required for sr_low_cost AEC mode (512-sample frames = larger buffers).
-  const uint32_t buf_caps = this->buffers_in_psram_ ? MALLOC_CAP_SPIRAM : MALLOC_CAP_INTERNAL;
-  ctx.rx_buffer = static_cast<int16_t *>(
-      heap_caps_malloc(ctx.rx_frame_bytes, buf_caps));
-
-  ctx.mic_separate = (ctx.ratio > 1) || ctx.use_stereo_aec_ref || ctx.use_tdm_ref;
-  ctx.mic_buffer = ctx.mic_separate
-      ? static_cast<int16_t *>(heap_caps_aligned_alloc(AEC_ALIGN, ctx.out_frame_bytes, buf_caps))
-      : ctx.rx_buffer;
-
-  ctx.spk_buffer = static_cast<int16_t *>(
-      heap_caps_malloc(ctx.bus_frame_size * ctx.num_ch * ctx.i2s_bps, buf_caps));
+  ctx.tdm_slots[0] = ctx.tdm_mic_slot;
+  for (size_t c = 1; c < ctx.tdm_mic_count; c++) ctx.tdm_slots[c] = this->tdm_aux_mic_slots_[c - 1];
+  ctx.tdm_slots[ctx.tdm_mic_count] = ctx.tdm_ref_slot;
+
+  const RxLayout rx_layout = ctx.use_tdm_ref          ? RxLayout::TDM
+                             : ctx.use_stereo_aec_ref ? RxLayout::STEREO
+                                                      : RxLayout::MONO;
+  const size_t rx_channels = ctx.use_tdm_ref ? ctx.tdm_mic_count + 1u : ctx.use_stereo_aec_ref ? 2u : 1u;
+  ctx.rx_kernel = select_rx_kernel(ctx.i2s_bps == 4, rx_layout, ctx.correct_dc_offset, ctx.ratio);
+
+  this->task_max_frame_size_ = max_frame_size;
+  size_frames_(ctx, max_frame_size);
+
+  // ── Buffers ──
+  // Buffers the AEC and FIR decimators work on sample by sample stay in internal SRAM unless
+  // buffers_in_psram is set (~28KB internal heap saved, needed for sr_low_cost's 512-sample
+  // frames on tight boards). I2S staging is one memcpy per frame and goes to PSRAM when
+  // present: the IDF I2S driver copies to/from user buffers (i2s_common.c:1337,1387), so they
+  // need no MALLOC_CAP_DMA.
+  using audio_kernels::ArenaPlacement;
+  const ArenaPlacement hot = this->buffers_in_psram_ ? ArenaPlacement::BULK : ArenaPlacement::HOT;
+  const ArenaPlacement bulk = ArenaPlacement::BULK;
+
+  // Without separate mic buffer, the raw RX frame is the mic frame (aliased in audio_task_)
+  layout.add(ctx.rx_buffer, ctx.rx_frame_bytes, ctx.mic_separate ? bulk : hot);
+  if (ctx.mic_separate) layout.add(ctx.mic_buffer, ctx.out_frame_bytes, hot);
+  layout.add(ctx.spk_buffer, ctx.bus_frame_size * ctx.num_ch * ctx.i2s_bps, bulk);
+  if (ctx.spk_output_rate) layout.add(ctx.spk_in_buffer, ctx.out_frame_bytes, hot);
+  if (ctx.tx_mixing) layout.add(ctx.mix_buffer, ctx.spk_frame_bytes, hot);
 
   if (ctx.use_stereo_aec_ref || ctx.use_tdm_ref) {
-    ctx.spk_ref_buffer = static_cast<int16_t *>(
-        heap_caps_aligned_alloc(AEC_ALIGN, ctx.out_frame_bytes, buf_caps));
+    layout.add(ctx.spk_ref_buffer, ctx.out_frame_bytes, hot);
   }
-
-  if (ctx.use_stereo_aec_ref && ctx.ratio > 1) {
-    ctx.deint_ref = static_cast<int16_t *>(heap_caps_malloc(ctx.bus_frame_bytes, buf_caps));
-    ctx.deint_mic = static_cast<int16_t *>(heap_caps_malloc(ctx.bus_frame_bytes, buf_caps));
-  }
-
-  if (ctx.use_tdm_ref && ctx.ratio > 1) {
-    ctx.tdm_deint_mic = static_cast<int16_t *>(heap_caps_malloc(ctx.bus_frame_bytes, buf_caps));
-    ctx.tdm_deint_ref = static_cast<int16_t *>(heap_caps_malloc(ctx.bus_frame_bytes, buf_caps));
+  // The fused RX kernel deinterleaves a block at a time: no bus-rate copy of any channel
+  const size_t rx_scratch = rx_scratch_samples(ctx.i2s_bps == 4, rx_layout, rx_channels, ctx.ratio);
+  if (rx_scratch > 0) layout.add(ctx.rx_scratch, rx_scratch * sizeof(int16_t), hot);
+  for (size_t c = 0; c + 1 < ctx.tdm_mic_count; c++) {
+    layout.add(ctx.aux_mic[c], ctx.out_frame_bytes, hot);
   }
-
   if (ctx.use_tdm_ref) {
-    ctx.tdm_tx_frame_bytes = ctx.bus_frame_size * ctx.tdm_total_slots * ctx.i2s_bps;
-    ctx.tdm_tx_buffer = static_cast<int16_t *>(
-        heap_caps_malloc(ctx.tdm_tx_frame_bytes, buf_caps));
+    layout.add(ctx.tdm_tx_buffer, ctx.tdm_tx_frame_bytes, bulk);
   }
 
 #ifdef USE_ESP_AEC
   if (this->aec_ != nullptr) {
-    if (!ctx.spk_ref_buffer && !ctx.use_tdm_ref)
-      ctx.spk_ref_buffer = static_cast<int16_t *>(
-          heap_caps_aligned_alloc(AEC_ALIGN, ctx.out_frame_bytes, buf_caps));
-    ctx.aec_output = static_cast<int16_t *>(
-        heap_caps_aligned_alloc(AEC_ALIGN, ctx.out_frame_bytes, buf_caps));
     if (!ctx.use_stereo_aec_ref && !ctx.use_tdm_ref) {
-      ctx.ref_bus_buffer = static_cast<int16_t *>(heap_caps_malloc(ctx.bus_frame_bytes, buf_caps));
+      layout.add(ctx.spk_ref_buffer, ctx.out_frame_bytes, hot);
+      layout.add(ctx.ref_bus_buffer, ctx.spk_frame_bytes, hot);
+    }
+    layout.add(ctx.aec_output, ctx.out_frame_bytes, hot);
+
+    // AEC pipeline slots: aec_task_ runs the AEC straight on them
+    if (this->aec_pipeline_) {
+      const bool slot_ref = ctx.use_stereo_aec_ref || ctx.use_tdm_ref;
+      for (auto &slot : this->pipeline_slots_) {
+        layout.add(slot.mic, ctx.out_frame_bytes, hot);
+        if (slot_ref) layout.add(slot.ref, ctx.out_frame_bytes, hot);
+        for (size_t c = 0; c + 1 < ctx.tdm_mic_count; c++) layout.add(slot.aux_mic[c], ctx.out_frame_bytes, hot);
+      }
     }
   }
 #endif
+}
+
+void I2SAudioDuplex::audio_task(void *param) {
+  I2SAudioDuplex *self = static_cast<I2SAudioDuplex *>(param);
+  self->audio_task_();
+  vTaskDelete(nullptr);
+}
 
-  // ── Verify critical allocations ──
-  auto alloc_fail = [this](const char *what) {
-    ESP_LOGE(TAG, "Failed to allocate %s", what);
+void I2SAudioDuplex::audio_task_() {
+  // Invariants and arena buffers from setup(), fresh loop state
+  AudioTaskCtx ctx = this->task_ctx_;
+  if (!ctx.mic_separate) ctx.mic_buffer = ctx.rx_buffer;
+
+  ESP_LOGD(TAG, "Audio task started (stereo=%s, tdm=%s, mics=%u, decimation=%ux)",
+           ctx.use_stereo_aec_ref ? "YES" : "no",
+           ctx.use_tdm_ref ? "YES" : "no", (unsigned)ctx.tdm_mic_count, (unsigned)ctx.ratio);
+
+  // Determine output frame size: use AEC's required chunk size if available, otherwise
+  // frame_duration (consumers such as intercom_api frame their audio to the same size).
+  // Buffers are sized for the largest frame the AEC can switch to (task_max_frame_size_), so a
+  // mode switch only re-sizes ctx at a frame boundary (see the main loop).
+  const size_t max_frame_size = this->task_max_frame_size_;
+  size_t frame_size = this->get_output_sample_rate() * this->frame_duration_ms_ / 1000;
+#ifdef USE_ESP_AEC
+  if (this->aec_ != nullptr && this->aec_->is_initialized()) {
+    frame_size = this->aec_->get_frame_size();
+    uint32_t out_rate = this->get_output_sample_rate();
+    ESP_LOGD(TAG, "AEC frame size: %u samples (%ums @ %uHz), buffers for %u",
+             (unsigned)frame_size, (unsigned)(frame_size * 1000 / out_rate), (unsigned)out_rate,
+             (unsigned)max_frame_size);
+  }
+#endif
+  if (frame_size > max_frame_size) {
+    ESP_LOGE(TAG, "AEC frame size %u exceeds the %u samples the audio buffers were sized for",
+             (unsigned)frame_size, (unsigned)max_frame_size);
     this->has_i2s_error_.store(true, std::memory_order_relaxed);
     this->task_exited_.store(true, std::memory_order_relaxed);
-  };
-  if (!ctx.rx_buffer || !ctx.spk_buffer || (ctx.mic_separate && !ctx.mic_buffer)) {
-    alloc_fail("audio buffers"); goto cleanup;
-  }
-  if (ctx.use_stereo_aec_ref && ctx.ratio > 1 && (!ctx.deint_ref || !ctx.deint_mic)) {
-    alloc_fail("stereo decimation buffers"); goto cleanup;
-  }
-  if (ctx.use_tdm_ref && !ctx.tdm_tx_buffer) {
-    alloc_fail("TDM TX buffer"); goto cleanup;
+    return;
   }
-  if (ctx.use_tdm_ref && ctx.ratio > 1 && (!ctx.tdm_deint_mic || !ctx.tdm_deint_ref)) {
-    alloc_fail("TDM decimation buffers"); goto cleanup;
+  ctx.aec_delay_bytes = this->aec_ref_delay_bytes_.load(std::memory_order_relaxed);
+
+  // Mic fan-out pools: one slot per live frame of the largest size (ctx is still sized for it)
+  for (FramePool *pool : {&this->raw_frame_pool_, &this->mic_frame_pool_}) {
+    if (pool->has_readers()) {
+      pool->init(pool->has_polled_readers() ? FRAME_POOL_POLLED_DEPTH : 1, ctx.out_frame_bytes);
+    }
   }
+
+  bool pipelined = false;
 #ifdef USE_ESP_AEC
-  if (this->aec_ != nullptr) {
-    if (!ctx.aec_output) { alloc_fail("AEC output buffer"); goto cleanup; }
-    if ((ctx.use_stereo_aec_ref || ctx.use_tdm_ref) && !ctx.spk_ref_buffer) {
-      alloc_fail("AEC reference buffer"); goto cleanup;
-    }
-    if (!ctx.use_stereo_aec_ref && !ctx.use_tdm_ref && !ctx.ref_bus_buffer) {
-      alloc_fail("AEC mono reference buffer"); goto cleanup;
+  // ── AEC pipeline: second task over the slots from setup() (falls back to single-stage) ──
+  if (this->aec_pipeline_ && this->aec_ != nullptr) {
+    this->pipeline_head_.store(0, std::memory_order_relaxed);
+    this->pipeline_tail_.store(0, std::memory_order_relaxed);
+    this->pipeline_skipped_.store(0, std::memory_order_relaxed);
+    this->pipeline_stop_.store(false, std::memory_order_relaxed);
+    this->aec_task_exited_.store(false, std::memory_order_relaxed);
+    this->aec_ctx_ = ctx;  // Shares the invariants; AEC-side buffers are only touched by aec_task_ from here on
+    pipelined = xTaskCreatePinnedToCore(aec_task, "i2s_duplex_aec", this->task_stack_size_, this,
+                                        this->aec_task_priority_, &this->aec_task_handle_,
+                                        this->aec_task_core_ >= 0 ? this->aec_task_core_ : tskNO_AFFINITY) == pdPASS;
+    if (!pipelined) {
+      this->aec_task_exited_.store(true, std::memory_order_relaxed);
+      ESP_LOGW(TAG, "AEC pipeline unavailable (task creation failed) - running AEC in the audio task");
+    } else {
+      ESP_LOGD(TAG, "AEC pipeline started on core %d", this->aec_task_core_);
     }
   }
 #endif
+  size_frames_(ctx, frame_size);
 
   // ── Main loop ──
+  ctx.idle_since_ms = millis();
   while (this->duplex_running_.load(std::memory_order_relaxed)) {
+    if (this->idle_suspend_ms_ > 0 && !this->suspend_while_idle_(ctx)) {
+      break;  // stop() while suspended
+    }
 
-    // Service ring buffer operations requested by main thread
+    // Service ring buffer operations requested by main thread. The reference ring
+    // belongs to whichever stage runs the AEC, so its part is forwarded.
     if (this->request_speaker_reset_.exchange(false, std::memory_order_relaxed)) {
       this->speaker_buffer_->reset();
-      if (this->speaker_ref_buffer_)
-        this->speaker_ref_buffer_->reset();
+      this->ref_requests_.fetch_or(REF_REQUEST_RESET, std::memory_order_relaxed);
     }
     if (this->request_ref_prefill_.exchange(false, std::memory_order_relaxed)) {
       this->speaker_buffer_->reset();
-      this->prefill_aec_ref_buffer_();
+      this->play_interpolator_.reset();
+      this->ref_requests_.fetch_or(REF_REQUEST_PREFILL, std::memory_order_relaxed);
     }
+    if (!pipelined) {
+      this->service_ref_ring_(ctx);
+    }
+#ifdef USE_ESP_AEC
+    // AEC mode switched to another frame size: follow it here, between two frames
+    if (this->aec_ != nullptr) {
+      const size_t aec_frame_size = static_cast<size_t>(this->aec_->get_frame_size());
+      if (aec_frame_size != ctx.out_frame_size && aec_frame_size > 0 && aec_frame_size <= max_frame_size) {
+        ESP_LOGD(TAG, "Frame size %u -> %u samples (AEC mode switch)", (unsigned)ctx.out_frame_size,
+                 (unsigned)aec_frame_size);
+        size_frames_(ctx, aec_frame_size);
+      }
+    }
+    const int64_t frame_start_us = esp_timer_get_time();
+#endif
 
     // Reset per-frame state
     ctx.output_buffer = nullptr;
@@ -768,8 +1203,23 @@ void I2SAudioDuplex::audio_task_() {
     }
     ctx.now_ms = millis();
 
-    this->process_aec_and_callbacks_(ctx);
+    if (pipelined) {
+      this->pipeline_handoff_(ctx);  // AEC + callbacks run one frame later in aec_task_
+    } else {
+      this->process_aec_and_callbacks_(ctx);
+    }
     this->process_tx_path_(ctx);
+#ifdef USE_ESP_AEC
+    // Load for an adaptive AEC: this frame minus the time spent blocked on I2S DMA
+    if (!pipelined && this->aec_ != nullptr && ctx.output_buffer != nullptr) {
+      const uint32_t frame_us = static_cast<uint32_t>(esp_timer_get_time() - frame_start_us);
+      const uint32_t io_us = this->metrics_.stage(DuplexStage::I2S_READ).last_us.load(std::memory_order_relaxed) +
+                             (this->tx_handle_ ? this->metrics_.stage(DuplexStage::I2S_WRITE).last_us.load(
+                                                     std::memory_order_relaxed)
+                                               : 0);
+      this->aec_->report_frame_load(frame_us > io_us ? frame_us - io_us : 0, static_cast<int>(ctx.out_frame_size));
+    }
+#endif
 
     // Yield: I2S read/write already block on DMA, so taskYIELD suffices.
     if (ctx.consecutive_i2s_errors > 0) {
@@ -779,23 +1229,159 @@ void I2SAudioDuplex::audio_task_() {
     }
   }
 
+  if (pipelined) {
+    // aec_task_ finishes the frame it holds; slots and buffers stay in the arena for the next run
+    this->pipeline_stop_.store(true, std::memory_order_release);
+    xTaskNotifyGive(this->aec_task_handle_);
+    while (!this->aec_task_exited_.load(std::memory_order_acquire)) {
+      vTaskDelay(1);
+    }
+    this->aec_task_handle_ = nullptr;
+  }
+
   this->task_exited_.store(true, std::memory_order_relaxed);
 
-cleanup:
-  heap_caps_free(ctx.rx_buffer);
-  if (ctx.mic_separate && ctx.mic_buffer) heap_caps_free(ctx.mic_buffer);
-  heap_caps_free(ctx.spk_buffer);
-  if (ctx.spk_ref_buffer) heap_caps_free(ctx.spk_ref_buffer);
-  if (ctx.deint_ref) heap_caps_free(ctx.deint_ref);
-  if (ctx.deint_mic) heap_caps_free(ctx.deint_mic);
-  if (ctx.tdm_deint_mic) heap_caps_free(ctx.tdm_deint_mic);
-  if (ctx.tdm_deint_ref) heap_caps_free(ctx.tdm_deint_ref);
-  if (ctx.tdm_tx_buffer) heap_caps_free(ctx.tdm_tx_buffer);
-  if (ctx.ref_bus_buffer) heap_caps_free(ctx.ref_bus_buffer);
-  if (ctx.aec_output) heap_caps_free(ctx.aec_output);
   ESP_LOGI(TAG, "Audio task stopped");
 }
 
+bool I2SAudioDuplex::suspend_while_idle_(AudioTaskCtx &ctx) {
+  const uint32_t now = millis();
+  bool buffered = false;
+  for (uint8_t i = 0; i < std::max<uint8_t>(this->tx_stream_count_, 1); i++) {
+    buffered = buffered || this->tx_streams_[i].ring->available() > 0;
+  }
+  if (this->in_use_() || buffered) {
+    ctx.idle_since_ms = now;
+    return true;
+  }
+  if (now - ctx.idle_since_ms < this->idle_suspend_ms_) {
+    return true;
+  }
+
+  // Nothing uses the bus: stop DMA. The driver drops its power management lock with it,
+  // so light sleep and DFS can kick in. TX DMA buffers are auto-cleared, no stale audio on resume.
+  if (this->tx_handle_) i2s_channel_disable(this->tx_handle_);
+  if (this->rx_handle_) i2s_channel_disable(this->rx_handle_);
+  // A start that lands before suspended_ is set skips the notify and the wait below
+  this->wake_request_us_.store(static_cast<uint32_t>(esp_timer_get_time()), std::memory_order_relaxed);
+  this->suspended_.store(true);  // Before the user check below: see suspended_
+  this->metrics_.idle_suspends.fetch_add(1, std::memory_order_relaxed);
+  ESP_LOGD(TAG, "No mic or speaker user for %ums - I2S suspended", (unsigned) this->idle_suspend_ms_);
+
+  while (!this->in_use_() && this->duplex_running_.load(std::memory_order_relaxed)) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(IDLE_SUSPEND_WAIT_MS));
+  }
+  this->suspended_.store(false);
+  if (!this->duplex_running_.load(std::memory_order_relaxed)) {
+    return false;  // stop() deletes the channels
+  }
+
+  // Filter history is from before the suspend
+  this->mic_decimator_.reset();
+  this->ref_decimator_.reset();
+  for (auto &dec : this->aux_mic_decimators_) dec.reset();
+  if (this->tx_handle_) i2s_channel_enable(this->tx_handle_);
+  if (this->rx_handle_) i2s_channel_enable(this->rx_handle_);
+  const uint32_t resume_us =
+      static_cast<uint32_t>(esp_timer_get_time()) - this->wake_request_us_.load(std::memory_order_relaxed);
+  this->metrics_.resume.record(resume_us);
+  ESP_LOGD(TAG, "I2S resumed %uus after the wake-up", (unsigned) resume_us);
+  ctx.idle_since_ms = millis();
+  return true;
+}
+
+void I2SAudioDuplex::aec_task(void *param) {
+  I2SAudioDuplex *self = static_cast<I2SAudioDuplex *>(param);
+  self->aec_task_();
+  vTaskDelete(nullptr);
+}
+
+// Second pipeline stage: AEC + mic fan-out for the frames audio_task_ hands over.
+// Owns the reference ring's read side, the reference decimator and the delay estimate
+// while it runs, so each is still touched by one task only.
+void I2SAudioDuplex::aec_task_() {
+  AudioTaskCtx &ctx = this->aec_ctx_;
+  const bool ring_ref = !ctx.use_stereo_aec_ref && !ctx.use_tdm_ref;
+
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(I2S_IO_TIMEOUT_MS));
+    const bool stopping = this->pipeline_stop_.load(std::memory_order_acquire);
+
+    uint32_t tail = this->pipeline_tail_.load(std::memory_order_relaxed);
+    while (tail != this->pipeline_head_.load(std::memory_order_acquire)) {
+      this->service_ref_ring_(ctx);
+#ifdef USE_ESP_AEC
+      // Frames audio_task_ dropped would each have consumed one frame of reference
+      const uint32_t skipped = this->pipeline_skipped_.exchange(0, std::memory_order_relaxed);
+      if (ring_ref && skipped > 0 && this->speaker_ref_buffer_ != nullptr) {
+        this->speaker_ref_buffer_->skip(skipped * ctx.spk_frame_bytes);
+      }
+#endif
+
+      PipelineSlot &slot = this->pipeline_slots_[tail % PIPELINE_DEPTH];
+      if (slot.out_frame_size != ctx.out_frame_size) size_frames_(ctx, slot.out_frame_size);
+      ctx.mic_buffer = slot.mic;
+      for (size_t c = 0; c + 1 < ctx.tdm_mic_count; c++) ctx.aux_mic[c] = slot.aux_mic[c];
+      if (!ring_ref) ctx.spk_ref_buffer = slot.ref;
+      ctx.output_buffer = slot.mic;
+      ctx.mic_gain = slot.mic_gain;
+      ctx.mic_attenuation = slot.mic_attenuation;
+      ctx.aec_ref_volume = slot.aec_ref_volume;
+      ctx.aec_enabled = slot.aec_enabled;
+      ctx.speaker_running = slot.speaker_running;
+      ctx.mic_running = slot.mic_running;
+      ctx.now_ms = slot.now_ms;
+
+#ifdef USE_ESP_AEC
+      const int64_t start_us = esp_timer_get_time();
+      this->process_aec_and_callbacks_(ctx);
+      this->aec_->report_frame_load(static_cast<uint32_t>(esp_timer_get_time() - start_us),
+                                    static_cast<int>(ctx.out_frame_size));
+#else
+      this->process_aec_and_callbacks_(ctx);
+#endif
+      this->pipeline_tail_.store(++tail, std::memory_order_release);
+    }
+
+    if (stopping) break;
+  }
+
+  this->aec_task_exited_.store(true, std::memory_order_release);
+}
+
+// audio_task_ side of the pipeline: copy this frame's mic (and hardware reference) into
+// a free slot with its snapshots. Never waits - the I2S DMA timing comes first.
+void I2SAudioDuplex::pipeline_handoff_(AudioTaskCtx &ctx) {
+  if (ctx.output_buffer == nullptr)
+    return;  // No RX frame this iteration
+
+  const uint32_t head = this->pipeline_head_.load(std::memory_order_relaxed);
+  if (head - this->pipeline_tail_.load(std::memory_order_acquire) >= PIPELINE_DEPTH) {
+    this->metrics_.pipeline_overruns.fetch_add(1, std::memory_order_relaxed);
+    // Keep the mono reference in step: this frame's share is dropped by aec_task_
+    if (ctx.aec_enabled && ctx.speaker_running) {
+      this->pipeline_skipped_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return;
+  }
+
+  PipelineSlot &slot = this->pipeline_slots_[head % PIPELINE_DEPTH];
+  slot.out_frame_size = ctx.out_frame_size;
+  memcpy(slot.mic, ctx.mic_buffer, ctx.out_frame_bytes);
+  if (slot.ref != nullptr) memcpy(slot.ref, ctx.spk_ref_buffer, ctx.out_frame_bytes);
+  for (size_t c = 0; c + 1 < ctx.tdm_mic_count; c++) memcpy(slot.aux_mic[c], ctx.aux_mic[c], ctx.out_frame_bytes);
+  slot.mic_gain = ctx.mic_gain;
+  slot.mic_attenuation = ctx.mic_attenuation;
+  slot.aec_ref_volume = ctx.aec_ref_volume;
+  slot.aec_enabled = ctx.aec_enabled;
+  slot.speaker_running = ctx.speaker_running;
+  slot.mic_running = ctx.mic_running;
+  slot.now_ms = ctx.now_ms;
+
+  this->pipeline_head_.store(head + 1, std::memory_order_release);
+  xTaskNotifyGive(this->aec_task_handle_);
+}
+
 // ════════════════════════════════════════════════════════════════════════════
 // RX PATH: I2S read → deinterleave/decimate → mic_buffer + spk_ref_buffer
 // ════════════════════════════════════════════════════════════════════════════
@@ -804,9 +1390,13 @@ void I2SAudioDuplex::process_rx_path_(AudioTaskCtx &ctx) {
     return;
 
   size_t bytes_read;
-  esp_err_t err = i2s_channel_read(this->rx_handle_, ctx.rx_buffer, ctx.rx_frame_bytes,
-                                    &bytes_read, I2S_IO_TIMEOUT_MS);
+  esp_err_t err;
+  {
+    ScopedStage stage(this->metrics_.stage(DuplexStage::I2S_READ));
+    err = i2s_channel_read(this->rx_handle_, ctx.rx_buffer, ctx.rx_frame_bytes, &bytes_read, I2S_IO_TIMEOUT_MS);
+  }
   if (err != ESP_OK && err != ESP_ERR_TIMEOUT && err != ESP_ERR_INVALID_STATE) {
+    this->metrics_.i2s_errors.fetch_add(1, std::memory_order_relaxed);
     ESP_LOGW(TAG, "i2s_channel_read failed: %s", esp_err_to_name(err));
     if (++ctx.consecutive_i2s_errors > 100) {
       ESP_LOGE(TAG, "Persistent I2S read errors (%d)", ctx.consecutive_i2s_errors);
@@ -819,79 +1409,45 @@ void I2SAudioDuplex::process_rx_path_(AudioTaskCtx &ctx) {
     return;
 
   ctx.consecutive_i2s_errors = 0;
-
-  // Convert 32-bit I2S samples to 16-bit for internal processing
-  if (ctx.i2s_bps == 4) {
-    auto *src32 = reinterpret_cast<int32_t *>(ctx.rx_buffer);
-    size_t total_i2s_samples = bytes_read / sizeof(int32_t);
-    for (size_t i = 0; i < total_i2s_samples; i++) {
-      ctx.rx_buffer[i] = static_cast<int16_t>(src32[i] >> 16);
-    }
-  }
-
   ctx.output_buffer = ctx.mic_buffer;  // Default: no AEC processing
 
-#if SOC_I2S_SUPPORTS_TDM
+  // One pass from the read buffer: 32 -> 16-bit, deinterleave, decimation, DC block and
+  // pre-AEC mic attenuation (snapshot value). Mics first, then the reference (stereo/TDM).
+  RxKernelJob job;
+  job.src = ctx.rx_buffer;
+  job.out_frames = ctx.out_frame_size;
+  job.ratio = ctx.ratio;
+  job.gain = audio_kernels::Gain::from_float(ctx.mic_attenuation);
+  job.scratch = ctx.rx_scratch;
+  job.out[0] = ctx.mic_buffer;
+  job.fir[0] = &this->mic_decimator_;
+  job.dc[0] = &ctx.dc_blocker;
   if (ctx.use_tdm_ref) {
-    const uint8_t ts = ctx.tdm_total_slots;
-    const uint8_t ms = ctx.tdm_mic_slot;
-    const uint8_t rs = ctx.tdm_ref_slot;
-    if (ctx.ratio > 1) {
-      for (size_t i = 0; i < ctx.bus_frame_size; i++) {
-        ctx.tdm_deint_mic[i] = ctx.rx_buffer[i * ts + ms];
-        ctx.tdm_deint_ref[i] = ctx.rx_buffer[i * ts + rs];
-      }
-      this->mic_decimator_.process(ctx.tdm_deint_mic, ctx.mic_buffer, ctx.bus_frame_size);
-      this->ref_decimator_.process(ctx.tdm_deint_ref, ctx.spk_ref_buffer, ctx.bus_frame_size);
-    } else {
-      for (size_t i = 0; i < ctx.out_frame_size; i++) {
-        ctx.mic_buffer[i] = ctx.rx_buffer[i * ts + ms];
-        ctx.spk_ref_buffer[i] = ctx.rx_buffer[i * ts + rs];
-      }
-    }
-  } else
-#endif
-  if (ctx.ratio > 1) {
-    if (ctx.use_stereo_aec_ref) {
-      const int ri = ctx.ref_channel_right ? 1 : 0;
-      const int mi = ctx.ref_channel_right ? 0 : 1;
-      for (size_t i = 0; i < ctx.bus_frame_size; i++) {
-        ctx.deint_ref[i] = ctx.rx_buffer[i * 2 + ri];
-        ctx.deint_mic[i] = ctx.rx_buffer[i * 2 + mi];
-      }
-      this->ref_decimator_.process(ctx.deint_ref, ctx.spk_ref_buffer, ctx.bus_frame_size);
-      this->mic_decimator_.process(ctx.deint_mic, ctx.mic_buffer, ctx.bus_frame_size);
-    } else {
-      this->mic_decimator_.process(ctx.rx_buffer, ctx.mic_buffer, ctx.bus_frame_size);
-    }
-  } else {
-    if (ctx.use_stereo_aec_ref) {
-      const int ri = ctx.ref_channel_right ? 1 : 0;
-      const int mi = ctx.ref_channel_right ? 0 : 1;
-      for (size_t i = 0; i < ctx.out_frame_size; i++) {
-        ctx.spk_ref_buffer[i] = ctx.rx_buffer[i * 2 + ri];
-        ctx.mic_buffer[i] = ctx.rx_buffer[i * 2 + mi];
-      }
-    }
-    // Mono without decimation: mic_buffer == rx_buffer (aliased), nothing to do
-  }
-
-  // DC offset correction (musicdsp.org DC-block in Q31, matches upstream)
-  if (ctx.correct_dc_offset) {
-    for (size_t i = 0; i < ctx.out_frame_size; i++) {
-      int32_t input = (int32_t) ctx.mic_buffer[i] << 16;
-      int32_t output = input - ctx.dc_prev_input + ctx.dc_prev_output - (ctx.dc_prev_output >> 10);
-      ctx.dc_prev_input = input;
-      ctx.dc_prev_output = output;
-      ctx.mic_buffer[i] = static_cast<int16_t>(output >> 16);
+    // Aux TDM mics get the same treatment (own DC and FIR state), so the array stays matched
+    const size_t mics = ctx.tdm_mic_count;
+    job.stride = ctx.tdm_total_slots;
+    job.mics = static_cast<uint8_t>(mics);
+    job.channels = static_cast<uint8_t>(mics + 1);
+    job.slots = ctx.tdm_slots;
+    for (size_t c = 1; c < mics; c++) {
+      job.out[c] = ctx.aux_mic[c - 1];
+      job.fir[c] = &this->aux_mic_decimators_[c - 1];
+      job.dc[c] = &ctx.aux_dc_blockers[c - 1];
     }
+    job.out[mics] = ctx.spk_ref_buffer;
+    job.fir[mics] = &this->ref_decimator_;
+  } else if (ctx.use_stereo_aec_ref) {
+    static const uint8_t MIC_LEFT[2] = {0, 1};
+    static const uint8_t MIC_RIGHT[2] = {1, 0};
+    job.slots = ctx.ref_channel_right ? MIC_LEFT : MIC_RIGHT;
+    job.out[1] = ctx.spk_ref_buffer;
+    job.fir[1] = &this->ref_decimator_;
   }
 
-  // Pre-AEC mic attenuation (snapshot value, no atomic load in loop)
-  if (ctx.mic_attenuation != 1.0f) {
-    for (size_t i = 0; i < ctx.out_frame_size; i++) {
-      ctx.mic_buffer[i] = scale_sample(ctx.mic_buffer[i], ctx.mic_attenuation);
-    }
+  const int64_t decimate_start_us = esp_timer_get_time();
+  ctx.rx_kernel(job);
+  if (ctx.mic_separate) {
+    this->metrics_.stage(DuplexStage::DECIMATE).record(static_cast<uint32_t>(esp_timer_get_time() - decimate_start_us));
   }
 }
 
@@ -902,11 +1458,17 @@ void I2SAudioDuplex::process_aec_and_callbacks_(AudioTaskCtx &ctx) {
   if (!this->rx_handle_ || ctx.output_buffer == nullptr)
     return;
 
-  // Raw mic callbacks: pre-AEC audio for MWW
-  if (ctx.mic_running && !this->raw_mic_callbacks_.empty()) {
+  // Raw mic fan-out: pre-AEC audio for MWW (published once, shared by every reader)
+  uint32_t callbacks_us = 0;
+  if (ctx.mic_running && (!this->raw_mic_callbacks_.empty() || this->raw_frame_pool_.has_readers())) {
+    const int64_t start_us = esp_timer_get_time();
+    if (this->raw_frame_pool_.has_readers()) {
+      this->raw_frame_pool_.publish((const uint8_t *) ctx.mic_buffer, ctx.out_frame_bytes);
+    }
     for (auto &callback : this->raw_mic_callbacks_) {
       callback((const uint8_t *) ctx.mic_buffer, ctx.out_frame_bytes);
     }
+    callbacks_us = static_cast<uint32_t>(esp_timer_get_time() - start_us);
   }
 
 #ifdef USE_ESP_AEC
@@ -915,12 +1477,19 @@ void I2SAudioDuplex::process_aec_and_callbacks_(AudioTaskCtx &ctx) {
       this->aec_->is_initialized() && ctx.spk_ref_buffer != nullptr && ctx.aec_output != nullptr) {
     // TDM: hardware-synced reference, no speaker gating needed.
     // TDM analog ref already reflects DAC volume — only match mic_attenuation.
-    if (ctx.mic_attenuation != 1.0f) {
-      for (size_t i = 0; i < ctx.out_frame_size; i++) {
-        ctx.spk_ref_buffer[i] = scale_sample(ctx.spk_ref_buffer[i], ctx.mic_attenuation);
+    audio_kernels::apply_gain(ctx.spk_ref_buffer, ctx.out_frame_size, ctx.mic_attenuation);
+    {
+      ScopedStage stage(this->metrics_.stage(DuplexStage::AEC));
+      if (ctx.tdm_mic_count > 1) {
+        // Multi-mic backend (esp_afe): AEC + beamforming/NS over every mic slot
+        const int16_t *mics[MAX_TDM_MICS] = {ctx.mic_buffer};
+        for (size_t c = 1; c < ctx.tdm_mic_count; c++) mics[c] = ctx.aux_mic[c - 1];
+        this->aec_->process_multi(mics, ctx.tdm_mic_count, ctx.spk_ref_buffer, ctx.aec_output,
+                                  static_cast<int>(ctx.out_frame_size));
+      } else {
+        this->aec_->process(ctx.mic_buffer, ctx.spk_ref_buffer, ctx.aec_output, ctx.out_frame_size);
       }
     }
-    this->aec_->process(ctx.mic_buffer, ctx.spk_ref_buffer, ctx.aec_output, ctx.out_frame_size);
     ctx.output_buffer = ctx.aec_output;
   } else
 #endif
@@ -928,76 +1497,154 @@ void I2SAudioDuplex::process_aec_and_callbacks_(AudioTaskCtx &ctx) {
       ctx.spk_ref_buffer != nullptr && ctx.aec_output != nullptr && ctx.speaker_running &&
       (ctx.now_ms - this->last_speaker_audio_ms_.load(std::memory_order_relaxed) <= AEC_ACTIVE_TIMEOUT_MS)) {
 
-    // Mono mode: read reference from ring buffer, decimate to output rate
+    // Mono mode: read reference from ring buffer, decimate to output rate when it holds bus-rate audio
     if (!ctx.use_stereo_aec_ref) {
-      size_t min_ref_bytes = ctx.aec_delay_bytes + ctx.bus_frame_bytes;
+      size_t min_ref_bytes = ctx.aec_delay_bytes + ctx.spk_frame_bytes;
       size_t ref_available = this->speaker_ref_buffer_ ? this->speaker_ref_buffer_->available() : 0;
+      this->metrics_.ring(DuplexRing::AEC_REF).sample(ref_available);
 
+      const float ref_scale = ctx.aec_ref_volume * ctx.mic_attenuation;
       if (this->speaker_ref_buffer_ != nullptr && ref_available >= min_ref_bytes && ctx.ref_bus_buffer != nullptr) {
-        this->speaker_ref_buffer_->read((void *) ctx.ref_bus_buffer, ctx.bus_frame_bytes, 0);
-        this->play_ref_decimator_.process(ctx.ref_bus_buffer, ctx.spk_ref_buffer, ctx.bus_frame_size);
+        this->speaker_ref_buffer_->read(ctx.ref_bus_buffer, ctx.spk_frame_bytes);
+        if (ctx.ratio > 1 && !ctx.spk_output_rate) {
+          this->play_ref_decimator_.process(ctx.ref_bus_buffer, ctx.spk_ref_buffer, ctx.bus_frame_size);
+          audio_kernels::apply_gain(ctx.spk_ref_buffer, ctx.out_frame_size, ref_scale);
+        } else {
+          // Already at the output rate: scale straight into the AEC reference (fused scale + copy)
+          audio_kernels::scale_copy(ctx.ref_bus_buffer, ctx.spk_ref_buffer, ctx.out_frame_size, ref_scale);
+        }
+        // Same frame pair the AEC sees: feeds the delay estimate while one is armed
+        this->delay_estimator_.capture(ctx.mic_buffer, ctx.spk_ref_buffer, ctx.out_frame_size);
       } else {
         memset(ctx.spk_ref_buffer, 0, ctx.out_frame_bytes);
-      }
-
-      float ref_scale = ctx.aec_ref_volume * ctx.mic_attenuation;
-      if (ref_scale != 1.0f) {
-        for (size_t i = 0; i < ctx.out_frame_size; i++) {
-          ctx.spk_ref_buffer[i] = scale_sample(ctx.spk_ref_buffer[i], ref_scale);
-        }
+        this->metrics_.ref_underruns.fetch_add(1, std::memory_order_relaxed);
       }
     }
     // Stereo mode: spk_ref_buffer already filled from deinterleave. Match mic_attenuation only.
-    if (ctx.use_stereo_aec_ref && ctx.mic_attenuation != 1.0f) {
-      for (size_t i = 0; i < ctx.out_frame_size; i++) {
-        ctx.spk_ref_buffer[i] = scale_sample(ctx.spk_ref_buffer[i], ctx.mic_attenuation);
-      }
+    if (ctx.use_stereo_aec_ref) {
+      audio_kernels::apply_gain(ctx.spk_ref_buffer, ctx.out_frame_size, ctx.mic_attenuation);
     }
 
-    this->aec_->process(ctx.mic_buffer, ctx.spk_ref_buffer, ctx.aec_output, ctx.out_frame_size);
+    {
+      ScopedStage stage(this->metrics_.stage(DuplexStage::AEC));
+      this->aec_->process(ctx.mic_buffer, ctx.spk_ref_buffer, ctx.aec_output, ctx.out_frame_size);
+    }
     ctx.output_buffer = ctx.aec_output;
   }
 #endif
 
   // Apply mic gain (snapshot value)
-  if (ctx.mic_gain != 1.0f) {
-    for (size_t i = 0; i < ctx.out_frame_size; i++) {
-      ctx.output_buffer[i] = scale_sample(ctx.output_buffer[i], ctx.mic_gain);
-    }
-  }
+  audio_kernels::apply_gain(ctx.output_buffer, ctx.out_frame_size, ctx.mic_gain);
 
-  // Post-AEC callbacks (VA/STT)
-  if (ctx.mic_running) {
+  // Post-AEC fan-out (VA/STT, intercom)
+  if (ctx.mic_running && (!this->mic_callbacks_.empty() || this->mic_frame_pool_.has_readers())) {
+    const int64_t start_us = esp_timer_get_time();
+    if (this->mic_frame_pool_.has_readers()) {
+      this->mic_frame_pool_.publish((const uint8_t *) ctx.output_buffer, ctx.out_frame_bytes);
+    }
     for (auto &callback : this->mic_callbacks_) {
       callback((const uint8_t *) ctx.output_buffer, ctx.out_frame_bytes);
     }
+    callbacks_us += static_cast<uint32_t>(esp_timer_get_time() - start_us);
+  }
+  if (ctx.mic_running) {
+    this->metrics_.stage(DuplexStage::CALLBACKS).record(callbacks_us);
   }
 }
 
+// Reference ring requests forwarded by audio_task_, then a pending delay estimate.
+// Runs in the ring's reader: audio_task_, or aec_task_ when the AEC is pipelined.
+void I2SAudioDuplex::service_ref_ring_(AudioTaskCtx &ctx) {
+  const uint8_t requests = this->ref_requests_.exchange(0, std::memory_order_relaxed);
+  if ((requests & REF_REQUEST_RESET) && this->speaker_ref_buffer_)
+    this->speaker_ref_buffer_->reset();
+  if (requests & REF_REQUEST_PREFILL)
+    this->prefill_aec_ref_buffer_();
+#ifdef USE_ESP_AEC
+  this->apply_ref_delay_estimate_(ctx);
+#endif
+}
+
+// Mono reference mode: move the reference ring buffer to the lag loop() measured.
+// Runs in the ring's reader (see service_ref_ring_): pads silence to delay the reference further,
+// or drops samples to advance it, so no lock is needed against play().
+void I2SAudioDuplex::apply_ref_delay_estimate_(AudioTaskCtx &ctx) {
+  int32_t lag;
+  float confidence;
+  if (!this->delay_estimator_.take_result(lag, confidence) || this->speaker_ref_buffer_ == nullptr)
+    return;
+
+  // The estimate is in output-rate samples; the ring holds speaker-rate samples
+  const uint32_t old_bytes = this->aec_ref_delay_bytes_.load(std::memory_order_relaxed);
+  const uint32_t ring_ratio = ctx.spk_output_rate ? 1 : ctx.ratio;
+  int64_t target = static_cast<int64_t>(old_bytes) + static_cast<int64_t>(lag) * ring_ratio * BYTES_PER_SAMPLE;
+  target = std::max<int64_t>(0, std::min<int64_t>(target, this->aec_ref_delay_max_bytes_));
+  uint32_t new_bytes = old_bytes;
+
+  if (target > static_cast<int64_t>(old_bytes)) {
+    this->speaker_ref_buffer_->pad_silence(static_cast<size_t>(target) - old_bytes);
+    new_bytes = static_cast<uint32_t>(target);
+  } else if (target < static_cast<int64_t>(old_bytes)) {
+    new_bytes -= static_cast<uint32_t>(this->speaker_ref_buffer_->skip(old_bytes - static_cast<size_t>(target)));
+  }
+
+  this->aec_ref_delay_bytes_.store(new_bytes, std::memory_order_relaxed);
+  ctx.aec_delay_bytes = new_bytes;
+  const uint32_t speaker_rate = this->get_speaker_sample_rate();
+  ESP_LOGI(TAG, "AEC reference delay %ums -> %ums (lag %+dms, correlation %.2f)",
+           (unsigned)(old_bytes / BYTES_PER_SAMPLE * 1000 / speaker_rate),
+           (unsigned)(new_bytes / BYTES_PER_SAMPLE * 1000 / speaker_rate),
+           (int)(lag * 1000 / (int32_t)this->get_output_sample_rate()), confidence);
+}
+
 // ════════════════════════════════════════════════════════════════════════════
-// TX PATH: ring buffer read → volume → format expand → I2S write
+// TX PATH: ring buffer read (or stream mix) → volume → (interpolate) → format expand → I2S write
 // ════════════════════════════════════════════════════════════════════════════
 void I2SAudioDuplex::process_tx_path_(AudioTaskCtx &ctx) {
   if (!this->tx_handle_)
     return;
 
-  if (ctx.speaker_running) {
-    size_t got = this->speaker_buffer_->read((void *) ctx.spk_buffer, ctx.bus_frame_bytes, 0);
+  if (ctx.speaker_running && ctx.tx_mixing) {
+    int16_t *frame = ctx.spk_output_rate ? ctx.spk_in_buffer : ctx.spk_buffer;
+    const bool played = this->mix_tx_streams_(ctx, frame);
+#ifdef USE_ESP_AEC
+    // The reference is the mix itself, before the master volume like play()'s reference
+    if (played && this->speaker_ref_buffer_ != nullptr && !ctx.use_stereo_aec_ref && !ctx.use_tdm_ref) {
+      this->speaker_ref_buffer_->write(frame, ctx.spk_frame_bytes);
+    }
+#endif
+    if (ctx.speaker_paused) {
+      memset(frame, 0, ctx.spk_frame_bytes);
+    } else if (played) {
+      audio_kernels::apply_gain(frame, ctx.spk_frame_bytes / sizeof(int16_t), ctx.speaker_volume);
+    }
+    if (ctx.spk_output_rate) {
+      this->play_interpolator_.process(frame, ctx.spk_buffer, ctx.out_frame_size);
+    }
+  } else if (ctx.speaker_running) {
+    // Output-rate ring: volume on the short frame, then up to the bus rate
+    int16_t *frame = ctx.spk_output_rate ? ctx.spk_in_buffer : ctx.spk_buffer;
+    const size_t frame_bytes = ctx.spk_frame_bytes;
+    this->metrics_.ring(DuplexRing::SPEAKER).sample(this->speaker_buffer_->available());
+    size_t got = this->speaker_buffer_->read(frame, frame_bytes);
+    // Short frame while audio is still flowing = underrun (idle silence is not counted)
+    if (got < frame_bytes && !ctx.speaker_paused &&
+        ctx.now_ms - this->last_speaker_audio_ms_.load(std::memory_order_relaxed) <= AEC_ACTIVE_TIMEOUT_MS) {
+      this->metrics_.speaker_underruns.fetch_add(1, std::memory_order_relaxed);
+    }
 
     if (ctx.speaker_paused) {
-      memset(ctx.spk_buffer, 0, ctx.bus_frame_bytes);
+      memset(frame, 0, frame_bytes);
     } else if (got > 0) {
-      if (ctx.speaker_volume != 1.0f) {
-        size_t got_samples = got / sizeof(int16_t);
-        for (size_t i = 0; i < got_samples; i++) {
-          ctx.spk_buffer[i] = scale_sample(ctx.spk_buffer[i], ctx.speaker_volume);
-        }
-      }
-      if (got < ctx.bus_frame_bytes) {
-        memset(((uint8_t *) ctx.spk_buffer) + got, 0, ctx.bus_frame_bytes - got);
+      audio_kernels::apply_gain(frame, got / sizeof(int16_t), ctx.speaker_volume);
+      if (got < frame_bytes) {
+        memset(((uint8_t *) frame) + got, 0, frame_bytes - got);
       }
     } else {
-      memset(ctx.spk_buffer, 0, ctx.bus_frame_bytes);
+      memset(frame, 0, frame_bytes);
+    }
+    if (ctx.spk_output_rate) {
+      this->play_interpolator_.process(frame, ctx.spk_buffer, ctx.out_frame_size);
     }
   } else {
     memset(ctx.spk_buffer, 0, ctx.bus_frame_bytes);
@@ -1043,8 +1690,13 @@ void I2SAudioDuplex::process_tx_path_(AudioTaskCtx &ctx) {
   }
 
   size_t bytes_written;
-  esp_err_t err = i2s_channel_write(this->tx_handle_, tx_data, tx_bytes, &bytes_written, I2S_IO_TIMEOUT_MS);
+  esp_err_t err;
+  {
+    ScopedStage stage(this->metrics_.stage(DuplexStage::I2S_WRITE));
+    err = i2s_channel_write(this->tx_handle_, tx_data, tx_bytes, &bytes_written, I2S_IO_TIMEOUT_MS);
+  }
   if (err != ESP_OK && err != ESP_ERR_TIMEOUT && err != ESP_ERR_INVALID_STATE) {
+    this->metrics_.i2s_errors.fetch_add(1, std::memory_order_relaxed);
     ESP_LOGW(TAG, "i2s_channel_write failed: %s", esp_err_to_name(err));
     if (++ctx.consecutive_i2s_errors > 100) {
       ESP_LOGE(TAG, "Persistent I2S write errors (%d)", ctx.consecutive_i2s_errors);
@@ -1055,21 +1707,154 @@ void I2SAudioDuplex::process_tx_path_(AudioTaskCtx &ctx) {
     ctx.consecutive_i2s_errors = 0;
   }
 
-  // Report frames played (for mixer pending_playback tracking)
+  // Report frames played (for mixer pending_playback tracking), at the rate play() takes
   if (err == ESP_OK && bytes_written > 0 && !this->speaker_output_callbacks_.empty()) {
     uint32_t frames_played = ctx.use_tdm_ref
         ? bytes_written / (ctx.tdm_total_slots * ctx.i2s_bps)
         : bytes_written / (ctx.num_ch * ctx.i2s_bps);
+    if (ctx.spk_output_rate) frames_played /= ctx.ratio;
     int64_t timestamp = esp_timer_get_time();
     for (auto &cb : this->speaker_output_callbacks_) {
-      cb(frames_played, timestamp);
+      if (!ctx.tx_mixing) {
+        cb.callback(frames_played, timestamp);
+      } else if (cb.stream < this->tx_stream_count_ && this->tx_streams_[cb.stream].played_bytes > 0) {
+        // Each stream reports what it played, which is less than the frame after an underrun
+        cb.callback(static_cast<uint32_t>(this->tx_streams_[cb.stream].played_bytes / sizeof(int16_t)), timestamp);
+      }
+    }
+  }
+}
+
+bool I2SAudioDuplex::mix_tx_streams_(AudioTaskCtx &ctx, int16_t *frame) {
+  const size_t frame_bytes = ctx.spk_frame_bytes;
+  memset(frame, 0, frame_bytes);
+
+  // Highest priority among the streams playing now: every stream below it is ducked
+  int top_priority = -1;
+  for (uint8_t i = 0; i < this->tx_stream_count_; i++) {
+    const TxStream &s = this->tx_streams_[i];
+    if (s.running.load(std::memory_order_relaxed) && !s.paused.load(std::memory_order_relaxed) &&
+        ctx.now_ms - s.last_audio_ms.load(std::memory_order_relaxed) <= TX_DUCK_HOLD_MS) {
+      top_priority = std::max<int>(top_priority, s.priority);
+    }
+  }
+
+  bool played = false;
+  size_t peak_fill = 0;
+  for (uint8_t i = 0; i < this->tx_stream_count_; i++) {
+    TxStream &s = this->tx_streams_[i];
+    s.played_bytes = 0;
+    if (s.reset_requested.exchange(false, std::memory_order_relaxed)) {
+      s.ring->reset();
+      s.gain_q15 = 0;  // A new session fades in over its first frame
+    }
+    if (!s.running.load(std::memory_order_relaxed) || s.paused.load(std::memory_order_relaxed)) {
+      s.gain_q15 = 0;  // Paused streams keep their audio and fade back in on resume
+      continue;
+    }
+
+    peak_fill = std::max(peak_fill, s.ring->available());
+    const size_t got = s.ring->read(ctx.mix_buffer, frame_bytes);
+    if (got < frame_bytes &&
+        ctx.now_ms - s.last_audio_ms.load(std::memory_order_relaxed) <= AEC_ACTIVE_TIMEOUT_MS) {
+      this->metrics_.speaker_underruns.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (got == 0) continue;
+
+    const float duck = static_cast<int>(s.priority) < top_priority ? s.duck_gain : 1.0f;
+    const int32_t gain = audio_kernels::mix_gain_q15(s.volume.load(std::memory_order_relaxed) * duck);
+    audio_kernels::mix_add(ctx.mix_buffer, frame, got / sizeof(int16_t), s.gain_q15, gain);
+    s.gain_q15 = gain;
+    s.played_bytes = got;
+    played = true;
+  }
+  this->metrics_.ring(DuplexRing::SPEAKER).sample(peak_fill);
+  return played;
+}
+
+bool I2SAudioDuplex::audio_task_alive_() const {
+  // audio_task_handle_ is only valid until the task deletes itself
+  return this->audio_task_handle_ != nullptr && this->duplex_running_.load(std::memory_order_relaxed) &&
+         !this->task_exited_.load(std::memory_order_relaxed);
+}
+
+uint32_t I2SAudioDuplex::get_task_stack_free() const {
+  if (!this->audio_task_alive_()) return 0;
+  // ESP-IDF reports the high-water mark in bytes
+  return static_cast<uint32_t>(uxTaskGetStackHighWaterMark(this->audio_task_handle_));
+}
+
+bool I2SAudioDuplex::get_task_run_time_us(uint32_t &run_time_us) const {
+#if configGENERATE_RUN_TIME_STATS
+  if (!this->audio_task_alive_()) return false;
+  run_time_us = static_cast<uint32_t>(ulTaskGetRunTimeCounter(this->audio_task_handle_));
+  return true;
+#else
+  return false;
+#endif
+}
+
+void I2SAudioDuplex::dump_metrics() {
+  static const char *const stage_names[] = {"i2s_read", "decimate", "aec", "callbacks", "i2s_write"};
+  static const char *const ring_names[] = {"speaker_buffer", "speaker_ref_buffer"};
+
+  ESP_LOGI(TAG, "Metrics:");
+  for (size_t i = 0; i < static_cast<size_t>(DuplexStage::COUNT); i++) {
+    const StageTimer &t = this->metrics_.stages[i];
+    uint32_t count = t.count.load(std::memory_order_relaxed);
+    if (count == 0) continue;
+    ESP_LOGI(TAG, "  %-9s last=%uus avg=%uus peak=%uus (n=%u)", stage_names[i],
+             (unsigned) t.last_us.load(std::memory_order_relaxed),
+             (unsigned) (t.total_us.load(std::memory_order_relaxed) / count),
+             (unsigned) t.peak_us.load(std::memory_order_relaxed), (unsigned) count);
+  }
+  for (size_t i = 0; i < static_cast<size_t>(DuplexRing::COUNT); i++) {
+    const FillWatermark &w = this->metrics_.rings[i];
+    uint32_t low = w.low.load(std::memory_order_relaxed);
+    if (low == UINT32_MAX) continue;
+    ESP_LOGI(TAG, "  %s fill: low=%u high=%u bytes", ring_names[i], (unsigned) low,
+             (unsigned) w.high.load(std::memory_order_relaxed));
+  }
+  ESP_LOGI(TAG, "  play dropped=%u bytes, speaker underruns=%u, ref underruns=%u, i2s errors=%u",
+           (unsigned) this->metrics_.play_dropped_bytes.load(std::memory_order_relaxed),
+           (unsigned) this->metrics_.speaker_underruns.load(std::memory_order_relaxed),
+           (unsigned) this->metrics_.ref_underruns.load(std::memory_order_relaxed),
+           (unsigned) this->metrics_.i2s_errors.load(std::memory_order_relaxed));
+  if (this->idle_suspend_ms_ > 0) {
+    const StageTimer &r = this->metrics_.resume;
+    const uint32_t resumes = r.count.load(std::memory_order_relaxed);
+    ESP_LOGI(TAG, "  idle suspends=%u%s, resume last=%uus avg=%uus peak=%uus",
+             (unsigned) this->metrics_.idle_suspends.load(std::memory_order_relaxed),
+             this->is_suspended() ? " (suspended)" : "", (unsigned) r.last_us.load(std::memory_order_relaxed),
+             (unsigned) (resumes > 0 ? r.total_us.load(std::memory_order_relaxed) / resumes : 0),
+             (unsigned) r.peak_us.load(std::memory_order_relaxed));
+  }
+  if (this->aec_pipeline_) {
+    ESP_LOGI(TAG, "  aec pipeline overruns=%u frames",
+             (unsigned) this->metrics_.pipeline_overruns.load(std::memory_order_relaxed));
+  }
+  static const char *const pool_names[] = {"raw", "post-aec"};
+  const FramePool *pools[] = {&this->raw_frame_pool_, &this->mic_frame_pool_};
+  for (size_t i = 0; i < 2; i++) {
+    if (pools[i]->get_depth() == 0) continue;
+    ESP_LOGI(TAG, "  %s frames: published=%u depth=%u reader overruns=%u", pool_names[i],
+             (unsigned) pools[i]->get_published(), (unsigned) pools[i]->get_depth(),
+             (unsigned) pools[i]->get_overruns());
+  }
+  if (this->audio_task_alive_()) {
+    uint32_t run_time_us = 0;
+    if (this->get_task_run_time_us(run_time_us)) {
+      ESP_LOGI(TAG, "  audio task: stack free=%u bytes, run time=%ums", (unsigned) this->get_task_stack_free(),
+               (unsigned) (run_time_us / 1000));
+    } else {
+      ESP_LOGI(TAG, "  audio task: stack free=%u bytes", (unsigned) this->get_task_stack_free());
     }
   }
 }
 
-size_t I2SAudioDuplex::get_speaker_buffer_available() const {
-  if (!this->speaker_buffer_) return 0;
-  return this->speaker_buffer_->available();
+size_t I2SAudioDuplex::get_speaker_buffer_available(uint8_t stream) const {
+  const audio_kernels::SpscRing *ring = stream < MAX_TX_STREAMS ? this->tx_streams_[stream].ring : nullptr;
+  return ring != nullptr ? ring->available() : 0;
 }
 
 size_t I2SAudioDuplex::get_speaker_buffer_size() const {
@@ -3,7 +3,6 @@
 #ifdef USE_ESP32
 
 #include "esphome/core/component.h"
-#include "esphome/core/ring_buffer.h"
 
 #include <driver/i2s_std.h>
 #if SOC_I2S_SUPPORTS_TDM
@@ -12,12 +11,24 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cstring>
 #include <functional>
 #include <vector>
 
-// Forward declare AEC processor interface (esp_aec/aec_processor.h)
+#include "esphome/components/audio_kernels/aec_owner.h"
+#include "esphome/components/audio_kernels/audio_arena.h"
+#include "esphome/components/audio_kernels/audio_kernels.h"
+#include "esphome/components/audio_kernels/delay_estimator.h"
+#include "esphome/components/audio_kernels/spsc_ring.h"
+
+#include "duplex_metrics.h"
+#include "fir_filters.h"
+#include "frame_pool.h"
+#include "rx_kernel.h"
+
+// Forward declare AEC processor interface (audio_kernels/aec_processor.h)
 namespace esphome {
 class AecProcessor;
 }  // namespace esphome
@@ -28,6 +39,9 @@ namespace i2s_audio_duplex {
 // Maximum listener count for microphone/speaker reference counting
 static constexpr UBaseType_t MAX_LISTENERS = 16;
 
+// Output frame without an AEC (frame_duration), 256 samples at 16 kHz
+static constexpr uint32_t DEFAULT_FRAME_DURATION_MS = 16;
+
 // Callback type for mic data: receives raw PCM samples (pointer + length, zero-copy).
 // IMPORTANT: Callbacks are invoked from the audio task (high priority, Core 0).
 // They MUST NOT block, allocate memory, do network I/O, or hold locks.
@@ -37,77 +51,36 @@ using MicDataCallback = std::function<void(const uint8_t *data, size_t len)>;
 // Same real-time constraints as MicDataCallback apply.
 using SpeakerOutputCallback = std::function<void(uint32_t frames, int64_t timestamp)>;
 
-// FIR coefficients: 32-tap (31 original + 1 zero pad), cutoff=7500Hz, fs=48kHz, Kaiser beta=8.0
-// Unity DC gain, ~35dB stopband attenuation (adequate for speech), symmetric (linear phase)
-// Padded to power-of-2 so modulo can use bitmask (& 0x1F) instead of division
-static constexpr size_t FIR_NUM_TAPS = 32;
-static constexpr float FIR_COEFFS[FIR_NUM_TAPS] = {
-    4.1270231666e-05f, 2.1633893589e-04f, 1.2531119530e-04f, -9.9999988238e-04f,
-    -2.6821920740e-03f, -1.8518117881e-03f, 4.4563387256e-03f, 1.2653483833e-02f,
-    1.0683467077e-02f, -1.0893520506e-02f, -4.0743026823e-02f, -4.2934182572e-02f,
-    1.7799016112e-02f, 1.3755146771e-01f, 2.6031620059e-01f, 3.1252367847e-01f,
-    2.6031620059e-01f, 1.3755146771e-01f, 1.7799016112e-02f, -4.2934182572e-02f,
-    -4.0743026823e-02f, -1.0893520506e-02f, 1.0683467077e-02f, 1.2653483833e-02f,
-    4.4563387256e-03f, -1.8518117881e-03f, -2.6821920740e-03f, -9.9999988238e-04f,
-    1.2531119530e-04f, 2.1633893589e-04f, 4.1270231666e-05f, 0.0f,
+// TX mixer: duplex speakers sharing one bus (ringtone, media/TTS, intercom...)
+static constexpr size_t MAX_TX_STREAMS = 4;
+
+// One speaker platform's input to the TX mixer. With a single duplex speaker there is no
+// mixer: stream 0 is speaker_buffer_ and the TX path is the plain copy it always was.
+// With several, process_tx_path_() sums every running stream into the frame, each at its
+// own volume, and ducks it while a stream of higher priority plays.
+struct TxStream {
+  const char *name{""};
+  uint8_t priority{0};
+  float duck_gain{1.0f};                      // Applied while a higher-priority stream plays
+  audio_kernels::SpscRing *ring{nullptr};     // Stream 0: speaker_buffer_
+  std::unique_ptr<audio_kernels::SpscRing> own_ring;
+  // Written by the speaker platform (main loop / play() caller), read by audio_task_
+  std::atomic<bool> running{false};
+  std::atomic<bool> paused{false};
+  std::atomic<bool> reset_requested{false};
+  std::atomic<float> volume{1.0f};
+  std::atomic<uint32_t> last_audio_ms{0};
+  // audio_task_ only
+  int32_t gain_q15{0};     // Gain at the end of the last frame: the next frame ramps from it
+  size_t played_bytes{0};  // Read in the current frame (frames-played callbacks)
 };
 
-// Lightweight FIR decimator: consumes (in_count) samples at high rate,
-// produces (in_count / ratio) samples at low rate.
-// Uses float accumulation for robustness (ESP32-S3 has hardware FPU).
-// When ratio == 1, process() is a simple memcpy (zero overhead for legacy configs).
-class FirDecimator {
- public:
-  void init(uint32_t ratio) {
-    this->ratio_ = ratio;
-    this->reset();
-  }
-
-  void reset() {
-    memset(this->delay_line_, 0, sizeof(this->delay_line_));
-    this->delay_pos_ = 0;
-  }
-
-  // Decimate in_count input samples to (in_count / ratio) output samples.
-  // in_count MUST be a multiple of ratio.
-  void process(const int16_t *in, int16_t *out, size_t in_count) {
-    if (this->ratio_ <= 1) {
-      memcpy(out, in, in_count * sizeof(int16_t));
-      return;
-    }
-
-    size_t out_count = in_count / this->ratio_;
-    for (size_t o = 0; o < out_count; o++) {
-      // Push ratio_ new samples into the delay line
-      for (uint32_t r = 0; r < this->ratio_; r++) {
-        this->delay_line_[this->delay_pos_] = static_cast<float>(*in++);
-        this->delay_pos_ = (this->delay_pos_ + 1) & (FIR_NUM_TAPS - 1);
-      }
-
-      // Convolve: FIR filter output
-      float acc = 0.0f;
-      uint32_t idx = this->delay_pos_;
-      for (size_t t = 0; t < FIR_NUM_TAPS; t++) {
-        acc += this->delay_line_[idx] * FIR_COEFFS[t];
-        idx = (idx + 1) & (FIR_NUM_TAPS - 1);
-      }
-
-      // Clamp to int16 range
-      if (acc > 32767.0f) acc = 32767.0f;
-      if (acc < -32768.0f) acc = -32768.0f;
-      out[o] = static_cast<int16_t>(acc);
-    }
-  }
-
- private:
-  uint32_t ratio_{1};
-  float delay_line_[FIR_NUM_TAPS]{};
-  uint32_t delay_pos_{0};
-};
-
-class I2SAudioDuplex : public Component {
+// AecOwner: components consuming the mic/speaker platforms (intercom_api) toggle this
+// component's AEC instead of running their own pass over the same frames
+class I2SAudioDuplex : public Component, public audio_kernels::AecOwner {
  public:
   void setup() override;
+  void loop() override;
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::HARDWARE; }
 
@@ -119,6 +92,9 @@ class I2SAudioDuplex : public Component {
   void set_dout_pin(int pin) { this->dout_pin_ = pin; }
   void set_sample_rate(uint32_t rate) { this->sample_rate_ = rate; }
   void set_output_sample_rate(uint32_t rate) { this->output_sample_rate_ = rate; }
+  // Output frame without an AEC (10/16/20/32 ms); with one the AEC chunk sets the frame
+  void set_frame_duration_ms(uint32_t ms) { this->frame_duration_ms_ = ms; }
+  uint32_t get_frame_duration_ms() const override;
   void set_bits_per_sample(uint8_t bps) { this->bits_per_sample_ = bps; }
   uint8_t get_bits_per_sample() const { return this->bits_per_sample_; }
   void set_correct_dc_offset(bool enabled) { this->correct_dc_offset_ = enabled; }
@@ -134,8 +110,9 @@ class I2SAudioDuplex : public Component {
 
   // AEC setter
   void set_aec(AecProcessor *aec);
-  void set_aec_enabled(bool enabled) { this->aec_enabled_.store(enabled, std::memory_order_relaxed); }
-  bool is_aec_enabled() const { return this->aec_enabled_.load(std::memory_order_relaxed); }
+  bool has_aec() const override { return this->aec_ != nullptr; }
+  void set_aec_enabled(bool enabled) override { this->aec_enabled_.store(enabled, std::memory_order_relaxed); }
+  bool is_aec_enabled() const override { return this->aec_enabled_.load(std::memory_order_relaxed); }
 
   // Volume control (0.0 - 1.0). Atomic: written from main loop, read from audio task.
   void set_mic_gain(float gain) { this->mic_gain_.store(gain, std::memory_order_relaxed); }
@@ -151,9 +128,13 @@ class I2SAudioDuplex : public Component {
   void set_aec_reference_volume(float volume) { this->aec_ref_volume_.store(volume, std::memory_order_relaxed); }
   float get_aec_reference_volume() const { return this->aec_ref_volume_.load(std::memory_order_relaxed); }
 
-  // AEC reference delay - acoustic path delay in milliseconds
+  // AEC reference delay - acoustic path delay in milliseconds (starting point when estimated)
   void set_aec_reference_delay_ms(uint32_t delay_ms) { this->aec_ref_delay_ms_ = delay_ms; }
-  uint32_t get_aec_reference_delay_ms() const { return this->aec_ref_delay_ms_; }
+  // Effective delay: the configured value, or the current estimate
+  uint32_t get_aec_reference_delay_ms() const override;
+  // Mono reference mode: measure the mic-vs-reference lag at the start of each playback
+  // session and move the reference ring buffer delay to it (delay_estimator.h)
+  void set_aec_reference_delay_estimation(bool enabled) { this->aec_delay_estimation_ = enabled; }
 
   // ES8311 Digital Feedback mode: RX is stereo with L=DAC(ref), R=ADC(mic)
   void set_use_stereo_aec_reference(bool use) { this->use_stereo_aec_ref_ = use; }
@@ -168,18 +149,45 @@ class I2SAudioDuplex : public Component {
   void set_tdm_total_slots(uint8_t n) { this->tdm_total_slots_ = n; }
   void set_tdm_mic_slot(uint8_t slot) { this->tdm_mic_slot_ = slot; }
   void set_tdm_ref_slot(uint8_t slot) { this->tdm_ref_slot_ = slot; }
+  // Further mic slots for a multi-mic AEC backend (AecProcessor::get_mic_num() > 1)
+  void add_tdm_aux_mic_slot(uint8_t slot) {
+    if (this->tdm_aux_mic_count_ < MAX_TDM_MICS - 1) this->tdm_aux_mic_slots_[this->tdm_aux_mic_count_++] = slot;
+  }
 
   // Microphone interface
   void add_mic_data_callback(MicDataCallback callback) { this->mic_callbacks_.push_back(callback); }
   void add_raw_mic_data_callback(MicDataCallback callback) { this->raw_mic_callbacks_.push_back(callback); }
+  // Shared frame fan-out (frame_pool.h): pre_aec=true taps the raw mic, false the post-AEC output.
+  // Register during setup(); the reader must outlive this component.
+  void add_mic_frame_reader(FramePool::Reader *reader, bool pre_aec) {
+    (pre_aec ? this->raw_frame_pool_ : this->mic_frame_pool_).add_reader(reader);
+  }
+  FramePool &get_mic_frame_pool(bool pre_aec) { return pre_aec ? this->raw_frame_pool_ : this->mic_frame_pool_; }
   void start_mic();
   void stop_mic();
   bool is_mic_running() const { return this->mic_ref_count_.load(std::memory_order_relaxed) > 0; }
 
-  // Speaker interface — data arrives at bus rate (from mixer/resampler)
-  size_t play(const uint8_t *data, size_t len, TickType_t ticks_to_wait = portMAX_DELAY);
-  void start_speaker();
-  void stop_speaker();
+  // Speaker interface — data arrives at get_speaker_sample_rate(): the bus rate (from a
+  // mixer/resampler), or the output rate with speaker_rate: output (16 kHz intercom audio
+  // straight from the source, upsampled by the TX path)
+  size_t play(const uint8_t *data, size_t len, TickType_t ticks_to_wait = portMAX_DELAY) {
+    return this->play_stream(0, data, len, ticks_to_wait);
+  }
+  // TX mixer: every duplex speaker registers a stream before setup() and plays into it
+  uint8_t add_tx_stream(const char *name, uint8_t priority, float duck_gain);
+  uint8_t get_tx_stream_count() const { return this->tx_stream_count_; }
+  bool is_mixing() const { return this->tx_stream_count_ > 1; }
+  size_t play_stream(uint8_t stream, const uint8_t *data, size_t len, TickType_t ticks_to_wait);
+  // Single stream: the master speaker volume/pause, as before. Mixing: that stream's own
+  void set_stream_volume(uint8_t stream, float volume);
+  void set_stream_paused(uint8_t stream, bool paused);
+  void set_speaker_output_rate(bool output_rate) { this->speaker_output_rate_ = output_rate; }
+  bool is_speaker_output_rate() const { return this->speaker_output_rate_ && this->decimation_ratio_ > 1; }
+  uint32_t get_speaker_sample_rate() const {
+    return this->is_speaker_output_rate() ? this->get_output_sample_rate() : this->sample_rate_;
+  }
+  void start_speaker(uint8_t stream = 0);
+  void stop_speaker(uint8_t stream = 0);
   bool is_speaker_running() const { return this->speaker_running_.load(std::memory_order_relaxed); }
   void set_speaker_paused(bool paused) { this->speaker_paused_.store(paused, std::memory_order_relaxed); }
   bool is_speaker_paused() const { return this->speaker_paused_.load(std::memory_order_relaxed); }
@@ -189,11 +197,14 @@ class I2SAudioDuplex : public Component {
   void stop();   // Stop both
 
   bool is_running() const { return this->duplex_running_.load(std::memory_order_relaxed); }
+  // I2S DMA stopped by idle_suspend: no mic or speaker user, the audio task is blocked
+  bool is_suspended() const { return this->suspended_.load(std::memory_order_relaxed); }
   bool has_i2s_error() const { return this->has_i2s_error_.load(std::memory_order_relaxed); }
 
   // Speaker output callback registration (for mixer pending_playback_frames tracking)
-  void add_speaker_output_callback(SpeakerOutputCallback callback) {
-    this->speaker_output_callbacks_.push_back(std::move(callback));
+  // Mixing: only called for frames the stream played audio in
+  void add_speaker_output_callback(SpeakerOutputCallback callback, uint8_t stream = 0) {
+    this->speaker_output_callbacks_.push_back({stream, std::move(callback)});
   }
 
   // Getters for platform wrappers
@@ -203,7 +214,7 @@ class I2SAudioDuplex : public Component {
   uint32_t get_output_sample_rate() const {
     return this->output_sample_rate_ > 0 ? this->output_sample_rate_ : this->sample_rate_;
   }
-  size_t get_speaker_buffer_available() const;
+  size_t get_speaker_buffer_available(uint8_t stream = 0) const;
   size_t get_speaker_buffer_size() const;
 
   // Task configuration (settable from YAML)
@@ -211,19 +222,44 @@ class I2SAudioDuplex : public Component {
   void set_task_core(int8_t core) { this->task_core_ = core; }
   void set_task_stack_size(uint32_t size) { this->task_stack_size_ = size; }
   void set_buffers_in_psram(bool psram) { this->buffers_in_psram_ = psram; }
+  // Two-stage pipeline: AEC + mic callbacks on their own task, one frame behind the I2S task
+  void set_aec_pipeline(bool pipeline) { this->aec_pipeline_ = pipeline; }
+  void set_aec_task_priority(uint8_t prio) { this->aec_task_priority_ = prio; }
+  void set_aec_task_core(int8_t core) { this->aec_task_core_ = core; }
+  // Stop I2S DMA after this long without a mic or speaker user (0 = keep it running)
+  void set_idle_suspend_ms(uint32_t ms) { this->idle_suspend_ms_ = ms; }
+
+  // Audio task metrics (counters only, see duplex_metrics.h)
+  DuplexMetrics &get_metrics() { return this->metrics_; }
+  // Free stack of the audio task in bytes, 0 while it is not running
+  uint32_t get_task_stack_free() const;
+  // Accumulated run time of the audio task in us; false without FreeRTOS run time stats
+  bool get_task_run_time_us(uint32_t &run_time_us) const;
+  // Log every metric once - lambda: id(duplex).dump_metrics();
+  void dump_metrics();
 
  protected:
   bool init_i2s_duplex_();
   void deinit_i2s_();
   void prefill_aec_ref_buffer_();
+  bool audio_task_alive_() const;
+  // idle_suspend: a microphone or the speaker platform holds the bus
+  bool in_use_() const;
+  void wake_suspended_task_();
+#ifdef USE_I2S_DUPLEX_Q15_FIR
+  void check_fir_backend_();
+  void check_interpolator_backend_();
+#endif
 
   static void audio_task(void *param);
   void audio_task_();
+  static void aec_task(void *param);
+  void aec_task_();
 
   // Audio task context: groups all buffers, sizes, and per-frame snapshots
   // to avoid long parameter lists in the refactored processing functions.
   struct AudioTaskCtx {
-    // ── Invariants (set once at task start) ──
+    // ── Invariants (set once in setup()) ──
     uint32_t ratio{1};
     uint8_t i2s_bps{2};       // 2 or 4 bytes per I2S sample
     uint8_t num_ch{1};        // TX channels
@@ -231,38 +267,45 @@ class I2SAudioDuplex : public Component {
     bool use_tdm_ref{false};
     bool ref_channel_right{false};
     bool correct_dc_offset{false};
+    bool spk_output_rate{false};  // Speaker/reference rings at output rate: TX interpolates, no ref decimation
+    bool tx_mixing{false};        // Two or more duplex speakers: the TX path mixes their streams
     uint8_t tdm_total_slots{0};
     uint8_t tdm_mic_slot{0};
     uint8_t tdm_ref_slot{0};
+    uint8_t tdm_mic_count{1};                  // Mics passed to the AEC (1 + aux slots in use)
+    uint8_t tdm_slots[MAX_TDM_MICS + 1]{};     // Deinterleave order: mics, then the reference
+    RxKernelFn rx_kernel{nullptr};             // Fused RX kernel for this bus (select_rx_kernel())
 
     // ── Frame sizing ──
     size_t out_frame_size{0};
     size_t bus_frame_size{0};
     size_t out_frame_bytes{0};
     size_t bus_frame_bytes{0};
+    size_t spk_frame_bytes{0};  // One frame in the speaker/reference rings (out or bus frame)
     size_t rx_frame_bytes{0};
     size_t tdm_tx_frame_bytes{0};
     size_t aec_delay_bytes{0};
 
-    // ── Working buffers (heap-allocated, owned by audio_task_) ──
+    // ── Working buffers (audio arena, carved in setup(); used by audio_task_ / aec_task_) ──
     int16_t *rx_buffer{nullptr};
     int16_t *mic_buffer{nullptr};
     int16_t *spk_buffer{nullptr};
+    int16_t *spk_in_buffer{nullptr};  // Output-rate speaker frame before interpolation (spk_output_rate)
     int16_t *spk_ref_buffer{nullptr};
-    int16_t *deint_ref{nullptr};
-    int16_t *deint_mic{nullptr};
-    int16_t *tdm_deint_mic{nullptr};
-    int16_t *tdm_deint_ref{nullptr};
+    int16_t *rx_scratch{nullptr};  // Fused RX kernel block scratch (rx_scratch_samples())
+    int16_t *aux_mic[MAX_TDM_MICS - 1]{};        // Aux mics at output rate
     int16_t *tdm_tx_buffer{nullptr};
     int16_t *ref_bus_buffer{nullptr};
     int16_t *aec_output{nullptr};
+    int16_t *mix_buffer{nullptr};  // One stream's frame before it is mixed in (mixing only)
 
     // ── Loop mutable state ──
     int consecutive_i2s_errors{0};
-    int32_t dc_prev_input{0};
-    int32_t dc_prev_output{0};
+    audio_kernels::DcBlocker dc_blocker;
+    audio_kernels::DcBlocker aux_dc_blockers[MAX_TDM_MICS - 1];
     int16_t *output_buffer{nullptr};  // points to mic_buffer or aec_output
     bool mic_separate{false};         // true if mic_buffer != rx_buffer
+    uint32_t idle_since_ms{0};        // Last frame with a mic or speaker user (idle_suspend)
 
     // ── Per-iteration snapshots from atomics ──
     float mic_gain{1.0f};
@@ -276,10 +319,56 @@ class I2SAudioDuplex : public Component {
     uint32_t now_ms{0};
   };
 
+  // Invariants and arena buffers of every audio_task_ run, prepared once in setup()
+  void plan_task_buffers_(audio_kernels::ArenaLayout &layout);
+  AudioTaskCtx task_ctx_;
+  size_t task_max_frame_size_{0};  // Frame the buffers in task_ctx_ were sized for
+
   // Refactored audio processing functions (called from audio_task_ main loop)
+  static void size_frames_(AudioTaskCtx &ctx, size_t out_frame_size);
   void process_rx_path_(AudioTaskCtx &ctx);
   void process_aec_and_callbacks_(AudioTaskCtx &ctx);
   void process_tx_path_(AudioTaskCtx &ctx);
+  // Mixing: sum the running streams into frame (spk_frame_bytes, before the master volume).
+  // Returns false when no stream had audio for this frame.
+  bool mix_tx_streams_(AudioTaskCtx &ctx, int16_t *frame);
+  void apply_ref_delay_estimate_(AudioTaskCtx &ctx);
+  // Reference ring reader side: reset/prefill requests and delay estimate (whichever stage runs AEC)
+  void service_ref_ring_(AudioTaskCtx &ctx);
+  void pipeline_handoff_(AudioTaskCtx &ctx);
+  // idle_suspend: stop I2S DMA and block while nothing uses the bus; false when stop() ended the wait
+  bool suspend_while_idle_(AudioTaskCtx &ctx);
+
+  // ── AEC pipeline (aec_pipeline: true) ──
+  // audio_task_ keeps I2S I/O, RX format conversion and the TX path (deterministic DMA timing);
+  // each RX frame goes through a double buffer to aec_task_, which runs AEC and the mic
+  // callbacks one frame later. A frame that finds both slots busy is dropped, not waited for.
+  static constexpr size_t PIPELINE_DEPTH = 2;
+  struct PipelineSlot {
+    int16_t *mic{nullptr};
+    int16_t *ref{nullptr};  // Stereo/TDM reference from RX (mono mode reads the ring in aec_task_)
+    int16_t *aux_mic[MAX_TDM_MICS - 1]{};  // Multi-mic TDM
+    size_t out_frame_size{0};  // Can change between frames after an AEC mode switch
+    // Snapshots taken by audio_task_ for this frame
+    float mic_gain{1.0f};
+    float mic_attenuation{1.0f};
+    float aec_ref_volume{1.0f};
+    bool aec_enabled{false};
+    bool speaker_running{false};
+    bool mic_running{false};
+    uint32_t now_ms{0};
+  };
+  PipelineSlot pipeline_slots_[PIPELINE_DEPTH];
+  std::atomic<uint32_t> pipeline_head_{0};     // Frames handed over (audio_task_)
+  std::atomic<uint32_t> pipeline_tail_{0};     // Frames processed (aec_task_)
+  std::atomic<uint32_t> pipeline_skipped_{0};  // Dropped frames whose reference aec_task_ must skip
+  std::atomic<bool> pipeline_stop_{false};
+  std::atomic<bool> aec_task_exited_{true};
+  AudioTaskCtx aec_ctx_;                       // aec_task_'s copy, taken before it starts
+  TaskHandle_t aec_task_handle_{nullptr};
+  bool aec_pipeline_{false};
+  uint8_t aec_task_priority_{18};
+  int8_t aec_task_core_{1};
 
   // Pin configuration
   int lrclk_pin_{-1};
@@ -300,12 +389,25 @@ class I2SAudioDuplex : public Component {
   bool mic_channel_right_{false};      // RX mono slot: false=LEFT, true=RIGHT
   uint8_t slot_bit_width_{0};          // 0 = auto (match bits_per_sample), or 16/24/32
   uint32_t output_sample_rate_{0};     // 0 = use sample_rate_ (no decimation)
+  bool speaker_output_rate_{false};    // play() takes output-rate audio (speaker_rate: output)
+  uint32_t frame_duration_ms_{DEFAULT_FRAME_DURATION_MS};
   uint32_t decimation_ratio_{1};       // sample_rate_ / output_sample_rate_ (computed in setup)
 
   // FIR decimators for mic path
   FirDecimator mic_decimator_;
   FirDecimator ref_decimator_;          // Stereo mode: RX L channel ref
   FirDecimator play_ref_decimator_;     // Mono mode: bus-rate ref from play() decimated in audio_task
+  FirInterpolator play_interpolator_;   // speaker_rate: output, output-rate frames up to the bus rate
+  FirDecimator aux_mic_decimators_[MAX_TDM_MICS - 1];  // TDM aux mic slots
+#ifdef USE_I2S_DUPLEX_Q15_FIR
+  // Boot self-check results (one DEFAULT_FRAME_SIZE output frame, cycles)
+  uint32_t fir_q15_cycles_{0};
+  uint32_t fir_float_cycles_{0};
+  int32_t fir_q15_max_error_{0};       // Max |q15 - float| in LSB
+  uint32_t interp_q15_cycles_{0};
+  uint32_t interp_float_cycles_{0};
+  int32_t interp_q15_max_error_{0};
+#endif
 
   // I2S handles - BOTH created from single channel for duplex
   i2s_chan_handle_t tx_handle_{nullptr};
@@ -317,27 +419,52 @@ class I2SAudioDuplex : public Component {
   std::atomic<bool> speaker_running_{false};
   std::atomic<bool> speaker_paused_{false};
   std::atomic<bool> task_exited_{false};  // Set by audio_task_ before exit (avoids eTaskGetState UB)
+  // start_speaker() .. stop_speaker(). speaker_running_ is also set by start() for the TX path
+  std::atomic<bool> speaker_in_use_{false};
+  // idle_suspend: audio_task_ stopped the channels and waits for start_mic()/start_speaker()/stop().
+  // Sequentially consistent with the user counts, so a start never misses a task going to sleep.
+  std::atomic<bool> suspended_{false};
+  uint32_t idle_suspend_ms_{0};
+  std::atomic<uint32_t> wake_request_us_{0};  // esp_timer of the start that woke a suspended task
   TaskHandle_t audio_task_handle_{nullptr};
 
   // Cross-thread buffer operation requests (main thread → audio task, avoids concurrent ring buffer access)
   std::atomic<bool> request_speaker_reset_{false};
   std::atomic<bool> request_ref_prefill_{false};
+  // audio_task_ → reference ring reader (itself, or aec_task_ when pipelined)
+  static constexpr uint8_t REF_REQUEST_RESET = 1 << 0;
+  static constexpr uint8_t REF_REQUEST_PREFILL = 1 << 1;
+  std::atomic<uint8_t> ref_requests_{0};
 
   // Mic data callbacks
   std::vector<MicDataCallback> mic_callbacks_;       // Post-AEC (for VA/STT)
   std::vector<MicDataCallback> raw_mic_callbacks_;   // Pre-AEC (for MWW)
+  // Published once per frame, read by every I2SAudioDuplexMicrophone (and polled readers)
+  FramePool mic_frame_pool_;                         // Post-AEC
+  FramePool raw_frame_pool_;                         // Pre-AEC
 
   // Speaker output callbacks (for mixer pending_playback_frames tracking)
-  std::vector<SpeakerOutputCallback> speaker_output_callbacks_;
+  struct StreamOutputCallback {
+    uint8_t stream;
+    SpeakerOutputCallback callback;
+  };
+  std::vector<StreamOutputCallback> speaker_output_callbacks_;
 
-  // Speaker ring buffer — stores data at bus rate (sample_rate_)
-  std::unique_ptr<RingBuffer> speaker_buffer_;
-  size_t speaker_buffer_size_{0};  // Actual allocated size (scales with decimation_ratio_)
+  // Speaker ring buffer — stores data at get_speaker_sample_rate(). SPSC: play() writes, audio_task_ reads
+  std::unique_ptr<audio_kernels::SpscRing> speaker_buffer_;
+  size_t speaker_buffer_size_{0};  // Actual allocated size (scales with the speaker rate)
+  // TX mixer streams, one per duplex speaker (add_tx_stream()); every ring is speaker_buffer_size_
+  TxStream tx_streams_[MAX_TX_STREAMS];
+  uint8_t tx_stream_count_{0};
+  // Ducking holds this long after the higher-priority stream's last audio (gaps between TTS sentences)
+  static constexpr uint32_t TX_DUCK_HOLD_MS{500};
 
   // AEC support
   AecProcessor *aec_{nullptr};
   std::atomic<bool> aec_enabled_{false};  // Runtime toggle (only enabled when aec_ is set)
-  std::unique_ptr<RingBuffer> speaker_ref_buffer_;  // Reference for AEC (bus rate in mono mode)
+  // Reference for AEC (mono mode, at the speaker rate). SPSC: play() writes, audio_task_ reads and realigns.
+  // Mixing: audio_task_ writes the mixed frame instead, so the reference is what was played
+  std::unique_ptr<audio_kernels::SpscRing> speaker_ref_buffer_;
 
   // Volume control — atomic: written from main loop, read from audio task via snapshot.
   std::atomic<float> mic_gain_{1.0f};         // 0.0 - 2.0 (1.0 = unity gain, applied AFTER AEC)
@@ -345,6 +472,10 @@ class I2SAudioDuplex : public Component {
   std::atomic<float> speaker_volume_{1.0f};   // 0.0 - 1.0 (for digital volume, keep 1.0 if codec has hardware volume)
   std::atomic<float> aec_ref_volume_{1.0f};   // AEC reference scaling (set to codec's output volume for proper echo matching)
   uint32_t aec_ref_delay_ms_{80}; // AEC reference delay in ms (80 for separate I2S, 20-40 for ES8311)
+  bool aec_delay_estimation_{true};
+  std::atomic<uint32_t> aec_ref_delay_bytes_{0};  // Effective delay at the speaker rate (prefill + estimate corrections)
+  uint32_t aec_ref_delay_max_bytes_{0};           // Largest delay speaker_ref_buffer_ was sized for
+  audio_kernels::DelayEstimator delay_estimator_;  // Captured by audio_task_, computed in loop()
   bool use_stereo_aec_ref_{false}; // ES8311 digital feedback: RX stereo with L=ref, R=mic
   bool ref_channel_right_{false};  // Which channel is AEC reference: false=L, true=R
 
@@ -353,20 +484,26 @@ class I2SAudioDuplex : public Component {
   uint8_t tdm_total_slots_{4};
   uint8_t tdm_mic_slot_{0};    // TDM slot index for voice mic
   uint8_t tdm_ref_slot_{1};    // TDM slot index for AEC reference
+  uint8_t tdm_aux_mic_slots_[MAX_TDM_MICS - 1]{};
+  uint8_t tdm_aux_mic_count_{0};
 
   // AEC gating: only run echo canceller while speaker has recent real audio.
   std::atomic<uint32_t> last_speaker_audio_ms_{0};
   static constexpr uint32_t AEC_ACTIVE_TIMEOUT_MS{250};
+  // Idle-suspended audio task: start_mic()/start_speaker()/stop() notify it, the timeout is a safety net
+  static constexpr uint32_t IDLE_SUSPEND_WAIT_MS{5000};
 
   // Task configuration (defaults match ESP-IDF audio best practices)
   uint8_t task_priority_{19};     // Above lwIP(18), below WiFi(23)
   int8_t task_core_{0};           // Core 0: canonical Espressif AEC pattern; -1 = unpinned
   uint32_t task_stack_size_{8192};
-  bool buffers_in_psram_{false};  // Non-DMA buffers in PSRAM (saves ~15KB internal RAM)
+  bool buffers_in_psram_{false};  // Hot buffers in PSRAM too (saves ~15KB internal RAM)
 
   // Error propagation: set by audio_task_ on persistent I2S failures
   std::atomic<bool> has_i2s_error_{false};
 
+  DuplexMetrics metrics_;
+
 };
 
 }  // namespace i2s_audio_duplex
@@ -35,20 +35,11 @@ void I2SAudioDuplexMicrophone::setup() {
   // AudioStreamInfo constructor: (bits_per_sample, channels, sample_rate)
   this->audio_stream_info_ = audio::AudioStreamInfo(16, 1, this->parent_->get_output_sample_rate());
 
-  // Pre-allocate callback buffer to avoid heap allocation in the RT audio task.
-  // 2048 bytes covers worst case (1024 samples mono 16-bit, no decimation).
-  this->audio_buffer_.reserve(2048);
-
-  // Register callback with the parent I2SAudioDuplex to receive mic data
+  // Read the parent's shared frame pool (no per-microphone copy of each frame)
   // pre_aec=true: raw mic for wake word detection (not suppressed by AEC)
   // pre_aec=false: AEC-processed mic for voice assistant STT
-  if (this->pre_aec_) {
-    this->parent_->add_raw_mic_data_callback(
-        [this](const uint8_t *data, size_t len) { this->on_audio_data_(data, len); });
-  } else {
-    this->parent_->add_mic_data_callback(
-        [this](const uint8_t *data, size_t len) { this->on_audio_data_(data, len); });
-  }
+  this->frame_reader_.on_frame = [this](const std::vector<uint8_t> &frame) { this->on_frame_(frame); };
+  this->parent_->add_mic_frame_reader(&this->frame_reader_, this->pre_aec_);
 }
 
 void I2SAudioDuplexMicrophone::dump_config() {
@@ -89,18 +80,17 @@ void I2SAudioDuplexMicrophone::stop() {
   }
 }
 
-void I2SAudioDuplexMicrophone::on_audio_data_(const uint8_t *data, size_t len) {
+void I2SAudioDuplexMicrophone::on_frame_(const std::vector<uint8_t> &frame) {
   if (this->state_ != microphone::STATE_RUNNING) {
     return;
   }
 
   if (this->mute_state_) {
     // Send silence — keeps pipeline running but no real audio leaks
-    this->audio_buffer_.assign(len, 0);
+    this->data_callbacks_.call(this->parent_->get_mic_frame_pool(this->pre_aec_).silence());
   } else {
-    this->audio_buffer_.assign(data, data + len);
+    this->data_callbacks_.call(frame);
   }
-  this->data_callbacks_.call(this->audio_buffer_);
 }
 
 void I2SAudioDuplexMicrophone::loop() {
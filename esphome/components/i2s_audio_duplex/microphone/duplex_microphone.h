@@ -7,8 +7,6 @@
 #include "esphome/components/microphone/microphone.h"
 #include "../i2s_audio_duplex.h"
 
-#include <vector>
-
 #include <freertos/FreeRTOS.h>
 #include <freertos/event_groups.h>
 #include <freertos/semphr.h>
@@ -32,10 +30,11 @@ class I2SAudioDuplexMicrophone : public microphone::Microphone,
   void set_pre_aec(bool pre_aec) { this->pre_aec_ = pre_aec; }
 
  protected:
-  void on_audio_data_(const uint8_t *data, size_t len);
+  void on_frame_(const std::vector<uint8_t> &frame);
 
   bool pre_aec_{false};  // If true, receives raw (pre-AEC) mic data for wake word detection
-  std::vector<uint8_t> audio_buffer_;
+  // Cursor into the parent's shared frame pool; frames are handed to data_callbacks_ as-is
+  FramePool::Reader frame_reader_;
 
   // Reference counting for multiple listeners (voice_assistant, wake_word, intercom, etc.)
   SemaphoreHandle_t active_listeners_semaphore_{nullptr};
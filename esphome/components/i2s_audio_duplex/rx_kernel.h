@@ -0,0 +1,159 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <soc/soc_caps.h>
+
+#include "esphome/components/audio_kernels/audio_kernels.h"
+
+#include "fir_filters.h"
+
+namespace esphome {
+namespace i2s_audio_duplex {
+
+// The audio task's RX kernel. Plain C++ over FirDecimator and audio_kernels (soc_caps
+// only for TDM support), so the host harness builds it too: host/test_rx_kernel.cpp
+// checks it against the separate passes.
+
+// TDM mics fed to a multi-mic AEC backend (tdm_mic_slot + tdm_aux_mic_slots; ES7210 has 4)
+static constexpr size_t MAX_TDM_MICS = 4;
+
+// ── Fused RX kernel ──
+// The whole RX frame in one streaming pass over the I2S read buffer: 32 -> 16-bit
+// conversion, stereo/TDM deinterleave, FIR decimation, DC block and mic attenuation.
+// The frame is walked in blocks of RX_BLOCK output samples. Each block's bus frames are
+// read once into a per-channel scratch of RX_BLOCK * ratio samples (no scratch at ratio 1:
+// straight into the outputs), decimated into the output frames, and the mics get DC block
+// and attenuation while the block is still hot. Results match the separate passes sample
+// for sample (FIR and DC state carry across blocks), on both FirDecimator backends.
+//
+// Compile-time specialised on sample width, bus layout, DC on/off and ratio (1, 2 and 3;
+// other ratios share one runtime-ratio instance), picked once per config by select_rx_kernel().
+enum class RxLayout : uint8_t {
+  MONO,    // Mic only
+  STEREO,  // Mic and reference on L/R (use_stereo_aec_ref)
+  TDM,     // Mic slots and the reference slot (use_tdm_ref)
+};
+
+static constexpr size_t RX_BLOCK = 32;                      // Output samples per block (keeps 16-byte alignment)
+static constexpr size_t RX_MAX_CHANNELS = MAX_TDM_MICS + 1;  // Mics, then the reference
+
+struct RxKernelJob {
+  const void *src{nullptr};       // I2S read buffer, int16_t or int32_t samples
+  size_t out_frames{0};           // Output samples per channel
+  uint32_t ratio{1};              // Read by the runtime-ratio instance only
+  uint8_t stride{1};              // Slots per bus frame (TDM)
+  uint8_t mics{1};                // Mic channels (TDM): DC blocked and attenuated
+  uint8_t channels{1};            // Mics plus the reference (TDM)
+  const uint8_t *slots{nullptr};  // Bus slot of every channel (STEREO, TDM)
+  int16_t *out[RX_MAX_CHANNELS]{};
+  FirDecimator *fir[RX_MAX_CHANNELS]{};
+  audio_kernels::DcBlocker *dc[MAX_TDM_MICS]{};
+  audio_kernels::Gain gain;       // Mic attenuation
+  int16_t *scratch{nullptr};      // channels * RX_BLOCK * ratio samples, 16-byte aligned (ratio > 1)
+};
+
+using RxKernelFn = void (*)(const RxKernelJob &job);
+
+static inline int16_t rx_sample(int16_t sample) { return sample; }
+static inline int16_t rx_sample(int32_t sample) { return static_cast<int16_t>(sample >> 16); }
+
+// Scratch samples the kernel needs for this bus (0: decimates from the read buffer or doesn't decimate)
+static inline size_t rx_scratch_samples(bool wide, RxLayout layout, size_t channels, uint32_t ratio) {
+  if (ratio <= 1 || (!wide && layout == RxLayout::MONO)) return 0;
+  return channels * RX_BLOCK * ratio;
+}
+
+template<typename SrcT, RxLayout L, bool DC, uint32_t Ratio> void fused_rx_kernel(const RxKernelJob &job) {
+  const uint32_t ratio = Ratio != 0 ? Ratio : job.ratio;
+  const size_t stride = L == RxLayout::MONO ? 1 : L == RxLayout::STEREO ? 2 : job.stride;
+  const size_t channels = L == RxLayout::MONO ? 1 : L == RxLayout::STEREO ? 2 : job.channels;
+  const size_t mics = L == RxLayout::TDM ? job.mics : 1;
+  // 16-bit mono is already the mic channel: decimate (or attenuate in place) right from the buffer
+  constexpr bool direct = L == RxLayout::MONO && sizeof(SrcT) == sizeof(int16_t);
+  const size_t scratch_stride = RX_BLOCK * ratio;
+  uint8_t slots[RX_MAX_CHANNELS]{};
+  if (L != RxLayout::MONO) {
+    for (size_t c = 0; c < channels; c++) slots[c] = job.slots[c];
+  }
+  const SrcT *src = static_cast<const SrcT *>(job.src);
+
+  for (size_t o = 0; o < job.out_frames; o += RX_BLOCK) {
+    const size_t n = std::min(RX_BLOCK, job.out_frames - o);
+    const size_t in = n * ratio;
+    const SrcT *frame = src + o * ratio * stride;
+
+    if (direct) {
+      const int16_t *block = reinterpret_cast<const int16_t *>(frame);
+      if (Ratio == 1) {
+        if (job.out[0] + o != block) memcpy(job.out[0] + o, block, n * sizeof(int16_t));
+      } else {
+        job.fir[0]->process(block, job.out[0] + o, in);
+      }
+    } else {
+      // One pass over the block's bus frames, every channel at once. At ratio 1 this writes
+      // the outputs, which may alias the read buffer (32-bit mono): forward and never ahead
+      // of the read position, so in place is safe.
+      int16_t *dst[RX_MAX_CHANNELS];
+      for (size_t c = 0; c < channels; c++) {
+        dst[c] = Ratio == 1 ? job.out[c] + o : job.scratch + c * scratch_stride;
+      }
+      for (size_t i = 0; i < in; i++, frame += stride) {
+        for (size_t c = 0; c < channels; c++) dst[c][i] = rx_sample(frame[slots[c]]);
+      }
+      if (Ratio != 1) {
+        for (size_t c = 0; c < channels; c++) job.fir[c]->process(dst[c], job.out[c] + o, in);
+      }
+    }
+
+    for (size_t c = 0; c < mics; c++) {
+      int16_t *y = job.out[c] + o;
+      if (DC) {
+        audio_kernels::dc_block_gain(y, y, n, *job.dc[c], job.gain);
+      } else {
+        audio_kernels::scale_copy(y, y, n, job.gain);
+      }
+    }
+  }
+}
+
+template<typename SrcT, RxLayout L, bool DC> RxKernelFn select_rx_kernel_ratio(uint32_t ratio) {
+  switch (ratio) {
+    case 1:
+      return &fused_rx_kernel<SrcT, L, DC, 1>;
+    case 2:
+      return &fused_rx_kernel<SrcT, L, DC, 2>;
+    case 3:
+      return &fused_rx_kernel<SrcT, L, DC, 3>;
+    default:
+      return &fused_rx_kernel<SrcT, L, DC, 0>;
+  }
+}
+
+template<typename SrcT> RxKernelFn select_rx_kernel_layout(RxLayout layout, bool dc, uint32_t ratio) {
+  switch (layout) {
+    case RxLayout::STEREO:
+      return dc ? select_rx_kernel_ratio<SrcT, RxLayout::STEREO, true>(ratio)
+                : select_rx_kernel_ratio<SrcT, RxLayout::STEREO, false>(ratio);
+#if SOC_I2S_SUPPORTS_TDM
+    case RxLayout::TDM:
+      return dc ? select_rx_kernel_ratio<SrcT, RxLayout::TDM, true>(ratio)
+                : select_rx_kernel_ratio<SrcT, RxLayout::TDM, false>(ratio);
+#endif
+    default:
+      return dc ? select_rx_kernel_ratio<SrcT, RxLayout::MONO, true>(ratio)
+                : select_rx_kernel_ratio<SrcT, RxLayout::MONO, false>(ratio);
+  }
+}
+
+// wide: 32-bit I2S samples (bits_per_sample > 16)
+static inline RxKernelFn select_rx_kernel(bool wide, RxLayout layout, bool dc, uint32_t ratio) {
+  return wide ? select_rx_kernel_layout<int32_t>(layout, dc, ratio)
+              : select_rx_kernel_layout<int16_t>(layout, dc, ratio);
+}
+
+}  // namespace i2s_audio_duplex
+}  // namespace esphome
@@ -0,0 +1,104 @@
+#pragma once
+
+#ifdef USE_ESP32
+
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/core/component.h"
+#include "i2s_audio_duplex.h"
+
+namespace esphome {
+namespace i2s_audio_duplex {
+
+// Diagnostic sensors for the audio task metrics, published every update_interval
+class DuplexMetricsSensor : public PollingComponent {
+ public:
+  void set_parent(I2SAudioDuplex *parent) { this->parent_ = parent; }
+
+  void set_stage_sensor(DuplexStage stage, sensor::Sensor *s) { this->stage_sensors_[static_cast<size_t>(stage)] = s; }
+  void set_ring_high_sensor(DuplexRing ring, sensor::Sensor *s) { this->ring_high_sensors_[static_cast<size_t>(ring)] = s; }
+  void set_ring_low_sensor(DuplexRing ring, sensor::Sensor *s) { this->ring_low_sensors_[static_cast<size_t>(ring)] = s; }
+  void set_play_dropped_sensor(sensor::Sensor *s) { this->play_dropped_sensor_ = s; }
+  void set_speaker_underruns_sensor(sensor::Sensor *s) { this->speaker_underruns_sensor_ = s; }
+  void set_ref_underruns_sensor(sensor::Sensor *s) { this->ref_underruns_sensor_ = s; }
+  void set_i2s_errors_sensor(sensor::Sensor *s) { this->i2s_errors_sensor_ = s; }
+  void set_stack_free_sensor(sensor::Sensor *s) { this->stack_free_sensor_ = s; }
+  void set_cpu_sensor(sensor::Sensor *s) { this->cpu_sensor_ = s; }
+
+  void update() override {
+    if (this->parent_ == nullptr) return;
+    DuplexMetrics &m = this->parent_->get_metrics();
+
+    // Stage sensors: peak us since the previous update
+    for (size_t i = 0; i < NUM_STAGES; i++) {
+      if (this->stage_sensors_[i] != nullptr) {
+        this->stage_sensors_[i]->publish_state(m.stages[i].take_peak());
+      }
+    }
+
+    for (size_t i = 0; i < NUM_RINGS; i++) {
+      if (this->ring_high_sensors_[i] == nullptr && this->ring_low_sensors_[i] == nullptr) continue;
+      uint32_t high, low;
+      if (!m.rings[i].take(high, low)) continue;  // Ring idle this interval - keep the last values
+      if (this->ring_high_sensors_[i] != nullptr) this->ring_high_sensors_[i]->publish_state(high);
+      if (this->ring_low_sensors_[i] != nullptr) this->ring_low_sensors_[i]->publish_state(low);
+    }
+
+    publish_counter_(this->play_dropped_sensor_, m.play_dropped_bytes);
+    publish_counter_(this->speaker_underruns_sensor_, m.speaker_underruns);
+    publish_counter_(this->ref_underruns_sensor_, m.ref_underruns);
+    publish_counter_(this->i2s_errors_sensor_, m.i2s_errors);
+
+    if (this->stack_free_sensor_ != nullptr) {
+      this->stack_free_sensor_->publish_state(this->parent_->get_task_stack_free());
+    }
+
+    if (this->cpu_sensor_ != nullptr) {
+      const int64_t now_us = esp_timer_get_time();
+      uint32_t run_time_us;
+      if (!this->parent_->get_task_run_time_us(run_time_us)) {
+        this->last_update_us_ = 0;  // Task stopped - the next run starts a new counter
+        return;
+      }
+      // First update after (re)start only takes the snapshot
+      if (this->last_update_us_ != 0 && now_us > this->last_update_us_) {
+        uint32_t busy_us = run_time_us - this->last_run_time_us_;
+        this->cpu_sensor_->publish_state(100.0f * busy_us / static_cast<float>(now_us - this->last_update_us_));
+      }
+      this->last_run_time_us_ = run_time_us;
+      this->last_update_us_ = now_us;
+    }
+  }
+
+  void dump_config() override {
+    ESP_LOGCONFIG("duplex_metrics", "I2S Audio Duplex Metrics Sensor (update interval: %ums)",
+                  (unsigned) this->get_update_interval());
+  }
+
+ protected:
+  static constexpr size_t NUM_STAGES = static_cast<size_t>(DuplexStage::COUNT);
+  static constexpr size_t NUM_RINGS = static_cast<size_t>(DuplexRing::COUNT);
+
+  static void publish_counter_(sensor::Sensor *s, const std::atomic<uint32_t> &counter) {
+    if (s != nullptr) s->publish_state(counter.load(std::memory_order_relaxed));
+  }
+
+  I2SAudioDuplex *parent_{nullptr};
+
+  sensor::Sensor *stage_sensors_[NUM_STAGES]{};
+  sensor::Sensor *ring_high_sensors_[NUM_RINGS]{};
+  sensor::Sensor *ring_low_sensors_[NUM_RINGS]{};
+  sensor::Sensor *play_dropped_sensor_{nullptr};
+  sensor::Sensor *speaker_underruns_sensor_{nullptr};
+  sensor::Sensor *ref_underruns_sensor_{nullptr};
+  sensor::Sensor *i2s_errors_sensor_{nullptr};
+  sensor::Sensor *stack_free_sensor_{nullptr};
+  sensor::Sensor *cpu_sensor_{nullptr};
+
+  uint32_t last_run_time_us_{0};
+  int64_t last_update_us_{0};
+};
+
+}  // namespace i2s_audio_duplex
+}  // namespace esphome
+
+#endif  // USE_ESP32
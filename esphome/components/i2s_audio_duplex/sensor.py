@@ -0,0 +1,107 @@
+"""Sensor platform for I2S Audio Duplex - audio task metrics (diagnostic)"""
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    CONF_ID,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    STATE_CLASS_MEASUREMENT,
+    STATE_CLASS_TOTAL_INCREASING,
+    UNIT_PERCENT,
+)
+
+from . import i2s_audio_duplex_ns, I2SAudioDuplex, CONF_I2S_AUDIO_DUPLEX_ID
+
+DEPENDENCIES = ["i2s_audio_duplex"]
+
+UNIT_MICROSECONDS = "µs"
+UNIT_BYTES = "B"
+
+CONF_PLAY_DROPPED_BYTES = "play_dropped_bytes"
+CONF_SPEAKER_UNDERRUNS = "speaker_underruns"
+CONF_REF_UNDERRUNS = "aec_ref_underruns"
+CONF_I2S_ERRORS = "i2s_errors"
+CONF_TASK_STACK_FREE = "task_stack_free"
+CONF_TASK_CPU = "task_cpu"
+
+DuplexMetricsSensor = i2s_audio_duplex_ns.class_("DuplexMetricsSensor", cg.PollingComponent)
+DuplexStage = i2s_audio_duplex_ns.enum("DuplexStage", is_class=True)
+DuplexRing = i2s_audio_duplex_ns.enum("DuplexRing", is_class=True)
+
+# Peak execution time per update interval: <key>_time
+STAGES = {
+    "i2s_read": DuplexStage.I2S_READ,
+    "decimate": DuplexStage.DECIMATE,
+    "aec": DuplexStage.AEC,
+    "callbacks": DuplexStage.CALLBACKS,
+    "i2s_write": DuplexStage.I2S_WRITE,
+}
+# Fill watermarks per update interval: <key>_high / <key>_low
+RINGS = {
+    "speaker_buffer": DuplexRing.SPEAKER,
+    "aec_ref_buffer": DuplexRing.AEC_REF,
+}
+# Monotonic counters
+COUNTERS = {
+    CONF_PLAY_DROPPED_BYTES: ("set_play_dropped_sensor", UNIT_BYTES, "mdi:download-off"),
+    CONF_SPEAKER_UNDERRUNS: ("set_speaker_underruns_sensor", None, "mdi:volume-off"),
+    CONF_REF_UNDERRUNS: ("set_ref_underruns_sensor", None, "mdi:ear-hearing-off"),
+    CONF_I2S_ERRORS: ("set_i2s_errors_sensor", None, "mdi:alert-circle-outline"),
+}
+
+
+def _diag_schema(unit, icon, state_class=STATE_CLASS_MEASUREMENT, decimals=0):
+    return sensor.sensor_schema(
+        unit_of_measurement=unit,
+        icon=icon,
+        accuracy_decimals=decimals,
+        state_class=state_class,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    )
+
+
+_SCHEMA = {
+    cv.GenerateID(): cv.declare_id(DuplexMetricsSensor),
+    cv.GenerateID(CONF_I2S_AUDIO_DUPLEX_ID): cv.use_id(I2SAudioDuplex),
+    cv.Optional(CONF_TASK_STACK_FREE): _diag_schema(UNIT_BYTES, "mdi:layers-outline"),
+    cv.Optional(CONF_TASK_CPU): _diag_schema(UNIT_PERCENT, "mdi:cpu-32-bit", decimals=1),
+}
+for _key in STAGES:
+    _SCHEMA[cv.Optional(f"{_key}_time")] = _diag_schema(UNIT_MICROSECONDS, "mdi:timer-outline")
+for _key in RINGS:
+    _SCHEMA[cv.Optional(f"{_key}_high")] = _diag_schema(UNIT_BYTES, "mdi:arrow-collapse-up")
+    _SCHEMA[cv.Optional(f"{_key}_low")] = _diag_schema(UNIT_BYTES, "mdi:arrow-collapse-down")
+for _key, (_setter, _unit, _icon) in COUNTERS.items():
+    _SCHEMA[cv.Optional(_key)] = _diag_schema(_unit, _icon, STATE_CLASS_TOTAL_INCREASING)
+
+CONFIG_SCHEMA = cv.Schema(_SCHEMA).extend(cv.polling_component_schema("10s"))
+
+
+async def to_code(config):
+    parent = await cg.get_variable(config[CONF_I2S_AUDIO_DUPLEX_ID])
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    cg.add(var.set_parent(parent))
+
+    for key, stage in STAGES.items():
+        if conf := config.get(f"{key}_time"):
+            cg.add(var.set_stage_sensor(stage, await sensor.new_sensor(conf)))
+
+    for key, ring in RINGS.items():
+        if conf := config.get(f"{key}_high"):
+            cg.add(var.set_ring_high_sensor(ring, await sensor.new_sensor(conf)))
+        if conf := config.get(f"{key}_low"):
+            cg.add(var.set_ring_low_sensor(ring, await sensor.new_sensor(conf)))
+
+    for key, (setter, _, _) in COUNTERS.items():
+        if conf := config.get(key):
+            cg.add(getattr(var, setter)(await sensor.new_sensor(conf)))
+
+    if conf := config.get(CONF_TASK_STACK_FREE):
+        cg.add(var.set_stack_free_sensor(await sensor.new_sensor(conf)))
+
+    if conf := config.get(CONF_TASK_CPU):
+        cg.add(var.set_cpu_sensor(await sensor.new_sensor(conf)))
+        # Task CPU time needs FreeRTOS run time stats (esp_timer clock, one timer read per context switch)
+        from esphome.components.esp32 import add_idf_sdkconfig_option
+        add_idf_sdkconfig_option("CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS", True)
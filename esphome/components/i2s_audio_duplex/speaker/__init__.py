@@ -1,8 +1,9 @@
 """I2S Audio Duplex Speaker Platform - Wraps duplex bus as standard ESPHome speaker"""
 import esphome.codegen as cg
 import esphome.config_validation as cv
+import esphome.final_validate as fv
 from esphome.components import audio, speaker
-from esphome.const import CONF_ID, CONF_NUM_CHANNELS
+from esphome.const import CONF_ID, CONF_NUM_CHANNELS, CONF_PLATFORM, CONF_PRIORITY
 from .. import (
     i2s_audio_duplex_ns,
     I2SAudioDuplex,
@@ -12,6 +13,11 @@ from .. import (
 DEPENDENCIES = ["i2s_audio_duplex"]
 CODEOWNERS = ["@n-IA-hane"]
 
+CONF_DUCKING = "ducking"
+
+# Duplex speakers sharing one bus (MAX_TX_STREAMS in i2s_audio_duplex.h)
+MAX_TX_STREAMS = 4
+
 I2SAudioDuplexSpeaker = i2s_audio_duplex_ns.class_(
     "I2SAudioDuplexSpeaker",
     speaker.Speaker,
@@ -24,8 +30,9 @@ def _set_audio_properties(config):
     """Set default audio properties for mixer/resampler compatibility.
 
     Note: sample_rate is NOT defaulted here because the speaker operates at bus
-    rate (e.g. 48kHz for ES8311), not a fixed 16kHz. The C++ setup() sets
-    audio_stream_info_ from parent->get_sample_rate() at runtime.
+    rate (e.g. 48kHz for ES8311), or at output_sample_rate with speaker_rate: output,
+    not a fixed 16kHz. The C++ setup() sets audio_stream_info_ from
+    parent->get_speaker_sample_rate() at runtime.
     """
     if CONF_NUM_CHANNELS not in config:
         config[CONF_NUM_CHANNELS] = 1
@@ -33,7 +40,8 @@ def _set_audio_properties(config):
 
 
 def _set_stream_limits(config):
-    # Speaker accepts audio at bus rate (e.g. 48kHz) — ResamplerSpeaker handles upsampling
+    # Speaker accepts audio at bus rate (e.g. 48kHz) — ResamplerSpeaker handles upsampling.
+    # With speaker_rate: output it takes output_sample_rate audio and the duplex upsamples it.
     audio.set_stream_limits(
         min_bits_per_sample=16,
         max_bits_per_sample=16,
@@ -50,6 +58,10 @@ CONFIG_SCHEMA = cv.All(
         {
             cv.GenerateID(): cv.declare_id(I2SAudioDuplexSpeaker),
             cv.GenerateID(CONF_I2S_AUDIO_DUPLEX_ID): cv.use_id(I2SAudioDuplex),
+            # TX mixer (two or more duplex speakers on one bus): while a speaker of higher
+            # priority plays, this one is attenuated by `ducking` dB
+            cv.Optional(CONF_PRIORITY, default=0): cv.int_range(min=0, max=255),
+            cv.Optional(CONF_DUCKING, default=0): cv.int_range(min=0, max=51),
         }
     ).extend(cv.COMPONENT_SCHEMA),
     _set_audio_properties,
@@ -57,11 +69,32 @@ CONFIG_SCHEMA = cv.All(
 )
 
 
+def _final_validate(config):
+    parent = config[CONF_I2S_AUDIO_DUPLEX_ID]
+    streams = [
+        conf
+        for conf in fv.full_config.get().get("speaker", [])
+        if conf.get(CONF_PLATFORM) == "i2s_audio_duplex" and conf.get(CONF_I2S_AUDIO_DUPLEX_ID) == parent
+    ]
+    if len(streams) > MAX_TX_STREAMS:
+        raise cv.Invalid(
+            f"At most {MAX_TX_STREAMS} i2s_audio_duplex speakers can share {parent} ({len(streams)} configured)"
+        )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate
+
+
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
 
     parent = await cg.get_variable(config[CONF_I2S_AUDIO_DUPLEX_ID])
     cg.add(var.set_parent(parent))
+    # One TX mixer stream per duplex speaker. A single one plays straight from the
+    # speaker ring, exactly as without the mixer.
+    duck_gain = 10 ** (-config[CONF_DUCKING] / 20)
+    cg.add(var.set_stream(parent.add_tx_stream(str(config[CONF_ID].id), config[CONF_PRIORITY], duck_gain)))
 
     await speaker.register_speaker(var, config)
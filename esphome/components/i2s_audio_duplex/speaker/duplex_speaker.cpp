@@ -40,20 +40,26 @@ void I2SAudioDuplexSpeaker::setup() {
     return;
   }
 
-  this->audio_stream_info_ = audio::AudioStreamInfo(16, 1, this->parent_->get_sample_rate());
+  // Bus rate, or the output rate with speaker_rate: output (the parent upsamples it)
+  this->audio_stream_info_ = audio::AudioStreamInfo(16, 1, this->parent_->get_speaker_sample_rate());
 
   // Forward frame-played notifications from I2S audio task to mixer callbacks.
   // Without this, mixer source speakers can't track pending_playback_frames.
-  this->parent_->add_speaker_output_callback([this](uint32_t frames, int64_t timestamp) {
-    this->audio_output_callback_.call(frames, timestamp);
-  });
+  this->parent_->add_speaker_output_callback(
+      [this](uint32_t frames, int64_t timestamp) { this->audio_output_callback_.call(frames, timestamp); },
+      this->stream_);
 }
 
 void I2SAudioDuplexSpeaker::dump_config() {
   ESP_LOGCONFIG(TAG, "I2S Audio Duplex Speaker:");
-  ESP_LOGCONFIG(TAG, "  Sample Rate: %u Hz", this->parent_->get_sample_rate());
+  ESP_LOGCONFIG(TAG, "  Sample Rate: %u Hz%s", (unsigned) this->parent_->get_speaker_sample_rate(),
+                this->parent_->is_speaker_output_rate() ? " (upsampled to the bus rate)" : "");
   ESP_LOGCONFIG(TAG, "  Bits Per Sample: 16");
   ESP_LOGCONFIG(TAG, "  Channels: 1 (mono)");
+  if (this->parent_->is_mixing()) {
+    ESP_LOGCONFIG(TAG, "  Mixer Stream: %u of %u", (unsigned) this->stream_ + 1,
+                  (unsigned) this->parent_->get_tx_stream_count());
+  }
 }
 
 void I2SAudioDuplexSpeaker::start() {
@@ -100,11 +106,11 @@ size_t I2SAudioDuplexSpeaker::play(const uint8_t *data, size_t length,
     this->start();
   }
 
-  return this->parent_->play(data, length, ticks_to_wait);
+  return this->parent_->play_stream(this->stream_, data, length, ticks_to_wait);
 }
 
 bool I2SAudioDuplexSpeaker::has_buffered_data() const {
-  return this->parent_->get_speaker_buffer_available() > 0;
+  return this->parent_->get_speaker_buffer_available(this->stream_) > 0;
 }
 
 void I2SAudioDuplexSpeaker::set_volume(float volume) {
@@ -119,7 +125,7 @@ void I2SAudioDuplexSpeaker::set_volume(float volume) {
   } else
 #endif
   {
-    this->parent_->set_speaker_volume(volume_to_db_factor(volume));
+    this->parent_->set_stream_volume(this->stream_, volume_to_db_factor(volume));
   }
 }
 
@@ -137,16 +143,16 @@ void I2SAudioDuplexSpeaker::set_mute_state(bool mute_state) {
 #endif
   {
     if (mute_state) {
-      this->parent_->set_speaker_volume(0.0f);
+      this->parent_->set_stream_volume(this->stream_, 0.0f);
     } else {
-      this->parent_->set_speaker_volume(volume_to_db_factor(this->volume_));
+      this->parent_->set_stream_volume(this->stream_, volume_to_db_factor(this->volume_));
     }
   }
 }
 
 void I2SAudioDuplexSpeaker::set_pause_state(bool pause_state) {
   this->pause_state_ = pause_state;
-  this->parent_->set_speaker_paused(pause_state);
+  this->parent_->set_stream_paused(this->stream_, pause_state);
   ESP_LOGD(TAG, "Pause state: %s", pause_state ? "PAUSED" : "PLAYING");
 }
 
@@ -172,7 +178,7 @@ void I2SAudioDuplexSpeaker::loop() {
       if (this->status_has_error()) {
         break;
       }
-      this->parent_->start_speaker();
+      this->parent_->start_speaker(this->stream_);
       this->state_ = speaker::STATE_RUNNING;
       break;
 
@@ -185,7 +191,7 @@ void I2SAudioDuplexSpeaker::loop() {
       break;
 
     case speaker::STATE_STOPPING:
-      this->parent_->stop_speaker();
+      this->parent_->stop_speaker(this->stream_);
       this->state_ = speaker::STATE_STOPPED;
       break;
 
@@ -40,7 +40,11 @@ class I2SAudioDuplexSpeaker : public speaker::Speaker,
   void set_pause_state(bool pause_state) override;
   bool get_pause_state() const override { return this->pause_state_; }
 
+  // TX mixer stream of the parent (I2SAudioDuplex::add_tx_stream(), before setup())
+  void set_stream(uint8_t stream) { this->stream_ = stream; }
+
  protected:
+  uint8_t stream_{0};
   bool pause_state_{false};
   bool finishing_{false};  // Non-blocking drain: finish() sets flag, loop() handles drain+stop
   // Reference counting for multiple listeners (media_player, voice_assistant, intercom, etc.)
@@ -1,6 +1,7 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import automation
+from esphome.core import CORE
 from esphome.const import (
     CONF_ID,
     CONF_MICROPHONE,
@@ -12,15 +13,26 @@ from esphome.const import (
     CONF_DISABLED_BY_DEFAULT,
 )
 from esphome.components import microphone, speaker, switch, text_sensor
+from esphome.components.audio_kernels import frame_duration
 
 CODEOWNERS = ["@n-IA-hane"]
 DEPENDENCIES = ["esp32"]
-AUTO_LOAD = ["switch", "number", "text_sensor"]
+AUTO_LOAD = ["audio_kernels", "switch", "number", "text_sensor", "sensor"]
 
 CONF_INTERCOM_API_ID = "intercom_api_id"
 CONF_DC_OFFSET_REMOVAL = "dc_offset_removal"
+CONF_CODEC = "codec"
+CONF_OPUS_BITRATE = "opus_bitrate"
+CONF_AUDIO_TRANSPORT = "audio_transport"
+CONF_PLAYOUT_MIN = "playout_min"
+CONF_PLAYOUT_MAX = "playout_max"
+CONF_MAX_MONITORS = "max_monitors"
+CONF_DTX = "dtx"
+CONF_FRAME_DURATION = "frame_duration"
 
 CONF_AEC_ID = "aec_id"
+CONF_AEC_OWNER = "aec_owner"
+CONF_AEC_REF_DELAY_ESTIMATION = "aec_reference_delay_estimation"
 CONF_RINGING_TIMEOUT = "ringing_timeout"
 CONF_ON_RINGING = "on_ringing"
 CONF_ON_STREAMING = "on_streaming"
@@ -35,6 +47,14 @@ CONF_ON_CALL_FAILED = "on_call_failed"
 MODE_SIMPLE = "simple"  # Simple: ring → HA notification → answer (browser ↔ ESP only)
 MODE_FULL = "full"      # Full: contacts, destination, ESP↔ESP calls via HA bridge
 
+# Codec constants
+CODEC_PCM = "pcm"    # Raw 16-bit PCM only (~256 kbps)
+CODEC_OPUS = "opus"  # Offer Opus on START/ANSWER, PCM fallback for older HA
+
+# Audio transport constants (signalling always stays on TCP)
+TRANSPORT_TCP = "tcp"  # AUDIO frames in the TCP stream
+TRANSPORT_UDP = "udp"  # Accept UDP AUDIO offers: jitter buffer + loss concealment, TCP fallback
+
 intercom_api_ns = cg.esphome_ns.namespace("intercom_api")
 IntercomApi = intercom_api_ns.class_("IntercomApi", cg.Component)
 
@@ -46,6 +66,7 @@ StopAction = intercom_api_ns.class_("StopAction", automation.Action)
 AnswerCallAction = intercom_api_ns.class_("AnswerCallAction", automation.Action)
 DeclineCallAction = intercom_api_ns.class_("DeclineCallAction", automation.Action)
 CallToggleAction = intercom_api_ns.class_("CallToggleAction", automation.Action)
+DumpMetricsAction = intercom_api_ns.class_("DumpMetricsAction", automation.Action)
 
 # Parameterized actions
 SetVolumeAction = intercom_api_ns.class_("SetVolumeAction", automation.Action)
@@ -71,6 +92,64 @@ def _aec_schema(value):
     return cv.use_id(esp_aec.EspAec)(value)
 
 
+def _aec_owner_schema(value):
+    """Validate aec_owner - import i2s_audio_duplex only if used."""
+    from esphome.components import i2s_audio_duplex
+    return cv.use_id(i2s_audio_duplex.I2SAudioDuplex)(value)
+
+
+def _duplex_configs(full_config):
+    duplex_configs = full_config.get("i2s_audio_duplex", [])
+    return [d for d in (duplex_configs if isinstance(duplex_configs, list) else [duplex_configs])
+            if isinstance(d, dict)]
+
+
+def _frame_duration_ms(config, full_config):
+    """PCM frame in ms: frame_duration, else the only i2s_audio_duplex's, else 32 ms."""
+    if CONF_FRAME_DURATION in config:
+        return config[CONF_FRAME_DURATION].total_milliseconds
+    duplexes = _duplex_configs(full_config)
+    if len(duplexes) == 1 and CONF_FRAME_DURATION in duplexes[0]:
+        return duplexes[0][CONF_FRAME_DURATION].total_milliseconds
+    return 32
+
+
+def _duplex_speaker_rate(config, full_config):
+    """Rate of the i2s_audio_duplex speaker this intercom plays into directly, or None."""
+    if CONF_SPEAKER not in config:
+        return None
+    speakers = full_config.get(CONF_SPEAKER, [])
+    for spk in (speakers if isinstance(speakers, list) else [speakers]):
+        if not isinstance(spk, dict) or spk.get("platform") != "i2s_audio_duplex":
+            continue
+        if spk[CONF_ID].id != config[CONF_SPEAKER].id:
+            continue
+        for duplex in _duplex_configs(full_config):
+            if duplex[CONF_ID].id == spk["i2s_audio_duplex_id"].id:
+                if duplex.get("speaker_rate") == "output":
+                    return duplex["output_sample_rate"]
+                return duplex["sample_rate"]
+    return None
+
+
+def _duplex_aec_owner(config, full_config):
+    """The i2s_audio_duplex instance that cancels echo for this intercom, or None.
+
+    Explicit aec_owner, otherwise the only i2s_audio_duplex with an aec_id (its mic
+    frames are already echo-cancelled, so intercom_api must not run AEC again).
+    """
+    if config.get(CONF_AEC_ID) is not None:
+        return None
+    duplexes = [d for d in _duplex_configs(full_config) if d.get("aec_id") is not None]
+    if CONF_AEC_OWNER in config:
+        owner_id = config[CONF_AEC_OWNER].id
+        for duplex in _duplex_configs(full_config):
+            if duplex[CONF_ID].id == owner_id:
+                return duplex
+        return None
+    return duplexes[0] if len(duplexes) == 1 else None
+
+
 CONFIG_SCHEMA = cv.Schema(
     {
         cv.GenerateID(): cv.declare_id(IntercomApi),
@@ -80,8 +159,36 @@ CONFIG_SCHEMA = cv.Schema(
         cv.Optional(CONF_SPEAKER): cv.use_id(speaker.Speaker),
         # DC offset removal for mics with significant DC bias (e.g., SPH0645)
         cv.Optional(CONF_DC_OFFSET_REMOVAL, default=False): cv.boolean,
+        # Audio codec: opus cuts call bandwidth ~10x (negotiated per call, PCM fallback)
+        cv.Optional(CONF_CODEC, default=CODEC_PCM): cv.one_of(CODEC_PCM, CODEC_OPUS, lower=True),
+        cv.Optional(CONF_OPUS_BITRATE, default=24000): cv.int_range(min=6000, max=64000),
+        # Audio transport: udp avoids TCP retransmit stalls on lossy Wi-Fi (negotiated per call)
+        cv.Optional(CONF_AUDIO_TRANSPORT, default=TRANSPORT_TCP): cv.one_of(
+            TRANSPORT_TCP, TRANSPORT_UDP, lower=True
+        ),
+        # DTX: quiet mic frames go out as 3-byte silence descriptors, the peer plays comfort noise
+        cv.Optional(CONF_DTX, default=False): cv.boolean,
+        # PCM call frame (negotiated per call, the longer side wins). Defaults to the
+        # i2s_audio_duplex frame_duration so frames pass through without rechunking;
+        # an AEC (aec_id or the bus owner's) frames calls to its chunk instead.
+        cv.Optional(CONF_FRAME_DURATION): frame_duration,
+        # Listen-only clients (START with the MONITOR flag) served next to the call client
+        cv.Optional(CONF_MAX_MONITORS, default=2): cv.int_range(min=0, max=4),
         # Optional AEC (Acoustic Echo Cancellation) component
-        cv.Optional(CONF_AEC_ID): _aec_schema,
+        cv.Exclusive(CONF_AEC_ID, "aec"): _aec_schema,
+        # i2s_audio_duplex that runs AEC on the shared bus (auto-detected when there is one)
+        cv.Exclusive(CONF_AEC_OWNER, "aec"): _aec_owner_schema,
+        # Align the AEC reference to the measured echo lag at the start of each call
+        cv.Optional(CONF_AEC_REF_DELAY_ESTIMATION, default=True): cv.boolean,
+        # Speaker playout window (aec_id mode): depth tracks network jitter within [min, max]
+        cv.Optional(CONF_PLAYOUT_MIN, default="40ms"): cv.All(
+            cv.positive_time_period_milliseconds,
+            cv.Range(min=cv.TimePeriod(milliseconds=32), max=cv.TimePeriod(milliseconds=200)),
+        ),
+        cv.Optional(CONF_PLAYOUT_MAX, default="120ms"): cv.All(
+            cv.positive_time_period_milliseconds,
+            cv.Range(min=cv.TimePeriod(milliseconds=32), max=cv.TimePeriod(milliseconds=200)),
+        ),
         # Ringing timeout: auto-decline call if not answered within this time
         cv.Optional(CONF_RINGING_TIMEOUT): cv.positive_time_period_milliseconds,
         # Trigger when incoming call (auto_answer OFF)
@@ -102,23 +209,43 @@ CONFIG_SCHEMA = cv.Schema(
 def _final_validate(config):
     """Cross-component validation: warn about conflicts with i2s_audio_duplex."""
     from esphome.core import CORE
+
+    if config[CONF_PLAYOUT_MIN] > config[CONF_PLAYOUT_MAX]:
+        raise cv.Invalid(f"{CONF_PLAYOUT_MIN} must not be larger than {CONF_PLAYOUT_MAX}")
+
     full_config = CORE.config or {}
 
     # Check if i2s_audio_duplex is also configured
-    duplex_configs = full_config.get("i2s_audio_duplex", [])
+    duplex_configs = _duplex_configs(full_config)
     if not duplex_configs:
+        if CONF_AEC_OWNER in config:
+            raise cv.Invalid(f"{CONF_AEC_OWNER} requires an i2s_audio_duplex component")
         return config
 
     # If duplex exists, check for AEC conflict
     if CONF_AEC_ID in config and config[CONF_AEC_ID] is not None:
-        for duplex in (duplex_configs if isinstance(duplex_configs, list) else [duplex_configs]):
-            if isinstance(duplex, dict) and "aec_id" in duplex and duplex["aec_id"] is not None:
+        for duplex in duplex_configs:
+            if duplex.get("aec_id") is not None:
                 raise cv.Invalid(
                     "Both intercom_api and i2s_audio_duplex have aec_id configured. "
-                    "This causes a race condition on the AEC processor. "
-                    "Use aec_id on only ONE component (i2s_audio_duplex recommended)."
+                    "This runs echo cancellation twice on the same frames. "
+                    f"Keep aec_id on i2s_audio_duplex only (intercom_api uses it via {CONF_AEC_OWNER})."
                 )
 
+    # Call audio is 16 kHz: straight into a duplex speaker only when it takes 16 kHz
+    speaker_rate = _duplex_speaker_rate(config, full_config)
+    if speaker_rate is not None and speaker_rate != 16000:
+        raise cv.Invalid(
+            f"{CONF_SPEAKER} is an i2s_audio_duplex speaker taking {speaker_rate} Hz audio, "
+            "intercom audio is 16000 Hz. Set speaker_rate: output (with output_sample_rate: 16000) "
+            "on i2s_audio_duplex, or play through a resampler speaker."
+        )
+
+    if CONF_AEC_OWNER in config:
+        owner = _duplex_aec_owner(config, full_config)
+        if owner is None or owner.get("aec_id") is None:
+            raise cv.Invalid(f"{CONF_AEC_OWNER} must reference an i2s_audio_duplex with aec_id configured")
+
     # Warn about DC offset double-filtering
     if config.get(CONF_DC_OFFSET_REMOVAL, False):
         for duplex in (duplex_configs if isinstance(duplex_configs, list) else [duplex_configs]):
@@ -138,6 +265,8 @@ FINAL_VALIDATE_SCHEMA = _final_validate
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
+    # audio_benchmark times the TCP framing when it is in the build
+    cg.add_define("USE_INTERCOM_API")
 
     mode = config[CONF_MODE]
     is_full = mode == MODE_FULL
@@ -155,13 +284,34 @@ async def to_code(config):
 
     cg.add(var.set_dc_offset_removal(config[CONF_DC_OFFSET_REMOVAL]))
 
+    cg.add(var.set_datagram_audio(config[CONF_AUDIO_TRANSPORT] == TRANSPORT_UDP))
+    cg.add(var.set_max_monitors(config[CONF_MAX_MONITORS]))
+    cg.add(var.set_dtx(config[CONF_DTX]))
+    cg.add(var.set_frame_duration_ms(_frame_duration_ms(config, CORE.config or {})))
+
+    if config[CONF_CODEC] == CODEC_OPUS:
+        from esphome.components.esp32 import add_idf_component, add_idf_sdkconfig_option
+        cg.add(var.set_opus_bitrate(config[CONF_OPUS_BITRATE]))
+        cg.add_define("USE_INTERCOM_OPUS")
+        add_idf_component(name="espressif/esp_audio_codec", ref="2.3.0")
+        # Encoder task stack (32KB) goes to PSRAM when available
+        add_idf_sdkconfig_option("CONFIG_SPIRAM_ALLOW_STACK_EXTERNAL_MEMORY", True)
+
     # Set device name (for full mode: exclude self from contacts list)
     cg.add(var.set_device_name(cg.RawExpression('App.get_friendly_name()')))
 
     if CONF_AEC_ID in config and config[CONF_AEC_ID] is not None:
         aec = await cg.get_variable(config[CONF_AEC_ID])
         cg.add(var.set_aec(aec))
+        cg.add(var.set_aec_reference_delay_estimation(config[CONF_AEC_REF_DELAY_ESTIMATION]))
         cg.add_define("USE_ESP_AEC")
+    else:
+        owner = _duplex_aec_owner(config, CORE.config or {})
+        if owner is not None:
+            duplex = await cg.get_variable(owner[CONF_ID])
+            cg.add(var.set_aec_owner(duplex))
+
+    cg.add(var.set_playout_window(config[CONF_PLAYOUT_MIN], config[CONF_PLAYOUT_MAX]))
 
     # Ringing timeout (auto-decline if not answered)
     if CONF_RINGING_TIMEOUT in config:
@@ -328,6 +478,14 @@ async def call_toggle_action_to_code(config, action_id, template_arg, args):
     return var
 
 
+@automation.register_action("intercom_api.dump_metrics", DumpMetricsAction, INTERCOM_ACTION_SCHEMA)
+async def dump_metrics_action_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    parent = await cg.get_variable(config[CONF_ID])
+    cg.add(var.set_parent(parent))
+    return var
+
+
 # === Parameterized actions ===
 
 CONF_VOLUME = "volume"
@@ -8,10 +8,10 @@
 #include <cstring>
 #include <fcntl.h>
 #include <esp_heap_caps.h>
+#include <esp_timer.h>
 
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
-#include "audio_utils.h"
 
 namespace esphome {
 namespace intercom_api {
@@ -36,7 +36,7 @@ void IntercomApi::setup() {
            use_intercom_aec ? "server+tx+speaker" : "server only");
 
   if (use_intercom_aec) {
-    // Full 3-task mode: need speaker semaphore, speaker_buffer, audio_tx_buffer, spk_ref_scaled
+    // Full 3-task mode: need speaker semaphore, speaker_buffer, audio_tx_buffer
     this->speaker_stopped_sem_ = xSemaphoreCreateBinary();
     if (!this->speaker_stopped_sem_) {
       ESP_LOGE(TAG, "Failed to create speaker semaphore");
@@ -45,64 +45,96 @@ void IntercomApi::setup() {
     }
   }
 
-  // Allocate ring buffers
-  // mic_buffer always needed (mic callback writes here, server_task or tx_task reads)
-  this->mic_buffer_ = RingBuffer::create(TX_BUFFER_SIZE);
-  if (!this->mic_buffer_) {
-    ESP_LOGE(TAG, "Failed to allocate mic ring buffer");
-    this->mark_failed();
-    return;
+#ifdef USE_ESP_AEC
+  // Validate AEC: its buffers come from the arena below, sized for the largest frame a
+  // mode switch can reach, so enabling AEC (default off) never allocates at runtime
+  bool aec_buffers = false;
+  if (this->aec_ != nullptr && this->aec_->is_initialized()) {
+    this->aec_frame_samples_ = this->aec_->get_frame_size();
+    this->aec_max_frame_samples_ = std::max(this->aec_frame_samples_, this->aec_->get_max_frame_size());
+    if (this->aec_frame_samples_ <= 0 || this->aec_max_frame_samples_ > 1024) {
+      ESP_LOGW(TAG, "AEC frame_size invalid (%d)", this->aec_frame_samples_);
+    } else {
+      aec_buffers = true;
+      ESP_LOGI(TAG, "AEC validated: frame_size=%d samples (%dms) - enable via switch",
+               this->aec_frame_samples_,
+               this->aec_frame_samples_ * 1000 / SAMPLE_RATE);
+    }
+  } else if (this->aec_owner_ != nullptr) {
+    ESP_LOGI(TAG, "AEC runs on the I2S bus owner (%s) - switch controls it there",
+             this->aec_owner_->has_aec() ? "available" : "no processor");
   }
+  this->aec_enabled_ = false;
+#endif
 
+  // ── Audio arena: rings and frame buffers, allocated once here ──
+  using audio_kernels::ArenaPlacement;
+  audio_kernels::ArenaLayout layout;
+
+  // mic_buffer always needed (mic callback writes here, server_task or tx_task reads)
+  layout.add_ring(this->mic_buffer_, TX_BUFFER_SIZE, ArenaPlacement::BULK);
   if (use_intercom_aec) {
     // speaker_buffer only needed when speaker_task exists (bridges network→speaker with AEC ref)
-    this->speaker_buffer_ = RingBuffer::create(RX_BUFFER_SIZE);
-    if (!this->speaker_buffer_) {
-      ESP_LOGE(TAG, "Failed to allocate speaker ring buffer");
-      this->mark_failed();
-      return;
-    }
+    layout.add_ring(this->speaker_buffer_, RX_BUFFER_SIZE, ArenaPlacement::BULK);
   }
 
-  // Allocate frame buffers (internal RAM — intercom_api must work on devices without PSRAM)
-  this->tx_buffer_ = static_cast<uint8_t *>(heap_caps_malloc(MAX_MESSAGE_SIZE, MALLOC_CAP_INTERNAL));
-  this->rx_buffer_ = static_cast<uint8_t *>(heap_caps_malloc(MAX_MESSAGE_SIZE, MALLOC_CAP_INTERNAL));
+  // RX frame buffer: one recv() per message, internal RAM on boards without PSRAM
+  // No TX frame buffer: send_frame_() gathers header + payload straight from the caller's memory
+  layout.add(this->rx_buffer_, MAX_MESSAGE_SIZE, ArenaPlacement::BULK);
 
-  if (!this->tx_buffer_ || !this->rx_buffer_) {
-    ESP_LOGE(TAG, "Failed to allocate frame buffers");
-    this->mark_failed();
-    return;
+  // Datagram audio: jitter buffer slots + last frame for PCM loss concealment
+  uint8_t *jitter_storage = nullptr;
+  if (this->datagram_audio_) {
+    layout.add(this->plc_pcm_, AUDIO_CHUNK_SIZE, ArenaPlacement::BULK);
+    layout.add(jitter_storage, JitterBuffer::storage_size(MAX_DATAGRAM_PAYLOAD), ArenaPlacement::BULK);
   }
 
+#ifdef USE_SPEAKER
+  // Comfort noise for received ComfortNoiseFrames (server_task)
+  layout.add(this->cn_pcm_, AUDIO_CHUNK_SIZE, ArenaPlacement::BULK);
+#endif
+
+#ifdef USE_INTERCOM_OPUS
+  // Opus decoder output (server_task) and tx_task → encoder_task handoff
+  // Without tx_task, encoder_task reads mic_buffer_ directly
+  layout.add(this->dec_pcm_, OPUS_MAX_FRAME_SAMPLES * sizeof(int16_t), ArenaPlacement::HOT);
   if (use_intercom_aec) {
-    // audio_tx_buffer only needed by tx_task (dedicated send buffer, no mutex)
-    this->audio_tx_buffer_ = static_cast<uint8_t *>(heap_caps_malloc(MAX_MESSAGE_SIZE, MALLOC_CAP_INTERNAL));
-    if (!this->audio_tx_buffer_) {
-      ESP_LOGE(TAG, "Failed to allocate audio TX buffer");
-      this->mark_failed();
-      return;
-    }
+    layout.add_ring(this->enc_buffer_, TX_BUFFER_SIZE, ArenaPlacement::BULK);
+  }
+#endif
+
+#ifdef USE_ESP_AEC
+  size_t ref_buf_bytes = 0;
+  if (aec_buffers) {
+    const size_t frame_bytes = static_cast<size_t>(this->aec_max_frame_samples_) * sizeof(int16_t);
+    // Room for the delay to move by up to AEC_DELAY_SEARCH_MS when it is estimated
+    ref_buf_bytes = AEC_REF_DELAY_BYTES + RX_BUFFER_SIZE + (this->aec_delay_estimation_ ? AEC_DELAY_SEARCH_BYTES : 0);
+    layout.add_ring(this->spk_ref_buffer_, ref_buf_bytes, ArenaPlacement::BULK);
+    layout.add(this->aec_mic_, frame_bytes, ArenaPlacement::HOT);
+    layout.add(this->aec_ref_, frame_bytes, ArenaPlacement::HOT);
+    layout.add(this->aec_out_, frame_bytes, ArenaPlacement::HOT);
   }
+#endif
 
-  // Pre-allocate audio processing buffers (avoid stack VLAs on 8KB FreeRTOS tasks)
-  static constexpr size_t MIC_BUF_SAMPLES = 512;  // MAX_SAMPLES in on_microphone_data_
-  this->mic_converted_ = static_cast<int16_t *>(heap_caps_malloc(MIC_BUF_SAMPLES * sizeof(int16_t), MALLOC_CAP_INTERNAL));
-  if (!this->mic_converted_) {
-    ESP_LOGE(TAG, "Failed to allocate mic processing buffer");
+  if (!audio_kernels::AudioArena::get().commit(TAG, layout)) {
+    ESP_LOGE(TAG, "Failed to allocate audio buffers (%u bytes internal, %u bytes PSRAM-preferred)",
+             (unsigned) layout.get_bytes(ArenaPlacement::HOT), (unsigned) layout.get_bytes(ArenaPlacement::BULK));
     this->mark_failed();
     return;
   }
-
-  if (use_intercom_aec) {
-    // spk_ref_scaled only needed by speaker_task (AEC reference scaling)
-    static constexpr size_t SPK_BUF_SAMPLES = AUDIO_CHUNK_SIZE * 4 / sizeof(int16_t);  // 1024
-    this->spk_ref_scaled_ = static_cast<int16_t *>(heap_caps_malloc(SPK_BUF_SAMPLES * sizeof(int16_t), MALLOC_CAP_INTERNAL));
-    if (!this->spk_ref_scaled_) {
-      ESP_LOGE(TAG, "Failed to allocate speaker ref buffer");
-      this->mark_failed();
-      return;
+  if (this->datagram_audio_) {
+    this->jitter_.init(jitter_storage, MAX_DATAGRAM_PAYLOAD);
+  }
+  this->dtx_vad_.init(SAMPLE_RATE, DTX_HANGOVER_MS);
+#ifdef USE_ESP_AEC
+  if (aec_buffers) {
+    this->aec_gate_vad_.init(SAMPLE_RATE, DTX_HANGOVER_MS);
+    if (this->aec_delay_estimation_) {
+      this->delay_estimator_.init((SAMPLE_RATE * AEC_DELAY_WINDOW_MS) / 1000, (SAMPLE_RATE * AEC_DELAY_SEARCH_MS) / 1000);
     }
+    ESP_LOGD(TAG, "AEC buffers: frame=%d samples, ref_buf=%zu bytes", this->aec_max_frame_samples_, ref_buf_bytes);
   }
+#endif
 
   // Setup microphone callback
 #ifdef USE_MICROPHONE
@@ -113,31 +145,19 @@ void IntercomApi::setup() {
   }
 #endif
 
-#ifdef USE_ESP_AEC
-  // Validate AEC but defer buffer allocation to set_aec_enabled(true)
-  // This saves ~13KB of internal RAM when AEC is disabled (the default)
-  if (this->aec_ != nullptr && this->aec_->is_initialized()) {
-    this->aec_frame_samples_ = this->aec_->get_frame_size();
-    if (this->aec_frame_samples_ <= 0 || this->aec_frame_samples_ > 1024) {
-      ESP_LOGW(TAG, "AEC frame_size invalid (%d)", this->aec_frame_samples_);
-    } else {
-      this->spk_ref_mutex_ = xSemaphoreCreateMutex();
-      ESP_LOGI(TAG, "AEC validated: frame_size=%d samples (%dms) - enable via switch",
-               this->aec_frame_samples_,
-               this->aec_frame_samples_ * 1000 / SAMPLE_RATE);
-    }
-  }
-  this->aec_enabled_ = false;
-#endif
-
   // Create server task (Core 1) - handles TCP connections and receiving
   // When !use_intercom_aec, also handles TX (mic→network) and direct speaker playback
   // Priority 5: i2s_duplex moved to Core 0, so Core 1 is audio-free; prio 5 sufficient
   // 8KB stack: callbacks trigger YAML automations that may do LVGL operations (must stay Core 1)
+#ifdef USE_INTERCOM_OPUS
+  static constexpr uint32_t SERVER_TASK_STACK = 12288;  // + Opus decode in handle_message_
+#else
+  static constexpr uint32_t SERVER_TASK_STACK = 8192;
+#endif
   BaseType_t ok = xTaskCreatePinnedToCore(
       IntercomApi::server_task,
       "intercom_srv",
-      8192,
+      SERVER_TASK_STACK,
       this,
       5,  // Core 1 now audio-free; lower prio gives MWW (prio 3) and LVGL better headroom
       &this->server_task_handle_,
@@ -187,6 +207,35 @@ void IntercomApi::setup() {
     }
   }
 
+#ifdef USE_INTERCOM_OPUS
+  // Create encoder task (Core 1) - Opus encoding is the heaviest per-frame work in intercom_api,
+  // keep it off Core 0 so it can never starve i2s_duplex (prio 19) or tx_task.
+  // Opus needs a deep stack; put it in PSRAM when available (CONFIG_SPIRAM_ALLOW_STACK_EXTERNAL_MEMORY)
+  static constexpr uint32_t ENCODER_TASK_STACK = 32768;
+  this->encoder_task_stack_ = static_cast<StackType_t *>(
+      heap_caps_malloc(ENCODER_TASK_STACK, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+  if (!this->encoder_task_stack_) {
+    this->encoder_task_stack_ = static_cast<StackType_t *>(heap_caps_malloc(ENCODER_TASK_STACK, MALLOC_CAP_INTERNAL));
+  }
+  if (this->encoder_task_stack_) {
+    this->encoder_task_handle_ = xTaskCreateStaticPinnedToCore(
+        IntercomApi::encoder_task,
+        "intercom_enc",
+        ENCODER_TASK_STACK,
+        this,
+        4,  // Below server_task(5): control traffic and YAML callbacks stay responsive
+        this->encoder_task_stack_,
+        &this->encoder_task_tcb_,
+        1  // Core 1 - away from i2s_duplex and tx_task
+    );
+  }
+  if (!this->encoder_task_handle_) {
+    ESP_LOGE(TAG, "Failed to create encoder task");
+    this->mark_failed();
+    return;
+  }
+#endif
+
   // Load persisted settings from flash (volume, mic gain, auto-answer, AEC)
   this->load_settings_();
 
@@ -202,6 +251,22 @@ void IntercomApi::setup() {
 void IntercomApi::loop() {
   // Main loop - mostly handled by FreeRTOS tasks
 
+#ifdef USE_ESP_AEC
+  // AEC delay estimation: correlate a captured window a slice at a time (no-op otherwise)
+  this->delay_estimator_.compute_step(AEC_DELAY_LAGS_PER_LOOP);
+#endif
+
+  // Sample audio task wakeup counters once per second
+  uint32_t sample_now = millis();
+  if (sample_now - this->wakeups_sample_time_ >= 1000) {
+    this->tx_wakeups_per_sec_ = this->tx_wakeups_.exchange(0, std::memory_order_relaxed);
+    this->speaker_wakeups_per_sec_ = this->speaker_wakeups_.exchange(0, std::memory_order_relaxed);
+    this->server_wakeups_per_sec_ = this->server_wakeups_.exchange(0, std::memory_order_relaxed);
+    this->wakeups_sample_time_ = sample_now;
+    ESP_LOGV(TAG, "Task wakeups/s: server=%u tx=%u spk=%u", this->server_wakeups_per_sec_, this->tx_wakeups_per_sec_,
+             this->speaker_wakeups_per_sec_);
+  }
+
   // Check call timeout (if configured and FSM in RINGING or OUTGOING state)
   // Use FSM state to handle case where TCP connection closed but call_state_ is stuck
   // Both timeouts send STOP to the other side to keep both ESPs in sync
@@ -214,6 +279,7 @@ void IntercomApi::loop() {
         ESP_LOGI(TAG, "Ringing timeout after %u ms - sending STOP to caller", this->ringing_timeout_ms_);
         // close_client_socket_() sends STOP before closing
         this->close_client_socket_();
+        this->set_active_(false);  // Stop mic/speaker (prepared while ringing)
         this->state_ = ConnectionState::DISCONNECTED;
         if (this->full_mode_) {
           this->publish_caller_("");
@@ -249,12 +315,43 @@ void IntercomApi::dump_config() {
 #ifdef USE_ESP_AEC
   if (this->aec_ != nullptr) {
     ESP_LOGCONFIG(TAG, "  AEC: configured (frame_size=%d samples)", this->aec_frame_samples_);
+    ESP_LOGCONFIG(TAG, "  AEC Reference Delay: %ums%s", static_cast<unsigned>(this->get_aec_reference_delay_ms()),
+                  this->aec_delay_estimation_ ? " (estimated per call)" : "");
+  } else if (this->aec_owner_ != nullptr) {
+    ESP_LOGCONFIG(TAG, "  AEC: I2S bus owner (reference delay %ums)",
+                  static_cast<unsigned>(this->get_aec_reference_delay_ms()));
   } else {
     ESP_LOGCONFIG(TAG, "  AEC: none");
   }
 #endif
+  ESP_LOGCONFIG(TAG, "  PCM Frame: %u ms (negotiated per call)", this->local_frame_ms_());
   ESP_LOGCONFIG(TAG, "  Tasks: %s", this->has_intercom_aec_() ?
                 "server+tx+speaker" : "server only");
+  if (this->datagram_audio_) {
+    ESP_LOGCONFIG(TAG, "  Audio transport: udp (jitter buffer %u-%u frames), tcp fallback",
+                  JITTER_MIN_FRAMES, JITTER_MAX_FRAMES);
+  } else {
+    ESP_LOGCONFIG(TAG, "  Audio transport: tcp");
+  }
+  ESP_LOGCONFIG(TAG, "  Max monitors: %u (listen-only, tcp)", this->max_monitors_);
+  ESP_LOGCONFIG(TAG, "  DTX: %s (comfort noise playback always on)",
+                this->dtx_enabled_ ? "quiet frames sent as silence descriptors" : "off");
+  const audio_kernels::AudioArena &arena = audio_kernels::AudioArena::get();
+  if (const audio_kernels::AudioArena::Owner *budget = arena.find(TAG)) {
+    ESP_LOGCONFIG(TAG, "  Audio Arena: %u bytes internal, %u bytes PSRAM, %u buffers",
+                  (unsigned) budget->internal_bytes, (unsigned) budget->psram_bytes, (unsigned) budget->buffers);
+    if (budget->spilled_bytes > 0) {
+      ESP_LOGW(TAG, "  Audio Arena: %u bytes of hot buffers spilled to PSRAM (internal RAM exhausted)",
+               (unsigned) budget->spilled_bytes);
+    }
+    ESP_LOGCONFIG(TAG, "  Audio Arena (all components): %u bytes internal, %u bytes PSRAM",
+                  (unsigned) arena.get_internal_bytes(), (unsigned) arena.get_psram_bytes());
+  }
+#ifdef USE_INTERCOM_OPUS
+  ESP_LOGCONFIG(TAG, "  Codecs: pcm, opus (%u bps, encoder task on core 1)", (unsigned) this->opus_bitrate_);
+#else
+  ESP_LOGCONFIG(TAG, "  Codecs: pcm");
+#endif
 }
 
 void IntercomApi::publish_entity_states() {
@@ -277,8 +374,10 @@ void IntercomApi::publish_entity_states() {
     if (initial.has_value()) {
       if (*initial) {
         this->set_aec_enabled(true);
+      } else if (this->aec_owner_ != nullptr) {
+        this->set_aec_enabled(false);  // The owner starts with its AEC on
       }
-      this->aec_switch_->publish_state(this->aec_enabled_);
+      this->aec_switch_->publish_state(this->is_aec_enabled());
     }
   }
 #endif
@@ -286,7 +385,7 @@ void IntercomApi::publish_entity_states() {
 #ifdef USE_ESP_AEC
   ESP_LOGI(TAG, "Entity states synced (vol=%.0f%%, mic=%.1fdB, auto=%s, aec=%s)",
            this->volume_ * 100.0f, this->mic_gain_db_,
-           this->auto_answer_ ? "ON" : "OFF", this->aec_enabled_ ? "ON" : "OFF");
+           this->auto_answer_ ? "ON" : "OFF", this->is_aec_enabled() ? "ON" : "OFF");
 #else
   ESP_LOGI(TAG, "Entity states synced (vol=%.0f%%, mic=%.1fdB, auto=%s)",
            this->volume_ * 100.0f, this->mic_gain_db_,
@@ -373,13 +472,10 @@ void IntercomApi::start() {
 
   const auto &dest = this->get_current_destination();
   ESP_LOGI(TAG, "%s -> %s: calling...", this->device_name_.c_str(), dest.c_str());
-  this->set_active_(true);
+  this->prepare_call_();
   this->set_call_state_(CallState::OUTGOING);
   this->outgoing_start_time_ = millis();
-
-  if (this->server_task_handle_) xTaskNotifyGive(this->server_task_handle_);
-  if (this->tx_task_handle_) xTaskNotifyGive(this->tx_task_handle_);
-  if (this->speaker_task_handle_) xTaskNotifyGive(this->speaker_task_handle_);
+  // set_call_state_() woke server_task, prepare_call_() the audio tasks
 }
 
 void IntercomApi::stop() {
@@ -409,7 +505,7 @@ void IntercomApi::answer_call() {
   ESP_LOGI(TAG, "%s: answering call", this->device_name_.c_str());
   this->send_message_(sock, MessageType::ANSWER);
   this->set_call_state_(CallState::ANSWERING);
-  this->set_active_(true);
+  this->prepare_call_();  // Already prepared while ringing: only the streaming gate flips
   this->set_streaming_(true);
 }
 
@@ -477,27 +573,56 @@ void IntercomApi::set_mic_gain_db(float db) {
 #ifdef USE_ESP_AEC
 void IntercomApi::reset_aec_buffers_() {
   if (!this->aec_enabled_ || this->spk_ref_buffer_ == nullptr) return;
+  // tx_task (the reference ring's reader) realigns it before its next AEC frame
+  this->aec_ref_reset_.store(true, std::memory_order_release);
+}
 
-  this->aec_mic_fill_ = 0;
-  if (xSemaphoreTake(this->spk_ref_mutex_, pdMS_TO_TICKS(50)) == pdTRUE) {
-    this->spk_ref_buffer_->reset();
-    // Pre-fill reference buffer with silence to create delay
-    // This compensates for I2S DMA latency + acoustic delay
-    // The mic captures echo from audio played ~80ms ago, so we delay the reference
-    // Use stack-based loop instead of heap allocation for the silence block
-    uint8_t zeros[256] = {};
-    size_t remaining = AEC_REF_DELAY_BYTES;
-    while (remaining > 0) {
-      size_t chunk = std::min(remaining, sizeof(zeros));
-      this->spk_ref_buffer_->write(zeros, chunk);
-      remaining -= chunk;
-    }
-    ESP_LOGD(TAG, "AEC buffers reset, pre-filled %ums silence", static_cast<unsigned>(AEC_REF_DELAY_MS));
-    xSemaphoreGive(this->spk_ref_mutex_);
+void IntercomApi::realign_aec_reference_() {
+  this->spk_ref_buffer_->reset();
+  // Delay the reference by reading silence first: this compensates for I2S DMA latency
+  // + acoustic delay (the mic captures echo from audio played ~80ms ago).
+  // After an estimate, a new call starts from the delay the previous one settled on.
+  this->spk_ref_buffer_->pad_silence(this->aec_ref_delay_bytes_);
+  this->delay_estimator_.arm();  // Re-measure during this call's first seconds of playback
+  ESP_LOGD(TAG, "AEC reference realigned, %ums of silence ahead",
+           static_cast<unsigned>(this->get_aec_reference_delay_ms()));
+}
+
+void IntercomApi::apply_ref_delay_estimate_() {
+  int32_t lag;
+  float confidence;
+  if (!this->delay_estimator_.take_result(lag, confidence)) return;
+
+  // Pad silence to delay the reference further, drop samples to advance it
+  const size_t old_bytes = this->aec_ref_delay_bytes_;
+  const int64_t target = std::max<int64_t>(
+      0, std::min<int64_t>(static_cast<int64_t>(old_bytes) + lag * static_cast<int32_t>(sizeof(int16_t)),
+                           AEC_REF_DELAY_BYTES + AEC_DELAY_SEARCH_BYTES));
+  size_t new_bytes = old_bytes;
+  if (target > static_cast<int64_t>(old_bytes)) {
+    this->spk_ref_buffer_->pad_silence(static_cast<size_t>(target) - old_bytes);
+    new_bytes = static_cast<size_t>(target);
+  } else {
+    new_bytes -= this->spk_ref_buffer_->skip(old_bytes - static_cast<size_t>(target));
   }
+  this->aec_ref_delay_bytes_ = new_bytes;
+  ESP_LOGI(TAG, "AEC reference delay %ums -> %ums (lag %+dms, correlation %.2f)",
+           static_cast<unsigned>(old_bytes / sizeof(int16_t) * 1000 / SAMPLE_RATE),
+           static_cast<unsigned>(this->get_aec_reference_delay_ms()),
+           static_cast<int>(lag * 1000 / static_cast<int32_t>(SAMPLE_RATE)), confidence);
 }
 
 void IntercomApi::set_aec_enabled(bool enabled) {
+  if (this->aec_owner_ != nullptr) {
+    // Echo cancellation already runs once per frame on the bus owner's mic path
+    if (enabled && !this->aec_owner_->has_aec()) {
+      ESP_LOGW(TAG, "Cannot enable AEC: I2S bus owner has no AEC processor");
+      enabled = false;
+    }
+    this->aec_owner_->set_aec_enabled(enabled);
+    ESP_LOGI(TAG, "AEC %s (I2S bus owner)", enabled ? "enabled" : "disabled");
+    return;
+  }
   if (enabled) {
     // Only allow enabling if AEC is properly initialized
     if (this->aec_ == nullptr || !this->aec_->is_initialized()) {
@@ -505,31 +630,16 @@ void IntercomApi::set_aec_enabled(bool enabled) {
       this->aec_enabled_ = false;
       return;
     }
-    // Lazy allocate AEC buffers on first enable (saves ~13KB when AEC unused)
+    // Buffers come from the audio arena (setup()): nothing to allocate here
     if (this->aec_mic_ == nullptr) {
-      const size_t frame_bytes = static_cast<size_t>(this->aec_frame_samples_) * sizeof(int16_t);
-      this->spk_ref_buffer_ = RingBuffer::create(AEC_REF_DELAY_BYTES + RX_BUFFER_SIZE);
-      this->aec_mic_ = static_cast<int16_t *>(heap_caps_malloc(frame_bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
-      this->aec_ref_ = static_cast<int16_t *>(heap_caps_malloc(frame_bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
-      this->aec_out_ = static_cast<int16_t *>(heap_caps_malloc(frame_bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
-
-      if (!this->spk_ref_buffer_ || !this->aec_mic_ || !this->aec_ref_ || !this->aec_out_) {
-        ESP_LOGE(TAG, "AEC buffer allocation failed");
-        if (this->aec_mic_) { heap_caps_free(this->aec_mic_); this->aec_mic_ = nullptr; }
-        if (this->aec_ref_) { heap_caps_free(this->aec_ref_); this->aec_ref_ = nullptr; }
-        if (this->aec_out_) { heap_caps_free(this->aec_out_); this->aec_out_ = nullptr; }
-        this->aec_enabled_ = false;
-        return;
-      }
-      ESP_LOGI(TAG, "AEC buffers allocated (frame=%d samples, ref_buf=%zu bytes)",
-               this->aec_frame_samples_, AEC_REF_DELAY_BYTES + RX_BUFFER_SIZE);
+      ESP_LOGW(TAG, "Cannot enable AEC: no AEC buffers (invalid frame size)");
+      this->aec_enabled_ = false;
+      return;
     }
   }
   this->aec_enabled_ = enabled;
   if (enabled) {
     this->reset_aec_buffers_();
-  } else {
-    this->aec_mic_fill_ = 0;
   }
   ESP_LOGI(TAG, "AEC %s", enabled ? "enabled" : "disabled");
 }
@@ -694,6 +804,7 @@ void IntercomApi::set_active_(bool on) {
   if (on) {
     // Starting - clear any pending stop request and start hardware
     this->speaker_stop_requested_.store(false, std::memory_order_release);
+    this->notify_audio_tasks_();
 
 #ifdef USE_MICROPHONE
     if (this->microphone_source_) {
@@ -716,10 +827,12 @@ void IntercomApi::set_active_(bool on) {
         // 1. Request speaker_task to stop the speaker
         // 2. Wait for acknowledgment (with timeout)
         this->speaker_stop_requested_.store(true, std::memory_order_release);
+        this->notify_audio_tasks_();
         if (xSemaphoreTake(this->speaker_stopped_sem_, pdMS_TO_TICKS(500)) != pdTRUE) {
           ESP_LOGW(TAG, "Speaker stop timeout");
         }
         this->speaker_stop_requested_.store(false, std::memory_order_release);
+        this->notify_audio_tasks_();  // Release speaker_task from its stop wait
       } else {
         // No AEC: no speaker_task exists, stop speaker directly from server_task (Core 1)
         // speaker_->stop() is safe here — it just sets state + signals the mixer
@@ -739,28 +852,63 @@ void IntercomApi::set_active_(bool on) {
 }
 
 void IntercomApi::set_streaming_(bool on) {
+  if (on) {
+    // Buffers and DSP state were reset by prepare_call_(); only the call's network state is new
+    this->metrics_.latency.reset();
+    this->last_probe_ms_ = millis() - PROBE_INTERVAL_MS;  // First probe at once
+  }
   this->client_.streaming.store(on, std::memory_order_release);
   this->state_ = on ? ConnectionState::STREAMING : ConnectionState::CONNECTED;
   if (on) {
-    // Reset audio buffers for new call - prevents stale data on quick reconnect
-    // RingBuffer::reset() is thread-safe (FreeRTOS xRingbuffer), no mutex needed
-    if (this->mic_buffer_) {
-      this->mic_buffer_->reset();
-    }
-    if (this->speaker_buffer_) {  // Only exists when has_intercom_aec_()
-      this->speaker_buffer_->reset();
-    }
-    this->dc_offset_ = 0;  // Reset DC filter state for new session
-
-#ifdef USE_ESP_AEC
-    // Reset AEC state for new call - critical for proper echo cancellation
-    this->reset_aec_buffers_();
-#endif
-
     this->set_call_state_(CallState::STREAMING);  // FSM - publishes state internally
   } else {
     this->publish_state_();  // Only publish when stopping (set_call_state_ already publishes)
   }
+  this->notify_audio_tasks_();
+  this->wake_server_task_();
+}
+
+void IntercomApi::prepare_call_() {
+  // Once active, speaker_task may be reading speaker_buffer_: the call is prepared already
+  if (this->active_.load(std::memory_order_acquire)) return;
+
+  // Reset audio buffers for new call - prevents stale data on quick reconnect
+  // Every reader and writer is parked (not active, not streaming), so the SPSC rings can be reset here
+  if (this->mic_buffer_) {
+    this->mic_buffer_->reset();
+  }
+  if (this->speaker_buffer_) {  // Only exists when has_intercom_aec_()
+    this->speaker_buffer_->reset();
+  }
+#ifdef USE_INTERCOM_OPUS
+  if (this->enc_buffer_) {  // Only exists when has_intercom_aec_()
+    this->enc_buffer_->reset();
+  }
+#endif
+  this->dc_blocker_.reset();  // Reset DC filter state for new session
+  this->dtx_vad_.reset();     // Noise floor is learned again per call
+
+#ifdef USE_ESP_AEC
+  // Reset AEC state for new call - critical for proper echo cancellation.
+  // Nothing reaches the reference before the answer, so the realigned delay still holds then.
+  this->reset_aec_buffers_();
+  this->aec_gate_vad_.reset();
+#endif
+
+  // Mic and speaker come up while the call rings: the speaker pipeline warms up in loop()
+  // and speaker_task starts its playout from it. Nothing is written to the speaker before
+  // the answer, so a ringtone played through the same (duplex or mixer) speaker is untouched.
+  this->set_active_(true);
+  ESP_LOGD(TAG, "Audio pipeline prepared");
+}
+
+void IntercomApi::notify_audio_tasks_() {
+  // Task notifications are latched: a notify given before the task blocks is not lost
+  if (this->tx_task_handle_) xTaskNotifyGive(this->tx_task_handle_);
+  if (this->speaker_task_handle_) xTaskNotifyGive(this->speaker_task_handle_);
+#ifdef USE_INTERCOM_OPUS
+  if (this->encoder_task_handle_) xTaskNotifyGive(this->encoder_task_handle_);
+#endif
 }
 
 void IntercomApi::set_call_state_(CallState new_state) {
@@ -794,6 +942,7 @@ void IntercomApi::set_call_state_(CallState new_state) {
   }
 
   this->publish_state_();
+  this->wake_server_task_();  // Leave (or enter) its idle select() timeout
 }
 
 void IntercomApi::end_call_(CallEndReason reason) {
@@ -815,6 +964,9 @@ void IntercomApi::end_call_(CallEndReason reason) {
   // NOTE: stop_trigger_ is NOT fired here — set_active_(false) already fires it.
   // Callers must ensure set_active_(false) is called before end_call_().
 
+  // Direct call: tell the HA link that dialed it
+  this->release_controller_();
+
   this->set_call_state_(CallState::IDLE);
 }
 
@@ -831,18 +983,14 @@ void IntercomApi::server_task_() {
   if (!this->setup_server_socket_()) {
     ESP_LOGE(TAG, "Failed to setup server socket on startup");
   }
+  if (this->datagram_audio_ && !this->setup_datagram_socket_()) {
+    ESP_LOGW(TAG, "Datagram audio unavailable - calls fall back to TCP");
+  }
+  if (!this->setup_wake_socket_()) {
+    ESP_LOGW(TAG, "No wake socket - idle server task polls every %u ms", TASK_IDLE_WAIT_MS);
+  }
 
   while (true) {
-    // When streaming, don't wait - poll as fast as possible
-    // When idle, wait up to 100ms to save CPU
-    if (this->client_.streaming.load()) {
-      // During streaming: just check notification without blocking
-      ulTaskNotifyTake(pdTRUE, 0);  // Non-blocking
-    } else {
-      // When idle: wait for activation signal
-      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
-    }
-
     // Server mode - listen for connections
     if (this->server_socket_ < 0) {
       if (!this->setup_server_socket_()) {
@@ -851,21 +999,87 @@ void IntercomApi::server_task_() {
       }
     }
 
-    // Accept new connection if none
-    if (this->client_.socket.load() < 0) {
+    // Accept new connections while the call client slot or a monitor slot is free
+    const bool can_accept = this->client_.socket.load() < 0 || this->free_monitor_slot_() != nullptr;
+    if (can_accept) {
       this->accept_client_();
     }
 
-    // Handle existing client
+    // One select() across the call client, the datagram socket and every monitor client.
+    // Datagram calls use a short timeout to keep the playout clock, streaming calls poll
+    // the inline TX path. Otherwise select() is the task's only wait: a connection to
+    // accept, a message or the wake socket (call-state change) ends it.
     int client_fd = this->client_.socket.load();
+    const bool datagram = client_fd >= 0 && this->datagram_active_.load(std::memory_order_acquire);
+    const bool streaming = this->client_.streaming.load();
+    const int wake_fd = this->wake_socket_.load(std::memory_order_acquire);
+    fd_set read_fds;
+    FD_ZERO(&read_fds);
+    int max_fd = -1;
+    if (can_accept) {
+      FD_SET(this->server_socket_, &read_fds);
+      max_fd = this->server_socket_;
+    }
+    if (wake_fd >= 0) {
+      FD_SET(wake_fd, &read_fds);
+      max_fd = std::max(max_fd, wake_fd);
+    }
     if (client_fd >= 0) {
-      // Check for incoming data
-      fd_set read_fds;
-      FD_ZERO(&read_fds);
       FD_SET(client_fd, &read_fds);
-      struct timeval tv = {.tv_sec = 0, .tv_usec = 10000};  // 10ms
+      max_fd = std::max(max_fd, client_fd);
+    }
+    if (datagram) {
+      FD_SET(this->datagram_socket_, &read_fds);
+      max_fd = std::max(max_fd, this->datagram_socket_);
+    }
+    for (size_t i = 0; i < this->max_monitors_; i++) {
+      int fd = this->monitors_[i].socket.load();
+      if (fd < 0) continue;
+      FD_SET(fd, &read_fds);
+      max_fd = std::max(max_fd, fd);
+    }
+    const int standby_fd = this->standby_.socket.load();
+    if (standby_fd >= 0) {
+      FD_SET(standby_fd, &read_fds);
+      max_fd = std::max(max_fd, standby_fd);
+    }
+    // Callee connect in progress (DIAL): writable once the handshake is through
+    const int dial_fd = this->dial_socket_.load();
+    fd_set write_fds;
+    FD_ZERO(&write_fds);
+    if (dial_fd >= 0) {
+      FD_SET(dial_fd, &write_fds);
+      max_fd = std::max(max_fd, dial_fd);
+    }
+    uint32_t wait_us = TASK_IDLE_WAIT_MS * 1000;  // Ringing/outgoing, or no wake socket
+    if (datagram) {
+      wait_us = 2000;
+    } else if (streaming) {
+      wait_us = 10000;
+    } else if (wake_fd >= 0 && this->call_state_ == CallState::IDLE) {
+      wait_us = SERVER_IDLE_WAIT_MS * 1000;
+    }
+    if (dial_fd >= 0) {
+      // Wake up for the connect deadline as well
+      const uint32_t elapsed = millis() - this->dial_started_ms_;
+      wait_us = std::min(wait_us, elapsed < DIAL_CONNECT_TIMEOUT_MS ? (DIAL_CONNECT_TIMEOUT_MS - elapsed) * 1000 : 0);
+    }
+    int ret = 0;
+    if (max_fd >= 0) {
+      struct timeval tv = {.tv_sec = static_cast<time_t>(wait_us / 1000000),
+                           .tv_usec = static_cast<suseconds_t>(wait_us % 1000000)};
+      ret = ::select(max_fd + 1, &read_fds, dial_fd >= 0 ? &write_fds : nullptr, nullptr, &tv);
+      this->server_wakeups_.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (ret > 0 && wake_fd >= 0 && FD_ISSET(wake_fd, &read_fds)) {
+      uint8_t drain[8];
+      while (recv(wake_fd, drain, sizeof(drain), 0) > 0) {
+        // Any number of wake-ups is one pass through the loop
+      }
+    }
 
-      int ret = ::select(client_fd + 1, &read_fds, nullptr, nullptr, &tv);
+    // Handle the call client
+    if (client_fd >= 0) {
       if (ret > 0 && FD_ISSET(client_fd, &read_fds)) {
         MessageHeader header;
         if (this->receive_message_(client_fd, header, this->rx_buffer_, MAX_MESSAGE_SIZE)) {
@@ -876,7 +1090,8 @@ void IntercomApi::server_task_() {
           // IMPORTANT: Order matters to avoid race conditions
           // 1. Stop streaming flag first
           this->client_.streaming.store(false);
-          // 2. Close socket immediately
+          // 2. Close socket immediately (a dead standby link is not parked)
+          this->client_.standby = false;
           this->close_client_socket_();
           // 3. Now stop audio hardware
           this->set_active_(false);
@@ -897,6 +1112,14 @@ void IntercomApi::server_task_() {
         }
       }
 
+      // Datagram audio: drain the UDP socket into the jitter buffer, then play what is due
+      if (this->datagram_active_.load(std::memory_order_acquire)) {
+        if (ret > 0 && FD_ISSET(this->datagram_socket_, &read_fds)) {
+          this->receive_datagrams_();
+        }
+        this->play_jitter_();
+      }
+
       // Send ping if needed - but NOT during streaming to avoid interference with audio
       if (this->state_ != ConnectionState::STREAMING &&
           millis() - this->client_.last_ping > PING_INTERVAL_MS) {
@@ -904,27 +1127,47 @@ void IntercomApi::server_task_() {
         this->client_.last_ping = millis();
       }
 
+      // In-call latency probe instead, for peers that answer it. Over TCP it queues behind
+      // the call audio, so its RTT includes what the audio waits for too.
+      if (this->state_ == ConnectionState::STREAMING && this->latency_peer_.load(std::memory_order_relaxed) &&
+          millis() - this->last_probe_ms_ > PROBE_INTERVAL_MS) {
+        this->send_latency_probe_(MessageType::PROBE, static_cast<uint32_t>(esp_timer_get_time()));
+        this->last_probe_ms_ = millis();
+      }
+
       // Inline TX: when no tx_task exists, read mic_buffer and send from server_task
       // Cannot call send() from mic callback (runs in audio_task prio 19 on Core 0)
       // so we use mic_buffer as the bridge, same as tx_task does
+      // Opus calls: encoder_task drains mic_buffer_ instead
       if (!this->has_intercom_aec_() &&
+          this->codec_.load(std::memory_order_acquire) == AudioCodec::PCM &&
           this->active_.load(std::memory_order_acquire) &&
           this->client_.streaming.load(std::memory_order_acquire) &&
           client_fd >= 0) {
-        // Drain mic_buffer — send all available chunks
-        while (this->mic_buffer_->available() >= AUDIO_CHUNK_SIZE) {
+        // Drain mic_buffer — send all available frames, one negotiated PCM frame each
+        this->metrics_.ring(MetricsRing::MIC).sample(this->mic_buffer_->available());
+        const size_t frame_bytes = this->tx_frame_bytes_();
+        const size_t frame_samples = frame_bytes / sizeof(int16_t);
+        while (this->mic_buffer_->available() >= frame_bytes) {
           uint8_t audio_chunk[AUDIO_CHUNK_SIZE];
-          size_t read = this->mic_buffer_->read(audio_chunk, AUDIO_CHUNK_SIZE, 0);
-          if (read != AUDIO_CHUNK_SIZE) break;
+          size_t read = this->mic_buffer_->read(audio_chunk, frame_bytes);
+          if (read != frame_bytes) break;
 
-          // Use send_message_ (takes send_mutex_, uses tx_buffer_) — safe because
-          // server_task is the only sender when tx_task doesn't exist
-          this->send_message_(client_fd, MessageType::AUDIO, MessageFlags::NONE,
-                              audio_chunk, AUDIO_CHUNK_SIZE);
+          // server_task is the only audio sender when tx_task doesn't exist
+          if (!this->send_dtx_frame_(reinterpret_cast<const int16_t *>(audio_chunk), frame_samples)) {
+            this->send_audio_frame_(audio_chunk, frame_bytes, frame_samples);
+          }
         }
       }
     }
 
+    // Monitor clients: control messages, pending-START timeouts, stalled subscribers
+    this->service_monitors_(&read_fds, ret > 0);
+    // Standby link: a call request takes the call client slot, silence closes it
+    this->service_standby_(&read_fds, ret > 0);
+    // Direct call being dialed: hand the callee connection over, or UNREACHABLE past the deadline
+    this->service_dial_(dial_fd, &write_fds, ret > 0);
+
     delay(1);  // Yield
   }
 }
@@ -942,143 +1185,199 @@ void IntercomApi::tx_task_() {
 
   while (true) {
     // Wait until active and connected
-    if (!this->active_.load(std::memory_order_acquire) ||
-        this->client_.socket.load() < 0 ||
-        !this->client_.streaming.load()) {
-#ifdef USE_ESP_AEC
-      // Reset AEC accumulator when paused
-      this->aec_mic_fill_ = 0;
-#endif
-      delay(20);
+    const bool active = this->active_.load(std::memory_order_acquire);
+    if (!active || this->client_.socket.load() < 0 || !this->client_.streaming.load()) {
+      // Block until set_active_/set_streaming_ wakes us
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(active ? TASK_IDLE_WAIT_MS : TASK_SLEEP_WAIT_MS));
+      this->tx_wakeups_.fetch_add(1, std::memory_order_relaxed);
       continue;
     }
 
-    // Read from mic buffer (RingBuffer is thread-safe, no mutex needed)
+    // One call frame per read (SPSC ring: tx_task is its only reader). Calls are framed to
+    // the AEC chunk, so an AEC frame comes out of mic_buffer_ in one piece.
+#ifdef USE_ESP_AEC
+    const bool run_aec = this->aec_enabled_ && this->aec_ != nullptr && this->aec_mic_ != nullptr;
+    const size_t frame_bytes =
+        run_aec ? static_cast<size_t>(this->aec_frame_samples_) * sizeof(int16_t) : this->tx_frame_bytes_();
+#else
+    const size_t frame_bytes = this->tx_frame_bytes_();
+#endif
     size_t avail = this->mic_buffer_->available();
-    if (avail < AUDIO_CHUNK_SIZE) {
-      delay(2);
-      continue;
-    }
-
-    size_t read = this->mic_buffer_->read(audio_chunk, AUDIO_CHUNK_SIZE, 0);
-
-    if (read != AUDIO_CHUNK_SIZE) {
+    this->metrics_.ring(MetricsRing::MIC).sample(avail);
+    if (avail < frame_bytes) {
+      // Block until on_microphone_data_() signals a full frame
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(TASK_DATA_WAIT_MS));
+      this->tx_wakeups_.fetch_add(1, std::memory_order_relaxed);
       continue;
     }
 
 #ifdef USE_ESP_AEC
-    // AEC Processing: accumulate samples, process when full frame ready
-    if (this->aec_enabled_ && this->aec_ != nullptr && this->aec_mic_ != nullptr) {
-      const int16_t *mic_samples = reinterpret_cast<const int16_t *>(audio_chunk);
-      size_t num_samples = AUDIO_CHUNK_SIZE / sizeof(int16_t);  // = SAMPLES_PER_CHUNK
-
-      // Copy mic samples to accumulator
-      size_t samples_to_copy = std::min(num_samples,
-                                        static_cast<size_t>(this->aec_frame_samples_) - this->aec_mic_fill_);
-      memcpy(this->aec_mic_ + this->aec_mic_fill_, mic_samples, samples_to_copy * sizeof(int16_t));
-      this->aec_mic_fill_ += samples_to_copy;
-
-      // If we have a full AEC frame, process it
-      if (this->aec_mic_fill_ >= static_cast<size_t>(this->aec_frame_samples_)) {
-        // Read speaker reference from buffer (same frame size)
-        size_t ref_bytes_needed = this->aec_frame_samples_ * sizeof(int16_t);
-
-        if (xSemaphoreTake(this->spk_ref_mutex_, pdMS_TO_TICKS(2)) == pdTRUE) {
-          size_t ref_avail = this->spk_ref_buffer_->available();
-          if (ref_avail >= ref_bytes_needed) {
-            this->spk_ref_buffer_->read(this->aec_ref_, ref_bytes_needed, 0);
-          } else {
-            // Not enough reference - use silence (still process to reduce latency)
-            memset(this->aec_ref_, 0, ref_bytes_needed);
-            static uint32_t last_warn = 0;
-            if (millis() - last_warn > 5000) {
-              ESP_LOGW(TAG, "AEC: ref buffer low (%zu/%zu bytes)", ref_avail, ref_bytes_needed);
-              last_warn = millis();
-            }
-          }
-          xSemaphoreGive(this->spk_ref_mutex_);
-        } else {
-          memset(this->aec_ref_, 0, ref_bytes_needed);
-          ESP_LOGW(TAG, "AEC: mutex timeout");
-        }
-
-        // Always process AEC - no skip threshold to avoid audio discontinuities
-        this->aec_->process(this->aec_mic_, this->aec_ref_, this->aec_out_, this->aec_frame_samples_);
-
-        // Send processed audio (may be larger than AUDIO_CHUNK_SIZE)
-        size_t out_bytes = this->aec_frame_samples_ * sizeof(int16_t);
-
-        // Check still active before sending
-        if (this->active_.load(std::memory_order_acquire) && this->client_.socket.load() >= 0) {
-          int socket = this->client_.socket.load();
-          MessageHeader header;
-          header.type = static_cast<uint8_t>(MessageType::AUDIO);
-          header.flags = static_cast<uint8_t>(MessageFlags::NONE);
-          header.length = out_bytes;
-
-          memcpy(this->audio_tx_buffer_, &header, HEADER_SIZE);
-          memcpy(this->audio_tx_buffer_ + HEADER_SIZE, this->aec_out_, out_bytes);
+    // AEC Processing: one AEC frame straight into aec_mic_
+    if (run_aec) {
+      if (this->aec_ref_reset_.exchange(false, std::memory_order_acquire)) {
+        this->realign_aec_reference_();
+      }
+      if (this->mic_buffer_->read(this->aec_mic_, frame_bytes) != frame_bytes) {
+        continue;
+      }
 
-          size_t total = HEADER_SIZE + out_bytes;
-          ssize_t sent = send(socket, this->audio_tx_buffer_, total, MSG_DONTWAIT);
+      // Read speaker reference from buffer (same frame size)
+      const size_t ref_bytes_needed = frame_bytes;
+
+      this->apply_ref_delay_estimate_();
+      size_t ref_avail = this->spk_ref_buffer_->available();
+      this->metrics_.ring(MetricsRing::SPK_REF).sample(ref_avail);
+      bool ref_quiet = true;
+      if (ref_avail >= ref_bytes_needed) {
+        this->spk_ref_buffer_->read(this->aec_ref_, ref_bytes_needed);
+        // Same frame pair the AEC sees: feeds the delay estimate while one is armed
+        this->delay_estimator_.capture(this->aec_mic_, this->aec_ref_, this->aec_frame_samples_);
+        ref_quiet = audio_kernels::peak_abs(this->aec_ref_, this->aec_frame_samples_) < DTX_REF_QUIET_PEAK;
+      } else {
+        // Not enough reference - use silence (still process to reduce latency)
+        memset(this->aec_ref_, 0, ref_bytes_needed);
+        static uint32_t last_warn = 0;
+        if (millis() - last_warn > 5000) {
+          ESP_LOGW(TAG, "AEC: ref buffer low (%zu/%zu bytes)", ref_avail, ref_bytes_needed);
+          last_warn = millis();
+        }
+      }
 
-          if (sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
-            // Only log if still streaming - avoid noise during shutdown
-            if (this->client_.streaming.load(std::memory_order_acquire)) {
-              ESP_LOGW(TAG, "TX send error: %d", errno);
-            }
-          }
+      // Process every frame (no skip threshold avoids discontinuities), except on DTX calls
+      // while nothing plays and nobody talks: there is no echo to cancel, and the quiet raw
+      // frame only feeds the DTX decision, which turns it into a ComfortNoiseFrame
+      const int16_t *out = this->aec_out_;
+      const bool mic_quiet =
+          this->is_dtx_call() && !this->aec_gate_vad_.process(this->aec_mic_, this->aec_frame_samples_);
+      if (mic_quiet && ref_quiet) {
+        out = this->aec_mic_;
+        this->metrics_.aec_skipped_frames.fetch_add(1, std::memory_order_relaxed);
+      } else {
+        {
+          ScopedStage stage(this->metrics_.stage(MetricsStage::AEC));
+          this->aec_->process(this->aec_mic_, this->aec_ref_, this->aec_out_, this->aec_frame_samples_);
         }
+        this->aec_->report_frame_load(
+            this->metrics_.stage(MetricsStage::AEC).last_us.load(std::memory_order_relaxed), this->aec_frame_samples_);
+      }
 
-        // Reset accumulators
-        this->aec_mic_fill_ = 0;
+      // Check still active before sending
+      if (this->active_.load(std::memory_order_acquire)) {
+        this->tx_send_audio_(reinterpret_cast<const uint8_t *>(out), frame_bytes);
+      }
 
-        // Handle overflow: if we had more samples than frame_size, carry over
-        if (samples_to_copy < num_samples) {
-          size_t remaining = num_samples - samples_to_copy;
-          memcpy(this->aec_mic_, mic_samples + samples_to_copy, remaining * sizeof(int16_t));
-          this->aec_mic_fill_ = remaining;
-        }
+      // Frame boundary: follow an AEC mode switch to another frame size (the next read
+      // takes the new size; the call keeps its negotiated frame_ms, TCP/UDP carry either)
+      const int next_frame = this->aec_->get_frame_size();
+      if (next_frame != this->aec_frame_samples_ && next_frame > 0 && next_frame <= this->aec_max_frame_samples_) {
+        ESP_LOGD(TAG, "AEC frame size %d -> %d samples", this->aec_frame_samples_, next_frame);
+        this->aec_frame_samples_ = next_frame;
       }
 
-      // Minimal delay
-      yield();
       continue;  // Skip non-AEC path
     }
 #endif
 
     // Non-AEC path: send directly
+    if (this->mic_buffer_->read(audio_chunk, frame_bytes) != frame_bytes) {
+      continue;
+    }
     // Check still active before sending
     if (!this->active_.load(std::memory_order_acquire) || this->client_.socket.load() < 0) {
       continue;
     }
 
-    // Send directly using dedicated audio_tx_buffer_ (no mutex needed)
-    int socket = this->client_.socket.load();
-    if (socket >= 0) {
-      MessageHeader header;
-      header.type = static_cast<uint8_t>(MessageType::AUDIO);
-      header.flags = static_cast<uint8_t>(MessageFlags::NONE);
-      header.length = AUDIO_CHUNK_SIZE;
+    this->tx_send_audio_(audio_chunk, frame_bytes);
+  }
+}
+
+void IntercomApi::tx_send_audio_(const uint8_t *data, size_t len) {
+  int socket = this->client_.socket.load();
+  if (socket < 0) return;
+
+#ifdef USE_INTERCOM_OPUS
+  if (this->codec_.load(std::memory_order_acquire) == AudioCodec::OPUS) {
+    // Hand PCM to encoder_task (Core 1) - tx_task stays cheap next to i2s_duplex
+    this->enc_buffer_->write(data, len);
+    xTaskNotifyGive(this->encoder_task_handle_);
+    return;
+  }
+#endif
+
+  if (this->send_dtx_frame_(reinterpret_cast<const int16_t *>(data), len / sizeof(int16_t))) return;
+  // Gather-send straight from the caller's buffer (no staging copy); drop the frame if the link is backed up
+  this->send_audio_frame_(data, len, len / sizeof(int16_t));
+}
 
-      memcpy(this->audio_tx_buffer_, &header, HEADER_SIZE);
-      memcpy(this->audio_tx_buffer_ + HEADER_SIZE, audio_chunk, AUDIO_CHUNK_SIZE);
+#ifdef USE_INTERCOM_OPUS
+// === Encoder Task (Core 1) - PCM to Opus ===
 
-      size_t total = HEADER_SIZE + AUDIO_CHUNK_SIZE;
-      ssize_t sent = send(socket, this->audio_tx_buffer_, total, MSG_DONTWAIT);
+void IntercomApi::encoder_task(void *param) {
+  static_cast<IntercomApi *>(param)->encoder_task_();
+}
 
-      if (sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
-        // Only log if still streaming - avoid noise during shutdown
-        if (this->client_.streaming.load(std::memory_order_acquire)) {
-          ESP_LOGW(TAG, "TX send error: %d", errno);
-        }
-      }
+void IntercomApi::encoder_task_() {
+  ESP_LOGD(TAG, "Encoder task started");
+
+  OpusFrameEncoder encoder;
+  int16_t pcm[OPUS_MAX_FRAME_SAMPLES];
+  uint8_t packet[OPUS_MAX_PACKET];
+
+  while (true) {
+    // Wait until an Opus call is prepared (ringing/outgoing) or streaming
+    const bool active = this->active_.load(std::memory_order_acquire);
+    if (!active || this->client_.socket.load() < 0 ||
+        this->codec_.load(std::memory_order_acquire) != AudioCodec::OPUS) {
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(active ? TASK_IDLE_WAIT_MS : TASK_SLEEP_WAIT_MS));
+      continue;
+    }
+
+    // (Re)create the encoder when the negotiated frame duration changes - before the
+    // answer, so the first answered frame is encoded at once
+    uint8_t frame_ms = this->codec_frame_ms_.load(std::memory_order_acquire);
+    if (encoder.get_frame_ms() != frame_ms && !encoder.init(frame_ms, this->opus_bitrate_)) {
+      ESP_LOGE(TAG, "Opus encoder init failed (%u ms) - no TX audio this call", frame_ms);
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(TASK_IDLE_WAIT_MS));
+      continue;
+    }
+    if (!this->client_.streaming.load()) {
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(TASK_IDLE_WAIT_MS));
+      continue;
+    }
+
+    // tx_task feeds enc_buffer_ (post-AEC); without tx_task the mic callback feeds mic_buffer_
+    audio_kernels::SpscRing *source = this->enc_buffer_ ? this->enc_buffer_.get() : this->mic_buffer_.get();
+    size_t frame_bytes = encoder.get_frame_bytes();
+    size_t avail = source->available();
+    if (source == this->mic_buffer_.get()) {
+      this->metrics_.ring(MetricsRing::MIC).sample(avail);
+    }
+    if (avail < frame_bytes) {
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(TASK_DATA_WAIT_MS));
+      continue;
+    }
+
+    if (source->read(pcm, frame_bytes) != frame_bytes) {
+      continue;
+    }
+    // Quiet frame on a DTX call: a ComfortNoiseFrame went out instead, nothing to encode
+    if (this->send_dtx_frame_(pcm, frame_bytes / sizeof(int16_t))) {
+      continue;
+    }
+
+    size_t packet_len;
+    {
+      ScopedStage stage(this->metrics_.stage(MetricsStage::ENCODE));
+      packet_len = encoder.encode(pcm, packet, sizeof(packet));
+    }
+    if (packet_len == 0) {
+      continue;
     }
 
-    // Minimal delay - let FreeRTOS scheduler handle timing
-    yield();
+    this->send_audio_frame_(packet, packet_len, frame_bytes / sizeof(int16_t));
   }
 }
+#endif
 
 // === Speaker Task (Core 0) - Network to Speaker ===
 
@@ -1090,8 +1389,12 @@ void IntercomApi::speaker_task_() {
   ESP_LOGD(TAG, "Speaker task started");
 
 #ifdef USE_SPEAKER
-  uint8_t audio_chunk[AUDIO_CHUNK_SIZE * 4];
+  int16_t chunk[SAMPLES_PER_CHUNK];
+  int16_t stretched[SAMPLES_PER_CHUNK + PLAYOUT_MAX_STRETCH_SAMPLES];
   bool speaker_was_idle = true;
+  bool buffering = true;      // Filling to the playout target (call start, after an underrun)
+  uint32_t warmup_start = 0;
+  int64_t next_play_us = 0;   // Media clock: when the next chunk is due at the speaker
 
   while (true) {
     // Check for stop request - single-owner model: only this task stops speaker
@@ -1104,261 +1407,358 @@ void IntercomApi::speaker_task_() {
       if (this->speaker_stopped_sem_ != nullptr) {
         xSemaphoreGive(this->speaker_stopped_sem_);
       }
-      // Wait for next activation
+      // Wait for next activation (set_active_ notifies when the request is cleared)
       while (this->speaker_stop_requested_.load(std::memory_order_acquire)) {
-        delay(10);
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(TASK_SLEEP_WAIT_MS));
+        this->speaker_wakeups_.fetch_add(1, std::memory_order_relaxed);
       }
       continue;
     }
 
     // Wait until active
     if (!this->active_.load(std::memory_order_acquire) || this->speaker_ == nullptr) {
-      delay(20);
+      if (!speaker_was_idle) {
+        ESP_LOGD(TAG, "Playout: target %ums, jitter %ums, underruns %u, overflows %u",
+                 (unsigned) this->playout_.get_target_ms(), (unsigned) this->playout_.get_jitter_ms(),
+                 (unsigned) this->playout_.get_underruns(), (unsigned) this->playout_.get_overflows());
+      }
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(TASK_SLEEP_WAIT_MS));
+      this->speaker_wakeups_.fetch_add(1, std::memory_order_relaxed);
       speaker_was_idle = true;
       continue;
     }
 
-    // First audio after becoming active: let main loop initialize mixer+resampler pipeline.
-    // Without this, the mixer task may read from an uninitialized SourceSpeaker ring buffer.
+    // First audio after becoming active: the main loop is bringing up the speaker (a whole
+    // mixer+resampler pipeline, or one loop() for an i2s_audio_duplex speaker with
+    // speaker_rate: output). Hold playout until the speaker reports running (the mixer task may
+    // otherwise read an uninitialized SourceSpeaker ring buffer); prebuffering overlaps with the warm-up.
     if (speaker_was_idle) {
       speaker_was_idle = false;
-      vTaskDelay(pdMS_TO_TICKS(300));
+      buffering = true;
+      this->playout_.reset();
+      warmup_start = millis();
       continue;
     }
 
-    // Read from speaker buffer (RingBuffer is thread-safe, no mutex needed)
+    // SPSC ring: speaker_task is its only reader
     size_t avail = this->speaker_buffer_->available();
-    if (avail < AUDIO_CHUNK_SIZE) {
-      delay(1);
+    this->metrics_.ring(MetricsRing::SPEAKER).sample(avail);
+
+    // One call frame per chunk (capped at SAMPLES_PER_CHUNK), the same block the network delivered
+    const size_t chunk_samples = this->play_chunk_samples_();
+    const size_t chunk_bytes = chunk_samples * sizeof(int16_t);
+    const int64_t chunk_us = static_cast<int64_t>(chunk_samples) * 1000000 / SAMPLE_RATE;
+
+    if (buffering) {
+      const bool warm = this->speaker_->is_running() || millis() - warmup_start > PLAYOUT_WARMUP_MAX_MS;
+      if (!warm || avail < std::max(this->playout_.get_target_bytes(), chunk_bytes)) {
+        // Block until write_speaker_() signals a chunk (poll the speaker state while warming up)
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(warm ? TASK_DATA_WAIT_MS : 10));
+        this->speaker_wakeups_.fetch_add(1, std::memory_order_relaxed);
+        continue;
+      }
+      buffering = false;
+      next_play_us = esp_timer_get_time();
+    }
+
+    // Pace at the media clock, one chunk ahead of the speaker. esp_timer and the I2S clock
+    // run off the same crystal, so speaker_buffer_ holds exactly what the network jitter needs.
+    const int64_t now_us = esp_timer_get_time();
+    const int64_t lead_us = next_play_us - now_us;
+    if (lead_us > chunk_us) {
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS((lead_us - chunk_us) / 1000 + 1));
+      this->speaker_wakeups_.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+    if (-lead_us > chunk_us * 4) {
+      next_play_us = now_us;  // Task was held up - restart the clock instead of bursting
+    }
+
+    if (avail < chunk_bytes) {
+      // Underrun: rebuffer to the (by now larger) jitter target
+      this->playout_.count_underrun();
+      buffering = true;
       continue;
     }
 
-    // Read up to 4 chunks at once to reduce overhead
-    size_t to_read = avail;
-    if (to_read > AUDIO_CHUNK_SIZE * 4) to_read = AUDIO_CHUNK_SIZE * 4;
-    // Align to chunk size
-    to_read = (to_read / AUDIO_CHUNK_SIZE) * AUDIO_CHUNK_SIZE;
+    if (avail > this->playout_.get_max_bytes() + chunk_bytes) {
+      // Far past the window (burst after a stall): drop a chunk rather than stretch for seconds
+      this->speaker_buffer_->read(chunk, chunk_bytes);
+      this->playout_.count_overflow();
+      continue;
+    }
+
+    int32_t adjust = this->playout_.update(avail);
+    if (this->speaker_buffer_->read(chunk, chunk_bytes) != chunk_bytes) {
+      continue;
+    }
+    // The cap is per SAMPLES_PER_CHUNK: shorter chunks get the same stretch ratio
+    if (adjust != 0 && chunk_samples < SAMPLES_PER_CHUNK) {
+      const int32_t scaled = adjust * static_cast<int32_t>(chunk_samples) / static_cast<int32_t>(SAMPLES_PER_CHUNK);
+      adjust = scaled != 0 ? scaled : (adjust > 0 ? 1 : -1);
+    }
+
+    // Converge on the target depth by playing the chunk a few samples longer or shorter
+    const int16_t *out = chunk;
+    size_t out_samples = chunk_samples;
+    if (adjust != 0) {
+      out_samples = chunk_samples + adjust;
+      PlayoutController::stretch(chunk, chunk_samples, stretched, out_samples);
+      out = stretched;
+    }
+    next_play_us += static_cast<int64_t>(out_samples) * 1000000 / SAMPLE_RATE;
 
-    size_t read = this->speaker_buffer_->read(audio_chunk, to_read, 0);
+    const uint8_t *audio_chunk = reinterpret_cast<const uint8_t *>(out);
+    const size_t read = out_samples * sizeof(int16_t);
 
-    if (read > 0 && this->volume_ > 0.001f) {
-      this->speaker_->play(audio_chunk, read, 0);
+    if (this->volume_ > 0.001f) {
+      {
+        ScopedStage stage(this->metrics_.stage(MetricsStage::PLAY));
+        this->speaker_->play(audio_chunk, read, 0);
+      }
 
 #ifdef USE_ESP_AEC
       // Feed speaker reference buffer for AEC
       // IMPORTANT: Apply same volume scaling as speaker output so reference matches actual echo
       if (this->aec_enabled_ && this->spk_ref_buffer_ != nullptr) {
-        if (xSemaphoreTake(this->spk_ref_mutex_, pdMS_TO_TICKS(2)) == pdTRUE) {
-          // Use pre-allocated buffer for scaled reference (don't modify audio_chunk!)
-          if (this->volume_ != 1.0f) {
-            const int16_t *src = reinterpret_cast<const int16_t *>(audio_chunk);
-            size_t num_samples = read / sizeof(int16_t);
-            for (size_t i = 0; i < num_samples; i++) {
-              this->spk_ref_scaled_[i] = scale_sample(src[i], this->volume_);
-            }
-            this->spk_ref_buffer_->write(this->spk_ref_scaled_, read);
-          } else {
-            this->spk_ref_buffer_->write(audio_chunk, read);
-          }
-          xSemaphoreGive(this->spk_ref_mutex_);
-        }
+        // Scale straight into the ring (audio_chunk is left untouched); a full ring drops the newest
+        const audio_kernels::Gain gain = audio_kernels::Gain::from_float(this->volume_);
+        this->spk_ref_buffer_->write_samples(out, out_samples, [&gain](const int16_t *src, int16_t *dst, size_t n) {
+          audio_kernels::scale_copy(src, dst, n, gain);
+        });
       }
 #endif
     }
-
-    // Minimal delay
-    yield();
   }
 #else
-  // No speaker, just idle
+  // No speaker, just idle (nothing notifies this task)
   while (true) {
-    delay(1000);
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
   }
 #endif
 }
 
-// === Protocol ===
-
-bool IntercomApi::send_message_(int socket, MessageType type, MessageFlags flags,
-                                 const uint8_t *data, size_t len) {
-  if (socket < 0) return false;
-
-  // Take mutex to protect tx_buffer_ from concurrent access
-  if (xSemaphoreTake(this->send_mutex_, pdMS_TO_TICKS(10)) != pdTRUE) {
-    // Could not get mutex - another task is sending
-    return false;
-  }
+// === Metrics ===
 
-  MessageHeader header;
-  header.type = static_cast<uint8_t>(type);
-  header.flags = static_cast<uint8_t>(flags);
-  header.length = static_cast<uint16_t>(len);
+static const char *const METRICS_STAGE_NAMES[] = {"aec", "send", "encode", "decode", "play"};
+static const char *const METRICS_RING_NAMES[] = {"mic_buffer", "speaker_buffer", "spk_ref_buffer"};
+static const char *const METRICS_TASK_NAMES[] = {"server", "tx", "speaker", "encoder"};
 
-  // Build message in tx_buffer
-  memcpy(this->tx_buffer_, &header, HEADER_SIZE);
-  if (data && len > 0) {
-    memcpy(this->tx_buffer_ + HEADER_SIZE, data, len);
+TaskHandle_t IntercomApi::get_task_handle_(MetricsTask task) const {
+  switch (task) {
+    case MetricsTask::SERVER: return this->server_task_handle_;
+    case MetricsTask::TX: return this->tx_task_handle_;
+    case MetricsTask::SPEAKER: return this->speaker_task_handle_;
+#ifdef USE_INTERCOM_OPUS
+    case MetricsTask::ENCODER: return this->encoder_task_handle_;
+#endif
+    default: return nullptr;
   }
+}
 
-  size_t total = HEADER_SIZE + len;
-  size_t offset = 0;
-  uint32_t start_ms = millis();
+uint32_t IntercomApi::get_task_stack_free(MetricsTask task) const {
+  TaskHandle_t handle = this->get_task_handle_(task);
+  if (handle == nullptr) return 0;
+  // ESP-IDF reports the high-water mark in bytes
+  return static_cast<uint32_t>(uxTaskGetStackHighWaterMark(handle));
+}
 
-  // Handle partial sends with retry
-  while (offset < total) {
-    ssize_t sent = send(socket, this->tx_buffer_ + offset, total - offset, MSG_DONTWAIT);
+bool IntercomApi::get_task_run_time_us(MetricsTask task, uint32_t &run_time_us) const {
+#if configGENERATE_RUN_TIME_STATS
+  TaskHandle_t handle = this->get_task_handle_(task);
+  if (handle == nullptr) return false;
+  run_time_us = static_cast<uint32_t>(ulTaskGetRunTimeCounter(handle));
+  return true;
+#else
+  return false;
+#endif
+}
 
-    if (sent > 0) {
-      offset += static_cast<size_t>(sent);
-      continue;
+void IntercomApi::dump_metrics() {
+  ESP_LOGI(TAG, "Metrics:");
+  for (size_t i = 0; i < static_cast<size_t>(MetricsStage::COUNT); i++) {
+    const StageTimer &t = this->metrics_.stages[i];
+    uint32_t count = t.count.load(std::memory_order_relaxed);
+    if (count == 0) continue;
+    ESP_LOGI(TAG, "  %-7s last=%uus avg=%uus peak=%uus (n=%u)", METRICS_STAGE_NAMES[i],
+             (unsigned) t.last_us.load(std::memory_order_relaxed),
+             (unsigned) (t.total_us.load(std::memory_order_relaxed) / count),
+             (unsigned) t.peak_us.load(std::memory_order_relaxed), (unsigned) count);
+  }
+  for (size_t i = 0; i < static_cast<size_t>(MetricsRing::COUNT); i++) {
+    const FillWatermark &w = this->metrics_.rings[i];
+    uint32_t low = w.low.load(std::memory_order_relaxed);
+    if (low == UINT32_MAX) continue;
+    ESP_LOGI(TAG, "  %s fill: low=%u high=%u bytes", METRICS_RING_NAMES[i], (unsigned) low,
+             (unsigned) w.high.load(std::memory_order_relaxed));
+  }
+  ESP_LOGI(TAG, "  rx dropped=%u bytes, tx dropped=%u frames, send EAGAIN=%u",
+           (unsigned) this->metrics_.rx_dropped_bytes.load(std::memory_order_relaxed),
+           (unsigned) this->metrics_.tx_dropped_frames.load(std::memory_order_relaxed),
+           (unsigned) this->metrics_.send_eagain.load(std::memory_order_relaxed));
+  ESP_LOGI(TAG, "  dtx: sent=%u received=%u frames, aec skipped=%u frames",
+           (unsigned) this->metrics_.dtx_tx_frames.load(std::memory_order_relaxed),
+           (unsigned) this->metrics_.dtx_rx_frames.load(std::memory_order_relaxed),
+           (unsigned) this->metrics_.aec_skipped_frames.load(std::memory_order_relaxed));
+  const LatencyStats &latency = this->metrics_.latency;
+  if (latency.samples.load(std::memory_order_relaxed) > 0) {
+    ESP_LOGI(TAG, "  latency: rtt=%ums, peer->here=%ums, here->peer=%ums (%u probes)",
+             (unsigned) (latency.rtt_us.load(std::memory_order_relaxed) / 1000),
+             (unsigned) latency.rx_latency_ms.load(std::memory_order_relaxed),
+             (unsigned) latency.tx_latency_ms.load(std::memory_order_relaxed),
+             (unsigned) latency.samples.load(std::memory_order_relaxed));
+  }
+  if (this->max_monitors_ > 0) {
+    ESP_LOGI(TAG, "  monitors: %u subscribed, dropped=%u frames", (unsigned) this->get_monitor_count(),
+             (unsigned) this->metrics_.monitor_dropped_frames.load(std::memory_order_relaxed));
+  }
+  for (size_t i = 0; i < static_cast<size_t>(MetricsTask::COUNT); i++) {
+    auto task = static_cast<MetricsTask>(i);
+    if (this->get_task_handle_(task) == nullptr) continue;
+    uint32_t run_time_us = 0;
+    if (this->get_task_run_time_us(task, run_time_us)) {
+      ESP_LOGI(TAG, "  %s task: stack free=%u bytes, run time=%ums", METRICS_TASK_NAMES[i],
+               (unsigned) this->get_task_stack_free(task), (unsigned) (run_time_us / 1000));
+    } else {
+      ESP_LOGI(TAG, "  %s task: stack free=%u bytes", METRICS_TASK_NAMES[i],
+               (unsigned) this->get_task_stack_free(task));
     }
+  }
+}
 
-    if (sent == 0) {
-      // Connection closed
-      xSemaphoreGive(this->send_mutex_);
-      return false;
-    }
+void IntercomMetricsSensor::update() {
+  IntercomMetrics &m = this->parent_->get_metrics();
 
-    // sent < 0
-    if (errno == EAGAIN || errno == EWOULDBLOCK) {
-      // Buffer full - wait briefly and retry
-      if (millis() - start_ms > 20) {
-        xSemaphoreGive(this->send_mutex_);
-        return false;
-      }
-      delay(1);
-      continue;
+  for (size_t i = 0; i < NUM_STAGES; i++) {
+    if (this->stage_sensors_[i] != nullptr) {
+      this->stage_sensors_[i]->publish_state(m.stages[i].take_peak());
     }
+  }
 
-    // Real error - only log if we expect the connection to be valid
-    if (this->client_.streaming.load(std::memory_order_relaxed)) {
-      ESP_LOGW(TAG, "Send failed: errno=%d sent=%zd offset=%zu total=%zu", errno, sent, offset, total);
-    }
-    xSemaphoreGive(this->send_mutex_);
-    return false;
+  for (size_t i = 0; i < NUM_RINGS; i++) {
+    if (this->ring_high_sensors_[i] == nullptr && this->ring_low_sensors_[i] == nullptr) continue;
+    uint32_t high, low;
+    if (!m.rings[i].take(high, low)) continue;  // Ring idle this interval - keep the last values
+    if (this->ring_high_sensors_[i] != nullptr) this->ring_high_sensors_[i]->publish_state(high);
+    if (this->ring_low_sensors_[i] != nullptr) this->ring_low_sensors_[i]->publish_state(low);
   }
 
-  xSemaphoreGive(this->send_mutex_);
-  return true;
-}
+  if (this->rx_dropped_sensor_ != nullptr) {
+    this->rx_dropped_sensor_->publish_state(m.rx_dropped_bytes.load(std::memory_order_relaxed));
+  }
+  if (this->tx_dropped_sensor_ != nullptr) {
+    this->tx_dropped_sensor_->publish_state(m.tx_dropped_frames.load(std::memory_order_relaxed));
+  }
+  if (this->send_eagain_sensor_ != nullptr) {
+    this->send_eagain_sensor_->publish_state(m.send_eagain.load(std::memory_order_relaxed));
+  }
 
-bool IntercomApi::receive_message_(int socket, MessageHeader &header, uint8_t *buffer, size_t buffer_size) {
-  // Read header - handle partial reads (non-blocking socket)
-  size_t header_read = 0;
-  int retry = 0;
-  const int MAX_RETRY = 300;  // 300ms max wait for complete message (50ms was too tight under mixer load)
-
-  while (header_read < HEADER_SIZE && retry < MAX_RETRY) {
-    ssize_t received = recv(socket, buffer + header_read, HEADER_SIZE - header_read, 0);
-    if (received > 0) {
-      header_read += received;
-      retry = 0;  // Reset on progress
-      continue;
-    }
-    if (received == 0) {
-      return false;  // Connection closed
+  // Latency: only when new probes came back - between calls the last call's values stay
+  const uint32_t probes = m.latency.samples.load(std::memory_order_relaxed);
+  if (probes > 0 && probes != this->last_latency_samples_) {
+    if (this->rtt_sensor_ != nullptr) {
+      this->rtt_sensor_->publish_state(m.latency.rtt_us.load(std::memory_order_relaxed) / 1000.0f);
     }
-    // received < 0
-    if (errno == EAGAIN || errno == EWOULDBLOCK) {
-      retry++;
-      delay(1);
-      continue;
+    if (this->latency_sensor_ != nullptr) {
+      this->latency_sensor_->publish_state(m.latency.rx_latency_ms.load(std::memory_order_relaxed));
     }
-    return false;  // Real error
   }
+  this->last_latency_samples_ = probes;
 
-  if (header_read != HEADER_SIZE) {
-    if (header_read > 0) {
-      ESP_LOGW(TAG, "Header incomplete: %zu/%zu", header_read, HEADER_SIZE);
+  const int64_t now_us = esp_timer_get_time();
+  const int64_t elapsed_us = now_us - this->last_update_us_;
+  for (size_t i = 0; i < NUM_TASKS; i++) {
+    auto task = static_cast<MetricsTask>(i);
+    if (this->task_stack_sensors_[i] != nullptr) {
+      this->task_stack_sensors_[i]->publish_state(this->parent_->get_task_stack_free(task));
+    }
+    uint32_t run_time_us;
+    if (this->task_cpu_sensors_[i] != nullptr && this->parent_->get_task_run_time_us(task, run_time_us)) {
+      // First update only takes the snapshot
+      if (this->last_update_us_ != 0 && elapsed_us > 0) {
+        uint32_t busy_us = run_time_us - this->last_run_time_us_[i];
+        this->task_cpu_sensors_[i]->publish_state(100.0f * busy_us / elapsed_us);
+      }
+      this->last_run_time_us_[i] = run_time_us;
     }
-    return false;
   }
+  this->last_update_us_ = now_us;
+}
 
-  memcpy(&header, buffer, HEADER_SIZE);
+void IntercomMetricsSensor::dump_config() {
+  ESP_LOGCONFIG(TAG, "Intercom API Metrics Sensor:");
+  ESP_LOGCONFIG(TAG, "  Update interval: %ums", (unsigned) this->get_update_interval());
+}
 
-  if (header.length > buffer_size - HEADER_SIZE) {
-    ESP_LOGW(TAG, "Message too large: %d", header.length);
+// === Protocol ===
+
+bool IntercomApi::send_message_(int socket, MessageType type, MessageFlags flags,
+                                 const uint8_t *data, size_t len) {
+  if (socket < 0) return false;
+
+  // Take mutex so control messages from different tasks don't interleave on the socket
+  if (xSemaphoreTake(this->send_mutex_, pdMS_TO_TICKS(10)) != pdTRUE) {
+    // Could not get mutex - another task is sending
     return false;
   }
 
-  // Read payload
-  if (header.length > 0) {
-    size_t payload_read = 0;
-    retry = 0;
-    while (payload_read < header.length && retry < MAX_RETRY) {
-      ssize_t received = recv(socket, buffer + HEADER_SIZE + payload_read,
-                              header.length - payload_read, 0);
-      if (received > 0) {
-        payload_read += received;
-        retry = 0;
-        continue;
-      }
-      if (received == 0) {
-        return false;
-      }
-      if (errno == EAGAIN || errno == EWOULDBLOCK) {
-        retry++;
-        delay(1);
-        continue;
-      }
-      return false;
-    }
+  bool ok = this->send_frame_(socket, type, flags, data, len, false);
 
-    if (payload_read != header.length) {
-      ESP_LOGW(TAG, "Payload incomplete: %zu/%d", payload_read, header.length);
-      return false;
-    }
+  xSemaphoreGive(this->send_mutex_);
+  return ok;
+}
+
+bool IntercomApi::send_frame_(int socket, MessageType type, MessageFlags flags,
+                              const uint8_t *data, size_t len, bool drop_if_busy) {
+  if (socket < 0) return false;
+
+  uint32_t eagain = 0;
+  const FrameSendResult result = send_frame(socket, type, flags, data, len, drop_if_busy, &eagain);
+  if (eagain > 0) this->metrics_.send_eagain.fetch_add(eagain, std::memory_order_relaxed);
+  if (result == FrameSendResult::SENT) return true;
+
+  // Real error - only log if we expect the connection to be valid
+  const int err = errno;
+  if (result == FrameSendResult::DROPPED && err != EAGAIN && err != EWOULDBLOCK &&
+      this->client_.streaming.load(std::memory_order_relaxed)) {
+    ESP_LOGW(TAG, "Send failed: errno=%d total=%zu", err, HEADER_SIZE + len);
   }
+  return false;
+}
 
-  return true;
+bool IntercomApi::receive_message_(int socket, MessageHeader &header, uint8_t *buffer, size_t buffer_size) {
+  return receive_frame(socket, header, buffer, buffer_size);
 }
 
 void IntercomApi::handle_message_(const MessageHeader &header, const uint8_t *data) {
   MessageType type = static_cast<MessageType>(header.type);
 
   switch (type) {
-    case MessageType::AUDIO: {
-#ifdef USE_SPEAKER
-      if (this->speaker_buffer_) {
-        // AEC mode: write to speaker_buffer, speaker_task reads and feeds AEC ref
-        size_t written = this->speaker_buffer_->write(data, header.length);
-        if (written != header.length) {
-          static uint32_t spk_drop = 0;
-          spk_drop++;
-          if (spk_drop <= 5 || spk_drop % 100 == 0) {
-            ESP_LOGW(TAG, "SPK buffer overflow: %zu/%d (drops=%lu)",
-                     written, header.length, (unsigned long)spk_drop);
-          }
-        }
-      } else if (this->speaker_) {
-        // No AEC: play directly from server_task — speaker_->play() is non-blocking
-        // (writes to mixer ring buffer, mixer task does the actual I2S output)
-        if (this->volume_ > 0.001f) {
-          this->speaker_->play(data, header.length, 0);
-        }
-      }
-#endif
-      if (this->state_ != ConnectionState::STREAMING) {
-        this->state_ = ConnectionState::STREAMING;
-      }
-      // If we're in OUTGOING state (caller waiting for dest to answer),
-      // receiving audio means dest answered - transition to STREAMING
-      if (this->call_state_ == CallState::OUTGOING) {
-        ESP_LOGI(TAG, "Dest answered - received audio, transitioning to STREAMING");
-        this->set_call_state_(CallState::STREAMING);  // trigger fired in set_call_state_
-      }
+    case MessageType::AUDIO:
+      // TCP audio plays immediately (no jitter buffer) - also the fallback during datagram calls
+      this->play_rx_audio_(data, header.length, header.flags);
+      this->on_rx_audio_();
       break;
-    }
 
     case MessageType::START: {
+      // Listen-only subscriber that got the call client slot: hand it to a monitor slot
+      if (header.flags & static_cast<uint8_t>(MessageFlags::MONITOR)) {
+        this->move_client_to_monitor_(header, data);
+        break;
+      }
       // Check for NO_RING flag (used for caller in bridge mode - skip ringing)
       const bool no_ring = (header.flags & static_cast<uint8_t>(MessageFlags::NO_RING)) != 0;
+      // Pick codec/transport before any task is woken - audio tasks read them on their next frame
+      const uint8_t reply_flags = this->negotiate_call_(header, data);
+      this->announce_codec_to_monitors_();
 
       // Extract caller name from payload (if present)
       std::string caller_name;
       if (header.length > 0 && data != nullptr) {
-        // Payload is the caller name (null-terminated or up to length)
-        size_t name_len = strnlen(reinterpret_cast<const char *>(data), header.length);
+        // Payload is the caller name (null-terminated or up to length), then the offers selected by flags
+        size_t offers = call_offer_size(header.flags);
+        size_t name_max = header.length >= offers ? header.length - offers : header.length;
+        size_t name_len = strnlen(reinterpret_cast<const char *>(data), name_max);
         caller_name.assign(reinterpret_cast<const char *>(data), name_len);
       }
 
@@ -1380,25 +1780,27 @@ void IntercomApi::handle_message_(const MessageHeader &header, const uint8_t *da
         // Go to OUTGOING state and wait for audio (dest to answer)
         this->outgoing_start_time_ = millis();  // Start timeout counter BEFORE state change
         this->set_call_state_(CallState::OUTGOING);  // FSM: outgoing call
-        this->set_active_(true);
+        this->prepare_call_();
         // Enable audio flow, but don't set STREAMING yet - wait for first audio
         this->client_.streaming.store(true, std::memory_order_release);
+        this->notify_audio_tasks_();
         this->state_ = ConnectionState::STREAMING;
-        this->send_message_(this->client_.socket.load(), MessageType::PONG);
+        this->send_call_reply_(MessageType::PONG, reply_flags);
       } else if (this->auto_answer_) {
         // Auto-answer ON: start streaming immediately, skip INCOMING/RINGING states
         // This skips INCOMING/RINGING states (no on_ringing trigger fires)
         this->set_call_state_(CallState::ANSWERING);  // FSM: go directly to answering
-        this->set_active_(true);
+        this->prepare_call_();
         this->set_streaming_(true);  // This will set CallState::STREAMING
-        this->send_message_(this->client_.socket.load(), MessageType::PONG);
+        this->send_call_reply_(MessageType::PONG, reply_flags);
       } else {
         // Auto-answer OFF: go to ringing state, wait for local answer
         this->set_call_state_(CallState::INCOMING);  // FSM: incoming call first
         this->state_ = ConnectionState::CONNECTED;  // Stay connected but not streaming
-        this->send_message_(this->client_.socket.load(), MessageType::RING);
+        this->send_call_reply_(MessageType::RING, reply_flags);
         ESP_LOGI(TAG, "%s: ringing (waiting for local answer)", this->device_name_.c_str());
         this->ringing_start_time_ = millis();  // Start ringing timeout timer
+        this->prepare_call_();  // Audio is up before on_ringing starts a ringtone
         this->set_call_state_(CallState::RINGING);  // FSM: then ringing (triggers on_ringing)
       }
       break;
@@ -1413,8 +1815,8 @@ void IntercomApi::handle_message_(const MessageHeader &header, const uint8_t *da
       // IMPORTANT: Order matters to avoid race conditions
       // 1. Stop streaming flag first (TX task checks this)
       this->set_streaming_(false);
-      // 2. Close socket immediately (before set_active_ which takes time)
-      this->close_client_socket_();
+      // 2. Close socket immediately (before set_active_ which takes time) - no STOP back
+      this->close_client_socket_(false);
       // 3. Now stop audio hardware (waits for tasks)
       this->set_active_(false);
       this->state_ = ConnectionState::DISCONNECTED;
@@ -1422,24 +1824,78 @@ void IntercomApi::handle_message_(const MessageHeader &header, const uint8_t *da
       break;
 
     case MessageType::PING:
+      if (header.flags & static_cast<uint8_t>(MessageFlags::STANDBY)) {
+        this->park_client_();
+        break;
+      }
       this->send_message_(this->client_.socket.load(), MessageType::PONG);
       break;
 
+    case MessageType::PROBE:
+      if (data != nullptr && header.length >= sizeof(LatencyProbe)) {
+        LatencyProbe probe;
+        memcpy(&probe, data, sizeof(probe));
+        this->send_latency_probe_(MessageType::PROBE_ECHO, probe.origin_us);
+      }
+      break;
+
+    case MessageType::PROBE_ECHO:
+      if (data != nullptr && header.length >= sizeof(LatencyProbe)) {
+        LatencyProbe echo;
+        memcpy(&echo, data, sizeof(echo));
+        const uint32_t rtt_us = static_cast<uint32_t>(esp_timer_get_time()) - echo.origin_us;
+        if (rtt_us <= PROBE_MAX_RTT_US) {
+          this->metrics_.latency.record(rtt_us, this->get_capture_delay_ms_(), this->get_playout_delay_ms_(),
+                                        echo.capture_ms, echo.playout_ms);
+        }
+      }
+      break;
+
     case MessageType::PONG:
       this->client_.last_ping = millis();
+      if (this->awaiting_call_reply_) {
+        // Direct call: the callee auto-answered our START
+        this->apply_call_reply_(header, data);
+        ESP_LOGI(TAG, "%s: callee answered (direct), streaming", this->device_name_.c_str());
+        this->set_streaming_(true);
+        this->notify_controller_(MessageType::ANSWER);
+      }
+      break;
+
+    case MessageType::RING:
+      // Direct call: the callee rings - audio starts with its ANSWER
+      if (this->awaiting_call_reply_) {
+        this->apply_call_reply_(header, data);
+        ESP_LOGI(TAG, "%s: callee ringing (direct)", this->device_name_.c_str());
+        this->notify_controller_(MessageType::RING);
+      } else {
+        ESP_LOGW(TAG, "RING received but no direct call pending");
+      }
+      break;
+
+    case MessageType::DIAL:
+      this->dial_peer_(header, data);
       break;
 
     case MessageType::ANSWER:
       // ANSWER: call was answered (either our outgoing call or remote answer)
-      if (this->call_state_ == CallState::OUTGOING) {
-        // We called them, they answered - start streaming
+      if (this->call_state_ == CallState::OUTGOING && this->outbound_call_) {
+        // Direct call answered locally on the callee - codec/transport came with its RING
+        ESP_LOGI(TAG, "%s: callee answered (direct), streaming", this->device_name_.c_str());
+        this->awaiting_call_reply_ = false;
+        this->set_streaming_(true);
+        this->notify_controller_(MessageType::ANSWER);
+      } else if (this->call_state_ == CallState::OUTGOING) {
+        // We called them, they answered - start streaming with the codec HA offered for this leg
         ESP_LOGI(TAG, "%s: destination answered, streaming", this->device_name_.c_str());
+        const uint8_t reply_flags = this->negotiate_call_(header, data);
+        this->announce_codec_to_monitors_();
         this->set_streaming_(true);
-        this->send_message_(this->client_.socket.load(), MessageType::PONG);
+        this->send_call_reply_(MessageType::PONG, reply_flags);
       } else if (this->call_state_ == CallState::RINGING) {
         ESP_LOGI(TAG, "%s: answered remotely (by HA)", this->device_name_.c_str());
         this->set_call_state_(CallState::ANSWERING);  // FSM
-        this->set_active_(true);
+        this->prepare_call_();  // Prepared while ringing: only the streaming gate flips
         this->set_streaming_(true);  // This will set CallState::STREAMING
         this->send_message_(this->client_.socket.load(), MessageType::PONG);
       } else {
@@ -1467,6 +1923,705 @@ void IntercomApi::handle_message_(const MessageHeader &header, const uint8_t *da
   }
 }
 
+// === Codec Negotiation ===
+
+uint8_t IntercomApi::negotiate_call_(const MessageHeader &header, const uint8_t *data) {
+  // Older HA sends no offers: raw PCM over TCP as before
+  this->datagram_active_.store(false, std::memory_order_release);
+  this->codec_.store(AudioCodec::PCM, std::memory_order_release);
+  this->codec_frame_ms_.store(this->local_frame_ms_(), std::memory_order_release);
+
+  // DTX has no offer bytes: the flag alone says the peer plays comfort noise. We always
+  // understand ComfortNoiseFrames, so it is echoed whether or not we send them (dtx option).
+  const bool peer_dtx = (header.flags & static_cast<uint8_t>(MessageFlags::DTX)) != 0;
+  this->dtx_peer_.store(peer_dtx, std::memory_order_release);
+  uint8_t reply_flags = peer_dtx ? static_cast<uint8_t>(MessageFlags::DTX) : 0;
+  // LATENCY works the same way: peers that offer it answer PROBE, and so do we
+  const bool peer_latency = (header.flags & static_cast<uint8_t>(MessageFlags::LATENCY)) != 0;
+  this->latency_peer_.store(peer_latency, std::memory_order_release);
+  if (peer_latency) reply_flags |= static_cast<uint8_t>(MessageFlags::LATENCY);
+
+  const size_t offers_size = call_offer_size(header.flags);
+  if (offers_size == 0 || data == nullptr || header.length < offers_size) {
+    return reply_flags;
+  }
+  const uint8_t *offer = data + header.length - offers_size;
+
+  if (header.flags & static_cast<uint8_t>(MessageFlags::CODEC)) {
+    CodecOffer codec_offer;
+    memcpy(&codec_offer, offer, sizeof(codec_offer));
+    offer += sizeof(codec_offer);
+
+    // frame_ms is a PCM preference only in a PCM-only offer (with Opus it is the Opus frame)
+    AudioCodec codec = AudioCodec::PCM;
+    const uint8_t pcm_offer = codec_offer.codec_mask == CODEC_MASK_PCM ? codec_offer.frame_ms : 0;
+    uint8_t frame_ms = this->pcm_frame_ms_for_offer_(pcm_offer);
+#ifdef USE_INTERCOM_OPUS
+    if ((codec_offer.codec_mask & CODEC_MASK_OPUS) != 0) {
+      const uint8_t opus_ms =
+          is_valid_opus_frame_ms(codec_offer.frame_ms) ? codec_offer.frame_ms : OPUS_DEFAULT_FRAME_MS;
+      // Kept from the last call when the frame matches, like the encoder (encoder_task)
+      if (this->decoder_.get_frame_ms() == opus_ms || this->decoder_.init(opus_ms)) {
+        codec = AudioCodec::OPUS;
+        frame_ms = opus_ms;
+      }  // else: decoder unavailable - PCM for this call
+    }
+#endif
+
+    this->codec_frame_ms_.store(frame_ms, std::memory_order_release);
+    this->codec_.store(codec, std::memory_order_release);
+    ESP_LOGD(TAG, "Codec: %s, %u ms frames (offer mask=0x%02X)", audio_codec_to_str(codec), frame_ms,
+             codec_offer.codec_mask);
+    reply_flags |= static_cast<uint8_t>(MessageFlags::CODEC);
+  }
+
+  if (header.flags & static_cast<uint8_t>(MessageFlags::DATAGRAM)) {
+    DatagramOffer datagram_offer;
+    memcpy(&datagram_offer, offer, sizeof(datagram_offer));
+
+    // Accept only when configured and bound - otherwise HA keeps sending audio over TCP
+    if (this->datagram_audio_ && this->datagram_socket_ >= 0 && datagram_offer.port != 0) {
+      this->start_datagram_call_(datagram_offer.port);
+      reply_flags |= static_cast<uint8_t>(MessageFlags::DATAGRAM);
+    }
+  }
+
+  return reply_flags;
+}
+
+void IntercomApi::start_datagram_call_(uint16_t peer_port) {
+  this->datagram_peer_ = this->client_.addr;  // Same host as the TCP signalling connection
+  this->datagram_peer_.sin_port = htons(peer_port);
+  this->datagram_tx_seq_ = 0;
+  this->datagram_tx_timestamp_ = 0;
+  this->plc_pcm_len_ = 0;
+  this->jitter_.reset((SAMPLE_RATE / 1000) * this->codec_frame_ms_.load(std::memory_order_relaxed));
+  this->datagram_active_.store(true, std::memory_order_release);
+  ESP_LOGD(TAG, "Audio over UDP, peer port %u", peer_port);
+}
+
+uint8_t IntercomApi::local_frame_ms_() const {
+#ifdef USE_ESP_AEC
+  // An AEC processes fixed chunks: framing calls to them keeps tx_task from rechunking
+  if (this->aec_ != nullptr && this->aec_frame_samples_ > 0) {
+    const uint32_t ms = static_cast<uint32_t>(this->aec_frame_samples_) * 1000 / SAMPLE_RATE;
+    if (is_valid_pcm_frame_ms(ms)) return static_cast<uint8_t>(ms);
+  }
+  if (this->aec_owner_ != nullptr) {
+    const uint32_t ms = this->aec_owner_->get_frame_duration_ms();
+    if (is_valid_pcm_frame_ms(ms)) return static_cast<uint8_t>(ms);
+  }
+#endif
+  return this->frame_duration_ms_;
+}
+
+uint8_t IntercomApi::pcm_frame_ms_for_offer_(uint8_t offered) const {
+  const uint8_t own = this->local_frame_ms_();
+  if (!is_valid_pcm_frame_ms(offered)) return own;
+#ifdef USE_ESP_AEC
+  // The AEC chunk cannot follow the peer
+  if (this->aec_ != nullptr || (this->aec_owner_ != nullptr && this->aec_owner_->has_aec())) return own;
+#endif
+  // The longer frame: the packet rate both sides can afford
+  return std::max(own, offered);
+}
+
+size_t IntercomApi::tx_frame_bytes_() const {
+#ifdef USE_ESP_AEC
+  if (this->aec_enabled_ && this->aec_ != nullptr && this->aec_mic_ != nullptr) {
+    return static_cast<size_t>(this->aec_frame_samples_) * sizeof(int16_t);
+  }
+#endif
+  // Opus frames above 32 ms are collected by encoder_task, not read in one piece
+  return std::min<size_t>(this->codec_frame_ms_.load(std::memory_order_relaxed) * BYTES_PER_MS, AUDIO_CHUNK_SIZE);
+}
+
+size_t IntercomApi::play_chunk_samples_() const {
+  const size_t samples = (SAMPLE_RATE / 1000) * this->codec_frame_ms_.load(std::memory_order_relaxed);
+  return std::min(samples, SAMPLES_PER_CHUNK);
+}
+
+// === Latency Probes (server_task) ===
+
+void IntercomApi::send_latency_probe_(MessageType type, uint32_t origin_us) {
+  LatencyProbe probe;
+  probe.origin_us = origin_us;
+  probe.capture_ms = static_cast<uint16_t>(std::min<uint32_t>(this->get_capture_delay_ms_(), UINT16_MAX));
+  probe.playout_ms = static_cast<uint16_t>(std::min<uint32_t>(this->get_playout_delay_ms_(), UINT16_MAX));
+  this->send_message_(this->client_.socket.load(), type, MessageFlags::NONE, reinterpret_cast<const uint8_t *>(&probe),
+                      sizeof(probe));
+}
+
+uint32_t IntercomApi::get_capture_delay_ms_() const {
+  // The frame being filled (it leaves with its last sample) plus mic audio not yet sent
+  uint32_t ms = this->codec_frame_ms_.load(std::memory_order_relaxed);
+  if (this->mic_buffer_) ms += this->mic_buffer_->available() / BYTES_PER_MS;
+  return ms;
+}
+
+uint32_t IntercomApi::get_playout_delay_ms_() const {
+  // Received audio not played yet: jitter buffer (UDP) and speaker_buffer_ (aec_id mode).
+  // Without speaker_buffer_ frames go straight to speaker_->play().
+  uint32_t ms = 0;
+  if (this->datagram_active_.load(std::memory_order_relaxed)) {
+    ms += this->jitter_.get_depth() * this->jitter_.get_frame_samples() / (SAMPLE_RATE / 1000);
+  }
+  if (this->speaker_buffer_) ms += this->speaker_buffer_->available() / BYTES_PER_MS;
+  return ms;
+}
+
+// === Direct Calls (server_task) ===
+
+void IntercomApi::dial_peer_(const MessageHeader &header, const uint8_t *data) {
+  const int ha_sock = this->client_.socket.load();
+  auto reply_error = [&](ErrorCode code) {
+    uint8_t reason = static_cast<uint8_t>(code);
+    this->send_message_(ha_sock, MessageType::ERROR, MessageFlags::NONE, &reason, 1);
+  };
+
+  if (data == nullptr || header.length < sizeof(DialRequest)) {
+    reply_error(ErrorCode::INVALID_MSG);
+    return;
+  }
+  // Same states a bridged START with NO_RING accepts: idle, or our own outgoing call
+  const CallState cs = this->call_state_.load(std::memory_order_acquire);
+  if (cs != CallState::IDLE && cs != CallState::OUTGOING) {
+    ESP_LOGW(TAG, "Cannot dial: already %s", call_state_to_str(cs));
+    reply_error(ErrorCode::BUSY);
+    return;
+  }
+  if (this->dial_socket_.load() >= 0) {
+    ESP_LOGW(TAG, "Cannot dial: still connecting to %s", this->dial_callee_.c_str());
+    reply_error(ErrorCode::BUSY);
+    return;
+  }
+
+  DialRequest request;
+  memcpy(&request, data, sizeof(request));
+  const char *name = reinterpret_cast<const char *>(data + sizeof(request));
+  std::string callee(name, strnlen(name, header.length - sizeof(request)));
+
+  struct sockaddr_in peer{};
+  peer.sin_family = AF_INET;
+  memcpy(&peer.sin_addr.s_addr, request.ipv4, sizeof(request.ipv4));
+  peer.sin_port = htons(request.port != 0 ? request.port : INTERCOM_PORT);
+  char ip_str[INET_ADDRSTRLEN];
+  inet_ntop(AF_INET, &peer.sin_addr, ip_str, sizeof(ip_str));
+  ESP_LOGI(TAG, "%s -> %s: calling directly (%s)...", this->device_name_.c_str(), callee.c_str(), ip_str);
+
+  int peer_sock = this->start_peer_connect_(peer);
+  if (peer_sock < 0) {
+    ESP_LOGW(TAG, "%s unreachable - Home Assistant relays the call", ip_str);
+    reply_error(ErrorCode::UNREACHABLE);
+    return;
+  }
+  // The handshake completes in server_task's select() (service_dial_), which keeps serving
+  // the HA link, monitors and the standby link meanwhile
+  this->dial_ha_socket_ = ha_sock;
+  this->dial_peer_addr_ = peer;
+  this->dial_callee_ = std::move(callee);
+  this->dial_started_ms_ = millis();
+  this->dial_socket_.store(peer_sock);
+}
+
+int IntercomApi::start_peer_connect_(const struct sockaddr_in &peer) {
+  int sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+  if (sock < 0) {
+    ESP_LOGE(TAG, "Failed to create peer socket: %d", errno);
+    return -1;
+  }
+  int flags = fcntl(sock, F_GETFL, 0);
+  fcntl(sock, F_SETFL, flags | O_NONBLOCK);
+
+  if (connect(sock, reinterpret_cast<const struct sockaddr *>(&peer), sizeof(peer)) < 0 && errno != EINPROGRESS) {
+    ESP_LOGW(TAG, "Peer connect failed: %d", errno);
+    close(sock);
+    return -1;
+  }
+  return sock;
+}
+
+void IntercomApi::service_dial_(int selected_fd, fd_set *write_fds, bool writable) {
+  const int sock = this->dial_socket_.load();
+  if (sock < 0) {
+    return;
+  }
+  // Writable = the handshake finished (SO_ERROR tells how); otherwise wait out the deadline
+  const bool done = writable && sock == selected_fd && FD_ISSET(sock, write_fds);
+  if (!done && millis() - this->dial_started_ms_ < DIAL_CONNECT_TIMEOUT_MS) {
+    return;
+  }
+  if (this->dial_socket_.exchange(-1) != sock) {
+    return;  // Cancelled by close_client_socket_() meanwhile
+  }
+
+  int err = ETIMEDOUT;
+  if (done) {
+    socklen_t err_len = sizeof(err);
+    if (getsockopt(sock, SOL_SOCKET, SO_ERROR, &err, &err_len) < 0) {
+      err = errno;
+    }
+  }
+  if (err != 0) {
+    ESP_LOGW(TAG, "Peer connect timed out or refused: %d", err);
+    close(sock);
+    char ip_str[INET_ADDRSTRLEN];
+    inet_ntop(AF_INET, &this->dial_peer_addr_.sin_addr, ip_str, sizeof(ip_str));
+    ESP_LOGW(TAG, "%s unreachable - Home Assistant relays the call", ip_str);
+    if (this->client_.socket.load() == this->dial_ha_socket_) {
+      uint8_t reason = static_cast<uint8_t>(ErrorCode::UNREACHABLE);
+      this->send_message_(this->dial_ha_socket_, MessageType::ERROR, MessageFlags::NONE, &reason, 1);
+    }
+    return;
+  }
+
+  int opt = 1;
+  setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+  this->finish_dial_(sock);
+}
+
+void IntercomApi::finish_dial_(int peer_sock) {
+  const int ha_sock = this->dial_ha_socket_;
+  // HA may have started a bridged call on its link while we were connecting
+  const CallState cs = this->call_state_.load(std::memory_order_acquire);
+  if (cs != CallState::IDLE && cs != CallState::OUTGOING) {
+    ESP_LOGW(TAG, "Dial to %s dropped: already %s", this->dial_callee_.c_str(), call_state_to_str(cs));
+    close(peer_sock);
+    uint8_t reason = static_cast<uint8_t>(ErrorCode::BUSY);
+    this->send_message_(ha_sock, MessageType::ERROR, MessageFlags::NONE, &reason, 1);
+    return;
+  }
+  const struct sockaddr_in peer = this->dial_peer_addr_;
+  this->send_message_(ha_sock, MessageType::PONG);
+
+  // The callee connection becomes the call client; HA's link stays on as controller: a standby
+  // link back in standby_ (where it stays after the call), others in a free monitor slot,
+  // otherwise it is closed quietly (no STOP - the call goes on)
+  const bool standby = this->client_.standby;
+  MonitorClient *controller = standby ? nullptr : this->free_monitor_slot_();
+  xSemaphoreTake(this->client_mutex_, portMAX_DELAY);
+  struct sockaddr_in ha_addr = this->client_.addr;
+  this->client_.socket.store(peer_sock);
+  this->client_.addr = peer;
+  this->client_.last_ping = millis();
+  this->client_.streaming.store(false);
+  this->client_.standby = false;
+  xSemaphoreGive(this->client_mutex_);
+  if (standby) {
+    this->park_socket_(ha_sock, ha_addr);
+    this->standby_.controller = true;
+  } else if (controller != nullptr) {
+    controller->addr = ha_addr;
+    controller->connected_at = millis();
+    controller->controller = true;
+    controller->socket.store(ha_sock);
+  } else {
+    shutdown(ha_sock, SHUT_RDWR);
+    close(ha_sock);
+  }
+
+  // PCM over TCP, no DTX until the callee answers our offers
+  this->datagram_active_.store(false, std::memory_order_release);
+  this->dtx_peer_.store(false, std::memory_order_release);
+  this->latency_peer_.store(false, std::memory_order_release);
+  this->codec_.store(AudioCodec::PCM, std::memory_order_release);
+  this->codec_frame_ms_.store(this->local_frame_ms_(), std::memory_order_release);
+  this->outbound_call_ = true;
+
+  if (this->full_mode_) {
+    this->publish_caller_(this->dial_callee_);
+  }
+  this->outgoing_start_time_ = millis();  // Timeout now covers the callee ringing
+  this->set_call_state_(CallState::OUTGOING);
+  this->prepare_call_();
+  this->state_ = ConnectionState::CONNECTED;
+  this->send_peer_start_();
+}
+
+void IntercomApi::send_peer_start_() {
+  // The START HA would send the callee: our name, NUL, codec offer [, UDP port offer], DTX, LATENCY
+  static constexpr size_t MAX_NAME = 63;
+  uint8_t payload[MAX_NAME + 1 + sizeof(CodecOffer) + sizeof(DatagramOffer)];
+  const size_t name_len = std::min(this->device_name_.size(), MAX_NAME);
+  memcpy(payload, this->device_name_.data(), name_len);
+  payload[name_len] = '\0';
+  size_t len = name_len + 1;
+
+  uint8_t flags = static_cast<uint8_t>(MessageFlags::CODEC) | static_cast<uint8_t>(MessageFlags::DTX) |
+                  static_cast<uint8_t>(MessageFlags::LATENCY);
+  CodecOffer codec_offer;
+  codec_offer.codec_mask = CODEC_MASK_PCM;
+  codec_offer.frame_ms = this->local_frame_ms_();  // Callee answers the longer of this and its own
+#ifdef USE_INTERCOM_OPUS
+  codec_offer.codec_mask |= CODEC_MASK_OPUS;
+  codec_offer.frame_ms = OPUS_DEFAULT_FRAME_MS;
+#endif
+  memcpy(payload + len, &codec_offer, sizeof(codec_offer));
+  len += sizeof(codec_offer);
+
+  if (this->datagram_audio_ && this->datagram_socket_ >= 0) {
+    DatagramOffer datagram_offer;
+    datagram_offer.port = INTERCOM_PORT;
+    memcpy(payload + len, &datagram_offer, sizeof(datagram_offer));
+    len += sizeof(datagram_offer);
+    flags |= static_cast<uint8_t>(MessageFlags::DATAGRAM);
+  }
+
+  this->awaiting_call_reply_ = true;
+  this->send_message_(this->client_.socket.load(), MessageType::START, static_cast<MessageFlags>(flags), payload,
+                      len);
+}
+
+void IntercomApi::apply_call_reply_(const MessageHeader &header, const uint8_t *data) {
+  // Callee's PONG/RING: CodecParams [, DatagramParams] as selected by its flags; DTX echoed
+  // by firmware that plays comfort noise, LATENCY by firmware that answers PROBE
+  this->awaiting_call_reply_ = false;
+  this->dtx_peer_.store((header.flags & static_cast<uint8_t>(MessageFlags::DTX)) != 0, std::memory_order_release);
+  this->latency_peer_.store((header.flags & static_cast<uint8_t>(MessageFlags::LATENCY)) != 0,
+                            std::memory_order_release);
+  const uint8_t *params = data;
+  size_t left = data != nullptr ? header.length : 0;
+
+  if ((header.flags & static_cast<uint8_t>(MessageFlags::CODEC)) && left >= sizeof(CodecParams)) {
+    CodecParams codec_params;
+    memcpy(&codec_params, params, sizeof(codec_params));
+    params += sizeof(codec_params);
+    left -= sizeof(codec_params);
+
+    AudioCodec codec = AudioCodec::PCM;
+    uint8_t frame_ms = is_valid_pcm_frame_ms(codec_params.frame_ms) ? codec_params.frame_ms : this->local_frame_ms_();
+#ifdef USE_INTERCOM_OPUS
+    if (codec_params.codec == static_cast<uint8_t>(AudioCodec::OPUS) &&
+        is_valid_opus_frame_ms(codec_params.frame_ms) &&
+        (this->decoder_.get_frame_ms() == codec_params.frame_ms || this->decoder_.init(codec_params.frame_ms))) {
+      codec = AudioCodec::OPUS;
+      frame_ms = codec_params.frame_ms;
+    }
+#endif
+    if (codec_params.codec != static_cast<uint8_t>(codec)) {
+      ESP_LOGW(TAG, "Callee picked codec %u we cannot decode - staying on PCM", codec_params.codec);
+    }
+    this->codec_frame_ms_.store(frame_ms, std::memory_order_release);
+    this->codec_.store(codec, std::memory_order_release);
+    ESP_LOGD(TAG, "Codec: %s, %u ms frames (callee reply)", audio_codec_to_str(codec), frame_ms);
+  }
+
+  if ((header.flags & static_cast<uint8_t>(MessageFlags::DATAGRAM)) && left >= sizeof(DatagramParams) &&
+      this->datagram_audio_ && this->datagram_socket_ >= 0) {
+    DatagramParams datagram_params;
+    memcpy(&datagram_params, params, sizeof(datagram_params));
+    if (datagram_params.port != 0) {
+      this->start_datagram_call_(datagram_params.port);
+    }
+  }
+
+  this->announce_codec_to_monitors_();
+}
+
+void IntercomApi::notify_controller_(MessageType type) {
+  for (size_t i = 0; i < this->max_monitors_; i++) {
+    MonitorClient &monitor = this->monitors_[i];
+    if (monitor.controller) {
+      this->send_message_(monitor.socket.load(), type);
+    }
+  }
+  if (this->standby_.controller) {
+    this->send_message_(this->standby_.socket.load(), type);
+  }
+}
+
+void IntercomApi::release_controller_() {
+  for (size_t i = 0; i < this->max_monitors_; i++) {
+    MonitorClient &monitor = this->monitors_[i];
+    if (!monitor.controller) continue;
+    monitor.controller = false;
+    this->send_message_(monitor.socket.load(), MessageType::STOP);
+    this->close_monitor_(monitor);
+  }
+  // A standby controller hears the STOP too, but stays parked for the next call
+  if (this->standby_.controller) {
+    this->standby_.controller = false;
+    this->send_message_(this->standby_.socket.load(), MessageType::STOP);
+  }
+}
+
+void IntercomApi::hang_up_direct_call_() {
+  // HA hung up the direct call it dialed - same order as a STOP from the call client
+  ESP_LOGI(TAG, "%s: direct call hung up by Home Assistant", this->device_name_.c_str());
+  if (this->full_mode_) {
+    this->publish_caller_("");
+  }
+  this->set_streaming_(false);
+  this->close_client_socket_();
+  this->set_active_(false);
+  this->state_ = ConnectionState::DISCONNECTED;
+  this->end_call_(CallEndReason::REMOTE_HANGUP);
+}
+
+void IntercomApi::send_call_reply_(MessageType type, uint8_t reply_flags) {
+  int socket = this->client_.socket.load();
+  uint8_t payload[sizeof(CodecParams) + sizeof(DatagramParams)];
+  size_t len = 0;
+
+  if (reply_flags & static_cast<uint8_t>(MessageFlags::CODEC)) {
+    CodecParams params;
+    params.codec = static_cast<uint8_t>(this->codec_.load(std::memory_order_acquire));
+    params.frame_ms = this->codec_frame_ms_.load(std::memory_order_acquire);
+    memcpy(payload + len, &params, sizeof(params));
+    len += sizeof(params);
+  }
+  if (reply_flags & static_cast<uint8_t>(MessageFlags::DATAGRAM)) {
+    DatagramParams params;
+    params.port = INTERCOM_PORT;
+    memcpy(payload + len, &params, sizeof(params));
+    len += sizeof(params);
+  }
+
+  this->send_message_(socket, type, static_cast<MessageFlags>(reply_flags), len > 0 ? payload : nullptr, len);
+}
+
+// === Audio Frames ===
+
+bool IntercomApi::send_audio_frame_(const uint8_t *data, size_t len, uint32_t samples, MessageFlags flags) {
+  ScopedStage stage(this->metrics_.stage(MetricsStage::SEND));
+  bool ok = this->transmit_audio_frame_(data, len, samples, flags);
+  if (!ok) {
+    this->metrics_.tx_dropped_frames.fetch_add(1, std::memory_order_relaxed);
+  }
+  // Same encoded frame to every monitor (after the call client - it is the latency-critical one).
+  // Monitors never offered DTX: they get nothing for a quiet frame.
+  if (flags == MessageFlags::NONE && this->monitor_count_.load(std::memory_order_relaxed) > 0) {
+    this->fan_out_audio_frame_(data, len);
+  }
+  return ok;
+}
+
+bool IntercomApi::transmit_audio_frame_(const uint8_t *data, size_t len, uint32_t samples, MessageFlags flags) {
+  if (this->datagram_active_.load(std::memory_order_acquire)) {
+    DatagramHeader header;
+    header.type = static_cast<uint8_t>(MessageType::AUDIO);
+    header.flags = static_cast<uint8_t>(flags);
+    header.seq = this->datagram_tx_seq_++;  // Advances on failure too - the receiver conceals the gap
+    header.timestamp = this->datagram_tx_timestamp_;
+    this->datagram_tx_timestamp_ += samples;
+
+    struct iovec iov[2];
+    iov[0].iov_base = &header;
+    iov[0].iov_len = DATAGRAM_HEADER_SIZE;
+    iov[1].iov_base = const_cast<uint8_t *>(data);
+    iov[1].iov_len = len;
+
+    struct msghdr msg {};
+    msg.msg_name = &this->datagram_peer_;
+    msg.msg_namelen = sizeof(this->datagram_peer_);
+    msg.msg_iov = iov;
+    msg.msg_iovlen = 2;
+
+    // Datagrams go out whole or not at all: no retry, a lost frame is cheaper than a late one
+    if (sendmsg(this->datagram_socket_, &msg, MSG_DONTWAIT) == static_cast<ssize_t>(DATAGRAM_HEADER_SIZE + len)) {
+      return true;
+    }
+    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOMEM) {
+      this->metrics_.send_eagain.fetch_add(1, std::memory_order_relaxed);  // lwIP reports a full pbuf pool as ENOMEM
+    }
+    return false;
+  }
+
+  int socket = this->client_.socket.load();
+  if (socket < 0) return false;
+
+  // Serialize with server_task control messages; drop the frame rather than delay it
+  if (xSemaphoreTake(this->send_mutex_, pdMS_TO_TICKS(5)) != pdTRUE) {
+    return false;
+  }
+  bool ok = this->send_frame_(socket, MessageType::AUDIO, flags, data, len, true);
+  xSemaphoreGive(this->send_mutex_);
+  return ok;
+}
+
+bool IntercomApi::send_dtx_frame_(const int16_t *pcm, size_t samples) {
+  if (!this->is_dtx_call() || this->dtx_vad_.process(pcm, samples)) return false;
+
+  // Quiet: 3 bytes instead of the frame; the peer fills the gap with noise at our floor
+  const float floor_dbfs = this->dtx_vad_.get_floor_dbfs();
+  ComfortNoiseFrame sid;
+  sid.level = static_cast<uint8_t>(std::min(-floor_dbfs, 255.0f) + 0.5f);
+  sid.samples = static_cast<uint16_t>(samples);
+  this->send_audio_frame_(reinterpret_cast<const uint8_t *>(&sid), sizeof(sid), samples, MessageFlags::DTX);
+  this->metrics_.dtx_tx_frames.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void IntercomApi::play_rx_audio_(const uint8_t *data, size_t len, uint8_t flags) {
+#ifdef USE_SPEAKER
+  if (flags & static_cast<uint8_t>(MessageFlags::DTX)) {
+    this->play_comfort_noise_(data, len);
+    return;
+  }
+  const uint8_t *pcm = data;
+  size_t pcm_len = len;
+#ifdef USE_INTERCOM_OPUS
+  if (this->codec_.load(std::memory_order_relaxed) == AudioCodec::OPUS) {
+    // Decode inline: one packet per message, output is at most one 60 ms frame
+    {
+      ScopedStage stage(this->metrics_.stage(MetricsStage::DECODE));
+      pcm_len = this->decoder_.decode(data, len, this->dec_pcm_, OPUS_MAX_FRAME_SAMPLES);
+    }
+    pcm = reinterpret_cast<const uint8_t *>(this->dec_pcm_);
+    if (pcm_len == 0) {
+      static uint32_t dec_err = 0;
+      dec_err++;
+      if (dec_err <= 5 || dec_err % 100 == 0) {
+        ESP_LOGW(TAG, "Opus decode failed: %zu bytes (errors=%lu)", len, (unsigned long) dec_err);
+      }
+      return;
+    }
+  }
+#endif
+  this->write_speaker_(pcm, pcm_len);
+#endif
+}
+
+void IntercomApi::play_comfort_noise_(const uint8_t *data, size_t len) {
+#ifdef USE_SPEAKER
+  if (data == nullptr || len < sizeof(ComfortNoiseFrame)) return;
+  ComfortNoiseFrame sid;
+  memcpy(&sid, data, sizeof(sid));
+  this->metrics_.dtx_rx_frames.fetch_add(1, std::memory_order_relaxed);
+
+  // Same duration the frame replaced, so playout depth and the AEC reference stay on time
+  size_t left = std::min<size_t>(sid.samples, OPUS_MAX_FRAME_SAMPLES);
+  while (left > 0) {
+    const size_t n = std::min(left, SAMPLES_PER_CHUNK);
+    if (sid.level >= DTX_SILENCE_LEVEL) {
+      memset(this->cn_pcm_, 0, n * sizeof(int16_t));
+    } else {
+      this->comfort_noise_.fill(this->cn_pcm_, n, -static_cast<float>(sid.level));
+    }
+    this->write_speaker_(reinterpret_cast<const uint8_t *>(this->cn_pcm_), n * sizeof(int16_t));
+    left -= n;
+  }
+#endif
+}
+
+void IntercomApi::write_speaker_(const uint8_t *pcm, size_t len) {
+#ifdef USE_SPEAKER
+  if (this->speaker_buffer_) {
+    // AEC mode: write to speaker_buffer, speaker_task paces playout and feeds AEC ref
+    this->playout_.on_arrival(len, esp_timer_get_time());
+    size_t written = this->speaker_buffer_->write(pcm, len);
+    if (written != len) {
+      this->playout_.count_overflow();
+      this->metrics_.rx_dropped_bytes.fetch_add(len - written, std::memory_order_relaxed);
+      static uint32_t spk_drop = 0;
+      spk_drop++;
+      if (spk_drop <= 5 || spk_drop % 100 == 0) {
+        ESP_LOGW(TAG, "SPK buffer overflow: %zu/%zu (drops=%lu)",
+                 written, len, (unsigned long)spk_drop);
+      }
+    }
+    // Wake speaker_task once a full chunk is buffered
+    if (this->speaker_task_handle_ &&
+        this->speaker_buffer_->available() >= this->play_chunk_samples_() * sizeof(int16_t)) {
+      xTaskNotifyGive(this->speaker_task_handle_);
+    }
+  } else if (this->speaker_) {
+    // No AEC: play directly from server_task — speaker_->play() is non-blocking
+    // (writes to mixer ring buffer, mixer task does the actual I2S output)
+    if (this->volume_ > 0.001f) {
+      ScopedStage stage(this->metrics_.stage(MetricsStage::PLAY));
+      this->speaker_->play(pcm, len, 0);
+    }
+  }
+#endif
+}
+
+void IntercomApi::on_rx_audio_() {
+  if (this->state_ != ConnectionState::STREAMING) {
+    this->state_ = ConnectionState::STREAMING;
+  }
+  // If we're in OUTGOING state (caller waiting for dest to answer),
+  // receiving audio means dest answered - transition to STREAMING
+  if (this->call_state_ == CallState::OUTGOING) {
+    ESP_LOGI(TAG, "Dest answered - received audio, transitioning to STREAMING");
+    this->set_call_state_(CallState::STREAMING);  // trigger fired in set_call_state_
+  }
+}
+
+// === Datagram Audio (server_task) ===
+
+void IntercomApi::receive_datagrams_() {
+  const int64_t now_us = esp_timer_get_time();
+
+  // rx_buffer_ is free here: TCP messages are handled to completion before we get here
+  while (true) {
+    struct sockaddr_in src;
+    socklen_t src_len = sizeof(src);
+    ssize_t n = recvfrom(this->datagram_socket_, this->rx_buffer_, MAX_MESSAGE_SIZE, MSG_DONTWAIT,
+                         reinterpret_cast<struct sockaddr *>(&src), &src_len);
+    if (n <= 0) break;  // Drained (EAGAIN)
+
+    // Only the peer of the current call; anything else on the port is ignored
+    if (src.sin_addr.s_addr != this->datagram_peer_.sin_addr.s_addr) continue;
+    if (static_cast<size_t>(n) <= DATAGRAM_HEADER_SIZE) continue;
+
+    DatagramHeader header;
+    memcpy(&header, this->rx_buffer_, DATAGRAM_HEADER_SIZE);
+    if (header.type != static_cast<uint8_t>(MessageType::AUDIO)) continue;
+
+    this->jitter_.push(header.seq, header.timestamp, header.flags, this->rx_buffer_ + DATAGRAM_HEADER_SIZE,
+                       static_cast<size_t>(n) - DATAGRAM_HEADER_SIZE, now_us);
+    this->on_rx_audio_();
+  }
+}
+
+void IntercomApi::play_jitter_() {
+  const int64_t now_us = esp_timer_get_time();
+  const uint8_t *frame;
+  size_t len;
+  uint8_t flags;
+
+  while (true) {
+    JitterBuffer::PopResult result = this->jitter_.pop(now_us, &frame, &len, &flags);
+    if (result == JitterBuffer::PopResult::EMPTY) break;
+
+    if (result == JitterBuffer::PopResult::LOST) {
+      this->conceal_rx_audio_();
+      continue;
+    }
+
+    if ((flags & static_cast<uint8_t>(MessageFlags::DTX)) != 0) {
+      this->plc_pcm_len_ = 0;  // A gap after comfort noise stays quiet instead of replaying old speech
+    } else if (this->codec_.load(std::memory_order_relaxed) == AudioCodec::PCM) {
+      // Keep a copy for concealment - the slot is reused by the next datagram
+      this->plc_pcm_len_ = std::min(len, AUDIO_CHUNK_SIZE) & ~static_cast<size_t>(1);
+      memcpy(this->plc_pcm_, frame, this->plc_pcm_len_);
+    }
+    this->play_rx_audio_(frame, len, flags);
+  }
+}
+
+void IntercomApi::conceal_rx_audio_() {
+#ifdef USE_INTERCOM_OPUS
+  if (this->codec_.load(std::memory_order_relaxed) == AudioCodec::OPUS) {
+    // Opus PLC extrapolates from decoder state
+    size_t pcm_len = this->decoder_.conceal(this->dec_pcm_, this->jitter_.get_frame_samples());
+    if (pcm_len > 0) {
+      this->write_speaker_(reinterpret_cast<const uint8_t *>(this->dec_pcm_), pcm_len);
+    }
+    return;
+  }
+#endif
+  if (this->plc_pcm_len_ == 0) return;
+
+  // PCM: replay the last frame at half level each time - fades out over JITTER_MAX_CONCEAL frames
+  size_t samples = this->plc_pcm_len_ / sizeof(int16_t);
+  for (size_t i = 0; i < samples; i++) {
+    this->plc_pcm_[i] = static_cast<int16_t>(this->plc_pcm_[i] / 2);
+  }
+  this->write_speaker_(reinterpret_cast<const uint8_t *>(this->plc_pcm_), this->plc_pcm_len_);
+}
+
 // === Socket Helpers ===
 
 bool IntercomApi::setup_server_socket_() {
@@ -1495,7 +2650,7 @@ bool IntercomApi::setup_server_socket_() {
     return false;
   }
 
-  if (listen(this->server_socket_, 1) < 0) {
+  if (listen(this->server_socket_, 1 + this->max_monitors_) < 0) {
     ESP_LOGE(TAG, "Listen failed: %d", errno);
     close(this->server_socket_);
     this->server_socket_ = -1;
@@ -1506,6 +2661,70 @@ bool IntercomApi::setup_server_socket_() {
   return true;
 }
 
+bool IntercomApi::setup_wake_socket_() {
+  int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (sock < 0) {
+    return false;
+  }
+
+  int flags = fcntl(sock, F_GETFL, 0);
+  fcntl(sock, F_SETFL, flags | O_NONBLOCK);
+
+  // Loopback, ephemeral port: the socket sends its wake byte to itself
+  struct sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = 0;
+  socklen_t addr_len = sizeof(addr);
+  if (bind(sock, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0 ||
+      getsockname(sock, reinterpret_cast<struct sockaddr *>(&addr), &addr_len) < 0) {
+    close(sock);
+    return false;
+  }
+
+  this->wake_port_ = ntohs(addr.sin_port);
+  this->wake_socket_.store(sock, std::memory_order_release);
+  return true;
+}
+
+void IntercomApi::wake_server_task_() {
+  const int sock = this->wake_socket_.load(std::memory_order_acquire);
+  if (sock < 0) return;
+  struct sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(this->wake_port_);
+  const uint8_t wake = 0;
+  // Non-blocking: a full socket already has a wake-up pending
+  sendto(sock, &wake, sizeof(wake), 0, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr));
+}
+
+bool IntercomApi::setup_datagram_socket_() {
+  this->datagram_socket_ = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (this->datagram_socket_ < 0) {
+    ESP_LOGE(TAG, "Failed to create datagram socket: %d", errno);
+    return false;
+  }
+
+  int flags = fcntl(this->datagram_socket_, F_GETFL, 0);
+  fcntl(this->datagram_socket_, F_SETFL, flags | O_NONBLOCK);
+
+  struct sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = INADDR_ANY;
+  addr.sin_port = htons(INTERCOM_PORT);
+
+  if (bind(this->datagram_socket_, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0) {
+    ESP_LOGE(TAG, "Datagram bind failed: %d", errno);
+    close(this->datagram_socket_);
+    this->datagram_socket_ = -1;
+    return false;
+  }
+
+  ESP_LOGI(TAG, "Datagram audio on UDP port %d", INTERCOM_PORT);
+  return true;
+}
+
 void IntercomApi::close_server_socket_() {
   if (this->server_socket_ >= 0) {
     close(this->server_socket_);
@@ -1513,21 +2732,43 @@ void IntercomApi::close_server_socket_() {
   }
 }
 
-void IntercomApi::close_client_socket_() {
+void IntercomApi::close_client_socket_(bool send_stop) {
   // Lock-free socket close: atomically get and invalidate socket
   // This prevents race conditions without needing mutex timeout hacks
   this->client_.streaming.store(false);
+  this->datagram_active_.store(false, std::memory_order_release);
+  this->outbound_call_ = false;
+  this->awaiting_call_reply_ = false;
+  this->cancel_dial_();
 
+  const bool standby = this->client_.standby;
+  this->client_.standby = false;
   int sock = this->client_.socket.exchange(-1);
   if (sock >= 0) {
     // Try to send STOP before closing (best effort)
-    this->send_message_(sock, MessageType::STOP);
+    if (send_stop) {
+      this->send_message_(sock, MessageType::STOP);
+    }
+    if (standby) {
+      // HA's pooled link: the call is over, the connection is not
+      this->park_socket_(sock, this->client_.addr);
+      return;
+    }
     // Graceful shutdown then close
     shutdown(sock, SHUT_RDWR);
     close(sock);
   }
 }
 
+void IntercomApi::cancel_dial_() {
+  // The link that sent DIAL is going away: nobody to hand the callee connection to
+  const int sock = this->dial_socket_.exchange(-1);
+  if (sock >= 0) {
+    ESP_LOGD(TAG, "Dial to %s cancelled", this->dial_callee_.c_str());
+    close(sock);
+  }
+}
+
 void IntercomApi::accept_client_() {
   struct sockaddr_in client_addr;
   socklen_t client_len = sizeof(client_addr);
@@ -1554,17 +2795,15 @@ void IntercomApi::accept_client_() {
     close(client_sock);
   };
 
-  // Check if already have a client
-  if (this->client_.socket.load() >= 0) {
-    reject_busy("already have client");
-    return;
-  }
-
-  // Check if we're in a state that shouldn't accept new connections
-  // Allow IDLE (normal) and OUTGOING (ESP called someone, waiting for answer)
+  // The call client slot takes the connection when free and the FSM can still accept a peer:
+  // IDLE (normal) and OUTGOING (ESP called someone, waiting for answer).
+  // Otherwise it can only become a monitor - it must START with MessageFlags::MONITOR.
   CallState cs = this->call_state_.load(std::memory_order_acquire);
-  if (cs != CallState::IDLE && cs != CallState::OUTGOING) {
-    reject_busy(call_state_to_str(cs));
+  const bool have_client = this->client_.socket.load() >= 0;
+  const bool call_slot = !have_client && (cs == CallState::IDLE || cs == CallState::OUTGOING);
+  MonitorClient *monitor = call_slot ? nullptr : this->free_monitor_slot_();
+  if (!call_slot && monitor == nullptr) {
+    reject_busy(have_client ? "already have client" : call_state_to_str(cs));
     return;
   }
 
@@ -1578,20 +2817,390 @@ void IntercomApi::accept_client_() {
 
   char ip_str[INET_ADDRSTRLEN];
   inet_ntop(AF_INET, &client_addr.sin_addr, ip_str, sizeof(ip_str));
+  if (monitor != nullptr) {
+    ESP_LOGI(TAG, "Client connected from %s (monitor slot, call %s)", ip_str, call_state_to_str(cs));
+    monitor->addr = client_addr;
+    monitor->connected_at = millis();
+    monitor->subscribed.store(false);
+    monitor->socket.store(client_sock);
+    return;
+  }
+
   ESP_LOGI(TAG, "Client connected from %s", ip_str);
+  this->attach_client_(client_sock, client_addr, false);
+}
 
+void IntercomApi::attach_client_(int sock, const struct sockaddr_in &addr, bool standby) {
   // Use mutex for non-atomic addr field
   xSemaphoreTake(this->client_mutex_, portMAX_DELAY);
-  this->client_.socket.store(client_sock);
-  this->client_.addr = client_addr;
+  this->client_.socket.store(sock);
+  this->client_.addr = addr;
   this->client_.last_ping = millis();
   this->client_.streaming.store(false);
+  this->client_.standby = standby;
   xSemaphoreGive(this->client_mutex_);
 
+  // Every connection starts as PCM over TCP until START/ANSWER negotiates otherwise
+  this->datagram_active_.store(false, std::memory_order_release);
+  this->dtx_peer_.store(false, std::memory_order_release);
+  this->latency_peer_.store(false, std::memory_order_release);
+  this->codec_.store(AudioCodec::PCM, std::memory_order_release);
+  this->codec_frame_ms_.store(this->local_frame_ms_(), std::memory_order_release);
+
   this->state_ = ConnectionState::CONNECTED;
   this->connect_trigger_.trigger();
 }
 
+// === Monitor Clients ===
+
+MonitorClient *IntercomApi::free_monitor_slot_() {
+  for (size_t i = 0; i < this->max_monitors_; i++) {
+    if (this->monitors_[i].socket.load() < 0) return &this->monitors_[i];
+  }
+  return nullptr;
+}
+
+void IntercomApi::move_client_to_monitor_(const MessageHeader &header, const uint8_t *data) {
+  MonitorClient *monitor = this->free_monitor_slot_();
+
+  xSemaphoreTake(this->client_mutex_, portMAX_DELAY);
+  int sock = this->client_.socket.exchange(-1);
+  struct sockaddr_in addr = this->client_.addr;
+  this->client_.standby = false;  // A monitor now, never parked
+  xSemaphoreGive(this->client_mutex_);
+  if (sock < 0) return;
+
+  if (monitor == nullptr) {
+    ESP_LOGW(TAG, "Rejecting monitor - no free monitor slot (max_monitors: %u)", this->max_monitors_);
+    uint8_t reason = static_cast<uint8_t>(ErrorCode::BUSY);
+    this->send_message_(sock, MessageType::ERROR, MessageFlags::NONE, &reason, 1);
+    shutdown(sock, SHUT_RDWR);
+    close(sock);
+  } else {
+    monitor->addr = addr;
+    monitor->connected_at = millis();
+    monitor->socket.store(sock);
+    this->subscribe_monitor_(*monitor, header, data);
+  }
+
+  // The call client slot is free again - the call FSM never saw this connection
+  this->state_ = ConnectionState::DISCONNECTED;
+  this->publish_state_();
+  this->disconnect_trigger_.trigger();
+}
+
+void IntercomApi::subscribe_monitor_(MonitorClient &monitor, const MessageHeader &header, const uint8_t *data) {
+  // Only the codec offer matters: monitors always receive over TCP, so a DatagramOffer is ignored
+  uint8_t mask = CODEC_MASK_PCM;
+  monitor.codec_reply = false;
+  const size_t offers_size = call_offer_size(header.flags);
+  if ((header.flags & static_cast<uint8_t>(MessageFlags::CODEC)) && data != nullptr &&
+      header.length >= offers_size) {
+    CodecOffer offer;
+    memcpy(&offer, data + header.length - offers_size, sizeof(offer));
+    mask |= offer.codec_mask;
+    monitor.codec_reply = true;
+  }
+  monitor.codec_mask.store(mask, std::memory_order_relaxed);
+  monitor.consecutive_drops.store(0, std::memory_order_relaxed);
+  if (!monitor.subscribed.exchange(true, std::memory_order_release)) {
+    this->monitor_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  char ip_str[INET_ADDRSTRLEN];
+  inet_ntop(AF_INET, &monitor.addr.sin_addr, ip_str, sizeof(ip_str));
+  ESP_LOGI(TAG, "Monitor %s subscribed (codecs 0x%02X, call %s)", ip_str, mask,
+           call_state_to_str(this->call_state_.load(std::memory_order_acquire)));
+  this->send_monitor_reply_(monitor);
+}
+
+void IntercomApi::send_monitor_reply_(MonitorClient &monitor) {
+  int sock = monitor.socket.load();
+  if (!monitor.codec_reply) {
+    this->send_message_(sock, MessageType::PONG);
+    return;
+  }
+  // Codec-aware monitors learn the call codec the same way a caller does: PONG with CodecParams
+  CodecParams params;
+  params.codec = static_cast<uint8_t>(this->codec_.load(std::memory_order_acquire));
+  params.frame_ms = this->codec_frame_ms_.load(std::memory_order_acquire);
+  this->send_message_(sock, MessageType::PONG, MessageFlags::CODEC, reinterpret_cast<const uint8_t *>(&params),
+                      sizeof(params));
+}
+
+void IntercomApi::announce_codec_to_monitors_() {
+  // New call negotiated: frames that follow use its codec - monitors without CODEC only decode PCM
+  // and simply receive nothing while the call is Opus (fan_out_audio_frame_ checks codec_mask)
+  if (this->monitor_count_.load(std::memory_order_relaxed) == 0) return;
+  for (size_t i = 0; i < this->max_monitors_; i++) {
+    MonitorClient &monitor = this->monitors_[i];
+    if (monitor.subscribed.load(std::memory_order_acquire) && monitor.codec_reply) {
+      this->send_monitor_reply_(monitor);
+    }
+  }
+}
+
+void IntercomApi::handle_monitor_message_(MonitorClient &monitor, const MessageHeader &header,
+                                          const uint8_t *data) {
+  switch (static_cast<MessageType>(header.type)) {
+    case MessageType::START:
+      if ((header.flags & static_cast<uint8_t>(MessageFlags::MONITOR)) == 0) {
+        // A second caller while the call client slot is taken - same answer as a busy accept
+        ESP_LOGW(TAG, "Rejecting START from second client - %s",
+                 call_state_to_str(this->call_state_.load(std::memory_order_acquire)));
+        uint8_t reason = static_cast<uint8_t>(ErrorCode::BUSY);
+        this->send_message_(monitor.socket.load(), MessageType::ERROR, MessageFlags::NONE, &reason, 1);
+        this->close_monitor_(monitor);
+        break;
+      }
+      this->subscribe_monitor_(monitor, header, data);
+      break;
+
+    case MessageType::STOP:
+      if (monitor.controller) {
+        this->close_monitor_(monitor);
+        this->hang_up_direct_call_();
+        break;
+      }
+      ESP_LOGI(TAG, "Monitor unsubscribed");
+      this->close_monitor_(monitor);
+      break;
+
+    case MessageType::PING:
+      if ((header.flags & static_cast<uint8_t>(MessageFlags::STANDBY)) && !monitor.controller &&
+          !monitor.subscribed.load(std::memory_order_acquire)) {
+        // HA's pool connected while the call client slot was taken: park the link instead.
+        // Never subscribed, so no fan-out holds the descriptor.
+        const int sock = monitor.socket.exchange(-1);
+        this->park_socket_(sock, monitor.addr);
+        this->send_message_(sock, MessageType::PONG, MessageFlags::STANDBY);
+        break;
+      }
+      this->send_message_(monitor.socket.load(), MessageType::PONG);
+      break;
+
+    case MessageType::AUDIO:
+      // Listen-only: the call client owns the speaker
+    case MessageType::PONG:
+      break;
+
+    default:
+      ESP_LOGW(TAG, "Monitor: unexpected message type 0x%02X", header.type);
+      break;
+  }
+}
+
+void IntercomApi::service_monitors_(fd_set *read_fds, bool readable) {
+  const uint32_t now = millis();
+  for (size_t i = 0; i < this->max_monitors_; i++) {
+    MonitorClient &monitor = this->monitors_[i];
+    int fd = monitor.socket.load();
+    if (fd < 0) continue;
+
+    if (readable && FD_ISSET(fd, read_fds)) {
+      MessageHeader header;
+      if (!this->receive_message_(fd, header, this->rx_buffer_, MAX_MESSAGE_SIZE)) {
+        ESP_LOGI(TAG, "Monitor disconnected");
+        this->close_monitor_(monitor);
+        continue;
+      }
+      this->handle_monitor_message_(monitor, header, this->rx_buffer_ + HEADER_SIZE);
+      if (monitor.socket.load() < 0) continue;
+    }
+
+    if (monitor.controller) {
+      continue;  // Call controller: lives until the call ends
+    }
+    if (!monitor.subscribed.load(std::memory_order_acquire)) {
+      if (now - monitor.connected_at > MONITOR_START_TIMEOUT_MS) {
+        ESP_LOGW(TAG, "Monitor slot: no START within %u ms - closing", MONITOR_START_TIMEOUT_MS);
+        this->close_monitor_(monitor);
+      }
+    } else if (monitor.consecutive_drops.load(std::memory_order_relaxed) >= MONITOR_MAX_DROPPED_FRAMES) {
+      // Never let a slow recorder hold frames back: it loses its subscription instead
+      ESP_LOGW(TAG, "Monitor not keeping up (%u frames dropped) - closing", MONITOR_MAX_DROPPED_FRAMES);
+      this->close_monitor_(monitor);
+    }
+  }
+}
+
+void IntercomApi::close_monitor_(MonitorClient &monitor) {
+  monitor.controller = false;
+  if (monitor.subscribed.exchange(false, std::memory_order_acq_rel)) {
+    this->monitor_count_.fetch_sub(1, std::memory_order_relaxed);
+  }
+  // fan_out_audio_frame_() uses the descriptor under send_mutex_: invalidate it under the same
+  // lock so a sender never writes to a closed (or already reused) fd
+  const bool locked = xSemaphoreTake(this->send_mutex_, pdMS_TO_TICKS(50)) == pdTRUE;
+  int sock = monitor.socket.exchange(-1);
+  if (locked) xSemaphoreGive(this->send_mutex_);
+  if (sock >= 0) {
+    shutdown(sock, SHUT_RDWR);
+    close(sock);
+  }
+}
+
+void IntercomApi::fan_out_audio_frame_(const uint8_t *data, size_t len) {
+  const uint8_t codec_bit = 1 << static_cast<uint8_t>(this->codec_.load(std::memory_order_acquire));
+
+  // One lock for the whole fan-out; each monitor gets the frame or drops it, nobody waits
+  if (xSemaphoreTake(this->send_mutex_, pdMS_TO_TICKS(5)) != pdTRUE) {
+    this->metrics_.monitor_dropped_frames.fetch_add(this->monitor_count_.load(std::memory_order_relaxed),
+                                                    std::memory_order_relaxed);
+    return;
+  }
+  for (size_t i = 0; i < this->max_monitors_; i++) {
+    MonitorClient &monitor = this->monitors_[i];
+    int sock = monitor.socket.load();
+    if (sock < 0 || !monitor.subscribed.load(std::memory_order_acquire) ||
+        (monitor.codec_mask.load(std::memory_order_relaxed) & codec_bit) == 0) {
+      continue;
+    }
+    if (this->send_frame_(sock, MessageType::AUDIO, MessageFlags::NONE, data, len, true)) {
+      monitor.consecutive_drops.store(0, std::memory_order_relaxed);
+    } else {
+      monitor.consecutive_drops.fetch_add(1, std::memory_order_relaxed);
+      this->metrics_.monitor_dropped_frames.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  xSemaphoreGive(this->send_mutex_);
+}
+
+// === Standby Link (server_task) ===
+
+void IntercomApi::park_client_() {
+  // PING with STANDBY from the call client: HA's pool keeps this link between calls.
+  // Mid-call it is only marked - close_client_socket_() parks it when the call ends.
+  this->client_.standby = true;
+  const CallState cs = this->call_state_.load(std::memory_order_acquire);
+  if (cs != CallState::IDLE || this->client_.streaming.load() || this->outbound_call_) {
+    this->send_message_(this->client_.socket.load(), MessageType::PONG, MessageFlags::STANDBY);
+    return;
+  }
+
+  xSemaphoreTake(this->client_mutex_, portMAX_DELAY);
+  int sock = this->client_.socket.exchange(-1);
+  struct sockaddr_in addr = this->client_.addr;
+  this->client_.standby = false;
+  xSemaphoreGive(this->client_mutex_);
+  if (sock < 0) return;
+
+  this->park_socket_(sock, addr);
+  this->send_message_(sock, MessageType::PONG, MessageFlags::STANDBY);
+
+  // The call client slot is free for peers again - the call FSM never saw this connection
+  this->state_ = ConnectionState::DISCONNECTED;
+  this->publish_state_();
+  this->disconnect_trigger_.trigger();
+}
+
+void IntercomApi::park_socket_(int sock, const struct sockaddr_in &addr) {
+  if (this->standby_.socket.load() >= 0) {
+    // One pooled link per device: HA reconnected, the old one is most likely half-open
+    ESP_LOGD(TAG, "Replacing standby link");
+    this->close_standby_();
+  }
+  char ip_str[INET_ADDRSTRLEN];
+  inet_ntop(AF_INET, &addr.sin_addr, ip_str, sizeof(ip_str));
+  ESP_LOGD(TAG, "Standby link from %s parked", ip_str);
+  this->standby_.addr = addr;
+  this->standby_.connected_at = millis();
+  this->standby_.controller = false;
+  this->standby_.socket.store(sock);
+}
+
+bool IntercomApi::unpark_standby_() {
+  // Same states accept_client_() gives the call client slot in
+  const CallState cs = this->call_state_.load(std::memory_order_acquire);
+  if (this->client_.socket.load() >= 0 || (cs != CallState::IDLE && cs != CallState::OUTGOING)) {
+    return false;
+  }
+  int sock = this->standby_.socket.exchange(-1);
+  if (sock < 0) return false;
+  this->standby_.controller = false;
+  ESP_LOGD(TAG, "Standby link takes the call (%s)", call_state_to_str(cs));
+  this->attach_client_(sock, this->standby_.addr, true);
+  return true;
+}
+
+void IntercomApi::handle_standby_message_(const MessageHeader &header, const uint8_t *data) {
+  this->standby_.connected_at = millis();
+
+  switch (static_cast<MessageType>(header.type)) {
+    case MessageType::START:
+      if (header.flags & static_cast<uint8_t>(MessageFlags::MONITOR)) {
+        // Listen-only subscribers connect on a link of their own
+        uint8_t reason = static_cast<uint8_t>(ErrorCode::INVALID_MSG);
+        this->send_message_(this->standby_.socket.load(), MessageType::ERROR, MessageFlags::NONE, &reason, 1);
+        break;
+      }
+      [[fallthrough]];
+    case MessageType::ANSWER:
+    case MessageType::DIAL:
+      // A call on the warm link: it becomes the call client, as if it had just connected
+      if (!this->unpark_standby_()) {
+        ESP_LOGW(TAG, "Standby link: call request while %s - busy",
+                 call_state_to_str(this->call_state_.load(std::memory_order_acquire)));
+        uint8_t reason = static_cast<uint8_t>(ErrorCode::BUSY);
+        this->send_message_(this->standby_.socket.load(), MessageType::ERROR, MessageFlags::NONE, &reason, 1);
+        break;
+      }
+      this->handle_message_(header, data);
+      break;
+
+    case MessageType::STOP:
+      if (this->standby_.controller) {
+        this->standby_.controller = false;
+        this->hang_up_direct_call_();
+      }
+      break;
+
+    case MessageType::PING:
+      this->send_message_(this->standby_.socket.load(), MessageType::PONG, MessageFlags::STANDBY);
+      break;
+
+    case MessageType::PONG:
+    case MessageType::AUDIO:
+      break;
+
+    default:
+      ESP_LOGW(TAG, "Standby link: unexpected message type 0x%02X", header.type);
+      break;
+  }
+}
+
+void IntercomApi::service_standby_(fd_set *read_fds, bool readable) {
+  int fd = this->standby_.socket.load();
+  if (fd < 0) return;
+
+  if (readable && FD_ISSET(fd, read_fds)) {
+    MessageHeader header;
+    if (!this->receive_message_(fd, header, this->rx_buffer_, MAX_MESSAGE_SIZE)) {
+      // A direct call it controls goes on, as with a monitor controller
+      ESP_LOGI(TAG, "Standby link disconnected");
+      this->close_standby_();
+      return;
+    }
+    this->handle_standby_message_(header, this->rx_buffer_ + HEADER_SIZE);
+    return;
+  }
+
+  // The controller of a direct call is quiet while it rings (HA pings nothing then)
+  if (!this->standby_.controller && millis() - this->standby_.connected_at > STANDBY_TIMEOUT_MS) {
+    ESP_LOGW(TAG, "Standby link silent for %u ms - closing", STANDBY_TIMEOUT_MS);
+    this->close_standby_();
+  }
+}
+
+void IntercomApi::close_standby_() {
+  this->standby_.controller = false;
+  int sock = this->standby_.socket.exchange(-1);
+  if (sock >= 0) {
+    shutdown(sock, SHUT_RDWR);
+    close(sock);
+  }
+}
+
 // === Microphone Callback ===
 
 void IntercomApi::on_microphone_data_(const uint8_t *data, size_t len) {
@@ -1613,23 +3222,35 @@ void IntercomApi::on_microphone_data_(const uint8_t *data, size_t len) {
   float effective_gain = (this->mic_gain_number_ != nullptr) ? this->mic_gain_ : 1.0f;
   bool needs_processing = effective_gain != 1.0f || this->dc_offset_removal_;
 
-  // RingBuffer is thread-safe, no mutex needed
+  // SPSC ring: this callback is mic_buffer_'s only writer
   if (needs_processing) {
-    for (size_t i = 0; i < num_samples; i++) {
-      int32_t s = src[i];
-      if (this->dc_offset_removal_) {
-        // IIR high-pass ~2.5Hz cutoff at 16kHz (matches i2s_audio_duplex)
-        this->dc_offset_ += (s - this->dc_offset_) >> 10;
-        s = s - this->dc_offset_;
-      }
-      this->mic_converted_[i] = scale_sample(static_cast<int16_t>(s), effective_gain);
+    // DC high-pass ~2.5Hz at 16kHz (same filter as i2s_audio_duplex) fused with gain: one pass,
+    // written straight into the ring
+    const audio_kernels::Gain gain = audio_kernels::Gain::from_float(effective_gain);
+    if (this->dc_offset_removal_) {
+      this->mic_buffer_->write_samples(src, num_samples, [this, &gain](const int16_t *in, int16_t *out, size_t n) {
+        audio_kernels::dc_block_gain(in, out, n, this->dc_blocker_, gain);
+      });
+    } else {
+      this->mic_buffer_->write_samples(src, num_samples, [&gain](const int16_t *in, int16_t *out, size_t n) {
+        audio_kernels::scale_copy(in, out, n, gain);
+      });
     }
-
-    this->mic_buffer_->write(this->mic_converted_, num_samples * sizeof(int16_t));
   } else {
     // Direct passthrough (gain=1.0, no DC offset)
     this->mic_buffer_->write(data, len);
   }
+
+  // Wake tx_task once a full frame is buffered (server_task drains inline when no tx_task)
+  if (this->tx_task_handle_ && this->mic_buffer_->available() >= this->tx_frame_bytes_()) {
+    xTaskNotifyGive(this->tx_task_handle_);
+  }
+#ifdef USE_INTERCOM_OPUS
+  // No tx_task: encoder_task reads mic_buffer_ directly during Opus calls
+  if (!this->tx_task_handle_ && this->codec_.load(std::memory_order_relaxed) == AudioCodec::OPUS) {
+    xTaskNotifyGive(this->encoder_task_handle_);
+  }
+#endif
 }
 
 }  // namespace intercom_api
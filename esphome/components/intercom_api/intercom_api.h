@@ -5,7 +5,6 @@
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
 #include "esphome/core/preferences.h"
-#include "esphome/core/ring_buffer.h"
 
 #ifdef USE_MICROPHONE
 #include "esphome/components/microphone/microphone.h"
@@ -18,18 +17,32 @@
 #include "esphome/components/switch/switch.h"
 #include "esphome/components/number/number.h"
 #include "esphome/components/text_sensor/text_sensor.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/components/audio_kernels/aec_owner.h"
+#include "esphome/components/audio_kernels/audio_arena.h"
+#include "esphome/components/audio_kernels/audio_kernels.h"
+#include "esphome/components/audio_kernels/delay_estimator.h"
+#include "esphome/components/audio_kernels/spsc_ring.h"
 
 #ifdef USE_ESP_AEC
-#include "esphome/components/esp_aec/esp_aec.h"
+#include "esphome/components/audio_kernels/aec_processor.h"
 #endif
 
 #include "intercom_protocol.h"
+#ifdef USE_INTERCOM_OPUS
+#include "intercom_codec.h"
+#endif
+#include "intercom_framing.h"
+#include "intercom_jitter.h"
+#include "intercom_metrics.h"
+#include "intercom_playout.h"
 
 #include <lwip/sockets.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #include <freertos/semphr.h>
 
+#include <algorithm>
 #include <atomic>
 #include <memory>
 #include <string>
@@ -99,6 +112,20 @@ struct ClientInfo {
   struct sockaddr_in addr{};
   uint32_t last_ping{0};
   std::atomic<bool> streaming{false};
+  bool standby{false};  // HA's pooled link (PING with STANDBY): parks in standby_ when the call ends
+};
+
+// Listen-only monitor client (START with MessageFlags::MONITOR). Slots are owned by
+// server_task; audio senders only read socket/subscribed/codec_mask under send_mutex_.
+struct MonitorClient {
+  std::atomic<int> socket{-1};
+  std::atomic<bool> subscribed{false};              // START/MONITOR accepted - receives mic AUDIO
+  std::atomic<uint8_t> codec_mask{CODEC_MASK_PCM};  // Codecs it decodes (PCM always)
+  std::atomic<uint32_t> consecutive_drops{0};       // Fan-out frames dropped in a row
+  bool codec_reply{false};                          // Offered CODEC: gets CodecParams when the call codec changes
+  bool controller{false};                           // HA link that DIALed the current call (see dial_peer_)
+  struct sockaddr_in addr{};
+  uint32_t connected_at{0};                         // standby_: last message (STANDBY_TIMEOUT_MS)
 };
 
 class IntercomApi : public Component {
@@ -123,9 +150,22 @@ class IntercomApi : public Component {
   void set_device_name(const std::string &name) { this->device_name_ = name; }
 
 #ifdef USE_ESP_AEC
-  void set_aec(esp_aec::EspAec *aec) { this->aec_ = aec; }
+  // Standalone AEC: separate mic/speaker, intercom_api feeds the processor itself (tx_task)
+  void set_aec(AecProcessor *aec) { this->aec_ = aec; }
+  // The I2S bus owner already cancels echo on the mic frames it delivers: the AEC switch
+  // drives its AEC and no intercom-side AEC buffers or tasks are created
+  void set_aec_owner(audio_kernels::AecOwner *owner) { this->aec_owner_ = owner; }
   void set_aec_enabled(bool enabled);
-  bool is_aec_enabled() const { return this->aec_enabled_; }
+  bool is_aec_enabled() const {
+    return this->aec_owner_ != nullptr ? this->aec_owner_->is_aec_enabled() : this->aec_enabled_;
+  }
+  // Measure the mic-vs-reference lag at the start of each call and align the reference to it
+  void set_aec_reference_delay_estimation(bool enabled) { this->aec_delay_estimation_ = enabled; }
+  // Current reference delay (AEC_REF_DELAY_MS until the first estimate)
+  uint32_t get_aec_reference_delay_ms() const {
+    if (this->aec_owner_ != nullptr) return this->aec_owner_->get_aec_reference_delay_ms();
+    return static_cast<uint32_t>(this->aec_ref_delay_bytes_ / sizeof(int16_t) * 1000 / SAMPLE_RATE);
+  }
 #endif
 
   // Runtime control
@@ -213,13 +253,65 @@ class IntercomApi : public Component {
   Trigger<std::string> *get_hangup_trigger() { return &this->hangup_trigger_; }
   Trigger<std::string> *get_call_failed_trigger() { return &this->call_failed_trigger_; }
 
+  // Audio task wakeups per second (sampled in loop(), 0 when task not created)
+  uint32_t get_tx_wakeups_per_sec() const { return this->tx_wakeups_per_sec_; }
+  uint32_t get_speaker_wakeups_per_sec() const { return this->speaker_wakeups_per_sec_; }
+  uint32_t get_server_wakeups_per_sec() const { return this->server_wakeups_per_sec_; }
+
+  // Pipeline metrics (counters only, see intercom_metrics.h)
+  IntercomMetrics &get_metrics() { return this->metrics_; }
+  // Free stack of an audio task in bytes, 0 when the task was not created
+  uint32_t get_task_stack_free(MetricsTask task) const;
+  // Accumulated run time of an audio task in us; false without FreeRTOS run time stats
+  bool get_task_run_time_us(MetricsTask task, uint32_t &run_time_us) const;
+  // Log every metric once (intercom_api.dump_metrics action)
+  void dump_metrics();
+
+  // Codec of the current call (negotiated on START/ANSWER, PCM when the peer sent no offer)
+  AudioCodec get_codec() const { return this->codec_.load(std::memory_order_acquire); }
+  uint8_t get_frame_ms() const { return this->codec_frame_ms_.load(std::memory_order_acquire); }
+#ifdef USE_INTERCOM_OPUS
+  void set_opus_bitrate(uint32_t bitrate) { this->opus_bitrate_ = bitrate; }
+#endif
+
+  // PCM frame this device prefers (frame_duration: 10/16/20/32 ms), negotiated per call.
+  // An AEC (own or the bus owner's) overrides it with its chunk.
+  void set_frame_duration_ms(uint8_t ms) { this->frame_duration_ms_ = ms; }
+
+  // Datagram audio: accept UDP AUDIO offers (audio_transport: udp), signalling stays on TCP
+  void set_datagram_audio(bool enabled) { this->datagram_audio_ = enabled; }
+
+  // DTX: send quiet mic frames as ComfortNoiseFrames to peers that offered DTX (dtx: true).
+  // Received ComfortNoiseFrames are always played as comfort noise.
+  void set_dtx(bool enabled) { this->dtx_enabled_ = enabled; }
+  bool is_dtx_call() const { return this->dtx_enabled_ && this->dtx_peer_.load(std::memory_order_acquire); }
+
+  // Listen-only monitor clients served next to the call client (0 = reject extra connections)
+  void set_max_monitors(uint8_t count) { this->max_monitors_ = std::min<uint8_t>(count, MAX_MONITORS); }
+  uint8_t get_monitor_count() const { return this->monitor_count_.load(std::memory_order_relaxed); }
+  // HA's pooled connection is parked, ready to carry the next call without reconnecting
+  bool has_standby_link() const { return this->standby_.socket.load() >= 0; }
+  bool is_datagram_call() const { return this->datagram_active_.load(std::memory_order_acquire); }
+  // Jitter buffer state (datagram calls only, server_task writes - values are approximate)
+  uint8_t get_jitter_depth_frames() const { return this->jitter_.get_depth(); }
+  uint8_t get_jitter_target_frames() const { return this->jitter_.get_target_frames(); }
+  uint32_t get_jitter_us() const { return this->jitter_.get_jitter_us(); }
+  uint32_t get_concealed_frames() const { return this->jitter_.get_lost(); }
+
+  // Speaker playout window (aec_id mode: speaker_task paces speaker_buffer_ within [min, max])
+  void set_playout_window(uint32_t min_ms, uint32_t max_ms) { this->playout_.configure(min_ms, max_ms); }
+  uint32_t get_playout_depth_ms() const { return this->playout_.get_depth_ms(); }
+  uint32_t get_playout_target_ms() const { return this->playout_.get_target_ms(); }
+  uint32_t get_playout_underruns() const { return this->playout_.get_underruns(); }
+  uint32_t get_playout_overflows() const { return this->playout_.get_overflows(); }
+
   // Call state getter
   CallState get_call_state() const { return this->call_state_.load(std::memory_order_acquire); }
   const char *get_call_state_str() const { return call_state_to_str(this->call_state_.load(std::memory_order_acquire)); }
 
  protected:
   // Returns true when intercom_api has its own AEC (aec_id configured on intercom_api component)
-  // When false, speaker_task and tx_task are eliminated to save ~34KB internal RAM
+  // When false (no AEC, or an aec_owner does it), speaker_task and tx_task are eliminated to save ~34KB internal RAM
   bool has_intercom_aec_() const {
 #ifdef USE_ESP_AEC
     return this->aec_ != nullptr;
@@ -243,17 +335,119 @@ class IntercomApi : public Component {
   static void speaker_task(void *param);
   void speaker_task_();
 
+#ifdef USE_INTERCOM_OPUS
+  // Encoder task - Opus-encodes outgoing PCM (Core 1, keeps codec CPU away from i2s_duplex on Core 0)
+  // Only created when codec: opus is configured
+  static void encoder_task(void *param);
+  void encoder_task_();
+#endif
+
   // Protocol handling
   bool send_message_(int socket, MessageType type, MessageFlags flags = MessageFlags::NONE,
                      const uint8_t *data = nullptr, size_t len = 0);
+  // Unlocked gather send (sendmsg header + payload iovecs, no staging copy)
+  // drop_if_busy: return on EAGAIN if nothing was sent yet (used by tx_task for audio)
+  bool send_frame_(int socket, MessageType type, MessageFlags flags, const uint8_t *data, size_t len,
+                   bool drop_if_busy);
   bool receive_message_(int socket, MessageHeader &header, uint8_t *buffer, size_t buffer_size);
   void handle_message_(const MessageHeader &header, const uint8_t *data);
 
+  // Call negotiation: pick codec and audio transport from the offers at the end of START/ANSWER.
+  // Returns the MessageFlags (CODEC/DATAGRAM) to echo in the reply, 0 for older HA (PCM over TCP).
+  uint8_t negotiate_call_(const MessageHeader &header, const uint8_t *data);
+  // PCM frame durations: ours (frame_duration or the AEC chunk), the one answering a peer
+  // offer, and the bytes tx_task / the inline TX path read from mic_buffer_ per frame
+  uint8_t local_frame_ms_() const;
+  uint8_t pcm_frame_ms_for_offer_(uint8_t offered) const;
+  size_t tx_frame_bytes_() const;
+  // speaker_task chunk: the call frame, capped at SAMPLES_PER_CHUNK (Opus 40/60 ms)
+  size_t play_chunk_samples_() const;
+  // Send a call reply (PONG/RING), carrying CodecParams/DatagramParams as selected by reply_flags
+  void send_call_reply_(MessageType type, uint8_t reply_flags);
+  // Datagram audio to the call client's host at the given UDP port (both negotiation directions)
+  void start_datagram_call_(uint16_t peer_port);
+  // In-call latency (LATENCY negotiated): PROBE every PROBE_INTERVAL_MS from server_task, PROBE_ECHO
+  // back for the peer's. Both carry our own buffered delays (capture / playout side, ms).
+  void send_latency_probe_(MessageType type, uint32_t origin_us);
+  uint32_t get_capture_delay_ms_() const;
+  uint32_t get_playout_delay_ms_() const;
+
+  // Direct ESP↔ESP calls: on DIAL we connect to the callee and become the client of client_
+  // (START/offers out, PONG/RING with CodecParams/DatagramParams back). The HA link that sent
+  // DIAL moves to a monitor slot (a standby link: back to standby_) as the call controller: it hears
+  // RING/ANSWER/STOP, its STOP hangs up.
+  // The callee connect does not block server_task: its socket joins the select() set with write
+  // interest, service_dial_() finishes the dial (finish_dial_) or replies UNREACHABLE after
+  // DIAL_CONNECT_TIMEOUT_MS, and close_client_socket_() drops it along with the HA link.
+  void dial_peer_(const MessageHeader &header, const uint8_t *data);
+  int start_peer_connect_(const struct sockaddr_in &peer);
+  void service_dial_(int selected_fd, fd_set *write_fds, bool writable);
+  void finish_dial_(int peer_sock);
+  void cancel_dial_();
+  void send_peer_start_();
+  void apply_call_reply_(const MessageHeader &header, const uint8_t *data);
+  void notify_controller_(MessageType type);
+  void release_controller_();
+  void hang_up_direct_call_();  // Controller sent STOP
+  // tx_task: hand one block of outgoing PCM to the socket (PCM) or the encoder task (Opus)
+  void tx_send_audio_(const uint8_t *data, size_t len);
+  // Send one outgoing AUDIO frame (samples = its duration) over UDP or TCP, dropping it if busy
+  // (timed and counted in metrics_; transmit_audio_frame_() does the actual send).
+  // flags = DTX marks a ComfortNoiseFrame, which monitors do not get.
+  bool send_audio_frame_(const uint8_t *data, size_t len, uint32_t samples, MessageFlags flags = MessageFlags::NONE);
+  bool transmit_audio_frame_(const uint8_t *data, size_t len, uint32_t samples, MessageFlags flags);
+  // DTX (active audio sender): run the VAD over one outgoing PCM frame; when it is quiet, send
+  // a ComfortNoiseFrame for it instead and return true. False = send the frame as usual.
+  bool send_dtx_frame_(const int16_t *pcm, size_t samples);
+
+  // Received audio: decode (Opus) and hand PCM to speaker_buffer_ / speaker. flags is the
+  // AUDIO header's: DTX payloads are a ComfortNoiseFrame, played by play_comfort_noise_().
+  void play_rx_audio_(const uint8_t *data, size_t len, uint8_t flags);
+  void play_comfort_noise_(const uint8_t *data, size_t len);
+  void write_speaker_(const uint8_t *pcm, size_t len);
+  // First audio of a call moves ConnectionState/CallState to STREAMING
+  void on_rx_audio_();
+
+  // Datagram audio (server_task)
+  bool setup_datagram_socket_();
+  void receive_datagrams_();
+  void play_jitter_();
+  void conceal_rx_audio_();  // Packet-loss concealment for one missing frame
+
+  // Wake socket: loopback UDP that server_task's select() also waits on, so call-state
+  // changes from other tasks end an idle select() at once
+  bool setup_wake_socket_();
+  void wake_server_task_();
+
   // Socket helpers
   bool setup_server_socket_();
   void close_server_socket_();
-  void close_client_socket_();
+  // send_stop = false when the peer's STOP ended the call. A standby client is parked, not closed.
+  void close_client_socket_(bool send_stop = true);
   void accept_client_();
+  // Give the call client slot a connected socket - every call starts as PCM over TCP
+  void attach_client_(int sock, const struct sockaddr_in &addr, bool standby);
+
+  // Standby link (server_task): HA's pool keeps one connection per device. Between calls it waits
+  // in standby_, outside the call client slot, so peers can still call in; START/ANSWER/DIAL on it
+  // move it into the slot without a new handshake, and close_client_socket_() parks it again.
+  void park_client_();
+  void park_socket_(int sock, const struct sockaddr_in &addr);
+  bool unpark_standby_();
+  void handle_standby_message_(const MessageHeader &header, const uint8_t *data);
+  void service_standby_(fd_set *read_fds, bool readable);
+  void close_standby_();
+
+  // Monitor clients (server_task). Frames are encoded once and fanned out by the audio sender.
+  MonitorClient *free_monitor_slot_();
+  void move_client_to_monitor_(const MessageHeader &header, const uint8_t *data);
+  void subscribe_monitor_(MonitorClient &monitor, const MessageHeader &header, const uint8_t *data);
+  void send_monitor_reply_(MonitorClient &monitor);
+  void announce_codec_to_monitors_();
+  void handle_monitor_message_(MonitorClient &monitor, const MessageHeader &header, const uint8_t *data);
+  void service_monitors_(fd_set *read_fds, bool readable);
+  void close_monitor_(MonitorClient &monitor);
+  void fan_out_audio_frame_(const uint8_t *data, size_t len);
 
   // Microphone callback
   void on_microphone_data_(const uint8_t *data, size_t len);
@@ -261,6 +455,12 @@ class IntercomApi : public Component {
   // State helpers - consolidate duplicated start/stop logic
   void set_active_(bool on);
   void set_streaming_(bool on);
+  // Prepared stage (RINGING/OUTGOING): reset the call's buffers and start mic/speaker
+  // ahead of the answer, so set_streaming_(true) only opens the gate. No-op once active.
+  void prepare_call_();
+
+  // Wake tx_task/speaker_task so they re-check active/streaming state immediately
+  void notify_audio_tasks_();
 
   // Publish sensor values
   void publish_state_();
@@ -275,6 +475,8 @@ class IntercomApi : public Component {
 #ifdef USE_ESP_AEC
   // AEC helper
   void reset_aec_buffers_();
+  void realign_aec_reference_();     // tx_task, on aec_ref_reset_
+  void apply_ref_delay_estimate_();  // tx_task
 #endif
 
   // Components
@@ -315,16 +517,55 @@ class IntercomApi : public Component {
   ClientInfo client_;
   SemaphoreHandle_t client_mutex_{nullptr};
 
-  // Buffers
-  std::unique_ptr<RingBuffer> mic_buffer_;
-  std::unique_ptr<RingBuffer> speaker_buffer_;
+  // Monitor clients (listen-only subscribers, see MonitorClient)
+  MonitorClient monitors_[MAX_MONITORS];
+  uint8_t max_monitors_{DEFAULT_MAX_MONITORS};
+  std::atomic<uint8_t> monitor_count_{0};  // Subscribed monitors - fan-out is skipped at 0
+  MonitorClient standby_;                  // Parked pooled HA link (never subscribed), see park_client_()
+
+  // Direct call state (server_task): we dialed client_ ourselves
+  bool outbound_call_{false};
+  bool awaiting_call_reply_{false};  // START sent to the callee, its PONG/RING not seen yet
+  std::atomic<int> dial_socket_{-1};  // Callee connect in progress, see service_dial_()
+  int dial_ha_socket_{-1};            // The link that sent DIAL (gets PONG or ERROR)
+  struct sockaddr_in dial_peer_addr_{};
+  uint32_t dial_started_ms_{0};
+  std::string dial_callee_;
+
+  // Datagram audio (per call, negotiated on START/ANSWER)
+  bool datagram_audio_{false};                // audio_transport: udp
+  int datagram_socket_{-1};                   // UDP INTERCOM_PORT, bound at startup
+  std::atomic<bool> datagram_active_{false};  // Current call sends/receives AUDIO over UDP
+  struct sockaddr_in datagram_peer_{};        // Written before datagram_active_ is set
+  std::atomic<int> wake_socket_{-1};          // Loopback UDP, see setup_wake_socket_()
+  uint16_t wake_port_{0};                     // Written before wake_socket_ is set
+  uint16_t datagram_tx_seq_{0};               // Owned by the active audio sender
+  uint32_t datagram_tx_timestamp_{0};
+  JitterBuffer jitter_;                       // server_task only
+  int16_t *plc_pcm_{nullptr};                 // Last PCM frame played, replayed (faded) on loss
+  size_t plc_pcm_len_{0};
+  PlayoutController playout_;                 // server_task arrivals, speaker_task playout
+
+  // DTX (per call, DTX flag on START/ANSWER or the callee's PONG/RING)
+  bool dtx_enabled_{false};                   // dtx: send ComfortNoiseFrames for quiet frames
+  std::atomic<bool> dtx_peer_{false};         // Peer plays comfort noise
+  audio_kernels::EnergyVad dtx_vad_;          // Active audio sender only (reset in prepare_call_)
+  audio_kernels::NoiseSource comfort_noise_;  // server_task only
+  int16_t *cn_pcm_{nullptr};                  // Comfort noise output (SAMPLES_PER_CHUNK)
+
+  // Latency probes (per call, LATENCY flag on START/ANSWER or the callee's PONG/RING)
+  std::atomic<bool> latency_peer_{false};     // Peer answers PROBE
+  uint32_t last_probe_ms_{0};                 // server_task only
+
+  // Buffers (audio arena, allocated once in setup() and never freed)
+  // SPSC rings (audio_kernels/spsc_ring.h): one writer and one reader each
+  std::unique_ptr<audio_kernels::SpscRing> mic_buffer_;      // mic callback → tx_task / server_task / encoder_task
+  std::unique_ptr<audio_kernels::SpscRing> speaker_buffer_;  // server_task → speaker_task
 
 
   // Pre-allocated frame buffers
-  uint8_t *tx_buffer_{nullptr};      // Used by server_task for control messages
   uint8_t *rx_buffer_{nullptr};      // Used by server_task for receiving
-  uint8_t *audio_tx_buffer_{nullptr}; // Used by tx_task for audio (no mutex needed)
-  SemaphoreHandle_t send_mutex_{nullptr};  // Protects tx_buffer_ during send
+  SemaphoreHandle_t send_mutex_{nullptr};  // Serializes send_message_() callers
 
   // Task handles
   TaskHandle_t server_task_handle_{nullptr};
@@ -336,6 +577,18 @@ class IntercomApi : public Component {
   std::atomic<bool> speaker_stop_requested_{false};
   SemaphoreHandle_t speaker_stopped_sem_{nullptr};  // Signaled when speaker has stopped
 
+  // Wakeup accounting: incremented by tasks on every return from ulTaskNotifyTake()
+  std::atomic<uint32_t> tx_wakeups_{0};
+  std::atomic<uint32_t> speaker_wakeups_{0};
+  std::atomic<uint32_t> server_wakeups_{0};  // server_task: every return from select()
+  uint32_t tx_wakeups_per_sec_{0};
+  uint32_t speaker_wakeups_per_sec_{0};
+  uint32_t server_wakeups_per_sec_{0};
+  uint32_t wakeups_sample_time_{0};
+
+  IntercomMetrics metrics_;
+  TaskHandle_t get_task_handle_(MetricsTask task) const;
+
   // Volume
   float volume_{1.0f};
 
@@ -371,27 +624,47 @@ class IntercomApi : public Component {
 
   // Mic configuration
   bool dc_offset_removal_{false}; // Enable for mics with DC bias (SPH0645)
-  int32_t dc_offset_{0};          // Running DC offset value
-
-  // Pre-allocated processing buffers (avoid stack VLAs on FreeRTOS tasks)
-  int16_t *mic_converted_{nullptr};     // Mic callback processing (MAX_SAMPLES = 512 samples)
-  int16_t *spk_ref_scaled_{nullptr};    // Speaker AEC ref scaling (AUDIO_CHUNK_SIZE*4/2 = 1024 samples)
+  audio_kernels::DcBlocker dc_blocker_;  // DC high-pass state (per call)
+
+  // Codec (per call)
+  std::atomic<AudioCodec> codec_{AudioCodec::PCM};
+  std::atomic<uint8_t> codec_frame_ms_{PCM_DEFAULT_FRAME_MS};
+  uint8_t frame_duration_ms_{PCM_DEFAULT_FRAME_MS};
+#ifdef USE_INTERCOM_OPUS
+  uint32_t opus_bitrate_{24000};
+  OpusFrameDecoder decoder_;            // Used by server_task only (handle_message_)
+  int16_t *dec_pcm_{nullptr};           // Decoder output (OPUS_MAX_FRAME_SAMPLES)
+  std::unique_ptr<audio_kernels::SpscRing> enc_buffer_;  // tx_task → encoder_task PCM (only with tx_task)
+  TaskHandle_t encoder_task_handle_{nullptr};
+  StaticTask_t encoder_task_tcb_;
+  StackType_t *encoder_task_stack_{nullptr};
+#endif
 
 #ifdef USE_ESP_AEC
   // AEC (Acoustic Echo Cancellation)
-  esp_aec::EspAec *aec_{nullptr};
+  AecProcessor *aec_{nullptr};
+  audio_kernels::AecOwner *aec_owner_{nullptr};  // Mutually exclusive with aec_ (codegen)
   bool aec_enabled_{false};
 
   // Speaker reference buffer for AEC (fed by speaker_task)
-  std::unique_ptr<RingBuffer> spk_ref_buffer_;
-  SemaphoreHandle_t spk_ref_mutex_{nullptr};
-
-  // AEC frame accumulation (frame_size = 512 samples = 32ms at 16kHz)
-  int aec_frame_samples_{0};
-  int16_t *aec_mic_{nullptr};   // Accumulated mic samples (frame_size)
+  // speaker_task writes, tx_task reads; delay changes are made by the reader (no lock)
+  std::unique_ptr<audio_kernels::SpscRing> spk_ref_buffer_;
+  std::atomic<bool> aec_ref_reset_{false};  // Set by reset_aec_buffers_(), served by tx_task
+
+  // AEC frames: tx_task reads one frame_size block from mic_buffer_ straight into aec_mic_
+  // (calls are framed to the AEC chunk, so nothing is carried over between frames)
+  int aec_frame_samples_{0};      // Current frame (follows AEC mode switches at frame boundaries)
+  int aec_max_frame_samples_{0};  // Buffers are sized for this
+  int16_t *aec_mic_{nullptr};   // Mic samples (frame_size)
   int16_t *aec_ref_{nullptr};   // Speaker reference samples (frame_size)
   int16_t *aec_out_{nullptr};   // AEC output samples (frame_size)
-  size_t aec_mic_fill_{0};      // Current fill level in aec_mic_
+
+  // Reference delay: padded by realign_aec_reference_(), moved by the estimate (both in tx_task)
+  bool aec_delay_estimation_{true};
+  size_t aec_ref_delay_bytes_{AEC_REF_DELAY_BYTES};
+  audio_kernels::DelayEstimator delay_estimator_;  // Captured by tx_task, computed in loop()
+  // DTX calls: tx_task skips aec_->process() while the reference and the mic are both quiet
+  audio_kernels::EnergyVad aec_gate_vad_;
 #endif
 
   // Internal triggers (TCP lifecycle)
@@ -536,6 +809,51 @@ class CallToggleAction : public Action<Ts...>, public Parented<IntercomApi> {
   void play(const Ts &...x) override { this->parent_->call_toggle(); }
 };
 
+template<typename... Ts>
+class DumpMetricsAction : public Action<Ts...>, public Parented<IntercomApi> {
+ public:
+  void play(const Ts &...x) override { this->parent_->dump_metrics(); }
+};
+
+// Diagnostic sensors for the pipeline metrics (sensor platform: intercom_api)
+class IntercomMetricsSensor : public PollingComponent, public Parented<IntercomApi> {
+ public:
+  void set_stage_sensor(MetricsStage stage, sensor::Sensor *s) { this->stage_sensors_[static_cast<size_t>(stage)] = s; }
+  void set_ring_high_sensor(MetricsRing ring, sensor::Sensor *s) { this->ring_high_sensors_[static_cast<size_t>(ring)] = s; }
+  void set_ring_low_sensor(MetricsRing ring, sensor::Sensor *s) { this->ring_low_sensors_[static_cast<size_t>(ring)] = s; }
+  void set_task_stack_sensor(MetricsTask task, sensor::Sensor *s) { this->task_stack_sensors_[static_cast<size_t>(task)] = s; }
+  void set_task_cpu_sensor(MetricsTask task, sensor::Sensor *s) { this->task_cpu_sensors_[static_cast<size_t>(task)] = s; }
+  void set_rx_dropped_sensor(sensor::Sensor *s) { this->rx_dropped_sensor_ = s; }
+  void set_tx_dropped_sensor(sensor::Sensor *s) { this->tx_dropped_sensor_ = s; }
+  void set_send_eagain_sensor(sensor::Sensor *s) { this->send_eagain_sensor_ = s; }
+  void set_rtt_sensor(sensor::Sensor *s) { this->rtt_sensor_ = s; }
+  void set_latency_sensor(sensor::Sensor *s) { this->latency_sensor_ = s; }
+
+  void update() override;
+  void dump_config() override;
+
+ protected:
+  static constexpr size_t NUM_STAGES = static_cast<size_t>(MetricsStage::COUNT);
+  static constexpr size_t NUM_RINGS = static_cast<size_t>(MetricsRing::COUNT);
+  static constexpr size_t NUM_TASKS = static_cast<size_t>(MetricsTask::COUNT);
+
+  sensor::Sensor *stage_sensors_[NUM_STAGES]{};     // Peak us per update interval
+  sensor::Sensor *ring_high_sensors_[NUM_RINGS]{};  // Bytes per update interval
+  sensor::Sensor *ring_low_sensors_[NUM_RINGS]{};
+  sensor::Sensor *task_stack_sensors_[NUM_TASKS]{};  // Free bytes
+  sensor::Sensor *task_cpu_sensors_[NUM_TASKS]{};    // % of one core over the interval
+  sensor::Sensor *rx_dropped_sensor_{nullptr};
+  sensor::Sensor *tx_dropped_sensor_{nullptr};
+  sensor::Sensor *send_eagain_sensor_{nullptr};
+  sensor::Sensor *rtt_sensor_{nullptr};      // Smoothed in-call round trip, ms
+  sensor::Sensor *latency_sensor_{nullptr};  // Estimated peer mic -> our speaker, ms
+  uint32_t last_latency_samples_{0};
+
+  // Previous run time snapshot for the CPU sensors
+  uint32_t last_run_time_us_[NUM_TASKS]{};
+  int64_t last_update_us_{0};
+};
+
 // === Switch platform classes with restore support ===
 
 // AEC switch (only available when USE_ESP_AEC is defined)
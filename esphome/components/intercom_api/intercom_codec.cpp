@@ -0,0 +1,170 @@
+#include "intercom_codec.h"
+
+#ifdef USE_ESP32
+#ifdef USE_INTERCOM_OPUS
+
+#include "esphome/core/log.h"
+
+#include <esp_audio_types.h>
+#include <esp_opus_dec.h>
+#include <esp_opus_enc.h>
+
+namespace esphome {
+namespace intercom_api {
+
+static const char *const TAG = "intercom_codec";
+
+static esp_opus_enc_frame_duration_t to_enc_duration(uint8_t frame_ms) {
+  switch (frame_ms) {
+    case 10: return ESP_OPUS_ENC_FRAME_DURATION_10_MS;
+    case 40: return ESP_OPUS_ENC_FRAME_DURATION_40_MS;
+    case 60: return ESP_OPUS_ENC_FRAME_DURATION_60_MS;
+    default: return ESP_OPUS_ENC_FRAME_DURATION_20_MS;
+  }
+}
+
+static esp_opus_dec_frame_duration_t to_dec_duration(uint8_t frame_ms) {
+  switch (frame_ms) {
+    case 10: return ESP_OPUS_DEC_FRAME_DURATION_10_MS;
+    case 40: return ESP_OPUS_DEC_FRAME_DURATION_40_MS;
+    case 60: return ESP_OPUS_DEC_FRAME_DURATION_60_MS;
+    default: return ESP_OPUS_DEC_FRAME_DURATION_20_MS;
+  }
+}
+
+// === Encoder ===
+
+bool OpusFrameEncoder::init(uint8_t frame_ms, uint32_t bitrate) {
+  this->deinit();
+
+  esp_opus_enc_config_t cfg = ESP_OPUS_ENC_CONFIG_DEFAULT();
+  cfg.sample_rate = SAMPLE_RATE;
+  cfg.channel = CHANNELS;
+  cfg.bits_per_sample = BITS_PER_SAMPLE;
+  cfg.bitrate = bitrate;
+  cfg.frame_duration = to_enc_duration(frame_ms);
+  cfg.application_mode = ESP_OPUS_ENC_APPLICATION_VOIP;
+  cfg.complexity = 0;  // Lowest CPU; speech at 16 kHz barely benefits from higher complexity
+  cfg.enable_fec = false;
+  cfg.enable_dtx = false;
+  cfg.enable_vbr = true;
+
+  esp_audio_err_t err = esp_opus_enc_open(&cfg, sizeof(cfg), &this->handle_);
+  if (err != ESP_AUDIO_ERR_OK || this->handle_ == nullptr) {
+    ESP_LOGE(TAG, "Opus encoder open failed: %d", err);
+    this->handle_ = nullptr;
+    return false;
+  }
+
+  int in_size = 0;
+  int out_size = 0;
+  esp_opus_enc_get_frame_size(this->handle_, &in_size, &out_size);
+  this->frame_ms_ = frame_ms;
+  this->frame_bytes_ = static_cast<size_t>(in_size);
+
+  ESP_LOGD(TAG, "Opus encoder: %u ms frames (%zu bytes PCM), %u bps", frame_ms, this->frame_bytes_,
+           (unsigned) bitrate);
+  return true;
+}
+
+void OpusFrameEncoder::deinit() {
+  if (this->handle_ != nullptr) {
+    esp_opus_enc_close(this->handle_);
+    this->handle_ = nullptr;
+  }
+  this->frame_ms_ = 0;
+  this->frame_bytes_ = 0;
+}
+
+size_t OpusFrameEncoder::encode(const int16_t *pcm, uint8_t *packet, size_t packet_size) {
+  if (this->handle_ == nullptr) return 0;
+
+  esp_audio_enc_in_frame_t in_frame{};
+  in_frame.buffer = reinterpret_cast<uint8_t *>(const_cast<int16_t *>(pcm));
+  in_frame.len = this->frame_bytes_;
+
+  esp_audio_enc_out_frame_t out_frame{};
+  out_frame.buffer = packet;
+  out_frame.len = packet_size;
+
+  if (esp_opus_enc_process(this->handle_, &in_frame, &out_frame) != ESP_AUDIO_ERR_OK) {
+    return 0;
+  }
+  return out_frame.encoded_bytes;
+}
+
+// === Decoder ===
+
+bool OpusFrameDecoder::init(uint8_t frame_ms) {
+  if (this->handle_ != nullptr && this->frame_ms_ == frame_ms) {
+    return true;  // Same framing - reuse the existing decoder
+  }
+  this->deinit();
+
+  esp_opus_dec_cfg_t cfg = ESP_OPUS_DEC_CONFIG_DEFAULT();
+  cfg.sample_rate = SAMPLE_RATE;
+  cfg.channel = CHANNELS;
+  cfg.frame_duration = to_dec_duration(frame_ms);
+  cfg.self_delimited = false;  // One packet per AUDIO message, length comes from MessageHeader
+
+  esp_audio_err_t err = esp_opus_dec_open(&cfg, sizeof(cfg), &this->handle_);
+  if (err != ESP_AUDIO_ERR_OK || this->handle_ == nullptr) {
+    ESP_LOGE(TAG, "Opus decoder open failed: %d", err);
+    this->handle_ = nullptr;
+    return false;
+  }
+
+  this->frame_ms_ = frame_ms;
+  ESP_LOGD(TAG, "Opus decoder: %u ms frames", frame_ms);
+  return true;
+}
+
+void OpusFrameDecoder::deinit() {
+  if (this->handle_ != nullptr) {
+    esp_opus_dec_close(this->handle_);
+    this->handle_ = nullptr;
+  }
+  this->frame_ms_ = 0;
+}
+
+size_t OpusFrameDecoder::decode(const uint8_t *packet, size_t len, int16_t *pcm, size_t pcm_samples) {
+  if (this->handle_ == nullptr || len == 0) return 0;
+
+  esp_audio_dec_in_raw_t raw{};
+  raw.buffer = const_cast<uint8_t *>(packet);
+  raw.len = len;
+
+  esp_audio_dec_out_frame_t out_frame{};
+  out_frame.buffer = reinterpret_cast<uint8_t *>(pcm);
+  out_frame.len = pcm_samples * sizeof(int16_t);
+
+  esp_audio_dec_info_t info{};
+  if (esp_opus_dec_decode(this->handle_, &raw, &out_frame, &info) != ESP_AUDIO_ERR_OK) {
+    return 0;
+  }
+  return out_frame.decoded_size;
+}
+
+size_t OpusFrameDecoder::conceal(int16_t *pcm, size_t pcm_samples) {
+  if (this->handle_ == nullptr) return 0;
+
+  // No packet: Opus PLC extrapolates from decoder state
+  esp_audio_dec_in_raw_t raw{};
+  raw.frame_recover = ESP_AUDIO_DEC_RECOVERY_PLC;
+
+  esp_audio_dec_out_frame_t out_frame{};
+  out_frame.buffer = reinterpret_cast<uint8_t *>(pcm);
+  out_frame.len = pcm_samples * sizeof(int16_t);
+
+  esp_audio_dec_info_t info{};
+  if (esp_opus_dec_decode(this->handle_, &raw, &out_frame, &info) != ESP_AUDIO_ERR_OK) {
+    return 0;
+  }
+  return out_frame.decoded_size;
+}
+
+}  // namespace intercom_api
+}  // namespace esphome
+
+#endif  // USE_INTERCOM_OPUS
+#endif  // USE_ESP32
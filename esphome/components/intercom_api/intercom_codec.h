@@ -0,0 +1,62 @@
+#pragma once
+
+#ifdef USE_ESP32
+#ifdef USE_INTERCOM_OPUS
+
+#include <cstddef>
+#include <cstdint>
+
+#include "intercom_protocol.h"
+
+namespace esphome {
+namespace intercom_api {
+
+// Thin wrappers around esp_audio_codec's Opus encoder/decoder (16 kHz mono 16-bit).
+// Each instance is owned by a single task: encoder by encoder_task, decoder by server_task.
+
+class OpusFrameEncoder {
+ public:
+  ~OpusFrameEncoder() { this->deinit(); }
+
+  // (Re)create the encoder for the given frame duration (10/20/40/60 ms)
+  bool init(uint8_t frame_ms, uint32_t bitrate);
+  void deinit();
+
+  bool is_initialized() const { return this->handle_ != nullptr; }
+  uint8_t get_frame_ms() const { return this->frame_ms_; }
+  size_t get_frame_bytes() const { return this->frame_bytes_; }
+
+  // Encode exactly get_frame_bytes() of PCM into one packet. Returns packet size, 0 on error.
+  size_t encode(const int16_t *pcm, uint8_t *packet, size_t packet_size);
+
+ protected:
+  void *handle_{nullptr};
+  uint8_t frame_ms_{0};
+  size_t frame_bytes_{0};
+};
+
+class OpusFrameDecoder {
+ public:
+  ~OpusFrameDecoder() { this->deinit(); }
+
+  bool init(uint8_t frame_ms);
+  void deinit();
+
+  bool is_initialized() const { return this->handle_ != nullptr; }
+  uint8_t get_frame_ms() const { return this->frame_ms_; }
+
+  // Decode one packet into at most pcm_samples samples. Returns PCM bytes, 0 on error.
+  size_t decode(const uint8_t *packet, size_t len, int16_t *pcm, size_t pcm_samples);
+  // Packet-loss concealment: synthesize one missing frame. Returns PCM bytes, 0 on error.
+  size_t conceal(int16_t *pcm, size_t pcm_samples);
+
+ protected:
+  void *handle_{nullptr};
+  uint8_t frame_ms_{0};
+};
+
+}  // namespace intercom_api
+}  // namespace esphome
+
+#endif  // USE_INTERCOM_OPUS
+#endif  // USE_ESP32
@@ -0,0 +1,157 @@
+#include "intercom_framing.h"
+
+#ifdef USE_ESP32
+
+#include <cerrno>
+#include <cstring>
+
+#include <lwip/sockets.h>
+
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace intercom_api {
+
+static const char *const TAG = "intercom_api";
+
+FrameSendResult send_frame(int socket, MessageType type, MessageFlags flags, const uint8_t *data, size_t len,
+                           bool drop_if_busy, uint32_t *eagain) {
+  if (socket < 0) {
+    errno = ENOTCONN;
+    return FrameSendResult::DROPPED;
+  }
+
+  MessageHeader header;
+  header.type = static_cast<uint8_t>(type);
+  header.flags = static_cast<uint8_t>(flags);
+  header.length = static_cast<uint16_t>(len);
+
+  // Gather send: header from the stack, payload from the caller's buffer.
+  // lwIP copies into its pbufs either way, so staging a contiguous frame was a wasted memcpy.
+  struct iovec iov[2];
+  iov[0].iov_base = &header;
+  iov[0].iov_len = HEADER_SIZE;
+  iov[1].iov_base = const_cast<uint8_t *>(data);
+  iov[1].iov_len = (data != nullptr) ? len : 0;
+
+  struct msghdr msg {};
+  msg.msg_iov = iov;
+  msg.msg_iovlen = (iov[1].iov_len > 0) ? 2 : 1;
+
+  const size_t total = HEADER_SIZE + iov[1].iov_len;
+  size_t offset = 0;
+  uint32_t start_ms = millis();
+
+  // Nothing sent: the stream is intact. Started: the rest of the frame can't be skipped.
+  auto fail = [&](int err, const char *why) {
+    if (offset == 0) {
+      errno = err;
+      return FrameSendResult::DROPPED;
+    }
+    ESP_LOGW(TAG, "Frame cut after %zu/%zu bytes (%s), closing the connection", offset, total, why);
+    shutdown(socket, SHUT_RDWR);
+    errno = err;
+    return FrameSendResult::CUT;
+  };
+
+  while (offset < total) {
+    ssize_t sent = sendmsg(socket, &msg, MSG_DONTWAIT);
+
+    if (sent > 0) {
+      offset += static_cast<size_t>(sent);
+      // Advance the iovecs past the bytes already sent
+      size_t consumed = static_cast<size_t>(sent);
+      while (consumed > 0 && msg.msg_iovlen > 0) {
+        if (consumed >= msg.msg_iov->iov_len) {
+          consumed -= msg.msg_iov->iov_len;
+          msg.msg_iov++;
+          msg.msg_iovlen--;
+        } else {
+          msg.msg_iov->iov_base = static_cast<uint8_t *>(msg.msg_iov->iov_base) + consumed;
+          msg.msg_iov->iov_len -= consumed;
+          consumed = 0;
+        }
+      }
+      continue;
+    }
+
+    if (sent == 0) {
+      return fail(ENOTCONN, "closed");
+    }
+
+    // sent < 0
+    const int err = errno;
+    if (err == EAGAIN || err == EWOULDBLOCK) {
+      if (eagain != nullptr) (*eagain)++;
+      // Audio frames are better dropped than delayed, as long as nothing went out yet
+      if (drop_if_busy && offset == 0) {
+        return FrameSendResult::DROPPED;
+      }
+      // Buffer full - wait briefly and retry
+      if (millis() - start_ms > (offset == 0 ? FRAME_SEND_RETRY_MS : FRAME_SEND_STALL_MS)) {
+        return fail(err, "send buffer stalled");
+      }
+      delay(1);
+      continue;
+    }
+    return fail(err, "send error");
+  }
+
+  return FrameSendResult::SENT;
+}
+
+// Reads exactly len bytes, waiting up to FRAME_RECEIVE_STALL_MS between two pieces
+static bool receive_exact(int socket, uint8_t *dst, size_t len, size_t &done) {
+  uint32_t retry = 0;
+  while (done < len && retry < FRAME_RECEIVE_STALL_MS) {
+    ssize_t received = recv(socket, dst + done, len - done, 0);
+    if (received > 0) {
+      done += static_cast<size_t>(received);
+      retry = 0;  // Reset on progress
+      continue;
+    }
+    if (received == 0) {
+      return false;  // Connection closed
+    }
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      retry++;
+      delay(1);
+      continue;
+    }
+    return false;  // Real error
+  }
+  return done == len;
+}
+
+bool receive_frame(int socket, MessageHeader &header, uint8_t *buffer, size_t buffer_size) {
+  // Header - partial reads are resumed (non-blocking socket)
+  size_t header_read = 0;
+  if (!receive_exact(socket, buffer, HEADER_SIZE, header_read)) {
+    if (header_read > 0) {
+      ESP_LOGW(TAG, "Header incomplete: %zu/%zu", header_read, HEADER_SIZE);
+    }
+    return false;
+  }
+
+  memcpy(&header, buffer, HEADER_SIZE);
+
+  if (header.length > buffer_size - HEADER_SIZE) {
+    ESP_LOGW(TAG, "Message too large: %d", header.length);
+    return false;
+  }
+
+  // Payload
+  size_t payload_read = 0;
+  if (header.length > 0 && !receive_exact(socket, buffer + HEADER_SIZE, header.length, payload_read)) {
+    ESP_LOGW(TAG, "Payload incomplete: %zu/%d", payload_read, header.length);
+    return false;
+  }
+
+  return true;
+}
+
+}  // namespace intercom_api
+}  // namespace esphome
+
+#endif  // USE_ESP32
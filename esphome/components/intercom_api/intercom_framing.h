@@ -0,0 +1,44 @@
+#pragma once
+
+#ifdef USE_ESP32
+
+#include <cstddef>
+#include <cstdint>
+
+#include "intercom_protocol.h"
+
+namespace esphome {
+namespace intercom_api {
+
+// TCP framing: a MessageHeader, then header.length payload bytes. Free functions so
+// every TCP link (call client, monitors, standby link) and the host harness share them.
+
+enum class FrameSendResult : uint8_t {
+  SENT = 0,  // Whole frame handed to the stack
+  DROPPED,   // Nothing went out (busy, retry budget, closed, error): the stream is intact
+  CUT,       // Part of the frame went out, the rest could not: the socket was shut down
+};
+
+// Gather send: header from the stack, payload from the caller's buffer, partial sends
+// resumed. Until the first byte goes out a failed send leaves the stream untouched: it
+// gives up after FRAME_SEND_RETRY_MS (drop_if_busy: at the first EAGAIN). Past that the
+// peer reads the rest of the frame as the next header, so a started frame is retried for
+// up to FRAME_SEND_STALL_MS and otherwise the socket is shut down - its owner sees it
+// close, and later sends on it fail without writing anything.
+// On DROPPED and CUT errno tells why (EAGAIN: busy or out of retry budget, ENOTCONN: closed).
+// eagain (optional) counts the EAGAIN retries.
+static constexpr uint32_t FRAME_SEND_RETRY_MS = 20;
+static constexpr uint32_t FRAME_SEND_STALL_MS = 500;
+FrameSendResult send_frame(int socket, MessageType type, MessageFlags flags, const uint8_t *data, size_t len,
+                           bool drop_if_busy, uint32_t *eagain = nullptr);
+
+// One whole frame into buffer: the header bytes first, the payload at buffer + HEADER_SIZE.
+// Waits up to FRAME_RECEIVE_STALL_MS without progress on a partial frame (non-blocking
+// socket); false on close, error, timeout or a payload larger than the buffer.
+static constexpr uint32_t FRAME_RECEIVE_STALL_MS = 300;
+bool receive_frame(int socket, MessageHeader &header, uint8_t *buffer, size_t buffer_size);
+
+}  // namespace intercom_api
+}  // namespace esphome
+
+#endif  // USE_ESP32
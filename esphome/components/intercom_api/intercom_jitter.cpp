@@ -0,0 +1,159 @@
+#include "intercom_jitter.h"
+
+#ifdef USE_ESP32
+
+#include <cstdlib>
+#include <cstring>
+
+namespace esphome {
+namespace intercom_api {
+
+void JitterBuffer::init(uint8_t *storage, size_t max_payload) {
+  this->storage_ = storage;
+  this->max_payload_ = max_payload;
+  this->reset(SAMPLES_PER_CHUNK);
+}
+
+void JitterBuffer::reset(uint32_t frame_samples) {
+  for (auto &slot : this->slots_) {
+    slot.used = false;
+  }
+  this->primed_ = false;
+  this->playing_ = false;
+  this->depth_ = 0;
+  this->concealed_run_ = 0;
+  this->frame_samples_ = frame_samples;
+  this->jitter_us_ = 0;
+  this->target_frames_ = JITTER_MIN_FRAMES;
+  this->lost_ = 0;
+  this->late_ = 0;
+  this->trimmed_ = 0;
+}
+
+void JitterBuffer::update_jitter_(uint32_t timestamp, int64_t now_us) {
+  // D = (arrival spacing) - (send spacing); J += (|D| - J) / 16
+  int64_t arrival_delta = now_us - this->last_arrival_us_;
+  int64_t send_delta = (static_cast<int64_t>(static_cast<int32_t>(timestamp - this->last_timestamp_)) * 1000000) /
+                       SAMPLE_RATE;
+  int64_t d = std::llabs(arrival_delta - send_delta);
+  if (d > 1000000) d = 1000000;  // One stall must not blow the estimate up for seconds
+  this->jitter_us_ += static_cast<uint32_t>(d) - ((this->jitter_us_ + 8) >> 4);
+
+  this->last_timestamp_ = timestamp;
+  this->last_arrival_us_ = now_us;
+
+  // Target depth: one frame plus three jitter deviations, rounded up
+  uint32_t frame_us = this->frame_us_();
+  uint32_t target = (frame_us + 3 * this->get_jitter_us() + frame_us - 1) / frame_us;
+  if (target < JITTER_MIN_FRAMES) target = JITTER_MIN_FRAMES;
+  if (target > JITTER_MAX_FRAMES) target = JITTER_MAX_FRAMES;
+  this->target_frames_ = static_cast<uint8_t>(target);
+}
+
+void JitterBuffer::push(uint16_t seq, uint32_t timestamp, uint8_t flags, const uint8_t *data, size_t len,
+                        int64_t now_us) {
+  if (this->storage_ == nullptr || len == 0 || len > this->max_payload_) return;
+
+  if (!this->primed_) {
+    this->primed_ = true;
+    this->next_seq_ = seq;
+    this->last_timestamp_ = timestamp;
+    this->last_arrival_us_ = now_us;
+  } else {
+    // Learn the frame duration from consecutive packets (PCM chunks, Opus 10-60 ms)
+    uint32_t ts_delta = timestamp - this->last_timestamp_;
+    if (static_cast<uint16_t>(seq - this->last_seq_) == 1 && ts_delta > 0 &&
+        ts_delta <= MAX_AUDIO_CHUNK / sizeof(int16_t)) {
+      this->frame_samples_ = ts_delta;
+    }
+    this->update_jitter_(timestamp, now_us);
+  }
+  this->last_seq_ = seq;
+
+  int16_t ahead = static_cast<int16_t>(seq - this->next_seq_);
+  if (ahead < 0) {
+    this->late_++;  // Already played or concealed
+    return;
+  }
+  if (ahead >= static_cast<int16_t>(JITTER_SLOTS)) {
+    // Peer restarted or a long outage - drop the window and rebuffer from this packet
+    for (auto &slot : this->slots_) {
+      slot.used = false;
+    }
+    this->depth_ = 0;
+    this->playing_ = false;
+    this->next_seq_ = seq;
+  }
+
+  size_t idx = seq % JITTER_SLOTS;
+  Slot &slot = this->slots_[idx];
+  if (slot.used && slot.seq == seq) return;  // Duplicate
+  if (!slot.used) this->depth_++;
+
+  memcpy(this->storage_ + idx * this->max_payload_, data, len);
+  slot.seq = seq;
+  slot.len = static_cast<uint16_t>(len);
+  slot.timestamp = timestamp;
+  slot.flags = flags;
+  slot.used = true;
+}
+
+JitterBuffer::PopResult JitterBuffer::pop(int64_t now_us, const uint8_t **data, size_t *len, uint8_t *flags) {
+  if (!this->primed_) return PopResult::EMPTY;
+
+  if (!this->playing_) {
+    if (this->depth_ < this->target_frames_) return PopResult::EMPTY;
+    this->playing_ = true;
+    this->concealed_run_ = 0;
+    this->next_playout_us_ = now_us;
+  }
+
+  if (now_us < this->next_playout_us_) return PopResult::EMPTY;
+
+  uint32_t frame_us = this->frame_us_();
+  // Don't race to catch up after server_task was held up - just restart the clock
+  if (now_us - this->next_playout_us_ > static_cast<int64_t>(frame_us) * JITTER_MAX_FRAMES) {
+    this->next_playout_us_ = now_us;
+  }
+  this->next_playout_us_ += frame_us;
+
+  // Deeper than the jitter needs: skip the oldest frame to pull latency back down
+  if (this->depth_ > this->target_frames_ + 1) {
+    Slot &old = this->slots_[this->next_seq_ % JITTER_SLOTS];
+    if (old.used && old.seq == this->next_seq_) {
+      old.used = false;
+      this->depth_--;
+    }
+    this->next_seq_++;
+    this->trimmed_++;
+  }
+
+  size_t idx = this->next_seq_ % JITTER_SLOTS;
+  Slot &slot = this->slots_[idx];
+  if (slot.used && slot.seq == this->next_seq_) {
+    slot.used = false;
+    this->depth_--;
+    this->next_seq_++;
+    this->concealed_run_ = 0;
+    *data = this->storage_ + idx * this->max_payload_;
+    *len = slot.len;
+    *flags = slot.flags;
+    return PopResult::FRAME;
+  }
+
+  if (this->depth_ == 0 && ++this->concealed_run_ > JITTER_MAX_CONCEAL) {
+    // Underrun: stop concealing, rebuffer and resync on the next datagram
+    this->playing_ = false;
+    this->primed_ = false;
+    return PopResult::EMPTY;
+  }
+
+  this->next_seq_++;
+  this->lost_++;
+  return PopResult::LOST;
+}
+
+}  // namespace intercom_api
+}  // namespace esphome
+
+#endif  // USE_ESP32
@@ -0,0 +1,91 @@
+#pragma once
+
+#ifdef USE_ESP32
+
+#include <cstddef>
+#include <cstdint>
+
+#include "intercom_protocol.h"
+
+namespace esphome {
+namespace intercom_api {
+
+// Adaptive jitter buffer for datagram audio (server_task only - no locking).
+//
+// Datagrams are slotted by sequence number, so reordering and duplicates are
+// absorbed. Playout starts once the buffer holds target_frames(); the target
+// follows the RFC 3550 interarrival jitter estimate (frame + 3 * jitter), and
+// excess depth is trimmed one frame at a time to keep latency down.
+class JitterBuffer {
+ public:
+  enum class PopResult : uint8_t {
+    EMPTY,  // Nothing due yet (buffering or waiting for the playout clock)
+    FRAME,  // Next frame in sequence order
+    LOST,   // Frame missing - caller should conceal one frame
+  };
+
+  // Bytes of slot storage for payloads up to max_payload
+  static constexpr size_t storage_size(size_t max_payload) { return JITTER_SLOTS * max_payload; }
+  // Use storage_size(max_payload) bytes of caller-owned storage (audio arena, PSRAM is fine:
+  // each slot is touched once per frame)
+  void init(uint8_t *storage, size_t max_payload);
+  // Forget all frames and restart buffering. frame_samples is the expected frame
+  // duration until timestamps tell otherwise.
+  void reset(uint32_t frame_samples);
+
+  // Insert one datagram payload (flags: DatagramHeader.flags). Late, duplicate or oversized
+  // frames are dropped.
+  void push(uint16_t seq, uint32_t timestamp, uint8_t flags, const uint8_t *data, size_t len, int64_t now_us);
+  // Pop the frame due at now_us. On FRAME, *data/*len point into the slot until the next push()
+  // and *flags is what the frame was pushed with.
+  PopResult pop(int64_t now_us, const uint8_t **data, size_t *len, uint8_t *flags);
+
+  uint8_t get_depth() const { return this->depth_; }
+  uint8_t get_target_frames() const { return this->target_frames_; }
+  uint32_t get_jitter_us() const { return this->jitter_us_ >> 4; }
+  uint32_t get_frame_samples() const { return this->frame_samples_; }
+  uint32_t get_lost() const { return this->lost_; }
+  uint32_t get_late() const { return this->late_; }
+  uint32_t get_trimmed() const { return this->trimmed_; }
+
+ protected:
+  struct Slot {
+    uint16_t seq;
+    uint16_t len;
+    uint32_t timestamp;
+    uint8_t flags;
+    bool used;
+  };
+
+  uint32_t frame_us_() const { return (this->frame_samples_ * 1000000ULL) / SAMPLE_RATE; }
+  void update_jitter_(uint32_t timestamp, int64_t now_us);
+
+  Slot slots_[JITTER_SLOTS]{};
+  uint8_t *storage_{nullptr};
+  size_t max_payload_{0};
+
+  bool primed_{false};      // First datagram seen since reset()
+  bool playing_{false};     // Playout clock running (false = buffering)
+  uint16_t next_seq_{0};    // Next sequence number to play
+  uint8_t depth_{0};        // Frames currently buffered
+  uint8_t concealed_run_{0};
+
+  uint32_t frame_samples_{SAMPLES_PER_CHUNK};
+  int64_t next_playout_us_{0};
+
+  // Interarrival jitter (RFC 3550 6.4.1), scaled by 16 to keep integer precision
+  uint32_t jitter_us_{0};
+  uint32_t last_timestamp_{0};
+  uint16_t last_seq_{0};
+  int64_t last_arrival_us_{0};
+  uint8_t target_frames_{JITTER_MIN_FRAMES};
+
+  uint32_t lost_{0};
+  uint32_t late_{0};
+  uint32_t trimmed_{0};
+};
+
+}  // namespace intercom_api
+}  // namespace esphome
+
+#endif  // USE_ESP32
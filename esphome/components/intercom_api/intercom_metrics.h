@@ -0,0 +1,138 @@
+#pragma once
+
+#ifdef USE_ESP32
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <esp_timer.h>
+
+namespace esphome {
+namespace intercom_api {
+
+// Audio pipeline metrics. Relaxed atomics only - written from the audio tasks,
+// read by IntercomMetricsSensor and dump_metrics(). Nothing here logs or locks,
+// so the counters stay on in production builds.
+
+// Execution time of one pipeline stage (single writer: the task running the stage)
+struct StageTimer {
+  std::atomic<uint32_t> last_us{0};
+  std::atomic<uint32_t> peak_us{0};   // Since the last take_peak()
+  std::atomic<uint32_t> total_us{0};  // Wraps - readers diff two snapshots
+  std::atomic<uint32_t> count{0};
+
+  void record(uint32_t us) {
+    this->last_us.store(us, std::memory_order_relaxed);
+    if (us > this->peak_us.load(std::memory_order_relaxed)) {
+      this->peak_us.store(us, std::memory_order_relaxed);
+    }
+    this->total_us.fetch_add(us, std::memory_order_relaxed);
+    this->count.fetch_add(1, std::memory_order_relaxed);
+  }
+  uint32_t take_peak() { return this->peak_us.exchange(0, std::memory_order_relaxed); }
+};
+
+// Times the enclosing scope into a StageTimer (one esp_timer read on each side)
+class ScopedStage {
+ public:
+  explicit ScopedStage(StageTimer &timer) : timer_(timer), start_us_(esp_timer_get_time()) {}
+  ~ScopedStage() { this->timer_.record(static_cast<uint32_t>(esp_timer_get_time() - this->start_us_)); }
+  ScopedStage(const ScopedStage &) = delete;
+  ScopedStage &operator=(const ScopedStage &) = delete;
+
+ protected:
+  StageTimer &timer_;
+  int64_t start_us_;
+};
+
+// Ring buffer fill watermarks in bytes, sampled where a task already calls available()
+struct FillWatermark {
+  std::atomic<uint32_t> high{0};
+  std::atomic<uint32_t> low{UINT32_MAX};
+
+  void sample(size_t fill) {
+    uint32_t f = static_cast<uint32_t>(fill);
+    if (f > this->high.load(std::memory_order_relaxed)) this->high.store(f, std::memory_order_relaxed);
+    if (f < this->low.load(std::memory_order_relaxed)) this->low.store(f, std::memory_order_relaxed);
+  }
+  // Watermarks since the last take(); false if the ring was not sampled in that window
+  bool take(uint32_t &high_out, uint32_t &low_out) {
+    high_out = this->high.exchange(0, std::memory_order_relaxed);
+    low_out = this->low.exchange(UINT32_MAX, std::memory_order_relaxed);
+    return low_out != UINT32_MAX;
+  }
+};
+
+// In-call latency from PROBE_ECHO (server_task writes). RTT is smoothed like TCP's SRTT
+// (1/8 per echo); the one-way estimates add half of it to the delays each side reports
+// buffered. I2S DMA and codec chip latency are not part of either side's report.
+struct LatencyStats {
+  std::atomic<uint32_t> rtt_us{0};         // Smoothed round trip, 0 = no echo this call
+  std::atomic<uint32_t> rx_latency_ms{0};  // Peer mic -> our speaker (mouth to ear, this end listening)
+  std::atomic<uint32_t> tx_latency_ms{0};  // Our mic -> peer speaker
+  std::atomic<uint32_t> samples{0};        // Echoes since reset()
+
+  void reset() {
+    this->rtt_us.store(0, std::memory_order_relaxed);
+    this->rx_latency_ms.store(0, std::memory_order_relaxed);
+    this->tx_latency_ms.store(0, std::memory_order_relaxed);
+    this->samples.store(0, std::memory_order_relaxed);
+  }
+  void record(uint32_t rtt_sample_us, uint32_t capture_ms, uint32_t playout_ms, uint32_t peer_capture_ms,
+              uint32_t peer_playout_ms) {
+    uint32_t srtt = this->rtt_us.load(std::memory_order_relaxed);
+    srtt = srtt == 0 ? rtt_sample_us : srtt - srtt / 8 + rtt_sample_us / 8;
+    const uint32_t one_way_ms = srtt / 2000;
+    this->rtt_us.store(srtt, std::memory_order_relaxed);
+    this->rx_latency_ms.store(peer_capture_ms + one_way_ms + playout_ms, std::memory_order_relaxed);
+    this->tx_latency_ms.store(capture_ms + one_way_ms + peer_playout_ms, std::memory_order_relaxed);
+    this->samples.fetch_add(1, std::memory_order_relaxed);
+  }
+};
+
+enum class MetricsStage : uint8_t {
+  AEC = 0,  // aec_->process() in tx_task
+  SEND,     // send_audio_frame_(), including the send_mutex_ wait
+  ENCODE,   // Opus encode in encoder_task
+  DECODE,   // Opus decode in play_rx_audio_()
+  PLAY,     // speaker_->play()
+  COUNT,
+};
+
+enum class MetricsRing : uint8_t {
+  MIC = 0,  // mic_buffer_ (sampled by its consumer)
+  SPEAKER,  // speaker_buffer_ (sampled by speaker_task)
+  SPK_REF,  // spk_ref_buffer_ (sampled by tx_task before AEC)
+  COUNT,
+};
+
+enum class MetricsTask : uint8_t {
+  SERVER = 0,
+  TX,
+  SPEAKER,
+  ENCODER,
+  COUNT,
+};
+
+struct IntercomMetrics {
+  StageTimer stages[static_cast<size_t>(MetricsStage::COUNT)];
+  FillWatermark rings[static_cast<size_t>(MetricsRing::COUNT)];
+
+  std::atomic<uint32_t> rx_dropped_bytes{0};   // speaker_buffer_ full in write_speaker_()
+  std::atomic<uint32_t> tx_dropped_frames{0};  // send_audio_frame_() gave up on a frame
+  std::atomic<uint32_t> send_eagain{0};        // EAGAIN/EWOULDBLOCK from sendmsg()
+  std::atomic<uint32_t> monitor_dropped_frames{0};  // Fan-out frames a monitor client could not take
+  std::atomic<uint32_t> dtx_tx_frames{0};      // Quiet frames sent as a ComfortNoiseFrame
+  std::atomic<uint32_t> dtx_rx_frames{0};      // ComfortNoiseFrames played as comfort noise
+  std::atomic<uint32_t> aec_skipped_frames{0}; // tx_task frames sent without aec_->process() (nobody talking)
+  LatencyStats latency;                        // Current call, reset in set_streaming_()
+
+  StageTimer &stage(MetricsStage s) { return this->stages[static_cast<size_t>(s)]; }
+  FillWatermark &ring(MetricsRing r) { return this->rings[static_cast<size_t>(r)]; }
+};
+
+}  // namespace intercom_api
+}  // namespace esphome
+
+#endif  // USE_ESP32
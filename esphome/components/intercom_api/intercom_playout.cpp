@@ -0,0 +1,99 @@
+#include "intercom_playout.h"
+
+#ifdef USE_ESP32
+
+#include <cstdlib>
+
+namespace esphome {
+namespace intercom_api {
+
+void PlayoutController::configure(uint32_t min_ms, uint32_t max_ms) {
+  this->min_ms_ = min_ms;
+  this->max_ms_ = max_ms > min_ms ? max_ms : min_ms;
+}
+
+void PlayoutController::reset() {
+  this->last_arrival_us_ = 0;
+  this->last_duration_us_ = 0;
+  this->jitter_us_.store(0, std::memory_order_relaxed);
+  this->depth_avg_x8_ = 0;
+  this->depth_ms_.store(0, std::memory_order_relaxed);
+  this->underruns_.store(0, std::memory_order_relaxed);
+  this->overflows_.store(0, std::memory_order_relaxed);
+}
+
+void PlayoutController::on_arrival(size_t bytes, int64_t now_us) {
+  uint32_t duration_us = static_cast<uint32_t>((bytes / sizeof(int16_t)) * 1000000ULL / SAMPLE_RATE);
+
+  if (this->last_arrival_us_ != 0) {
+    // D = arrival spacing - media duration of the previous block; J += (|D| - J) / 16
+    int64_t d = std::llabs((now_us - this->last_arrival_us_) - static_cast<int64_t>(this->last_duration_us_));
+    if (d > 1000000) d = 1000000;  // One stall must not blow the estimate up for seconds
+    uint32_t j = this->jitter_us_.load(std::memory_order_relaxed);
+    j += static_cast<uint32_t>(d) - ((j + 8) >> 4);
+    this->jitter_us_.store(j, std::memory_order_relaxed);
+  }
+
+  this->last_arrival_us_ = now_us;
+  this->last_duration_us_ = duration_us;
+}
+
+uint32_t PlayoutController::get_target_ms() const {
+  // One chunk of margin plus three jitter deviations
+  uint32_t target = CHUNK_DURATION_MS + 3 * this->get_jitter_ms();
+  if (target < this->min_ms_) target = this->min_ms_;
+  if (target > this->max_ms_) target = this->max_ms_;
+  return target;
+}
+
+int32_t PlayoutController::update(size_t depth_bytes) {
+  uint32_t depth_ms = static_cast<uint32_t>(depth_bytes / ((SAMPLE_RATE / 1000) * sizeof(int16_t)));
+
+  // Smooth over ~8 chunks so one burst doesn't trigger a correction
+  if (this->depth_avg_x8_ == 0) {
+    this->depth_avg_x8_ = depth_ms << 3;
+  } else {
+    this->depth_avg_x8_ += depth_ms - (this->depth_avg_x8_ >> 3);
+  }
+  uint32_t avg_ms = this->depth_avg_x8_ >> 3;
+  this->depth_ms_.store(avg_ms, std::memory_order_relaxed);
+
+  int32_t error_ms = static_cast<int32_t>(avg_ms) - static_cast<int32_t>(this->get_target_ms());
+  if (std::abs(error_ms) <= static_cast<int32_t>(PLAYOUT_HYSTERESIS_MS)) {
+    return 0;
+  }
+
+  // Proportional, capped: at most PLAYOUT_MAX_STRETCH_SAMPLES per chunk (~1.5%, inaudible on speech)
+  int32_t adjust = error_ms / 4;
+  if (adjust == 0) adjust = error_ms > 0 ? 1 : -1;
+  if (adjust > static_cast<int32_t>(PLAYOUT_MAX_STRETCH_SAMPLES)) adjust = PLAYOUT_MAX_STRETCH_SAMPLES;
+  if (adjust < -static_cast<int32_t>(PLAYOUT_MAX_STRETCH_SAMPLES)) adjust = -static_cast<int32_t>(PLAYOUT_MAX_STRETCH_SAMPLES);
+  return -adjust;  // Too deep -> fewer output samples
+}
+
+void PlayoutController::stretch(const int16_t *in, size_t in_n, int16_t *out, size_t out_n) {
+  if (out_n == 0 || in_n == 0) return;
+  if (out_n == 1 || in_n == 1) {
+    for (size_t i = 0; i < out_n; i++) out[i] = in[0];
+    return;
+  }
+
+  // Map out[0]..out[out_n-1] onto in[0]..in[in_n-1] so chunk boundaries stay continuous
+  // Q16 fixed-point position step
+  const uint32_t step = static_cast<uint32_t>(((in_n - 1) << 16) / (out_n - 1));
+  uint32_t pos = 0;
+  for (size_t i = 0; i < out_n - 1; i++) {
+    size_t idx = pos >> 16;
+    int32_t frac = static_cast<int32_t>(pos & 0xFFFF);
+    int32_t a = in[idx];
+    int32_t b = in[idx + 1 < in_n ? idx + 1 : idx];
+    out[i] = static_cast<int16_t>(a + (((b - a) * frac) >> 16));
+    pos += step;
+  }
+  out[out_n - 1] = in[in_n - 1];
+}
+
+}  // namespace intercom_api
+}  // namespace esphome
+
+#endif  // USE_ESP32
@@ -0,0 +1,69 @@
+#pragma once
+
+#ifdef USE_ESP32
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "intercom_protocol.h"
+
+namespace esphome {
+namespace intercom_api {
+
+// Playout controller for speaker_buffer_ (speaker_task, AEC mode).
+//
+// The writer (server_task) reports arrivals, from which an interarrival jitter
+// estimate sets the target depth within [min_ms, max_ms]. The reader (speaker_task)
+// asks for a per-chunk adjustment: a few samples of time-stretch (buffer too shallow)
+// or compression (too deep), so depth converges on the target without drops.
+class PlayoutController {
+ public:
+  void configure(uint32_t min_ms, uint32_t max_ms);
+  // New call: forget depth/jitter history, target back to min_ms
+  void reset();
+
+  // Writer side (server_task): one block of PCM was written to speaker_buffer_
+  void on_arrival(size_t bytes, int64_t now_us);
+  void count_overflow() { this->overflows_.fetch_add(1, std::memory_order_relaxed); }
+
+  // Reader side (speaker_task): depth before playing one chunk.
+  // Returns samples to add (+, stretch) or remove (-, compress) for that chunk.
+  int32_t update(size_t depth_bytes);
+  void count_underrun() { this->underruns_.fetch_add(1, std::memory_order_relaxed); }
+
+  size_t get_target_bytes() const { return ms_to_bytes(this->get_target_ms()); }
+  size_t get_max_bytes() const { return ms_to_bytes(this->max_ms_); }
+
+  uint32_t get_target_ms() const;
+  uint32_t get_depth_ms() const { return this->depth_ms_.load(std::memory_order_relaxed); }
+  uint32_t get_jitter_ms() const { return (this->jitter_us_.load(std::memory_order_relaxed) >> 4) / 1000; }
+  uint32_t get_underruns() const { return this->underruns_.load(std::memory_order_relaxed); }
+  uint32_t get_overflows() const { return this->overflows_.load(std::memory_order_relaxed); }
+
+  // Linear-interpolation resample of one chunk to out_n samples (out_n within a few % of in_n)
+  static void stretch(const int16_t *in, size_t in_n, int16_t *out, size_t out_n);
+
+ protected:
+  static size_t ms_to_bytes(uint32_t ms) { return (SAMPLE_RATE / 1000) * ms * sizeof(int16_t); }
+
+  uint32_t min_ms_{PLAYOUT_DEFAULT_MIN_MS};
+  uint32_t max_ms_{PLAYOUT_DEFAULT_MAX_MS};
+
+  // Writer side (server_task). Jitter is RFC 3550 style, scaled by 16.
+  int64_t last_arrival_us_{0};
+  uint32_t last_duration_us_{0};
+  std::atomic<uint32_t> jitter_us_{0};
+
+  // Reader side (speaker_task). Smoothed depth, scaled by 8.
+  uint32_t depth_avg_x8_{0};
+  std::atomic<uint32_t> depth_ms_{0};
+
+  std::atomic<uint32_t> underruns_{0};
+  std::atomic<uint32_t> overflows_{0};
+};
+
+}  // namespace intercom_api
+}  // namespace esphome
+
+#endif  // USE_ESP32
@@ -1,11 +1,12 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 namespace esphome {
 namespace intercom_api {
 
-// TCP port for audio streaming
+// TCP port for audio streaming (datagram audio uses the same number over UDP)
 static constexpr uint16_t INTERCOM_PORT = 6054;
 
 // Message types
@@ -18,6 +19,9 @@ enum class MessageType : uint8_t {
   ERROR = 0x06,   // Error response
   RING = 0x07,    // ESP→HA: auto_answer OFF, waiting for local answer
   ANSWER = 0x08,  // ESP→HA: call answered locally, start stream
+  DIAL = 0x09,    // HA→ESP: call a peer ESP directly (payload: DialRequest + callee name)
+  PROBE = 0x0A,       // In-call latency probe (payload: LatencyProbe), answered with PROBE_ECHO
+  PROBE_ECHO = 0x0B,  // Probe answer: the probe's origin_us, the responder's own delays
 };
 
 // Message flags
@@ -25,14 +29,95 @@ enum class MessageFlags : uint8_t {
   NONE = 0x00,
   END = 0x01,      // Last packet of stream
   NO_RING = 0x02,  // START flag: skip ringing, start streaming directly (for caller in bridge)
+  CODEC = 0x04,    // START/ANSWER: payload ends with CodecOffer; PONG/RING reply: payload is CodecParams
+  DATAGRAM = 0x08, // START/ANSWER: payload ends with DatagramOffer; PONG/RING reply: DatagramParams follows
+  MONITOR = 0x10,  // START flag: listen-only subscriber, receives the call's mic AUDIO without joining the call
+  DTX = 0x20,      // START/ANSWER/PONG/RING: peer plays comfort noise; AUDIO: payload is a ComfortNoiseFrame
+  LATENCY = 0x40,  // START/ANSWER/PONG/RING: peer answers PROBE during the call
+  STANDBY = 0x80,  // PING/PONG: keep this connection between calls (HA connection pool), see standby_
 };
 
+// Audio codecs - negotiated per call, PCM is always the fallback (older peers never set CODEC)
+enum class AudioCodec : uint8_t {
+  PCM = 0x00,
+  OPUS = 0x01,
+};
+
+inline const char *audio_codec_to_str(AudioCodec codec) {
+  switch (codec) {
+    case AudioCodec::PCM: return "pcm";
+    case AudioCodec::OPUS: return "opus";
+    default: return "unknown";
+  }
+}
+
+static constexpr uint8_t CODEC_MASK_PCM = 1 << static_cast<uint8_t>(AudioCodec::PCM);
+static constexpr uint8_t CODEC_MASK_OPUS = 1 << static_cast<uint8_t>(AudioCodec::OPUS);
+
+// Codec offer (HA→ESP): last bytes of START/ANSWER payload, after the NUL-terminated caller name.
+// Older firmware stops reading the caller name at the NUL and never sees the offer.
+// With Opus in the mask frame_ms is the preferred Opus frame; a PCM-only offer carries the
+// shortest PCM frame the peer handles, and the callee answers with the longer of it and its own.
+struct __attribute__((packed)) CodecOffer {
+  uint8_t codec_mask;  // CODEC_MASK_* bits the peer can handle
+  uint8_t frame_ms;    // Preferred frame duration (0 = no preference)
+};
+
+// Codec selection (ESP→HA): payload of the PONG/RING that answers an offer
+struct __attribute__((packed)) CodecParams {
+  uint8_t codec;     // AudioCodec
+  uint8_t frame_ms;  // Frame duration of AUDIO payloads
+};
+
+// Datagram audio offer (HA→ESP): after CodecOffer (if any) at the end of START/ANSWER payload
+struct __attribute__((packed)) DatagramOffer {
+  uint16_t port;  // Peer's UDP port for AUDIO datagrams (little-endian)
+};
+
+// Datagram audio accepted (ESP→HA): after CodecParams (if any) in the PONG/RING reply
+struct __attribute__((packed)) DatagramParams {
+  uint16_t port;  // ESP's UDP port (INTERCOM_PORT)
+};
+
+// Silence descriptor: sent in place of an AUDIO payload while the sender's mic is quiet
+// (DTX flag on the AUDIO header). Only sent to a peer that offered or echoed DTX for the
+// call; the receiver fills `samples` with noise at `level` instead of playing nothing.
+struct __attribute__((packed)) ComfortNoiseFrame {
+  uint8_t level;     // Sender's noise floor, -dBFS (0 = full scale, 90+ = digital silence)
+  uint16_t samples;  // Audio the frame replaces, 16 kHz samples (little-endian)
+};
+
+// Latency probe (PROBE / PROBE_ECHO, both directions, only to a peer that offered or echoed
+// LATENCY). The echo returns origin_us untouched, so the prober's RTT needs no clock sync;
+// both messages carry the sender's own buffered delays, added to RTT/2 for a one-way estimate.
+struct __attribute__((packed)) LatencyProbe {
+  uint32_t origin_us;   // Prober's clock when sent (µs, wraps), little-endian
+  uint16_t capture_ms;  // Sender's mic to network: frame being filled + queued mic audio
+  uint16_t playout_ms;  // Sender's network to speaker: jitter buffer + speaker ring
+};
+
+// Direct call request (HA→ESP): the ESP opens the call to the callee itself, HA only signals.
+// Reply: PONG once the peer connection is up, ERROR UNREACHABLE when HA should relay instead.
+struct __attribute__((packed)) DialRequest {
+  uint8_t ipv4[4];  // Callee address, network order
+  uint16_t port;    // Callee TCP port (little-endian), 0 = INTERCOM_PORT
+};
+
+// Total size of the offers selected by flags at the end of a START/ANSWER payload
+inline size_t call_offer_size(uint8_t flags) {
+  size_t size = 0;
+  if (flags & static_cast<uint8_t>(MessageFlags::CODEC)) size += sizeof(CodecOffer);
+  if (flags & static_cast<uint8_t>(MessageFlags::DATAGRAM)) size += sizeof(DatagramOffer);
+  return size;
+}
+
 // Error codes
 enum class ErrorCode : uint8_t {
   OK = 0x00,
   BUSY = 0x01,           // Already streaming with another client
   INVALID_MSG = 0x02,    // Invalid message format
   NOT_READY = 0x03,      // Component not ready
+  UNREACHABLE = 0x04,    // DIAL: callee not reachable directly
   INTERNAL = 0xFF,       // Internal error
 };
 
@@ -40,9 +125,19 @@ enum class ErrorCode : uint8_t {
 static constexpr uint32_t SAMPLE_RATE = 16000;
 static constexpr uint8_t BITS_PER_SAMPLE = 16;
 static constexpr uint8_t CHANNELS = 1;
-static constexpr size_t AUDIO_CHUNK_SIZE = 1024;     // bytes per chunk (32ms @ 16kHz mono 16-bit)
+static constexpr size_t AUDIO_CHUNK_SIZE = 1024;     // Largest PCM frame (32ms @ 16kHz mono 16-bit)
 static constexpr size_t SAMPLES_PER_CHUNK = 512;     // 1024 bytes / 2 bytes per sample
-static constexpr uint32_t CHUNK_DURATION_MS = 32;    // 512 samples at 16kHz — matches AEC frame
+static constexpr uint32_t CHUNK_DURATION_MS = 32;    // 512 samples at 16kHz — sr_low_cost AEC frame
+static constexpr size_t BYTES_PER_MS = (SAMPLE_RATE / 1000) * sizeof(int16_t);
+
+// PCM framing: negotiated per call (CodecOffer/CodecParams.frame_ms), so the duplex frame,
+// mic_buffer_ reads, TX frames and the HA relay all move the same block of audio. Peers that
+// negotiate nothing get the device's own frame (frame_duration, or the AEC chunk).
+static constexpr uint8_t PCM_DEFAULT_FRAME_MS = CHUNK_DURATION_MS;
+
+inline bool is_valid_pcm_frame_ms(uint32_t ms) {
+  return ms == 10 || ms == 16 || ms == 20 || ms == 32;
+}
 
 // Protocol header
 struct __attribute__((packed)) MessageHeader {
@@ -53,24 +148,101 @@ struct __attribute__((packed)) MessageHeader {
 
 static constexpr size_t HEADER_SIZE = sizeof(MessageHeader);
 static constexpr size_t MAX_AUDIO_CHUNK = 2048;  // Browser may send larger chunks
+
+// Opus framing (one Opus packet per AUDIO message)
+static constexpr uint8_t OPUS_DEFAULT_FRAME_MS = 20;
+static constexpr uint8_t OPUS_MAX_FRAME_MS = 60;
+static constexpr size_t OPUS_MAX_FRAME_SAMPLES = (SAMPLE_RATE * OPUS_MAX_FRAME_MS) / 1000;  // 960 samples
+static constexpr size_t OPUS_MAX_PACKET = 512;  // Far above 64 kbit/s @ 60 ms (480 B)
+
+inline bool is_valid_opus_frame_ms(uint8_t ms) {
+  return ms == 10 || ms == 20 || ms == 40 || ms == 60;
+}
 static constexpr size_t MAX_MESSAGE_SIZE = HEADER_SIZE + MAX_AUDIO_CHUNK + 64;
 
+// Datagram audio: one AUDIO frame per UDP packet, signalling stays on TCP
+struct __attribute__((packed)) DatagramHeader {
+  uint8_t type;        // MessageType::AUDIO
+  uint8_t flags;       // MessageFlags (NONE, or DTX for a ComfortNoiseFrame)
+  uint16_t seq;        // +1 per datagram, wraps
+  uint32_t timestamp;  // Sample clock of the first sample (16 kHz), wraps
+};
+
+static constexpr size_t DATAGRAM_HEADER_SIZE = sizeof(DatagramHeader);
+static constexpr size_t MAX_DATAGRAM_PAYLOAD = AUDIO_CHUNK_SIZE;  // PCM chunk or Opus packet, below the Wi-Fi MTU
+
+// Jitter buffer (datagram receive path)
+static constexpr size_t JITTER_SLOTS = 16;        // Reorder window, in frames
+static constexpr uint8_t JITTER_MIN_FRAMES = 1;   // Playout depth bounds - target follows measured jitter
+static constexpr uint8_t JITTER_MAX_FRAMES = 8;
+static constexpr uint8_t JITTER_MAX_CONCEAL = 3;  // Concealed frames on underrun before rebuffering
+
+// DTX (dtx: true, peer offered DTX): quiet mic frames go out as a ComfortNoiseFrame.
+// The VAD holds speech for a hangover so word endings are not clipped, and the noise
+// floor it reports sets the receiver's comfort noise level.
+static constexpr uint32_t DTX_HANGOVER_MS = 240;
+static constexpr uint8_t DTX_SILENCE_LEVEL = 90;  // ComfortNoiseFrame.level at or above this plays zeros
+static constexpr int32_t DTX_REF_QUIET_PEAK = 64;  // Reference peak below this (~-54 dBFS): nothing playing
+
 // Buffer sizes
-static constexpr size_t RX_BUFFER_SIZE = 8192;       // ~256ms - fits 4 browser chunks
+static constexpr size_t RX_BUFFER_SIZE = 8192;       // ~256ms capacity - playout depth is set by PlayoutController
 static constexpr size_t TX_BUFFER_SIZE = 4096;       // ~128ms of audio (4 chunks @ 32ms)
 
+// Playout (speaker_task): target depth follows measured jitter within [min, max]
+static constexpr uint32_t PLAYOUT_DEFAULT_MIN_MS = 40;
+static constexpr uint32_t PLAYOUT_DEFAULT_MAX_MS = 120;
+static constexpr uint32_t PLAYOUT_HYSTERESIS_MS = 8;        // No correction within +/- this of the target
+static constexpr uint32_t PLAYOUT_MAX_STRETCH_SAMPLES = 8;  // Per 512-sample chunk (~1.5%)
+static constexpr uint32_t PLAYOUT_WARMUP_MAX_MS = 300;      // Give up waiting for the speaker to report running
+
 // AEC reference delay: compensate for I2S DMA latency + acoustic path
 // The mic captures echo from audio played ~60-100ms ago, but reference is "fresh".
 // We delay the reference so it aligns with when the echo appears in mic.
 // DMA latency: ~64ms typical (depends on buffer count/size)
 // Acoustic delay: ~5ms (room dependent)
 // Total: ~70ms, we use 80ms for safety margin
+// With delay estimation this is only the starting point of the first call.
 static constexpr size_t AEC_REF_DELAY_MS = 80;
 static constexpr size_t AEC_REF_DELAY_SAMPLES = (SAMPLE_RATE * AEC_REF_DELAY_MS) / 1000;  // 1280 samples
 static constexpr size_t AEC_REF_DELAY_BYTES = AEC_REF_DELAY_SAMPLES * sizeof(int16_t);   // 2560 bytes
 
+// AEC reference delay estimation (audio_kernels::DelayEstimator): at the start of each
+// call's playback, a 256ms mic/reference window is correlated over +-64ms around the
+// current delay in loop(), 16 lags per iteration, and the reference ring is moved to it.
+static constexpr uint32_t AEC_DELAY_WINDOW_MS = 256;
+static constexpr uint32_t AEC_DELAY_SEARCH_MS = 64;
+static constexpr size_t AEC_DELAY_SEARCH_BYTES = (SAMPLE_RATE * AEC_DELAY_SEARCH_MS) / 1000 * sizeof(int16_t);
+static constexpr size_t AEC_DELAY_LAGS_PER_LOOP = 16;
+
 // Timeouts
 static constexpr uint32_t PING_INTERVAL_MS = 5000;
+// In-call latency probes (PING stays off while streaming)
+static constexpr uint32_t PROBE_INTERVAL_MS = 2500;
+static constexpr uint32_t PROBE_MAX_RTT_US = 5000000;  // Older echoes (previous call, stalled link) are dropped
+
+// Monitor clients (START with MessageFlags::MONITOR), served next to the call client.
+// Monitors get every mic AUDIO frame of the call over TCP; their AUDIO is ignored.
+static constexpr size_t MAX_MONITORS = 4;
+static constexpr uint8_t DEFAULT_MAX_MONITORS = 2;
+static constexpr uint32_t MONITOR_START_TIMEOUT_MS = 5000;   // Connected but no START yet - free the slot
+static constexpr uint32_t MONITOR_MAX_DROPPED_FRAMES = 64;   // ~2 s of consecutive drops - not keeping up
+
+// Standby link (PING with MessageFlags::STANDBY): HA's pooled connection, parked between calls.
+// HA pings every 5 s, so a standby link that stays silent this long is dead.
+static constexpr uint32_t STANDBY_TIMEOUT_MS = PING_INTERVAL_MS * 3;
+
+// Direct ESP↔ESP calls: outbound connect to the callee (blocks server_task, no call audio yet)
+static constexpr uint32_t DIAL_CONNECT_TIMEOUT_MS = 1500;
+
+// Audio task wakeups: tx_task/speaker_task block on task notifications and are woken
+// by the producer once a full chunk is buffered. The timeouts are only a safety net.
+static constexpr uint32_t TASK_SLEEP_WAIT_MS = 10000;                 // No call: woken by set_active_
+static constexpr uint32_t TASK_IDLE_WAIT_MS = 100;                    // Call not streaming: woken by set_streaming_
+static constexpr uint32_t TASK_DATA_WAIT_MS = CHUNK_DURATION_MS * 2;  // Active: waiting for the next chunk
+
+// server_task select() with no call: ends on a readable socket (listening socket included)
+// or the wake socket. Bounds the ping and slot timeout checks, pings go out every 5 s.
+static constexpr uint32_t SERVER_IDLE_WAIT_MS = 1000;
 
 }  // namespace intercom_api
 }  // namespace esphome
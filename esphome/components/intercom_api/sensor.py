@@ -0,0 +1,126 @@
+"""Sensor platform for Intercom API - audio pipeline metrics (diagnostic)"""
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    CONF_ID,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    STATE_CLASS_MEASUREMENT,
+    STATE_CLASS_TOTAL_INCREASING,
+    UNIT_PERCENT,
+)
+
+from . import intercom_api_ns, IntercomApi, CONF_INTERCOM_API_ID
+
+DEPENDENCIES = ["intercom_api"]
+
+UNIT_MICROSECONDS = "µs"
+UNIT_MILLISECONDS = "ms"
+UNIT_BYTES = "B"
+
+CONF_RX_DROPPED_BYTES = "rx_dropped_bytes"
+CONF_TX_DROPPED_FRAMES = "tx_dropped_frames"
+CONF_SEND_EAGAIN = "send_eagain"
+CONF_CALL_RTT = "call_rtt"
+CONF_CALL_LATENCY = "call_latency"
+
+IntercomMetricsSensor = intercom_api_ns.class_(
+    "IntercomMetricsSensor", cg.PollingComponent, cg.Parented.template(IntercomApi)
+)
+MetricsStage = intercom_api_ns.enum("MetricsStage", is_class=True)
+MetricsRing = intercom_api_ns.enum("MetricsRing", is_class=True)
+MetricsTask = intercom_api_ns.enum("MetricsTask", is_class=True)
+
+# Peak execution time per update interval: <key>_time
+STAGES = {
+    "aec": MetricsStage.AEC,
+    "send": MetricsStage.SEND,
+    "encode": MetricsStage.ENCODE,
+    "decode": MetricsStage.DECODE,
+    "play": MetricsStage.PLAY,
+}
+# Fill watermarks per update interval: <key>_high / <key>_low
+RINGS = {
+    "mic_buffer": MetricsRing.MIC,
+    "speaker_buffer": MetricsRing.SPEAKER,
+    "aec_ref_buffer": MetricsRing.SPK_REF,
+}
+# Free stack and CPU load: <key>_stack_free / <key>_cpu
+TASKS = {
+    "server_task": MetricsTask.SERVER,
+    "tx_task": MetricsTask.TX,
+    "speaker_task": MetricsTask.SPEAKER,
+    "encoder_task": MetricsTask.ENCODER,
+}
+
+
+def _diag_schema(unit, icon, state_class=STATE_CLASS_MEASUREMENT, decimals=0):
+    return sensor.sensor_schema(
+        unit_of_measurement=unit,
+        icon=icon,
+        accuracy_decimals=decimals,
+        state_class=state_class,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    )
+
+
+_SCHEMA = {
+    cv.GenerateID(): cv.declare_id(IntercomMetricsSensor),
+    cv.GenerateID(CONF_INTERCOM_API_ID): cv.use_id(IntercomApi),
+    cv.Optional(CONF_RX_DROPPED_BYTES): _diag_schema(UNIT_BYTES, "mdi:download-off", STATE_CLASS_TOTAL_INCREASING),
+    cv.Optional(CONF_TX_DROPPED_FRAMES): _diag_schema(None, "mdi:upload-off", STATE_CLASS_TOTAL_INCREASING),
+    cv.Optional(CONF_SEND_EAGAIN): _diag_schema(None, "mdi:timer-sand", STATE_CLASS_TOTAL_INCREASING),
+    # In-call latency probes (peers that echo LATENCY): smoothed RTT, estimated peer mic -> our speaker
+    cv.Optional(CONF_CALL_RTT): _diag_schema(UNIT_MILLISECONDS, "mdi:swap-horizontal", decimals=1),
+    cv.Optional(CONF_CALL_LATENCY): _diag_schema(UNIT_MILLISECONDS, "mdi:ear-hearing"),
+}
+for _key in STAGES:
+    _SCHEMA[cv.Optional(f"{_key}_time")] = _diag_schema(UNIT_MICROSECONDS, "mdi:timer-outline")
+for _key in RINGS:
+    _SCHEMA[cv.Optional(f"{_key}_high")] = _diag_schema(UNIT_BYTES, "mdi:arrow-collapse-up")
+    _SCHEMA[cv.Optional(f"{_key}_low")] = _diag_schema(UNIT_BYTES, "mdi:arrow-collapse-down")
+for _key in TASKS:
+    _SCHEMA[cv.Optional(f"{_key}_stack_free")] = _diag_schema(UNIT_BYTES, "mdi:layers-outline")
+    _SCHEMA[cv.Optional(f"{_key}_cpu")] = _diag_schema(UNIT_PERCENT, "mdi:cpu-32-bit", decimals=1)
+
+CONFIG_SCHEMA = cv.Schema(_SCHEMA).extend(cv.polling_component_schema("10s"))
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    await cg.register_parented(var, config[CONF_INTERCOM_API_ID])
+
+    if CONF_RX_DROPPED_BYTES in config:
+        cg.add(var.set_rx_dropped_sensor(await sensor.new_sensor(config[CONF_RX_DROPPED_BYTES])))
+    if CONF_TX_DROPPED_FRAMES in config:
+        cg.add(var.set_tx_dropped_sensor(await sensor.new_sensor(config[CONF_TX_DROPPED_FRAMES])))
+    if CONF_SEND_EAGAIN in config:
+        cg.add(var.set_send_eagain_sensor(await sensor.new_sensor(config[CONF_SEND_EAGAIN])))
+    if CONF_CALL_RTT in config:
+        cg.add(var.set_rtt_sensor(await sensor.new_sensor(config[CONF_CALL_RTT])))
+    if CONF_CALL_LATENCY in config:
+        cg.add(var.set_latency_sensor(await sensor.new_sensor(config[CONF_CALL_LATENCY])))
+
+    for key, stage in STAGES.items():
+        if conf := config.get(f"{key}_time"):
+            cg.add(var.set_stage_sensor(stage, await sensor.new_sensor(conf)))
+
+    for key, ring in RINGS.items():
+        if conf := config.get(f"{key}_high"):
+            cg.add(var.set_ring_high_sensor(ring, await sensor.new_sensor(conf)))
+        if conf := config.get(f"{key}_low"):
+            cg.add(var.set_ring_low_sensor(ring, await sensor.new_sensor(conf)))
+
+    uses_cpu = False
+    for key, task in TASKS.items():
+        if conf := config.get(f"{key}_stack_free"):
+            cg.add(var.set_task_stack_sensor(task, await sensor.new_sensor(conf)))
+        if conf := config.get(f"{key}_cpu"):
+            cg.add(var.set_task_cpu_sensor(task, await sensor.new_sensor(conf)))
+            uses_cpu = True
+
+    if uses_cpu:
+        # Per-task CPU time needs FreeRTOS run time stats (esp_timer clock, one timer read per context switch)
+        from esphome.components.esp32 import add_idf_sdkconfig_option
+        add_idf_sdkconfig_option("CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS", True)
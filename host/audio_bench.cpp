@@ -0,0 +1,289 @@
+// Host micro-benchmarks for the per-frame audio kernels: the kernels audio_benchmark
+// times on the device, over the same synthetic 32 ms frame, timed per frame in
+// nanoseconds on the host clock with the allocations made during the timed frames.
+//
+//   audio_bench [--frames N] [--kernel NAME]
+//
+// Exits non-zero when a kernel allocates per frame or a framing round trip fails, so
+// the ctest smoke run guards the no-allocation rule of the audio paths.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "esphome/components/audio_benchmark/bench_fixtures.h"
+#include "esphome/components/audio_kernels/audio_kernels.h"
+#include "esphome/components/audio_kernels/spsc_ring.h"
+#include "esphome/components/i2s_audio_duplex/rx_kernel.h"
+
+#include "host_alloc.h"
+
+using namespace esphome;
+
+static const size_t FRAME_SAMPLES = 512;         // 32 ms at 16 kHz, as audio_benchmark
+static const uint32_t FIR_RATIO = 3;             // 48 kHz bus -> 16 kHz
+static const uint32_t SAMPLE_RATE = 16000;
+static const float BENCH_GAIN = 0.7f;
+static const uint32_t VAD_HANGOVER_MS = 240;
+static const float NOISE_LEVEL_DBFS = -50.0f;
+static const size_t DUPLEX_CHUNK_SAMPLES = 256;  // i2s_audio_duplex frame_duration default (16 ms)
+static const uint32_t WARMUP_FRAMES = 10;
+
+struct Kernel {
+  const char *name;
+  size_t samples;                // Output samples per frame
+  std::function<bool()> begin;   // false: not available
+  std::function<bool()> frame;   // false: the frame failed
+  std::function<void()> end;
+};
+
+struct Result {
+  uint64_t min_ns{UINT64_MAX};
+  uint64_t max_ns{0};
+  uint64_t total_ns{0};
+  uint64_t allocations{0};
+  uint32_t failures{0};
+};
+
+int main(int argc, char **argv) {
+  uint32_t frames = 1000;
+  std::string only;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+      frames = static_cast<uint32_t>(std::max(1, atoi(argv[++i])));
+    } else if (strcmp(argv[i], "--kernel") == 0 && i + 1 < argc) {
+      only = argv[++i];
+    } else {
+      fprintf(stderr, "usage: %s [--frames N] [--kernel NAME]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  // Frames as audio_benchmark's: two voice-band tones at about -12 dBFS over -50 dBFS noise
+  std::vector<int16_t> in(FRAME_SAMPLES * FIR_RATIO), ref(FRAME_SAMPLES), out(FRAME_SAMPLES),
+      out2(FRAME_SAMPLES), bus_out(FRAME_SAMPLES * FIR_RATIO);
+  audio_kernels::NoiseSource noise;
+  noise.fill(in.data(), in.size(), NOISE_LEVEL_DBFS);
+  const float bus_rate = static_cast<float>(SAMPLE_RATE * FIR_RATIO);
+  for (size_t i = 0; i < in.size(); i++) {
+    const float t = static_cast<float>(i) / bus_rate;
+    const float tone = 5000.0f * sinf(2.0f * static_cast<float>(M_PI) * 440.0f * t) +
+                       3000.0f * sinf(2.0f * static_cast<float>(M_PI) * 1250.0f * t);
+    in[i] = audio_kernels::saturate16(static_cast<int32_t>(tone) + in[i]);
+  }
+  for (size_t i = 0; i < FRAME_SAMPLES; i++) ref[i] = in[i * FIR_RATIO];
+
+  const size_t n = FRAME_SAMPLES;
+  audio_kernels::Gain gain = audio_kernels::Gain::from_float(BENCH_GAIN);
+  audio_kernels::DcBlocker dc;
+  audio_kernels::EnergyVad vad;
+  audio_kernels::NoiseSource cn;
+  std::unique_ptr<audio_kernels::SpscRing> ring = audio_kernels::SpscRing::create(n * sizeof(int16_t) * 2, false);
+  audio_benchmark::AecAccumulator accumulator;
+  audio_benchmark::FramingLoopback framing;
+  std::unique_ptr<i2s_audio_duplex::FirDecimator> fir;
+  std::unique_ptr<i2s_audio_duplex::FirDecimator> ref_fir;  // Second channel of rx_fused
+  std::unique_ptr<i2s_audio_duplex::FirInterpolator> interp;
+  volatile int32_t sink = 0;
+
+  auto always = [] { return true; };
+  auto nothing = [] {};
+  auto new_fir = [&](bool q15) {
+    fir.reset(new i2s_audio_duplex::FirDecimator());
+    fir->init(FIR_RATIO);
+    fir->set_q15_enabled(q15);
+    return fir->is_q15_enabled() == q15;
+  };
+  auto new_interp = [&](bool q15) {
+    interp.reset(new i2s_audio_duplex::FirInterpolator());
+    interp->init(FIR_RATIO);
+    interp->set_q15_enabled(q15);
+    return interp->is_q15_enabled() == q15;
+  };
+
+  const std::vector<Kernel> kernels = {
+      {"scale_copy", n, always,
+       [&] {
+         audio_kernels::scale_copy(ref.data(), out.data(), n, gain);
+         return true;
+       },
+       nothing},
+      {"dc_block_gain", n,
+       [&] {
+         dc.reset();
+         return true;
+       },
+       [&] {
+         audio_kernels::dc_block_gain(ref.data(), out.data(), n, dc, gain);
+         return true;
+       },
+       nothing},
+      {"deinterleave", n, always,
+       [&] {
+         static const uint8_t SLOTS[2] = {0, 1};
+         int16_t *const dst[2] = {out.data(), out2.data()};
+         audio_kernels::deinterleave(in.data(), n, 2, SLOTS, dst, 2);
+         return true;
+       },
+       nothing},
+      {"peak_abs", n, always,
+       [&] {
+         sink = audio_kernels::peak_abs(ref.data(), n);
+         return true;
+       },
+       nothing},
+      {"energy_vad", n,
+       [&] {
+         vad.init(SAMPLE_RATE, VAD_HANGOVER_MS);
+         return true;
+       },
+       [&] {
+         sink = vad.process(ref.data(), n) ? 1 : 0;
+         return true;
+       },
+       nothing},
+      {"noise_source", n, always,
+       [&] {
+         cn.fill(out.data(), n, NOISE_LEVEL_DBFS);
+         return true;
+       },
+       nothing},
+      {"spsc_ring", n,
+       [&] {
+         ring->reset();
+         return true;
+       },
+       [&] {
+         ring->write(ref.data(), n * sizeof(int16_t));
+         return ring->read(out.data(), n * sizeof(int16_t)) == n * sizeof(int16_t);
+       },
+       nothing},
+      {"mix_add", n,
+       [&] {
+         memcpy(out.data(), ref.data(), n * sizeof(int16_t));
+         return true;
+       },
+       [&] {
+         audio_kernels::mix_add(ref.data(), out.data(), n, 32767, 5827);
+         return true;
+       },
+       nothing},
+      {"aec_accumulator", n, [&] { return accumulator.init(n, DUPLEX_CHUNK_SAMPLES); },
+       [&] { return (sink = accumulator.run(in.data(), ref.data(), out.data(), out2.data())) >= 0; }, nothing},
+      {"framing", n, [&] { return framing.open(); },
+       [&] { return framing.round_trip(reinterpret_cast<const uint8_t *>(ref.data()), n * sizeof(int16_t)); },
+       [&] { framing.release(); }},
+      {"fir_float", n, [&] { return new_fir(false); },
+       [&] {
+         fir->process(in.data(), out.data(), n * FIR_RATIO);
+         return true;
+       },
+       [&] { fir.reset(); }},
+      {"fir_q15", n, [&] { return new_fir(true); },
+       [&] {
+         fir->process(in.data(), out.data(), n * FIR_RATIO);
+         return true;
+       },
+       [&] { fir.reset(); }},
+      {"rx_fused", n / 2,
+       [&] {
+         // in read as stereo: half the frame per channel, decimators on the Q15 backend as on an S3
+         fir.reset(new i2s_audio_duplex::FirDecimator());
+         fir->init(FIR_RATIO);
+         ref_fir.reset(new i2s_audio_duplex::FirDecimator());
+         ref_fir->init(FIR_RATIO);
+         dc.reset();
+         return true;
+       },
+       [&] {
+         static const uint8_t SLOTS[2] = {1, 0};  // Mic on the right, reference on the left
+         static const i2s_audio_duplex::RxKernelFn KERNEL =
+             i2s_audio_duplex::select_rx_kernel(false, i2s_audio_duplex::RxLayout::STEREO, true, FIR_RATIO);
+         i2s_audio_duplex::RxKernelJob job;
+         job.src = in.data();
+         job.out_frames = n / 2;
+         job.ratio = FIR_RATIO;
+         job.slots = SLOTS;
+         job.out[0] = out.data();
+         job.out[1] = out2.data();
+         job.fir[0] = fir.get();
+         job.fir[1] = ref_fir.get();
+         job.dc[0] = &dc;
+         job.gain = gain;
+         job.scratch = bus_out.data();
+         KERNEL(job);
+         return true;
+       },
+       [&] {
+         fir.reset();
+         ref_fir.reset();
+       }},
+      {"interp_float", n, [&] { return new_interp(false); },
+       [&] {
+         interp->process(ref.data(), bus_out.data(), n);
+         return true;
+       },
+       [&] { interp.reset(); }},
+      {"interp_q15", n, [&] { return new_interp(true); },
+       [&] {
+         interp->process(ref.data(), bus_out.data(), n);
+         return true;
+       },
+       [&] { interp.reset(); }},
+  };
+
+  printf("Host benchmark: %u frames per kernel, %zu samples (%u ms), ns per frame\n", (unsigned) frames,
+         FRAME_SAMPLES, (unsigned) (FRAME_SAMPLES * 1000 / SAMPLE_RATE));
+  printf("(Q15 kernels run esp-dsp's ANSI loop, framing the host TCP stack: compare them against each other only)\n");
+  printf("  %-18s %7s %10s %10s %10s %8s %8s %7s\n", "kernel", "samples", "min", "avg", "max", "ns/smp", "budget",
+         "allocs");
+
+  int status = 0;
+  for (const Kernel &kernel : kernels) {
+    if (!only.empty() && only != kernel.name) continue;
+    if (!kernel.begin()) {
+      printf("  %-18s (not available)\n", kernel.name);
+      kernel.end();
+      continue;
+    }
+    for (uint32_t i = 0; i < WARMUP_FRAMES; i++) kernel.frame();
+
+    Result r;
+    const uint64_t allocations_before = host::allocations();
+    for (uint32_t i = 0; i < frames; i++) {
+      const auto start = std::chrono::steady_clock::now();
+      const bool ok = kernel.frame();
+      const uint64_t ns = static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+      if (!ok) r.failures++;
+      r.total_ns += ns;
+      r.min_ns = std::min(r.min_ns, ns);
+      r.max_ns = std::max(r.max_ns, ns);
+    }
+    r.allocations = host::allocations() - allocations_before;
+    kernel.end();
+
+    const double avg_ns = static_cast<double>(r.total_ns) / frames;
+    const double frame_ns = static_cast<double>(kernel.samples) * 1e9 / SAMPLE_RATE;
+    printf("  %-18s %7zu %10llu %10.0f %10llu %8.2f %7.3f%% %7llu\n", kernel.name, kernel.samples,
+           (unsigned long long) r.min_ns, avg_ns, (unsigned long long) r.max_ns, avg_ns / kernel.samples,
+           avg_ns * 100.0 / frame_ns, (unsigned long long) r.allocations);
+    if (r.allocations > 0) {
+      fprintf(stderr, "%s: %llu allocations over %u frames\n", kernel.name, (unsigned long long) r.allocations,
+              (unsigned) frames);
+      status = 1;
+    }
+    if (r.failures > 0) {
+      fprintf(stderr, "%s: %u of %u frames failed\n", kernel.name, (unsigned) r.failures, (unsigned) frames);
+      status = 1;
+    }
+  }
+  return status;
+}
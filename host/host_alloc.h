@@ -0,0 +1,14 @@
+#pragma once
+
+// Allocation counter of the host harness: operator new and the heap_caps stubs both
+// count, so a benchmark can tell whether a kernel allocates per frame
+
+#include <cstdint>
+
+namespace esphome {
+namespace host {
+
+uint64_t allocations();
+
+}  // namespace host
+}  // namespace esphome
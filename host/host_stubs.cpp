@@ -0,0 +1,175 @@
+// Definitions behind the host stubs (stubs/): heap_caps, time, esp-dsp's Q15 FIR and a
+// stand-in echo canceller. Linked into every host program.
+
+#include "host_alloc.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include <dsps_fir.h>
+#include <esp_aec.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+
+#include "esphome/core/hal.h"
+
+static std::atomic<uint64_t> g_allocations{0};
+
+namespace esphome {
+namespace host {
+
+uint64_t allocations() { return g_allocations.load(std::memory_order_relaxed); }
+
+}  // namespace host
+}  // namespace esphome
+
+// ── Allocations ──
+
+void *operator new(size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *ptr = malloc(size == 0 ? 1 : size)) return ptr;
+  throw std::bad_alloc();
+}
+void *operator new[](size_t size) { return operator new(size); }
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  return malloc(size == 0 ? 1 : size);
+}
+void *operator new[](size_t size, const std::nothrow_t &tag) noexcept { return operator new(size, tag); }
+void operator delete(void *ptr) noexcept { free(ptr); }
+void operator delete[](void *ptr) noexcept { free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { free(ptr); }
+
+void *heap_caps_malloc(size_t size, uint32_t caps) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  return malloc(size);
+}
+
+void *heap_caps_calloc(size_t n, size_t size, uint32_t caps) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  return calloc(n, size);
+}
+
+void *heap_caps_aligned_alloc(size_t alignment, size_t size, uint32_t caps) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  // aligned_alloc() wants a size that is a multiple of the alignment
+  return aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+void heap_caps_free(void *ptr) { free(ptr); }
+
+// ── Time ──
+
+static const auto g_boot = std::chrono::steady_clock::now();
+
+int64_t esp_timer_get_time() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - g_boot).count();
+}
+
+namespace esphome {
+
+uint32_t millis() { return static_cast<uint32_t>(esp_timer_get_time() / 1000); }
+uint32_t micros() { return static_cast<uint32_t>(esp_timer_get_time()); }
+void delay(uint32_t ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+void delayMicroseconds(uint32_t us) { std::this_thread::sleep_for(std::chrono::microseconds(us)); }
+
+}  // namespace esphome
+
+// ── esp-dsp dsps_fird_s16 (ANSI reference) ──
+
+esp_err_t dsps_fird_init_s16(fir_s16_t *fir, int16_t *coeffs, int16_t *delay, int16_t coeffs_len, int16_t decim,
+                             int16_t start_pos, int16_t shift) {
+  if (fir == nullptr || coeffs == nullptr || delay == nullptr || coeffs_len <= 0 || decim <= 0 ||
+      start_pos < 0 || start_pos >= decim || shift < -40 || shift > 40) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  fir->coeffs = coeffs;
+  fir->delay = delay;
+  fir->coeffs_len = coeffs_len;
+  fir->pos = 0;
+  fir->decim = decim;
+  fir->d_pos = start_pos;
+  fir->shift = shift;
+  fir->rounding_buff = nullptr;
+  fir->rounding_val = shift < 15 ? 1 << (14 - shift) : 0;  // Half an output LSB
+  fir->free_status = 0;
+  return ESP_OK;
+}
+
+int32_t dsps_fird_s16(fir_s16_t *fir, const int16_t *input, int16_t *output, int32_t len) {
+  const int32_t final_shift = fir->shift - 15;
+  int32_t in_pos = 0;
+  for (int32_t i = 0; i < len; i++) {
+    // d_pos: input samples still owed to the first output (start_pos at init)
+    for (int32_t k = fir->d_pos; k < fir->decim; k++) {
+      if (fir->pos >= fir->coeffs_len) fir->pos = 0;
+      fir->delay[fir->pos++] = input[in_pos++];
+    }
+    fir->d_pos = 0;
+
+    int64_t acc = fir->rounding_val;
+    int32_t c = 0;
+    for (int32_t n = fir->pos; n < fir->coeffs_len; n++) acc += static_cast<int32_t>(fir->coeffs[c++]) * fir->delay[n];
+    for (int32_t n = 0; n < fir->pos; n++) acc += static_cast<int32_t>(fir->coeffs[c++]) * fir->delay[n];
+    output[i] = static_cast<int16_t>(final_shift > 0 ? (acc << final_shift) : (acc >> -final_shift));
+  }
+  return len;
+}
+
+void dsps_fird_s16_aexx_free(fir_s16_t *fir) { fir->free_status = 0; }
+
+// ── ESP-SR AEC stand-in: NLMS ──
+
+struct aec_handle_t {
+  static constexpr int TAPS = 256;  // 16 ms echo path at 16 kHz
+  static constexpr float MU = 0.3f;
+
+  int chunk;
+  std::vector<float> weights;
+  std::vector<float> history;  // Reference, circular, TAPS long
+  int pos;
+  float energy;  // Of what is in history
+};
+
+aec_handle_t *aec_create(int sample_rate, int filter_length, int channel_num, aec_mode_t mode) {
+  if (sample_rate != 16000 || channel_num != 1) return nullptr;
+  auto *handle = new aec_handle_t;
+  handle->chunk = (mode == AEC_MODE_VOIP_LOW_COST || mode == AEC_MODE_VOIP_HIGH_PERF) ? 256 : 512;
+  handle->weights.assign(aec_handle_t::TAPS, 0.0f);
+  handle->history.assign(aec_handle_t::TAPS, 0.0f);
+  handle->pos = 0;
+  handle->energy = 0.0f;
+  return handle;
+}
+
+void aec_process(const aec_handle_t *handle, int16_t *indata, int16_t *refdata, int16_t *outdata) {
+  auto *h = const_cast<aec_handle_t *>(handle);
+  const int taps = aec_handle_t::TAPS;
+  for (int i = 0; i < h->chunk; i++) {
+    const float x = static_cast<float>(refdata[i]);
+    h->energy += x * x - h->history[h->pos] * h->history[h->pos];
+    if (h->energy < 0.0f) h->energy = 0.0f;
+    h->history[h->pos] = x;
+
+    // weights[k] pairs with the reference k samples back
+    float echo = 0.0f;
+    for (int k = 0, n = h->pos; k < taps; k++, n = (n == 0 ? taps - 1 : n - 1)) echo += h->weights[k] * h->history[n];
+    const float err = static_cast<float>(indata[i]) - echo;
+    const float step = aec_handle_t::MU * err / (h->energy + 1e3f);
+    for (int k = 0, n = h->pos; k < taps; k++, n = (n == 0 ? taps - 1 : n - 1)) h->weights[k] += step * h->history[n];
+
+    h->pos = (h->pos + 1) % taps;
+    outdata[i] = static_cast<int16_t>(std::fmax(-32768.0f, std::fmin(32767.0f, std::round(err))));
+  }
+}
+
+int aec_get_chunksize(const aec_handle_t *handle) { return handle->chunk; }
+
+void aec_destroy(aec_handle_t *handle) { delete handle; }
@@ -0,0 +1,29 @@
+#pragma once
+
+// Host stand-in for esp-dsp's decimating Q15 FIR: the fir_s16_t fields the duplex FIR
+// code touches, and dsps_fird_s16() computed the way esp-dsp's ANSI version does (64-bit
+// accumulator over the circular delay line, oldest sample first, >> (15 - shift)), rounded
+// to nearest. Host timings of the Q15 paths say nothing about the S3's PIE loop.
+
+#include <cstdint>
+
+#include "esp_err.h"
+
+typedef struct fir_s16_s {
+  int16_t *coeffs;
+  int16_t *delay;
+  int16_t coeffs_len;
+  int16_t pos;
+  int16_t decim;
+  int16_t d_pos;
+  int16_t shift;
+  int32_t *rounding_buff;
+  int32_t rounding_val;
+  int16_t free_status;
+} fir_s16_t;
+
+esp_err_t dsps_fird_init_s16(fir_s16_t *fir, int16_t *coeffs, int16_t *delay, int16_t coeffs_len, int16_t decim,
+                             int16_t start_pos, int16_t shift);
+// len = output samples; reads len * decim input samples
+int32_t dsps_fird_s16(fir_s16_t *fir, const int16_t *input, int16_t *output, int32_t len);
+void dsps_fird_s16_aexx_free(fir_s16_t *fir);
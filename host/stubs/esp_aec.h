@@ -0,0 +1,22 @@
+#pragma once
+
+// Host stand-in for ESP-SR's esp_aec.h. aec_process() is a plain NLMS echo canceller,
+// enough for the replay driver to show the reference path lines up; it is not ESP-SR's
+// filter, so its output level and cost say nothing about the device's.
+
+#include <cstdint>
+
+typedef struct aec_handle_t aec_handle_t;
+
+typedef enum {
+  AEC_MODE_SR_LOW_COST = 0,
+  AEC_MODE_SR_HIGH_PERF = 1,
+  AEC_MODE_VOIP_LOW_COST = 3,
+  AEC_MODE_VOIP_HIGH_PERF = 4,
+} aec_mode_t;
+
+// Chunk sizes as ESP-SR's at 16 kHz: 512 samples for the SR modes, 256 for VoIP
+aec_handle_t *aec_create(int sample_rate, int filter_length, int channel_num, aec_mode_t mode);
+void aec_process(const aec_handle_t *handle, int16_t *indata, int16_t *refdata, int16_t *outdata);
+int aec_get_chunksize(const aec_handle_t *handle);
+void aec_destroy(aec_handle_t *handle);
@@ -0,0 +1,10 @@
+#pragma once
+
+// Host stand-in for ESP-IDF esp_err.h (the codes the host-built sources test for)
+
+typedef int esp_err_t;
+
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_NO_MEM 0x101
+#define ESP_ERR_INVALID_ARG 0x102
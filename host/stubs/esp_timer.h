@@ -0,0 +1,7 @@
+#pragma once
+
+// Host stand-in for ESP-IDF esp_timer: microseconds on the monotonic clock
+
+#include <cstdint>
+
+int64_t esp_timer_get_time();
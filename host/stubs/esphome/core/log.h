@@ -0,0 +1,24 @@
+#pragma once
+
+// Host stand-in for esphome/core/log.h: errors, warnings and info to stderr, debug and
+// verbose compiled out
+
+#include <cstdio>
+
+#define ESP_LOG_HOST_(level, tag, format, ...) fprintf(stderr, "[" level "][%s] " format "\n", tag, ##__VA_ARGS__)
+
+#define ESP_LOGE(tag, format, ...) ESP_LOG_HOST_("E", tag, format, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) ESP_LOG_HOST_("W", tag, format, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) ESP_LOG_HOST_("I", tag, format, ##__VA_ARGS__)
+#define ESP_LOGCONFIG(tag, format, ...) ESP_LOG_HOST_("C", tag, format, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...) \
+  do { \
+  } while (0)
+#define ESP_LOGV(tag, format, ...) \
+  do { \
+  } while (0)
+#define ESP_LOGVV(tag, format, ...) \
+  do { \
+  } while (0)
+
+#define YESNO(b) ((b) ? "YES" : "NO")
@@ -0,0 +1,11 @@
+#pragma once
+
+// Host stand-in for lwIP's BSD socket API: the POSIX one it mirrors
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
@@ -0,0 +1,5 @@
+#pragma once
+
+// Host stand-in for ESP-IDF soc_caps.h: the I2S capabilities of the ESP32-S3
+
+#define SOC_I2S_SUPPORTS_TDM 1
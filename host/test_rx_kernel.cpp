@@ -0,0 +1,161 @@
+// Equivalence test of the fused duplex RX kernel (rx_kernel.h) against the separate
+// passes process_rx_path_() made before it: 32 -> 16-bit conversion, deinterleave into
+// bus-rate copies, FirDecimator per channel, then DC block or attenuation on the mics.
+//
+// Every layout (mono, stereo, TDM with 1, 2 and 4 mics), sample width (16, 32 bit),
+// DC on / off, ratio 1-6, three attenuations and frame lengths that are and are not a
+// multiple of RX_BLOCK, over several consecutive frames so filter and DC state carry
+// over, on both FirDecimator backends (float and Q15). Outputs must match sample for
+// sample; mono at ratio 1 runs in place, as the audio task does.
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "esphome/components/audio_kernels/audio_kernels.h"
+#include "esphome/components/i2s_audio_duplex/rx_kernel.h"
+
+using namespace esphome;
+using namespace esphome::i2s_audio_duplex;
+
+static const int FRAMES = 4;
+static const size_t TDM_STRIDE = 8;
+static const uint8_t TDM_SLOTS[RX_MAX_CHANNELS] = {3, 5, 1, 6, 0};  // Mics, then the reference
+static const uint8_t STEREO_SLOTS[2] = {1, 0};                      // Mic right, reference left
+
+static uint32_t g_rng = 0x12345678u;
+static uint32_t next_random() {
+  g_rng ^= g_rng << 13;
+  g_rng ^= g_rng >> 17;
+  g_rng ^= g_rng << 5;
+  return g_rng;
+}
+
+struct Case {
+  RxLayout layout;
+  bool wide;
+  bool dc;
+  uint32_t ratio;
+  size_t mics;
+  float attenuation;
+  size_t out_frames;
+  bool q15;
+};
+
+template<typename T> static bool run_case(const Case &k) {
+  const size_t stride = k.layout == RxLayout::MONO ? 1 : k.layout == RxLayout::STEREO ? 2 : TDM_STRIDE;
+  const size_t channels = k.layout == RxLayout::MONO ? 1 : k.layout == RxLayout::STEREO ? 2 : k.mics + 1;
+  const size_t mics = k.layout == RxLayout::TDM ? k.mics : 1;
+  const uint8_t *slots = k.layout == RxLayout::STEREO ? STEREO_SLOTS : TDM_SLOTS;
+  static const uint8_t MONO_SLOT[1] = {0};
+  if (k.layout == RxLayout::MONO) slots = MONO_SLOT;
+  const size_t bus_frames = k.out_frames * k.ratio;
+
+  FirDecimator ref_fir[RX_MAX_CHANNELS], fused_fir[RX_MAX_CHANNELS];
+  audio_kernels::DcBlocker ref_dc[MAX_TDM_MICS], fused_dc[MAX_TDM_MICS];
+  for (size_t c = 0; c < channels; c++) {
+    ref_fir[c].init(k.ratio);
+    fused_fir[c].init(k.ratio);
+    ref_fir[c].set_q15_enabled(k.q15);
+    fused_fir[c].set_q15_enabled(k.q15);
+    if (fused_fir[c].is_q15_enabled() != k.q15 || ref_fir[c].is_q15_enabled() != k.q15) {
+      fprintf(stderr, "FirDecimator backend not available (q15=%d ratio=%u)\n", k.q15, (unsigned) k.ratio);
+      return false;
+    }
+  }
+
+  std::vector<int16_t> expected[RX_MAX_CHANNELS], actual[RX_MAX_CHANNELS];
+  for (size_t c = 0; c < channels; c++) {
+    expected[c].assign(k.out_frames, 0);
+    actual[c].assign(k.out_frames, 0);
+  }
+  std::vector<int16_t> scratch(rx_scratch_samples(k.wide, k.layout, channels, k.ratio) + 8);
+  const RxKernelFn kernel = select_rx_kernel(k.wide, k.layout, k.dc, k.ratio);
+
+  for (int f = 0; f < FRAMES; f++) {
+    std::vector<T> raw(bus_frames * stride);
+    for (T &x : raw) x = static_cast<T>(next_random() >> (sizeof(T) == 4 ? 0 : 16));
+
+    // Separate passes: convert, deinterleave, decimate, then DC / attenuation on the mics
+    std::vector<int16_t> bus16(raw.size());
+    for (size_t i = 0; i < raw.size(); i++) bus16[i] = rx_sample(raw[i]);
+    for (size_t c = 0; c < channels; c++) {
+      std::vector<int16_t> deint(bus_frames);
+      for (size_t i = 0; i < bus_frames; i++) deint[i] = bus16[i * stride + slots[c]];
+      ref_fir[c].process(deint.data(), expected[c].data(), bus_frames);
+    }
+    for (size_t c = 0; c < mics; c++) {
+      if (k.dc) {
+        audio_kernels::dc_block_gain(expected[c].data(), expected[c].data(), k.out_frames, ref_dc[c], k.attenuation);
+      } else {
+        audio_kernels::apply_gain(expected[c].data(), k.out_frames, k.attenuation);
+      }
+    }
+
+    // Fused kernel
+    RxKernelJob job;
+    job.src = raw.data();
+    job.out_frames = k.out_frames;
+    job.ratio = k.ratio;
+    job.stride = static_cast<uint8_t>(stride);
+    job.mics = static_cast<uint8_t>(mics);
+    job.channels = static_cast<uint8_t>(channels);
+    job.slots = slots;
+    job.gain = audio_kernels::Gain::from_float(k.attenuation);
+    job.scratch = scratch.data();
+    for (size_t c = 0; c < channels; c++) {
+      job.out[c] = actual[c].data();
+      job.fir[c] = &fused_fir[c];
+    }
+    for (size_t c = 0; c < mics; c++) job.dc[c] = &fused_dc[c];
+    const bool in_place = k.layout == RxLayout::MONO && k.ratio == 1;
+    if (in_place) job.out[0] = reinterpret_cast<int16_t *>(raw.data());
+    kernel(job);
+
+    for (size_t c = 0; c < channels; c++) {
+      const int16_t *got = in_place ? reinterpret_cast<const int16_t *>(raw.data()) : actual[c].data();
+      for (size_t i = 0; i < k.out_frames; i++) {
+        if (got[i] != expected[c][i]) {
+          fprintf(stderr,
+                  "FAIL %s %s-bit dc=%d ratio=%u mics=%zu att=%.2f frames=%zu q15=%d: frame %d channel %zu "
+                  "sample %zu: %d != %d\n",
+                  k.layout == RxLayout::MONO ? "mono" : k.layout == RxLayout::STEREO ? "stereo" : "tdm",
+                  k.wide ? "32" : "16", k.dc, (unsigned) k.ratio, k.mics, k.attenuation, k.out_frames, k.q15, f, c,
+                  i, got[i], expected[c][i]);
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+int main() {
+  int cases = 0;
+  int failures = 0;
+  for (bool q15 : {false, true}) {
+    for (RxLayout layout : {RxLayout::MONO, RxLayout::STEREO, RxLayout::TDM}) {
+      for (bool wide : {false, true}) {
+        for (bool dc : {false, true}) {
+          for (uint32_t ratio = 1; ratio <= 6; ratio++) {
+            // The Q15 backend only exists for decimation
+            if (q15 && ratio == 1) continue;
+            for (size_t mics : {1, 2, 4}) {
+              if (layout != RxLayout::TDM && mics != 1) continue;
+              for (float attenuation : {1.0f, 0.5f, 0.1f}) {
+                for (size_t out_frames : {256, 200, 37}) {
+                  const Case k{layout, wide, dc, ratio, mics, attenuation, out_frames, q15};
+                  const bool ok = wide ? run_case<int32_t>(k) : run_case<int16_t>(k);
+                  cases++;
+                  if (!ok) failures++;
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  printf("Fused RX kernel: %d cases, %d failures\n", cases, failures);
+  return failures == 0 ? 0 : 1;
+}
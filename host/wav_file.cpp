@@ -0,0 +1,84 @@
+#include "wav_file.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace esphome {
+namespace host {
+
+struct __attribute__((packed)) WavFormat {
+  uint16_t format;  // 1 = PCM
+  uint16_t channels;
+  uint32_t sample_rate;
+  uint32_t byte_rate;
+  uint16_t block_align;
+  uint16_t bits_per_sample;
+};
+
+bool read_wav(const std::string &path, WavData &wav) {
+  FILE *file = fopen(path.c_str(), "rb");
+  if (file == nullptr) {
+    fprintf(stderr, "%s: cannot open\n", path.c_str());
+    return false;
+  }
+  char riff[12];
+  bool ok = fread(riff, 1, sizeof(riff), file) == sizeof(riff) && memcmp(riff, "RIFF", 4) == 0 &&
+            memcmp(riff + 8, "WAVE", 4) == 0;
+
+  WavFormat fmt{};
+  bool have_fmt = false;
+  while (ok) {
+    char id[4];
+    uint32_t size;
+    if (fread(id, 1, 4, file) != 4 || fread(&size, 1, 4, file) != 4) {
+      ok = false;
+      break;
+    }
+    if (memcmp(id, "fmt ", 4) == 0 && size >= sizeof(fmt)) {
+      ok = fread(&fmt, 1, sizeof(fmt), file) == sizeof(fmt) &&
+           fseek(file, size - sizeof(fmt) + (size & 1), SEEK_CUR) == 0;
+      have_fmt = true;
+    } else if (memcmp(id, "data", 4) == 0 && have_fmt) {
+      if (fmt.format != 1 || fmt.bits_per_sample != 16 || fmt.channels == 0) {
+        fprintf(stderr, "%s: not 16-bit PCM\n", path.c_str());
+        fclose(file);
+        return false;
+      }
+      const size_t frames = size / fmt.block_align;
+      std::vector<int16_t> interleaved(frames * fmt.channels);
+      const size_t got = fread(interleaved.data(), fmt.block_align, frames, file);
+      wav.sample_rate = fmt.sample_rate;
+      wav.samples.resize(got);
+      for (size_t i = 0; i < got; i++) wav.samples[i] = interleaved[i * fmt.channels];
+      fclose(file);
+      return true;
+    } else {
+      ok = fseek(file, size + (size & 1), SEEK_CUR) == 0;
+    }
+  }
+  fprintf(stderr, "%s: not a WAV file\n", path.c_str());
+  fclose(file);
+  return false;
+}
+
+bool write_wav(const std::string &path, uint32_t sample_rate, const std::vector<int16_t> &samples) {
+  FILE *file = fopen(path.c_str(), "wb");
+  if (file == nullptr) {
+    fprintf(stderr, "%s: cannot create\n", path.c_str());
+    return false;
+  }
+  const uint32_t data_size = static_cast<uint32_t>(samples.size() * sizeof(int16_t));
+  const uint32_t riff_size = 4 + 8 + sizeof(WavFormat) + 8 + data_size;
+  const uint32_t fmt_size = sizeof(WavFormat);
+  WavFormat fmt{1, 1, sample_rate, sample_rate * 2, 2, 16};
+  bool ok = fwrite("RIFF", 1, 4, file) == 4 && fwrite(&riff_size, 4, 1, file) == 1 &&
+            fwrite("WAVEfmt ", 1, 8, file) == 8 && fwrite(&fmt_size, 4, 1, file) == 1 && fwrite(&fmt, sizeof(fmt), 1, file) == 1 &&
+            fwrite("data", 1, 4, file) == 4 && fwrite(&data_size, 4, 1, file) == 1 &&
+            fwrite(samples.data(), sizeof(int16_t), samples.size(), file) == samples.size();
+  ok = fclose(file) == 0 && ok;
+  if (!ok) fprintf(stderr, "%s: write failed\n", path.c_str());
+  return ok;
+}
+
+}  // namespace host
+}  // namespace esphome
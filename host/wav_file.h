@@ -0,0 +1,22 @@
+#pragma once
+
+// 16-bit PCM WAV files for the replay driver
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace host {
+
+struct WavData {
+  uint32_t sample_rate{0};
+  std::vector<int16_t> samples;  // First channel of the file
+};
+
+// false (with a message on stderr) when the file is missing or not 16-bit PCM
+bool read_wav(const std::string &path, WavData &wav);
+bool write_wav(const std::string &path, uint32_t sample_rate, const std::vector<int16_t> &samples);
+
+}  // namespace host
+}  // namespace esphome
@@ -0,0 +1,342 @@
+// End-to-end replay of a mic / speaker-reference WAV pair through the device audio path:
+//
+//   RX       i2s_audio_duplex's fused RX kernel on a stereo bus (mic right, reference
+//            left, as use_stereo_aec_ref): FIR decimation to 16 kHz (48 kHz input), DC
+//            block and mic attenuation on the mic, 16 ms duplex frames
+//   TX       intercom_api tx_task_(): the AEC frame accumulator (AecAccumulator), the
+//            quiet-frame AEC gate, aec_process() (host NLMS stand-in), the DTX decision
+//   Framing  send_frame() over loopback TCP, receive_frame() and playout on the far end
+//            (PCM, or comfort noise for a DTX frame)
+//
+//   wav_replay MIC.wav REF.wav OUT.wav [--aec sr|voip|off] [--dtx] [--dc] [--attenuation X]
+//   wav_replay --self-test
+//
+// Both inputs are 16-bit PCM at the same rate, 16 kHz or 48 kHz (first channel used);
+// OUT.wav is what the far end plays, 16 kHz mono. --self-test replays a synthetic pair
+// (far-end talk with its echo, then near-end talk, then silence) without files and checks
+// that the echo is cancelled, the near-end talk gets through and every frame arrives.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <esp_aec.h>
+
+#include "esphome/components/audio_benchmark/bench_fixtures.h"
+#include "esphome/components/audio_kernels/audio_kernels.h"
+#include "esphome/components/i2s_audio_duplex/rx_kernel.h"
+#include "esphome/components/intercom_api/intercom_framing.h"
+
+#include "wav_file.h"
+
+using namespace esphome;
+using intercom_api::ComfortNoiseFrame;
+using intercom_api::MessageFlags;
+using intercom_api::MessageType;
+
+static const uint32_t SAMPLE_RATE = 16000;
+static const size_t DUPLEX_CHUNK_SAMPLES = 256;  // i2s_audio_duplex frame_duration default (16 ms)
+static const int AEC_FILTER_LENGTH = 4;          // esp_aec default
+
+struct ReplayConfig {
+  aec_mode_t aec_mode{AEC_MODE_SR_LOW_COST};
+  bool aec{true};
+  bool dtx{false};
+  bool dc{false};
+  float attenuation{1.0f};
+};
+
+struct ReplayStats {
+  uint32_t frames{0};
+  uint32_t aec_frames{0};
+  uint32_t aec_skipped{0};  // Quiet-frame gate (DTX calls)
+  uint32_t dtx_frames{0};
+  uint32_t sent{0};
+  uint32_t received{0};
+  uint64_t rx_ns{0};
+  uint64_t accumulate_ns{0};
+  uint64_t aec_ns{0};
+  uint64_t framing_ns{0};
+};
+
+static uint64_t elapsed_ns(std::chrono::steady_clock::time_point start) {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+// Replays mic / ref (same rate) into far_end (what the peer plays) and aec_out (the TX
+// audio before the DTX decision). false when the setup fails.
+static bool replay(const ReplayConfig &config, uint32_t rate, const std::vector<int16_t> &mic,
+                   const std::vector<int16_t> &ref, std::vector<int16_t> &far_end, std::vector<int16_t> &aec_out,
+                   ReplayStats &stats) {
+  if (rate != SAMPLE_RATE && rate != SAMPLE_RATE * 3) {
+    fprintf(stderr, "Unsupported rate %u (16000 or 48000)\n", (unsigned) rate);
+    return false;
+  }
+  const uint32_t ratio = rate / SAMPLE_RATE;
+
+  aec_handle_t *aec = nullptr;
+  size_t frame_samples = intercom_api::SAMPLES_PER_CHUNK;
+  if (config.aec) {
+    aec = aec_create(SAMPLE_RATE, AEC_FILTER_LENGTH, 1, config.aec_mode);
+    if (aec == nullptr) {
+      fprintf(stderr, "aec_create failed\n");
+      return false;
+    }
+    frame_samples = static_cast<size_t>(aec_get_chunksize(aec));
+  }
+
+  static const uint8_t SLOTS[2] = {1, 0};
+  i2s_audio_duplex::FirDecimator mic_fir, ref_fir;
+  mic_fir.init(ratio);
+  ref_fir.init(ratio);
+  audio_kernels::DcBlocker dc;
+  const i2s_audio_duplex::RxKernelFn rx_kernel =
+      i2s_audio_duplex::select_rx_kernel(false, i2s_audio_duplex::RxLayout::STEREO, config.dc, ratio);
+  std::vector<int16_t> bus(DUPLEX_CHUNK_SAMPLES * ratio * 2);
+  std::vector<int16_t> rx_scratch(
+      i2s_audio_duplex::rx_scratch_samples(false, i2s_audio_duplex::RxLayout::STEREO, 2, ratio));
+  i2s_audio_duplex::RxKernelJob job;
+  job.ratio = ratio;
+  job.stride = 2;
+  job.channels = 2;
+  job.slots = SLOTS;
+  job.fir[0] = &mic_fir;
+  job.fir[1] = &ref_fir;
+  job.dc[0] = &dc;
+  job.gain = audio_kernels::Gain::from_float(config.attenuation);
+  job.scratch = rx_scratch.data();
+  job.src = bus.data();
+  audio_kernels::EnergyVad gate_vad, dtx_vad;
+  gate_vad.init(SAMPLE_RATE, intercom_api::DTX_HANGOVER_MS);
+  dtx_vad.init(SAMPLE_RATE, intercom_api::DTX_HANGOVER_MS);
+  audio_kernels::NoiseSource comfort_noise;
+
+  audio_benchmark::AecAccumulator accumulator;
+  audio_benchmark::FramingLoopback link;
+  if (!accumulator.init(frame_samples, std::min(DUPLEX_CHUNK_SAMPLES, frame_samples)) || !link.open()) {
+    fprintf(stderr, "Accumulator or loopback link setup failed\n");
+    if (aec != nullptr) aec_destroy(aec);
+    return false;
+  }
+
+  std::vector<int16_t> mic16(frame_samples), ref16(frame_samples), mic_frame(frame_samples),
+      ref_frame(frame_samples), out(frame_samples);
+  std::vector<uint8_t> rx_buffer(intercom_api::MAX_MESSAGE_SIZE);
+  const size_t in_frame = frame_samples * ratio;
+
+  for (size_t pos = 0; pos + in_frame <= std::min(mic.size(), ref.size()); pos += in_frame) {
+    // RX: one duplex frame at a time, as the audio task reads them off the bus (the
+    // interleave stands in for the I2S read and is not timed)
+    uint64_t rx_ns = 0;
+    for (size_t done = 0; done < frame_samples; done += DUPLEX_CHUNK_SAMPLES) {
+      const size_t n = std::min(DUPLEX_CHUNK_SAMPLES, frame_samples - done);
+      for (size_t i = 0; i < n * ratio; i++) {
+        bus[i * 2 + SLOTS[0]] = mic[pos + done * ratio + i];
+        bus[i * 2 + SLOTS[1]] = ref[pos + done * ratio + i];
+      }
+      job.out_frames = n;
+      job.out[0] = &mic16[done];
+      job.out[1] = &ref16[done];
+      const auto rx_start = std::chrono::steady_clock::now();
+      rx_kernel(job);
+      rx_ns += elapsed_ns(rx_start);
+    }
+    stats.rx_ns += rx_ns;
+
+    // TX: accumulate to one AEC frame, then the gate and the AEC
+    auto start = std::chrono::steady_clock::now();
+    const int32_t ref_peak = accumulator.run(mic16.data(), ref16.data(), mic_frame.data(), ref_frame.data());
+    stats.accumulate_ns += elapsed_ns(start);
+    if (ref_peak < 0) continue;
+    stats.frames++;
+
+    const int16_t *tx = mic_frame.data();
+    if (aec != nullptr) {
+      const bool ref_quiet = ref_peak < intercom_api::DTX_REF_QUIET_PEAK;
+      const bool mic_quiet = config.dtx && !gate_vad.process(mic_frame.data(), frame_samples);
+      if (mic_quiet && ref_quiet) {
+        stats.aec_skipped++;
+      } else {
+        start = std::chrono::steady_clock::now();
+        aec_process(aec, mic_frame.data(), ref_frame.data(), out.data());
+        stats.aec_ns += elapsed_ns(start);
+        stats.aec_frames++;
+        tx = out.data();
+      }
+    }
+    aec_out.insert(aec_out.end(), tx, tx + frame_samples);
+
+    // Framing: the PCM frame or, on a quiet DTX frame, a ComfortNoiseFrame at the floor
+    start = std::chrono::steady_clock::now();
+    intercom_api::FrameSendResult sent;
+    if (config.dtx && !dtx_vad.process(tx, frame_samples)) {
+      ComfortNoiseFrame sid;
+      sid.level = static_cast<uint8_t>(std::min(-dtx_vad.get_floor_dbfs(), 255.0f) + 0.5f);
+      sid.samples = static_cast<uint16_t>(frame_samples);
+      sent = intercom_api::send_frame(link.tx_socket(), MessageType::AUDIO, MessageFlags::DTX,
+                                      reinterpret_cast<const uint8_t *>(&sid), sizeof(sid), false);
+      stats.dtx_frames++;
+    } else {
+      sent = intercom_api::send_frame(link.tx_socket(), MessageType::AUDIO, MessageFlags::NONE,
+                                      reinterpret_cast<const uint8_t *>(tx), frame_samples * sizeof(int16_t), false);
+    }
+    if (sent != intercom_api::FrameSendResult::SENT) continue;
+    stats.sent++;
+
+    intercom_api::MessageHeader header;
+    if (!intercom_api::receive_frame(link.rx_socket(), header, rx_buffer.data(), rx_buffer.size())) continue;
+    stats.framing_ns += elapsed_ns(start);
+    stats.received++;
+
+    // Far end playout
+    const uint8_t *payload = rx_buffer.data() + intercom_api::HEADER_SIZE;
+    if (header.flags & static_cast<uint8_t>(MessageFlags::DTX)) {
+      ComfortNoiseFrame sid;
+      memcpy(&sid, payload, sizeof(sid));
+      const size_t start_pos = far_end.size();
+      far_end.resize(start_pos + sid.samples);
+      if (sid.level >= intercom_api::DTX_SILENCE_LEVEL) {
+        std::fill(far_end.begin() + start_pos, far_end.end(), 0);
+      } else {
+        comfort_noise.fill(&far_end[start_pos], sid.samples, -static_cast<float>(sid.level));
+      }
+    } else {
+      const int16_t *pcm = reinterpret_cast<const int16_t *>(payload);
+      far_end.insert(far_end.end(), pcm, pcm + header.length / sizeof(int16_t));
+    }
+  }
+
+  if (aec != nullptr) aec_destroy(aec);
+  return true;
+}
+
+static void print_stats(const ReplayStats &stats, size_t frame_samples) {
+  const auto per_frame = [](uint64_t ns, uint32_t frames) { return frames > 0 ? static_cast<double>(ns) / frames : 0.0; };
+  printf("Frames: %u (%zu samples), AEC %u, AEC skipped %u, DTX %u, sent %u, received %u\n", (unsigned) stats.frames,
+         frame_samples, (unsigned) stats.aec_frames, (unsigned) stats.aec_skipped, (unsigned) stats.dtx_frames,
+         (unsigned) stats.sent, (unsigned) stats.received);
+  printf("ns per frame: rx %.0f, accumulate %.0f, aec %.0f, framing %.0f\n", per_frame(stats.rx_ns, stats.frames),
+         per_frame(stats.accumulate_ns, stats.frames), per_frame(stats.aec_ns, stats.aec_frames),
+         per_frame(stats.framing_ns, stats.received));
+}
+
+// Mean power of samples [from, to) seconds at 16 kHz, dBFS
+static float level_dbfs(const std::vector<int16_t> &pcm, float from, float to) {
+  const size_t a = std::min(pcm.size(), static_cast<size_t>(from * SAMPLE_RATE));
+  const size_t b = std::min(pcm.size(), static_cast<size_t>(to * SAMPLE_RATE));
+  if (b <= a) return audio_kernels::EnergyVad::SILENCE_DBFS;
+  double energy = 0.0;
+  for (size_t i = a; i < b; i++) energy += static_cast<double>(pcm[i]) * pcm[i];
+  if (energy <= 0.0) return audio_kernels::EnergyVad::SILENCE_DBFS;
+  return static_cast<float>(10.0 * log10(energy / ((b - a) * 32768.0 * 32768.0)));
+}
+
+static int self_test() {
+  // 48 kHz pair, 4 s: far-end talk (0-2 s) and its echo at -8 dB, 1 ms late; near-end
+  // talk (2.5-3.5 s); a -60 dBFS noise floor on the mic throughout
+  const uint32_t rate = SAMPLE_RATE * 3;
+  const size_t total = rate * 4;
+  const size_t echo_delay = rate / 1000;
+  std::vector<int16_t> mic(total), ref(total);
+  audio_kernels::NoiseSource noise;
+  noise.fill(mic.data(), total, -60.0f);
+  for (size_t i = 0; i < total; i++) {
+    const float t = static_cast<float>(i) / rate;
+    if (t < 2.0f) {
+      const float envelope = 0.55f + 0.45f * sinf(2.0f * static_cast<float>(M_PI) * 3.0f * t);
+      ref[i] = static_cast<int16_t>(envelope * (6000.0f * sinf(2.0f * static_cast<float>(M_PI) * 310.0f * t) +
+                                               3000.0f * sinf(2.0f * static_cast<float>(M_PI) * 870.0f * t)));
+    }
+    int32_t sample = mic[i];
+    if (i >= echo_delay) sample += static_cast<int32_t>(ref[i - echo_delay] * 0.4f);
+    if (t >= 2.5f && t < 3.5f) sample += static_cast<int32_t>(5000.0f * sinf(2.0f * static_cast<float>(M_PI) * 620.0f * t));
+    mic[i] = audio_kernels::saturate16(sample);
+  }
+
+  ReplayConfig config;
+  config.dtx = true;
+  config.dc = true;
+  std::vector<int16_t> far_end, aec_out;
+  ReplayStats stats;
+  if (!replay(config, rate, mic, ref, far_end, aec_out, stats)) return 1;
+  print_stats(stats, aec_out.size() / std::max<uint32_t>(stats.frames, 1));
+
+  // The mic as the AEC sees it, for the echo reference level
+  std::vector<int16_t> mic16(mic.size() / 3);
+  i2s_audio_duplex::FirDecimator fir;
+  fir.init(3);
+  fir.process(mic.data(), mic16.data(), mic16.size() * 3);
+
+  const float echo_in = level_dbfs(mic16, 1.0f, 2.0f);
+  const float echo_out = level_dbfs(aec_out, 1.0f, 2.0f);
+  const float near_in = level_dbfs(mic16, 2.6f, 3.4f);
+  const float near_out = level_dbfs(far_end, 2.6f, 3.4f);
+  printf("Echo %.1f -> %.1f dBFS (ERLE %.1f dB), near-end talk %.1f -> %.1f dBFS\n", echo_in, echo_out,
+         echo_in - echo_out, near_in, near_out);
+
+  int failures = 0;
+  auto check = [&failures](bool ok, const char *what) {
+    if (!ok) {
+      fprintf(stderr, "FAIL: %s\n", what);
+      failures++;
+    }
+  };
+  check(stats.frames > 0 && stats.received == stats.frames, "every frame arrives");
+  check(far_end.size() == aec_out.size(), "far end plays as many samples as were sent");
+  check(echo_in - echo_out >= 10.0f, "echo cancelled by at least 10 dB");
+  check(std::fabs(near_in - near_out) <= 3.0f, "near-end talk within 3 dB");
+  check(stats.dtx_frames > 0, "silence sent as DTX frames");
+  check(stats.aec_skipped > 0, "AEC skipped on quiet frames");
+  printf("%s\n", failures == 0 ? "Self-test passed" : "Self-test FAILED");
+  return failures == 0 ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
+  if (argc == 2 && strcmp(argv[1], "--self-test") == 0) return self_test();
+
+  ReplayConfig config;
+  std::vector<std::string> paths;
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg == "--aec" && i + 1 < argc) {
+      const std::string mode = argv[++i];
+      config.aec = mode != "off";
+      config.aec_mode = mode == "voip" ? AEC_MODE_VOIP_LOW_COST : AEC_MODE_SR_LOW_COST;
+    } else if (arg == "--dtx") {
+      config.dtx = true;
+    } else if (arg == "--dc") {
+      config.dc = true;
+    } else if (arg == "--attenuation" && i + 1 < argc) {
+      config.attenuation = static_cast<float>(atof(argv[++i]));
+    } else {
+      paths.push_back(arg);
+    }
+  }
+  if (paths.size() != 3) {
+    fprintf(stderr, "usage: %s MIC.wav REF.wav OUT.wav [--aec sr|voip|off] [--dtx] [--dc] [--attenuation X]\n"
+                    "       %s --self-test\n",
+            argv[0], argv[0]);
+    return 2;
+  }
+
+  host::WavData mic, ref;
+  if (!host::read_wav(paths[0], mic) || !host::read_wav(paths[1], ref)) return 1;
+  if (mic.sample_rate != ref.sample_rate) {
+    fprintf(stderr, "Mic (%u Hz) and reference (%u Hz) rates differ\n", (unsigned) mic.sample_rate,
+            (unsigned) ref.sample_rate);
+    return 1;
+  }
+
+  std::vector<int16_t> far_end, aec_out;
+  ReplayStats stats;
+  if (!replay(config, mic.sample_rate, mic.samples, ref.samples, far_end, aec_out, stats)) return 1;
+  print_stats(stats, aec_out.size() / std::max<uint32_t>(stats.frames, 1));
+  return host::write_wav(paths[2], SAMPLE_RATE, far_end) ? 0 : 1;
+}